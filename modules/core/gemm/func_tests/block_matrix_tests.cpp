@@ -0,0 +1,140 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/block_matrix.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> randomMatrix(int size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<T> dist(-1.0, 1.0);
+  std::vector<T> matrix(static_cast<size_t>(size) * size);
+  for (auto &value : matrix) value = dist(gen);
+  return matrix;
+}
+
+std::vector<double> naiveProduct(const std::vector<double> &a, const std::vector<double> &b, int size) {
+  std::vector<double> c(a.size(), 0.0);
+  for (int i = 0; i < size; ++i) {
+    for (int k = 0; k < size; ++k) {
+      for (int j = 0; j < size; ++j) {
+        c[i * size + j] += a[i * size + k] * b[k * size + j];
+      }
+    }
+  }
+  return c;
+}
+
+}  // namespace
+
+TEST(block_matrix_tests, row_major_roundtrip_pads_with_zeros) {
+  const int size = 37;
+  const int block = 8;
+  const auto a = randomMatrix<double>(size, 1);
+  const auto blocks = ppc::core::BlockMatrix::fromRowMajor(a.data(), size, block);
+  ASSERT_EQ(blocks.grid(), 5);
+  ASSERT_EQ(blocks.size(), size);
+  ASSERT_EQ(blocks.blockSize(), block);
+  // element (12, 30) is row 4, column 6 of tile (1, 3)
+  EXPECT_EQ(blocks.tile(1, 3)[4 * block + 6], a[12 * size + 30]);
+  // the last tile holds rows and columns 32..36, the rest is padding
+  const double *last = blocks.tile(4, 4);
+  for (int r = 0; r < block; ++r) {
+    for (int c = 0; c < block; ++c) {
+      if (r >= size - 32 || c >= size - 32) {
+        ASSERT_EQ(last[r * block + c], 0.0) << r << " " << c;
+      }
+    }
+  }
+  std::vector<double> back(a.size());
+  blocks.toRowMajor(back.data());
+  EXPECT_EQ(back, a);
+}
+
+TEST(block_matrix_tests, schedules_and_layers_with_padding) {
+  const int size = 70;
+  const int block = 16;
+  const auto a = randomMatrix<double>(size, 3);
+  const auto b = randomMatrix<double>(size, 4);
+  const auto expected = naiveProduct(a, b, size);
+
+  const auto block_a = ppc::core::BlockMatrix::fromRowMajor(a.data(), size, block);
+  const auto block_b = ppc::core::BlockMatrix::fromRowMajor(b.data(), size, block);
+  for (ppc::core::BlockSchedule schedule : {ppc::core::BlockSchedule::Fox, ppc::core::BlockSchedule::Cannon}) {
+    for (int layers : {1, 2, 5, 9}) {
+      ppc::core::BlockMatrix block_c(size, block);
+      ppc::core::multiplyBlocks(block_a, block_b, block_c, schedule, layers);
+      std::vector<double> c(a.size());
+      block_c.toRowMajor(c.data());
+      for (size_t i = 0; i < c.size(); ++i) {
+        ASSERT_NEAR(c[i], expected[i], 1e-10) << layers;
+      }
+    }
+  }
+}
+
+TEST(block_matrix_tests, single_tile) {
+  const int size = 5;
+  const auto a = randomMatrix<double>(size, 5);
+  const auto b = randomMatrix<double>(size, 6);
+  const auto expected = naiveProduct(a, b, size);
+  const auto block_a = ppc::core::BlockMatrix::fromRowMajor(a.data(), size, 16);
+  const auto block_b = ppc::core::BlockMatrix::fromRowMajor(b.data(), size, 16);
+  ppc::core::BlockMatrix block_c(size, 16);
+  ASSERT_EQ(block_c.grid(), 1);
+  ppc::core::multiplyBlocks(block_a, block_b, block_c, ppc::core::BlockSchedule::Cannon,
+                            ppc::core::defaultLayers(block_c.grid()));
+  std::vector<double> c(a.size());
+  block_c.toRowMajor(c.data());
+  for (size_t i = 0; i < c.size(); ++i) {
+    ASSERT_NEAR(c[i], expected[i], 1e-12);
+  }
+}
+
+TEST(block_matrix_tests, float_tiles_into_double) {
+  // |C - fl(C)| <= gamma(n) |A| |B| elementwise with u = 2^-24 for float and mixed sums
+  const int size = 90;
+  const int block = 32;
+  const auto a = randomMatrix<float>(size, 7);
+  const auto b = randomMatrix<float>(size, 8);
+  const std::vector<double> a64(a.begin(), a.end());
+  const std::vector<double> b64(b.begin(), b.end());
+  const auto exact = naiveProduct(a64, b64, size);
+  std::vector<double> magnitude(exact.size(), 0.0);
+  for (int i = 0; i < size; ++i) {
+    for (int k = 0; k < size; ++k) {
+      for (int j = 0; j < size; ++j) {
+        magnitude[i * size + j] += std::abs(a64[i * size + k] * b64[k * size + j]);
+      }
+    }
+  }
+  const double gamma = (size + 1) * 0x1p-24 / (1.0 - (size + 1) * 0x1p-24);
+
+  const auto block_a = ppc::core::BasicBlockMatrix<float>::fromRowMajor(a.data(), size, block);
+  const auto block_b = ppc::core::BasicBlockMatrix<float>::fromRowMajor(b.data(), size, block);
+  ppc::core::BasicBlockMatrix<float> single_c(size, block);
+  ppc::core::BasicBlockMatrix<double> mixed_c(size, block);
+  ppc::core::multiplyBlocks(block_a, block_b, single_c, ppc::core::BlockSchedule::Fox, 2);
+  ppc::core::multiplyBlocks(block_a, block_b, mixed_c, ppc::core::BlockSchedule::Fox, 2);
+  std::vector<float> single(exact.size());
+  std::vector<double> mixed(exact.size());
+  single_c.toRowMajor(single.data());
+  mixed_c.toRowMajor(mixed.data());
+  for (size_t i = 0; i < exact.size(); ++i) {
+    ASSERT_LE(std::abs(single[i] - exact[i]), gamma * magnitude[i]);
+    ASSERT_LE(std::abs(mixed[i] - exact[i]), gamma * magnitude[i]);
+  }
+}
+
+TEST(block_matrix_tests, default_layers_stay_within_the_grid) {
+  for (int grid : {1, 2, 3, 8, 64}) {
+    const int layers = ppc::core::defaultLayers(grid);
+    EXPECT_GE(layers, 1);
+    EXPECT_LE(layers, grid);
+  }
+}
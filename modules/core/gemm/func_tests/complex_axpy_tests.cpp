@@ -0,0 +1,102 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/complex_axpy.hpp"
+
+namespace {
+
+struct SplitVector {
+  std::vector<double> re;
+  std::vector<double> im;
+};
+
+SplitVector randomSplit(size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  SplitVector v{std::vector<double>(n), std::vector<double>(n)};
+  for (size_t k = 0; k < n; ++k) {
+    v.re[k] = dist(gen);
+    v.im[k] = dist(gen);
+  }
+  return v;
+}
+
+void checkAgainstScalar(const std::vector<int> &index, size_t m) {
+  const double a_re = 0.75;
+  const double a_im = -1.25;
+  SplitVector x = randomSplit(index.size(), 1);
+  SplitVector y = randomSplit(m, 2);
+  SplitVector expected = y;
+  for (size_t k = 0; k < index.size(); ++k) {
+    const int j = index[k];
+    expected.re[j] += a_re * x.re[k] - a_im * x.im[k];
+    expected.im[j] += a_re * x.im[k] + a_im * x.re[k];
+  }
+  ppc::core::complexAxpyScatter(a_re, a_im, x.re.data(), x.im.data(), index.data(), index.size(), y.re.data(),
+                                y.im.data());
+  for (size_t j = 0; j < m; ++j) {
+    EXPECT_DOUBLE_EQ(y.re[j], expected.re[j]) << "at " << j;
+    EXPECT_DOUBLE_EQ(y.im[j], expected.im[j]) << "at " << j;
+  }
+}
+
+}  // namespace
+
+TEST(complex_axpy, consecutive_run_matches_scalar_for_every_tail) {
+  for (size_t n = 0; n <= 9; ++n) {
+    std::vector<int> index(n);
+    for (size_t k = 0; k < n; ++k) index[k] = static_cast<int>(k + 3);
+    checkAgainstScalar(index, n + 6);
+  }
+}
+
+TEST(complex_axpy, scattered_indices_match_scalar) {
+  std::mt19937 gen(7);
+  std::vector<int> index(100);
+  for (auto &j : index) j = static_cast<int>(gen() % 256);
+  checkAgainstScalar(index, 256);
+}
+
+TEST(complex_axpy, repeated_index_accumulates) {
+  const std::vector<int> index = {2, 2, 2, 2, 2};
+  const std::vector<double> x_re(5, 1.0);
+  const std::vector<double> x_im(5, 0.0);
+  std::vector<double> y_re(4, 0.0);
+  std::vector<double> y_im(4, 0.0);
+  ppc::core::complexAxpyScatter(0.0, 1.0, x_re.data(), x_im.data(), index.data(), index.size(), y_re.data(),
+                                y_im.data());
+  EXPECT_EQ(y_re[2], 0.0);
+  EXPECT_EQ(y_im[2], 5.0);
+}
+
+TEST(complex_axpy, empty_slice_leaves_output_unchanged) {
+  std::vector<double> y_re = {1.0, 2.0};
+  std::vector<double> y_im = {3.0, 4.0};
+  ppc::core::complexAxpyScatter(2.0, 3.0, nullptr, nullptr, nullptr, 0, y_re.data(), y_im.data());
+  EXPECT_EQ(y_re, (std::vector<double>{1.0, 2.0}));
+  EXPECT_EQ(y_im, (std::vector<double>{3.0, 4.0}));
+}
+
+TEST(complex_axpy, run_with_a_gap_matches_scalar) {
+  const std::vector<int> index = {0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12};
+  checkAgainstScalar(index, 16);
+}
+
+TEST(complex_axpy, entries_outside_the_run_are_untouched) {
+  const std::vector<int> index = {4, 5, 6, 7, 8, 9, 10, 11};
+  const std::vector<double> x_re(8, 1.0);
+  const std::vector<double> x_im(8, 1.0);
+  std::vector<double> y_re(16, -1.0);
+  std::vector<double> y_im(16, -1.0);
+  ppc::core::complexAxpyScatter(1.0, 1.0, x_re.data(), x_im.data(), index.data(), index.size(), y_re.data(),
+                                y_im.data());
+  for (int j = 0; j < 16; ++j) {
+    const bool inside = j >= 4 && j < 12;
+    EXPECT_EQ(y_re[j], -1.0) << "at " << j;
+    EXPECT_EQ(y_im[j], inside ? 1.0 : -1.0) << "at " << j;
+  }
+}
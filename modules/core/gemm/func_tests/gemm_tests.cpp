@@ -0,0 +1,178 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+
+std::vector<double> randomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> matrix(rows * cols);
+  for (auto &value : matrix) value = dist(gen);
+  return matrix;
+}
+
+std::vector<double> naiveProduct(const std::vector<double> &a, const std::vector<double> &b, int m, int n, int k) {
+  std::vector<double> c(m * n, 0.0);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      for (int p = 0; p < k; ++p) {
+        c[i * n + j] += a[i * k + p] * b[p * n + j];
+      }
+    }
+  }
+  return c;
+}
+
+void checkProduct(int m, int n, int k) {
+  std::vector<double> a = randomMatrix(m, k, 1);
+  std::vector<double> b = randomMatrix(k, n, 2);
+  std::vector<double> expected = naiveProduct(a, b, m, n, k);
+  std::vector<double> c = ppc::core::gemm(a, b, m, n, k);
+  ASSERT_EQ(c.size(), expected.size());
+  for (size_t i = 0; i < c.size(); ++i) {
+    ASSERT_NEAR(c[i], expected[i], 1e-12 * k);
+  }
+}
+
+}  // namespace
+
+TEST(gemm_tests, small_product) { checkProduct(3, 5, 7); }
+
+TEST(gemm_tests, product_with_edge_tiles) { checkProduct(101, 67, 45); }
+
+TEST(gemm_tests, product_over_several_panels) { checkProduct(200, 2100, 300); }
+
+TEST(gemm_tests, accumulate_into_block) {
+  // C[1:1+m, 2:2+n] += A[0:m, 3:3+k] * B[1:1+k, 0:n] inside larger matrices
+  int m = 37;
+  int n = 29;
+  int k = 41;
+  int lda = 50;
+  int ldb = 40;
+  int ldc = 35;
+  std::vector<double> a = randomMatrix(m, lda, 3);
+  std::vector<double> b = randomMatrix(k + 1, ldb, 4);
+  std::vector<double> c = randomMatrix(m + 1, ldc, 5);
+  std::vector<double> original = c;
+  ppc::core::gemm(m, n, k, a.data() + 3, lda, b.data() + ldb, ldb, c.data() + ldc + 2, ldc, true);
+
+  for (int i = 0; i < m + 1; ++i) {
+    for (int j = 0; j < ldc; ++j) {
+      double expected = original[i * ldc + j];
+      if (i >= 1 && j >= 2 && j < 2 + n) {
+        for (int p = 0; p < k; ++p) expected += a[(i - 1) * lda + 3 + p] * b[(p + 1) * ldb + j - 2];
+      }
+      ASSERT_NEAR(c[i * ldc + j], expected, 1e-12 * k);
+    }
+  }
+}
+
+TEST(gemm_tests, empty_inner_dimension) {
+  std::vector<double> c(6, 1.0);
+  ppc::core::gemm(2, 3, 0, nullptr, 0, nullptr, 3, c.data(), 3);
+  for (double value : c) ASSERT_EQ(value, 0.0);
+}
+
+TEST(gemm_tests, float_and_mixed_within_error_bounds) {
+  // |C - fl(C)| <= gamma(n) |A| |B| elementwise, gamma(n) = n u / (1 - n u)
+  const int m = 67;
+  const int n = 45;
+  const int k = 700;
+  const double u = 0x1p-24;
+  auto gamma = [u](int terms) { return terms * u / (1.0 - terms * u); };
+  std::vector<double> a64 = randomMatrix(m, k, 6);
+  std::vector<double> b64 = randomMatrix(k, n, 7);
+  std::vector<float> a(a64.begin(), a64.end());
+  std::vector<float> b(b64.begin(), b64.end());
+  std::vector<double> exact(m * n, 0.0);
+  std::vector<double> magnitude(m * n, 0.0);
+  for (int i = 0; i < m; ++i) {
+    for (int p = 0; p < k; ++p) {
+      for (int j = 0; j < n; ++j) {
+        exact[i * n + j] += static_cast<double>(a[i * k + p]) * b[p * n + j];
+        magnitude[i * n + j] += std::abs(static_cast<double>(a[i * k + p]) * b[p * n + j]);
+      }
+    }
+  }
+
+  std::vector<float> single = ppc::core::gemm(a, b, m, n, k);
+  std::vector<double> mixed(m * n);
+  ppc::core::gemmMixed(m, n, k, a.data(), k, b.data(), n, mixed.data(), n);
+  for (int i = 0; i < m * n; ++i) {
+    // float sums run over the whole inner dimension, mixed ones over one kc = 256 panel
+    ASSERT_LE(std::abs(single[i] - exact[i]), gamma(k + 1) * magnitude[i]) << "float at " << i;
+    ASSERT_LE(std::abs(mixed[i] - exact[i]), gamma(256 + 1) * magnitude[i]) << "mixed at " << i;
+  }
+}
+
+TEST(gemm_tests, batched_fixed_and_generic_sizes) {
+  const int batch = 300;
+  for (int size : {4, 8, 16, 32, 64, 5, 24}) {
+    // every matrix of the batch sits in a slot with one spare row, so strides differ from size^2
+    const int64_t stride = static_cast<int64_t>(size + 1) * size;
+    std::vector<double> a = randomMatrix(batch * (size + 1), size, 6);
+    std::vector<double> b = randomMatrix(batch * (size + 1), size, 7);
+    std::vector<double> c = randomMatrix(batch * (size + 1), size, 8);
+    std::vector<double> original = c;
+    ppc::core::gemmBatched(size, size, size, a.data(), size, stride, b.data(), size, stride, c.data(), size, stride,
+                           batch, true);
+
+    for (int i = 0; i < batch; ++i) {
+      std::vector<double> ai(a.begin() + i * stride, a.begin() + i * stride + size * size);
+      std::vector<double> bi(b.begin() + i * stride, b.begin() + i * stride + size * size);
+      std::vector<double> expected = naiveProduct(ai, bi, size, size, size);
+      for (int j = 0; j < size * size; ++j) {
+        ASSERT_NEAR(c[i * stride + j], original[i * stride + j] + expected[j], 1e-12 * size);
+      }
+      // the spare row is left untouched
+      for (int j = size * size; j < stride; ++j) {
+        ASSERT_EQ(c[i * stride + j], original[i * stride + j]);
+      }
+    }
+  }
+}
+
+TEST(gemm_tests, batched_rectangular_with_shared_operand) {
+  // stride 0 reuses one B for the whole batch
+  const int m = 6;
+  const int n = 10;
+  const int k = 3;
+  const int batch = 50;
+  std::vector<double> a = randomMatrix(batch * m, k, 9);
+  std::vector<double> b = randomMatrix(k, n, 10);
+  std::vector<double> c(batch * m * n, 1.0);
+  ppc::core::gemmBatched(m, n, k, a.data(), k, m * k, b.data(), n, 0, c.data(), n, m * n, batch);
+
+  std::vector<double> expected = naiveProduct(a, b, batch * m, n, k);
+  for (size_t i = 0; i < c.size(); ++i) {
+    ASSERT_NEAR(c[i], expected[i], 1e-12 * k);
+  }
+}
+
+TEST(gemm_tests, batched_thread_cap) {
+  // 1 keeps the whole batch on the calling thread; any cap gives the same products
+  const int size = 24;
+  const int batch = 400;
+  const int64_t stride = size * size;
+  std::vector<double> a = randomMatrix(batch * size, size, 11);
+  std::vector<double> b = randomMatrix(batch * size, size, 12);
+  std::vector<double> serial(a.size());
+  ppc::core::gemmBatched(size, size, size, a.data(), size, stride, b.data(), size, stride, serial.data(), size, stride,
+                         batch, false, 1);
+  for (int threads : {0, 2, 3}) {
+    std::vector<double> c(a.size());
+    ppc::core::gemmBatched(size, size, size, a.data(), size, stride, b.data(), size, stride, c.data(), size, stride,
+                           batch, false, threads);
+    ASSERT_EQ(c, serial) << threads;
+  }
+  EXPECT_THROW(ppc::core::gemmBatched(size, size, size, a.data(), size, stride, b.data(), size, stride, serial.data(),
+                                      size, stride, batch, false, -1),
+               std::invalid_argument);
+}
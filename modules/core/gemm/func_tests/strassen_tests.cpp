@@ -0,0 +1,75 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/strassen.hpp"
+
+namespace {
+
+std::vector<double> randomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> matrix(rows * cols);
+  for (auto &value : matrix) value = dist(gen);
+  return matrix;
+}
+
+void checkStrassen(int m, int n, int k, int cutoff) {
+  std::vector<double> a = randomMatrix(m, k, 3);
+  std::vector<double> b = randomMatrix(k, n, 4);
+  std::vector<double> expected = ppc::core::gemm(a, b, m, n, k);
+  std::vector<double> c(m * n, 7.0);
+  std::vector<double> workspace(ppc::core::strassenWorkspaceSize(m, n, k, cutoff));
+  ppc::core::strassen(m, n, k, a.data(), k, b.data(), n, c.data(), n, cutoff, workspace.data());
+  for (size_t i = 0; i < c.size(); ++i) {
+    ASSERT_NEAR(c[i], expected[i], 1e-10 * k);
+  }
+}
+
+}  // namespace
+
+TEST(strassen, power_of_two_down_to_scalars) { checkStrassen(32, 32, 32, 1); }
+
+TEST(strassen, odd_sizes_are_peeled) {
+  checkStrassen(37, 37, 37, 2);
+  checkStrassen(1, 1, 1, 1);
+  checkStrassen(3, 5, 7, 1);
+}
+
+TEST(strassen, rectangular_operands) {
+  checkStrassen(40, 24, 56, 4);
+  checkStrassen(65, 130, 33, 8);
+}
+
+TEST(strassen, blocks_of_larger_matrices) {
+  const int ld = 50;
+  const int n = 34;
+  std::vector<double> a = randomMatrix(ld, ld, 5);
+  std::vector<double> b = randomMatrix(ld, ld, 6);
+  std::vector<double> expected(ld * ld, -1.0);
+  std::vector<double> c(ld * ld, -1.0);
+  ppc::core::gemm(n, n, n, a.data() + ld + 3, ld, b.data() + 2 * ld + 1, ld, expected.data() + 5, ld);
+  std::vector<double> workspace(ppc::core::strassenWorkspaceSize(n, n, n, 4));
+  ppc::core::strassen(n, n, n, a.data() + ld + 3, ld, b.data() + 2 * ld + 1, ld, c.data() + 5, ld, 4,
+                      workspace.data());
+  for (size_t i = 0; i < c.size(); ++i) {
+    ASSERT_NEAR(c[i], expected[i], 1e-10 * n);
+  }
+}
+
+TEST(strassen, square_overload_with_tuned_cutoff) {
+  const int n = 70;
+  std::vector<double> a = randomMatrix(n, n, 7);
+  std::vector<double> b = randomMatrix(n, n, 8);
+  std::vector<double> expected = ppc::core::gemm(a, b, n, n, n);
+  std::vector<double> c = ppc::core::strassen(a, b, n);
+  ASSERT_EQ(c.size(), expected.size());
+  for (size_t i = 0; i < c.size(); ++i) {
+    ASSERT_NEAR(c[i], expected[i], 1e-10 * n);
+  }
+  EXPECT_GE(ppc::core::strassenCutoff(), 64);
+  EXPECT_TRUE(ppc::core::strassen(std::vector<double>{}, {}, 0).empty());
+}
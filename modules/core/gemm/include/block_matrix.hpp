@@ -0,0 +1,63 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BLOCK_MATRIX_HPP_
+#define MODULES_CORE_INCLUDE_BLOCK_MATRIX_HPP_
+
+#include <memory>
+#include <vector>
+
+namespace ppc::core {
+
+// Square matrix stored as a grid x grid array of contiguous block x block tiles (block-major),
+// zero-padded up to a whole number of tiles. Storage is left untouched on allocation, so the
+// first write places the pages. In multiplyBlocks every tile of C is first written by the one
+// thread that owns it, so with first-touch page placement C tiles sit on the NUMA node of their
+// owner. Tiles of A and B are written by the threads of the parallel fromRowMajor, which spreads
+// them over the nodes; each of them is read by a whole block row or column of owners in turn,
+// so no placement makes them local to all of their readers.
+// Instantiated for float and double.
+template <class T>
+class BasicBlockMatrix {
+ public:
+  BasicBlockMatrix(int size, int block);
+
+  // Converts a row-major size x size matrix; tiles are filled in parallel.
+  static BasicBlockMatrix fromRowMajor(const T* src, int size, int block);
+  void toRowMajor(T* dst) const;
+
+  [[nodiscard]] int size() const { return size_; }
+  [[nodiscard]] int blockSize() const { return block_; }
+  [[nodiscard]] int grid() const { return grid_; }
+  T* tile(int i, int j) { return data_.get() + (static_cast<size_t>(i) * grid_ + j) * block_ * block_; }
+  [[nodiscard]] const T* tile(int i, int j) const {
+    return data_.get() + (static_cast<size_t>(i) * grid_ + j) * block_ * block_;
+  }
+
+ private:
+  int size_;
+  int block_;
+  int grid_;
+  std::unique_ptr<T[]> data_;
+};
+
+using BlockMatrix = BasicBlockMatrix<double>;
+
+// Which A tile the owner of C(i, j) multiplies at stage s: Fox broadcasts A(i, i + s) along
+// the block row, Cannon skews to A(i, i + j + s) so no two owners read the same tile at once.
+enum class BlockSchedule { Fox, Cannon };
+
+// C = A * B over tiles. Tile C(i, j) is owned by one thread for all stages, so no locking is
+// needed. With layers > 1 (2.5D) the stages are split between `layers` replicas of C that run
+// concurrently and are summed at the end: more memory, more parallel tiles and less time
+// every tile of A and B spends shared between owners. Acc may be wider than T: float tiles
+// accumulated into double C is the mixed-precision mode of ppc::core::gemmMixed.
+template <class T, class Acc>
+void multiplyBlocks(const BasicBlockMatrix<T>& a, const BasicBlockMatrix<T>& b, BasicBlockMatrix<Acc>& c,
+                    BlockSchedule schedule, int layers = 1);
+
+// Replication factor that gives every thread at least one tile of C to work on.
+int defaultLayers(int grid);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BLOCK_MATRIX_HPP_
@@ -0,0 +1,20 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_COMPLEX_AXPY_HPP_
+#define MODULES_CORE_INCLUDE_COMPLEX_AXPY_HPP_
+
+#include <cstddef>
+
+namespace ppc::core {
+
+// y[index[k]] += a * x[k] for k < n, for complex values stored as separate real and imaginary
+// arrays: the inner step of a row-by-row (Gustavson) sparse product with a dense accumulator.
+// On x86-64 CPUs with AVX2, a slice whose indices form one run of consecutive columns is done four
+// elements at a time with packed loads and stores of y; other slices use the scalar loop, so an
+// index repeated within x adds up in order. Both paths round every sum as the scalar code does.
+void complexAxpyScatter(double a_re, double a_im, const double* x_re, const double* x_im, const int* index,
+                        size_t n, double* y_re, double* y_im);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_COMPLEX_AXPY_HPP_
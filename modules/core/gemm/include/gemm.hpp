@@ -0,0 +1,49 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_GEMM_HPP_
+#define MODULES_CORE_INCLUDE_GEMM_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+// C = A * B, or C += A * B with accumulate, for row-major A (m x k), B (k x n) and C (m x n)
+// with leading dimensions lda, ldb and ldc, so blocks of larger matrices are passed in place.
+// BLIS-style: B is packed into kc x nc panels, A into mc x kc panels, and a register-tiled
+// micro-kernel (AVX2 with FMA on x86-64 CPUs that have it) updates mr x nr tiles of C. Packing
+// buffers are per thread, so the function is safe to call from OpenMP/TBB/std::thread workers on
+// disjoint parts of C.
+void gemm(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc,
+          bool accumulate = false);
+void gemm(int m, int n, int k, const float* a, int lda, const float* b, int ldb, float* c, int ldc,
+          bool accumulate = false);
+
+// Mixed precision: float operands and float sums within each kc-long panel of the inner
+// dimension, accumulated across panels into double C. Bandwidth and SIMD width of float,
+// with rounding error growing with kc instead of k.
+void gemmMixed(int m, int n, int k, const float* a, int lda, const float* b, int ldb, double* c, int ldc,
+               bool accumulate = false);
+
+// Strided batch of independent products C_i = A_i * B_i (or C_i += A_i * B_i), where A_i starts
+// at a + i * stride_a and likewise for B_i and C_i. Square 4, 8 and 16 sized products use
+// kernels specialized at compile time, other shapes go through gemm; either way without the
+// per-call setup and allocations of a task. Built with OpenMP, the batch is split across threads
+// unless the call is made from inside a parallel region or the batch is too small to pay for a
+// thread team. threads caps the team (0: the OpenMP default) like radixSort's; sequential tasks
+// and callers running on TBB or std::thread workers pass 1. Negative threads throw
+// std::invalid_argument.
+void gemmBatched(int m, int n, int k, const double* a, int lda, int64_t stride_a, const double* b, int ldb,
+                 int64_t stride_b, double* c, int ldc, int64_t stride_c, int64_t batch, bool accumulate = false,
+                 int threads = 0);
+void gemmBatched(int m, int n, int k, const float* a, int lda, int64_t stride_a, const float* b, int ldb,
+                 int64_t stride_b, float* c, int ldc, int64_t stride_c, int64_t batch, bool accumulate = false,
+                 int threads = 0);
+
+// Dense row-major product of an m x k and a k x n matrix.
+std::vector<double> gemm(const std::vector<double>& a, const std::vector<double>& b, int m, int n, int k);
+std::vector<float> gemm(const std::vector<float>& a, const std::vector<float>& b, int m, int n, int k);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_GEMM_HPP_
@@ -0,0 +1,33 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_STRASSEN_HPP_
+#define MODULES_CORE_INCLUDE_STRASSEN_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace ppc::core {
+
+// Strassen-Winograd C = A * B (7 products and 15 additions per level) for row-major operands
+// with leading dimensions. Every level works on quadrant views and takes its two temporaries
+// from `workspace`, so nothing is allocated during the recursion. Odd sizes are peeled: the
+// even part recurses, the leftover row, column and rank-1 update go to gemm. Once the smallest
+// dimension is at most `cutoff` the product is handed to gemm.
+void strassen(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc, int cutoff,
+              double* workspace);
+void strassen(int m, int n, int k, const float* a, int lda, const float* b, int ldb, float* c, int ldc, int cutoff,
+              float* workspace);
+
+// Elements of workspace strassen() needs for these sizes and cutoff.
+size_t strassenWorkspaceSize(int m, int n, int k, int cutoff);
+
+// Square n x n product with a workspace allocated once; cutoff <= 0 selects strassenCutoff().
+std::vector<double> strassen(const std::vector<double>& a, const std::vector<double>& b, int n, int cutoff = 0);
+std::vector<float> strassen(const std::vector<float>& a, const std::vector<float>& b, int n, int cutoff = 0);
+
+// Smallest size at which one Strassen level beats gemm on this machine, measured on first use.
+int strassenCutoff();
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_STRASSEN_HPP_
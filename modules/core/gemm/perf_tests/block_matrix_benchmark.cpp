@@ -0,0 +1,115 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/gemm/include/block_matrix.hpp"
+#include "core/gemm/include/gemm.hpp"
+#include "core/perf/include/perf.hpp"
+
+// A 1024 x 1024 product over 128 x 128 tiles, once over row-major tiles addressed in place and
+// once block-major with the Fox and Cannon schedules and 1, 2 and 4 layers. Each line reads
+// block_matrix_benchmark/<layout>:pipeline:<multiply-adds/s>:<bytes/s>, counting A, B and C once.
+
+namespace {
+
+constexpr int kSize = 1024;
+constexpr int kBlock = 128;
+
+class ProductBenchmarkTask : public ppc::core::Task {
+ public:
+  ProductBenchmarkTask(std::shared_ptr<ppc::core::TaskData> taskData_, std::function<void()> run_)
+      : Task(std::move(taskData_)), product(std::move(run_)) {}
+
+  bool validation() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    product();
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  std::function<void()> product;
+};
+
+void measure(const std::string &name, const std::function<void()> &product) {
+  auto task = std::make_shared<ProductBenchmarkTask>(std::make_shared<ppc::core::TaskData>(), product);
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(task);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  const uint64_t elements = static_cast<uint64_t>(kSize) * kSize;
+  ppc::core::Perf::print_throughput_statistic(perfAttr, perfResults, "block_matrix_benchmark/" + name,
+                                              elements * kSize, 3 * elements * sizeof(double));
+}
+
+}  // namespace
+
+TEST(block_matrix_benchmark, layouts) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<> dis(1.0, 6.0);
+  std::vector<double> a(static_cast<size_t>(kSize) * kSize);
+  std::vector<double> b(a.size());
+  for (auto &value : a) value = dis(gen);
+  for (auto &value : b) value = dis(gen);
+
+  // row-major tiles with index arithmetic, each tile of C owned by one thread
+  std::vector<double> expected(a.size());
+  measure("row_major", [&] {
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2) schedule(static)
+#endif
+    for (int i = 0; i < kSize; i += kBlock) {
+      for (int j = 0; j < kSize; j += kBlock) {
+        for (int k = 0; k < kSize; k += kBlock) {
+          ppc::core::gemm(kBlock, kBlock, kBlock, &a[i * kSize + k], kSize, &b[k * kSize + j], kSize,
+                          &expected[i * kSize + j], kSize, k > 0);
+        }
+      }
+    }
+  });
+
+  const auto block_a = ppc::core::BlockMatrix::fromRowMajor(a.data(), kSize, kBlock);
+  const auto block_b = ppc::core::BlockMatrix::fromRowMajor(b.data(), kSize, kBlock);
+  const std::pair<const char *, ppc::core::BlockSchedule> schedules[] = {{"fox", ppc::core::BlockSchedule::Fox},
+                                                                         {"cannon", ppc::core::BlockSchedule::Cannon}};
+  std::vector<double> c(a.size());
+  for (const auto &[name, schedule] : schedules) {
+    for (int layers : {1, 2, 4}) {
+      ppc::core::BlockMatrix block_c(kSize, kBlock);
+      measure(std::string("block_major_") + name + "/layers_" + std::to_string(layers),
+              [&] { ppc::core::multiplyBlocks(block_a, block_b, block_c, schedule, layers); });
+      block_c.toRowMajor(c.data());
+      for (size_t i = 0; i < c.size(); ++i) {
+        ASSERT_NEAR(c[i], expected[i], 1e-6);
+      }
+    }
+  }
+}
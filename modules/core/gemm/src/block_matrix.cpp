@@ -0,0 +1,146 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/block_matrix.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace ppc::core {
+
+namespace {
+
+void tileProduct(int bs, const double* a, const double* b, double* c, bool accumulate) {
+  gemm(bs, bs, bs, a, bs, b, bs, c, bs, accumulate);
+}
+
+void tileProduct(int bs, const float* a, const float* b, float* c, bool accumulate) {
+  gemm(bs, bs, bs, a, bs, b, bs, c, bs, accumulate);
+}
+
+void tileProduct(int bs, const float* a, const float* b, double* c, bool accumulate) {
+  gemmMixed(bs, bs, bs, a, bs, b, bs, c, bs, accumulate);
+}
+
+}  // namespace
+
+template <class T>
+BasicBlockMatrix<T>::BasicBlockMatrix(int size, int block)
+    : size_(size),
+      block_(block),
+      grid_((size + block - 1) / block),
+      data_(new T[static_cast<size_t>(grid_) * grid_ * block * block]) {}
+
+template <class T>
+BasicBlockMatrix<T> BasicBlockMatrix<T>::fromRowMajor(const T* src, int size, int block) {
+  BasicBlockMatrix matrix(size, block);
+  const int grid = matrix.grid_;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int t = 0; t < grid * grid; ++t) {
+    const int bi = t / grid;
+    const int bj = t % grid;
+    T* dst = matrix.tile(bi, bj);
+    for (int r = 0; r < block; ++r) {
+      const int row = bi * block + r;
+      int cols = 0;
+      if (row < size) {
+        cols = std::min(block, size - bj * block);
+        const T* from = src + static_cast<size_t>(row) * size + bj * block;
+        std::copy(from, from + cols, dst + r * block);
+      }
+      std::fill(dst + r * block + cols, dst + (r + 1) * block, T(0));
+    }
+  }
+  return matrix;
+}
+
+template <class T>
+void BasicBlockMatrix<T>::toRowMajor(T* dst) const {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int t = 0; t < grid_ * grid_; ++t) {
+    const int bi = t / grid_;
+    const int bj = t % grid_;
+    const T* src = tile(bi, bj);
+    const int rows = std::min(block_, size_ - bi * block_);
+    const int cols = std::min(block_, size_ - bj * block_);
+    for (int r = 0; r < rows; ++r) {
+      std::copy(src + r * block_, src + r * block_ + cols,
+                dst + static_cast<size_t>(bi * block_ + r) * size_ + bj * block_);
+    }
+  }
+}
+
+template <class T, class Acc>
+void multiplyBlocks(const BasicBlockMatrix<T>& a, const BasicBlockMatrix<T>& b, BasicBlockMatrix<Acc>& c,
+                    BlockSchedule schedule, int layers) {
+  const int grid = a.grid();
+  const int bs = a.blockSize();
+  const int tiles = grid * grid;
+  layers = std::clamp(layers, 1, grid);
+  auto source = [&](int i, int j, int s) {
+    return schedule == BlockSchedule::Fox ? (i + s) % grid : (i + j + s) % grid;
+  };
+
+  // layer 0 accumulates straight into C, the other layers into their own replicas
+  std::vector<BasicBlockMatrix<Acc>> replicas;
+  for (int l = 1; l < layers; ++l) replicas.emplace_back(a.size(), bs);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int t = 0; t < layers * tiles; ++t) {
+      const int l = t / tiles;
+      const int i = t % tiles / grid;
+      const int j = t % grid;
+      Acc* out = l == 0 ? c.tile(i, j) : replicas[l - 1].tile(i, j);
+      const int first = l * grid / layers;
+      const int last = (l + 1) * grid / layers;
+      for (int s = first; s < last; ++s) {
+        const int k = source(i, j, s);
+        tileProduct(bs, a.tile(i, k), b.tile(k, j), out, s > first);
+      }
+    }
+    if (layers > 1) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int t = 0; t < tiles; ++t) {
+        Acc* out = c.tile(t / grid, t % grid);
+        for (const auto& replica : replicas) {
+          const Acc* part = replica.tile(t / grid, t % grid);
+          for (int e = 0; e < bs * bs; ++e) out[e] += part[e];
+        }
+      }
+    }
+  }
+}
+
+int defaultLayers(int grid) {
+#ifdef _OPENMP
+  return std::clamp(omp_get_max_threads() / (grid * grid), 1, grid);
+#else
+  return 1;
+#endif
+}
+
+template class BasicBlockMatrix<double>;
+template class BasicBlockMatrix<float>;
+template void multiplyBlocks(const BasicBlockMatrix<double>&, const BasicBlockMatrix<double>&,
+                             BasicBlockMatrix<double>&, BlockSchedule, int);
+template void multiplyBlocks(const BasicBlockMatrix<float>&, const BasicBlockMatrix<float>&,
+                             BasicBlockMatrix<float>&, BlockSchedule, int);
+template void multiplyBlocks(const BasicBlockMatrix<float>&, const BasicBlockMatrix<float>&,
+                             BasicBlockMatrix<double>&, BlockSchedule, int);
+
+}  // namespace ppc::core
@@ -0,0 +1,69 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/complex_axpy.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+namespace {
+
+void complexAxpyScatterScalar(double a_re, double a_im, const double* x_re, const double* x_im, const int* index,
+                              size_t n, double* y_re, double* y_im) {
+  for (size_t k = 0; k < n; ++k) {
+    const int j = index[k];
+    y_re[j] += a_re * x_re[k] - a_im * x_im[k];
+    y_im[j] += a_re * x_im[k] + a_im * x_re[k];
+  }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+bool hasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+// y[k] += a * x[k] for one run of consecutive indices, four elements per step. Multiplies and
+// subtracts separately rather than with FMA, so every sum is rounded exactly as in the scalar loop.
+__attribute__((target("avx2"))) void complexAxpyRunAvx2(double a_re, double a_im, const double* x_re,
+                                                        const double* x_im, size_t n, double* y_re, double* y_im) {
+  const __m256d ar = _mm256_set1_pd(a_re);
+  const __m256d ai = _mm256_set1_pd(a_im);
+  size_t k = 0;
+  for (; k + 4 <= n; k += 4) {
+    const __m256d xr = _mm256_loadu_pd(x_re + k);
+    const __m256d xi = _mm256_loadu_pd(x_im + k);
+    const __m256d pr = _mm256_sub_pd(_mm256_mul_pd(ar, xr), _mm256_mul_pd(ai, xi));
+    const __m256d pi = _mm256_add_pd(_mm256_mul_pd(ar, xi), _mm256_mul_pd(ai, xr));
+    _mm256_storeu_pd(y_re + k, _mm256_add_pd(_mm256_loadu_pd(y_re + k), pr));
+    _mm256_storeu_pd(y_im + k, _mm256_add_pd(_mm256_loadu_pd(y_im + k), pi));
+  }
+  for (; k < n; ++k) {
+    y_re[k] += a_re * x_re[k] - a_im * x_im[k];
+    y_im[k] += a_re * x_im[k] + a_im * x_re[k];
+  }
+}
+
+#endif
+
+}  // namespace
+
+void ppc::core::complexAxpyScatter(double a_re, double a_im, const double* x_re, const double* x_im,
+                                   const int* index, size_t n, double* y_re, double* y_im) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  static const bool avx2 = hasAvx2();
+  if (avx2 && n >= 4) {
+    // A gather/scatter of four scattered indices is no faster than the scalar loop, so the vector
+    // path is taken only when the slice is one run of consecutive indices (a dense row of B).
+    size_t k = 1;
+    while (k < n && index[k] == index[0] + static_cast<int>(k)) {
+      ++k;
+    }
+    if (k == n) {
+      complexAxpyRunAvx2(a_re, a_im, x_re, x_im, n, y_re + index[0], y_im + index[0]);
+      return;
+    }
+  }
+#endif
+  complexAxpyScatterScalar(a_re, a_im, x_re, x_im, index, n, y_re, y_im);
+}
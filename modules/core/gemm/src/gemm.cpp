@@ -0,0 +1,360 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/gemm.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+// mr x nr accumulators fill the vector register file of SSE2/AVX2 targets without spilling;
+// kc x nr of B stays in L1, mc x kc of A in L2 and kc x nc of B in L3. Float tiles are four
+// times as wide: with 4 x 16 GCC keeps too few independent accumulators and runs 4x slower.
+constexpr int kMR = 4;
+template <class T>
+constexpr int kNR = sizeof(T) == sizeof(double) ? 8 : 32;
+constexpr int kMC = 96;
+constexpr int kKC = 256;
+constexpr int kNC = 2048;
+
+// below this many multiply-adds packing costs more than it saves
+constexpr int64_t kSmallProduct = 16 * 16 * 16;
+// below this many multiply-adds in a whole batch a thread team costs more than it saves
+constexpr int64_t kParallelBatch = 1 << 18;
+
+template <class T>
+void packA(int mc, int kc, const T* a, int lda, T* buffer) {
+  for (int i = 0; i < mc; i += kMR) {
+    const int rows = std::min(kMR, mc - i);
+    for (int p = 0; p < kc; ++p) {
+      for (int r = 0; r < kMR; ++r) {
+        *buffer++ = r < rows ? a[(i + r) * lda + p] : T(0);
+      }
+    }
+  }
+}
+
+template <class T>
+void packB(int kc, int nc, const T* b, int ldb, T* buffer) {
+  constexpr int nr = kNR<T>;
+  for (int j = 0; j < nc; j += nr) {
+    const int cols = std::min(nr, nc - j);
+    for (int p = 0; p < kc; ++p) {
+      const T* row = b + p * ldb + j;
+      if (cols == nr) {
+        std::copy(row, row + nr, buffer);
+      } else {
+        std::fill(std::copy(row, row + cols, buffer), buffer + nr, T(0));
+      }
+      buffer += nr;
+    }
+  }
+}
+
+// acc = sum_p a[p][0:mr] (outer) b[p][0:nr] over packed micro-panels
+template <class T>
+void panelProduct(int kc, const T* a, const T* b, T (&acc)[kMR][kNR<T>]) {
+  constexpr int nr = kNR<T>;
+  for (int r = 0; r < kMR; ++r) {
+    std::fill(acc[r], acc[r] + nr, T(0));
+  }
+  for (int p = 0; p < kc; ++p) {
+    for (int r = 0; r < kMR; ++r) {
+      const T value = a[r];
+      for (int j = 0; j < nr; ++j) {
+        acc[r][j] += value * b[j];
+      }
+    }
+    a += kMR;
+    b += nr;
+  }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+bool hasAvx2Fma() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+// 4 x 8 doubles in eight accumulators: per step two loads of B and four broadcasts of A feed
+// eight FMAs, enough independent chains to cover the FMA latency on both ports
+__attribute__((target("avx2,fma"))) void panelProductAvx2(int kc, const double* a, const double* b,
+                                                          double (&acc)[kMR][8]) {
+  __m256d c00 = _mm256_setzero_pd();
+  __m256d c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd();
+  __m256d c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd();
+  __m256d c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd();
+  __m256d c31 = _mm256_setzero_pd();
+  for (int p = 0; p < kc; ++p) {
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+    __m256d value = _mm256_broadcast_sd(a);
+    c00 = _mm256_fmadd_pd(value, b0, c00);
+    c01 = _mm256_fmadd_pd(value, b1, c01);
+    value = _mm256_broadcast_sd(a + 1);
+    c10 = _mm256_fmadd_pd(value, b0, c10);
+    c11 = _mm256_fmadd_pd(value, b1, c11);
+    value = _mm256_broadcast_sd(a + 2);
+    c20 = _mm256_fmadd_pd(value, b0, c20);
+    c21 = _mm256_fmadd_pd(value, b1, c21);
+    value = _mm256_broadcast_sd(a + 3);
+    c30 = _mm256_fmadd_pd(value, b0, c30);
+    c31 = _mm256_fmadd_pd(value, b1, c31);
+    a += kMR;
+    b += 8;
+  }
+  _mm256_storeu_pd(acc[0], c00);
+  _mm256_storeu_pd(acc[0] + 4, c01);
+  _mm256_storeu_pd(acc[1], c10);
+  _mm256_storeu_pd(acc[1] + 4, c11);
+  _mm256_storeu_pd(acc[2], c20);
+  _mm256_storeu_pd(acc[2] + 4, c21);
+  _mm256_storeu_pd(acc[3], c30);
+  _mm256_storeu_pd(acc[3] + 4, c31);
+}
+
+// the 4 x 32 float tile would need 16 accumulators plus B and A in 16 registers, so it is
+// formed as two 4 x 16 halves that each run over the panel like the double kernel
+__attribute__((target("avx2,fma"))) void panelProductAvx2(int kc, const float* a, const float* b,
+                                                          float (&acc)[kMR][32]) {
+  for (int half = 0; half < 32; half += 16) {
+    const float* ap = a;
+    const float* bp = b + half;
+    __m256 c00 = _mm256_setzero_ps();
+    __m256 c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps();
+    __m256 c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps();
+    __m256 c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps();
+    __m256 c31 = _mm256_setzero_ps();
+    for (int p = 0; p < kc; ++p) {
+      const __m256 b0 = _mm256_loadu_ps(bp);
+      const __m256 b1 = _mm256_loadu_ps(bp + 8);
+      __m256 value = _mm256_broadcast_ss(ap);
+      c00 = _mm256_fmadd_ps(value, b0, c00);
+      c01 = _mm256_fmadd_ps(value, b1, c01);
+      value = _mm256_broadcast_ss(ap + 1);
+      c10 = _mm256_fmadd_ps(value, b0, c10);
+      c11 = _mm256_fmadd_ps(value, b1, c11);
+      value = _mm256_broadcast_ss(ap + 2);
+      c20 = _mm256_fmadd_ps(value, b0, c20);
+      c21 = _mm256_fmadd_ps(value, b1, c21);
+      value = _mm256_broadcast_ss(ap + 3);
+      c30 = _mm256_fmadd_ps(value, b0, c30);
+      c31 = _mm256_fmadd_ps(value, b1, c31);
+      ap += kMR;
+      bp += 32;
+    }
+    _mm256_storeu_ps(acc[0] + half, c00);
+    _mm256_storeu_ps(acc[0] + half + 8, c01);
+    _mm256_storeu_ps(acc[1] + half, c10);
+    _mm256_storeu_ps(acc[1] + half + 8, c11);
+    _mm256_storeu_ps(acc[2] + half, c20);
+    _mm256_storeu_ps(acc[2] + half + 8, c21);
+    _mm256_storeu_ps(acc[3] + half, c30);
+    _mm256_storeu_ps(acc[3] + half + 8, c31);
+  }
+}
+
+#endif
+
+// c[0:rows, 0:cols] += sum_p a[p][0:mr] (outer) b[p][0:nr] on packed micro-panels; the sum
+// over one kc panel is formed in T and then added to C in its own type
+template <class T, class Acc>
+void microKernel(int kc, const T* a, const T* b, Acc* c, int ldc, int rows, int cols) {
+  constexpr int nr = kNR<T>;
+  T acc[kMR][nr];
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  static const bool avx2 = hasAvx2Fma();
+  if (avx2) {
+    panelProductAvx2(kc, a, b, acc);
+  } else {
+    panelProduct(kc, a, b, acc);
+  }
+#else
+  panelProduct(kc, a, b, acc);
+#endif
+  if (rows == kMR && cols == nr) {
+    for (int r = 0; r < kMR; ++r) {
+      for (int j = 0; j < nr; ++j) {
+        c[r * ldc + j] += acc[r][j];
+      }
+    }
+    return;
+  }
+  for (int r = 0; r < rows; ++r) {
+    for (int j = 0; j < cols; ++j) {
+      c[r * ldc + j] += acc[r][j];
+    }
+  }
+}
+
+template <class T, class Acc>
+void gemmImpl(int m, int n, int k, const T* a, int lda, const T* b, int ldb, Acc* c, int ldc, bool accumulate) {
+  if (m <= 0 || n <= 0) return;
+  if (!accumulate) {
+    for (int i = 0; i < m; ++i) {
+      std::fill(c + i * ldc, c + i * ldc + n, Acc(0));
+    }
+  }
+  if (k <= 0) return;
+
+  if (static_cast<int64_t>(m) * n * k <= kSmallProduct) {
+    for (int i = 0; i < m; ++i) {
+      for (int p = 0; p < k; ++p) {
+        const T value = a[i * lda + p];
+        for (int j = 0; j < n; ++j) {
+          c[i * ldc + j] += value * b[p * ldb + j];
+        }
+      }
+    }
+    return;
+  }
+
+  constexpr int nr = kNR<T>;
+  thread_local std::vector<T> packed_a;
+  thread_local std::vector<T> packed_b;
+  const int nc_max = std::min(kNC, (n + nr - 1) / nr * nr);
+  const int kc_max = std::min(kKC, k);
+  packed_a.resize(std::max(packed_a.size(), static_cast<size_t>(kMC) * kc_max));
+  packed_b.resize(std::max(packed_b.size(), static_cast<size_t>(kc_max) * nc_max));
+
+  for (int jc = 0; jc < n; jc += kNC) {
+    const int nc = std::min(kNC, n - jc);
+    for (int pc = 0; pc < k; pc += kKC) {
+      const int kc = std::min(kKC, k - pc);
+      packB(kc, nc, b + pc * ldb + jc, ldb, packed_b.data());
+      for (int ic = 0; ic < m; ic += kMC) {
+        const int mc = std::min(kMC, m - ic);
+        packA(mc, kc, a + ic * lda + pc, lda, packed_a.data());
+        for (int jr = 0; jr < nc; jr += nr) {
+          for (int ir = 0; ir < mc; ir += kMR) {
+            microKernel(kc, packed_a.data() + ir * kc, packed_b.data() + jr * kc, c + (ic + ir) * ldc + jc + jr, ldc,
+                        std::min(kMR, mc - ir), std::min(nr, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+// Square product of a compile-time size without packing: every R x W tile of C is summed in
+// registers over the whole inner dimension, and the constant trip counts let the compiler
+// unroll and vectorize the tile completely
+template <int N, class T>
+void fixedGemm(const T* a, int lda, const T* b, int ldb, T* c, int ldc, bool accumulate) {
+  constexpr int R = N < kMR ? N : kMR;
+  constexpr int W = N < 8 ? N : 8;
+  for (int i = 0; i < N; i += R) {
+    for (int j = 0; j < N; j += W) {
+      T acc[R][W] = {};
+      for (int p = 0; p < N; ++p) {
+        for (int r = 0; r < R; ++r) {
+          const T value = a[(i + r) * lda + p];
+          for (int w = 0; w < W; ++w) {
+            acc[r][w] += value * b[p * ldb + j + w];
+          }
+        }
+      }
+      for (int r = 0; r < R; ++r) {
+        T* row = c + (i + r) * ldc + j;
+        for (int w = 0; w < W; ++w) {
+          row[w] = accumulate ? row[w] + acc[r][w] : acc[r][w];
+        }
+      }
+    }
+  }
+}
+
+template <class T>
+using FixedKernel = void (*)(const T*, int, const T*, int, T*, int, bool);
+
+// from 32 on the packed path is faster than a fixed kernel reading B with stride ldb
+template <class T>
+FixedKernel<T> fixedKernel(int m, int n, int k) {
+  if (m != n || n != k) return nullptr;
+  switch (n) {
+    case 4:
+      return fixedGemm<4, T>;
+    case 8:
+      return fixedGemm<8, T>;
+    case 16:
+      return fixedGemm<16, T>;
+    default:
+      return nullptr;
+  }
+}
+
+template <class T>
+void gemmBatchedImpl(int m, int n, int k, const T* a, int lda, int64_t stride_a, const T* b, int ldb, int64_t stride_b,
+                     T* c, int ldc, int64_t stride_c, int64_t batch, bool accumulate, int max_threads) {
+  if (max_threads < 0) throw std::invalid_argument("gemmBatched: threads must not be negative");
+  const FixedKernel<T> kernel = fixedKernel<T>(m, n, k);
+#ifdef _OPENMP
+  const int64_t work = batch * m * n * k;
+  int threads = 1;
+  if (work >= kParallelBatch && !omp_in_parallel()) threads = max_threads == 0 ? omp_get_max_threads() : max_threads;
+#pragma omp parallel for schedule(static) num_threads(threads) if (threads > 1)
+#endif
+  for (int64_t i = 0; i < batch; ++i) {
+    if (kernel != nullptr) {
+      kernel(a + i * stride_a, lda, b + i * stride_b, ldb, c + i * stride_c, ldc, accumulate);
+    } else {
+      gemmImpl(m, n, k, a + i * stride_a, lda, b + i * stride_b, ldb, c + i * stride_c, ldc, accumulate);
+    }
+  }
+}
+
+}  // namespace
+
+void ppc::core::gemm(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc,
+                     bool accumulate) {
+  gemmImpl(m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+}
+
+void ppc::core::gemm(int m, int n, int k, const float* a, int lda, const float* b, int ldb, float* c, int ldc,
+                     bool accumulate) {
+  gemmImpl(m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+}
+
+void ppc::core::gemmMixed(int m, int n, int k, const float* a, int lda, const float* b, int ldb, double* c, int ldc,
+                          bool accumulate) {
+  gemmImpl(m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+}
+
+void ppc::core::gemmBatched(int m, int n, int k, const double* a, int lda, int64_t stride_a, const double* b, int ldb,
+                            int64_t stride_b, double* c, int ldc, int64_t stride_c, int64_t batch, bool accumulate,
+                            int threads) {
+  gemmBatchedImpl(m, n, k, a, lda, stride_a, b, ldb, stride_b, c, ldc, stride_c, batch, accumulate, threads);
+}
+
+void ppc::core::gemmBatched(int m, int n, int k, const float* a, int lda, int64_t stride_a, const float* b, int ldb,
+                            int64_t stride_b, float* c, int ldc, int64_t stride_c, int64_t batch, bool accumulate,
+                            int threads) {
+  gemmBatchedImpl(m, n, k, a, lda, stride_a, b, ldb, stride_b, c, ldc, stride_c, batch, accumulate, threads);
+}
+
+std::vector<double> ppc::core::gemm(const std::vector<double>& a, const std::vector<double>& b, int m, int n, int k) {
+  std::vector<double> c(static_cast<size_t>(m) * n);
+  gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+  return c;
+}
+
+std::vector<float> ppc::core::gemm(const std::vector<float>& a, const std::vector<float>& b, int m, int n, int k) {
+  std::vector<float> c(static_cast<size_t>(m) * n);
+  gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+  return c;
+}
@@ -0,0 +1,178 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gemm/include/strassen.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+
+template <class T>
+void strassenRec(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc, int cutoff,
+                 T* workspace);
+
+// z = x + sign * y, z may alias x or y
+template <class T>
+void combine(int rows, int cols, const T* x, int ldx, const T* y, int ldy, T* z, int ldz, T sign) {
+  for (int i = 0; i < rows; ++i) {
+    const T* xr = x + i * ldx;
+    const T* yr = y + i * ldy;
+    T* zr = z + i * ldz;
+    for (int j = 0; j < cols; ++j) {
+      zr[j] = xr[j] + sign * yr[j];
+    }
+  }
+}
+
+// One Winograd level on even m, n, k with two temporaries X (m/2 x max(k/2, n/2)) and
+// Y (k/2 x n/2); the quadrants of C hold the other intermediate results.
+template <class T>
+void winogradLevel(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc, int cutoff,
+                   T* workspace) {
+  const int mh = m / 2;
+  const int nh = n / 2;
+  const int kh = k / 2;
+  const T* a11 = a;
+  const T* a12 = a + kh;
+  const T* a21 = a + mh * lda;
+  const T* a22 = a21 + kh;
+  const T* b11 = b;
+  const T* b12 = b + nh;
+  const T* b21 = b + kh * ldb;
+  const T* b22 = b21 + nh;
+  T* c11 = c;
+  T* c12 = c + nh;
+  T* c21 = c + mh * ldc;
+  T* c22 = c21 + nh;
+  const int ldx = std::max(kh, nh);
+  const int ldy = nh;
+  T* x = workspace;
+  T* y = x + static_cast<size_t>(mh) * ldx;
+  T* rest = y + static_cast<size_t>(kh) * ldy;
+  auto product = [&](const T* lhs, int ldl, const T* rhs, int ldr, T* out, int ldo) {
+    strassenRec(mh, nh, kh, lhs, ldl, rhs, ldr, out, ldo, cutoff, rest);
+  };
+
+  combine(mh, kh, a11, lda, a21, lda, x, ldx, T(-1));    // S3
+  combine(kh, nh, b22, ldb, b12, ldb, y, ldy, T(-1));    // T3
+  product(x, ldx, y, ldy, c21, ldc);                     // P7
+  combine(mh, kh, a21, lda, a22, lda, x, ldx, T(1));     // S1
+  combine(kh, nh, b12, ldb, b11, ldb, y, ldy, T(-1));    // T1
+  product(x, ldx, y, ldy, c22, ldc);                     // P5
+  combine(mh, kh, x, ldx, a11, lda, x, ldx, T(-1));      // S2
+  combine(kh, nh, b22, ldb, y, ldy, y, ldy, T(-1));      // T2
+  product(x, ldx, y, ldy, c12, ldc);                     // P6
+  combine(mh, kh, a12, lda, x, ldx, x, ldx, T(-1));      // S4
+  product(x, ldx, b22, ldb, c11, ldc);                   // P3
+  product(a11, lda, b11, ldb, x, ldx);                   // P1
+  combine(mh, nh, x, ldx, c12, ldc, c12, ldc, T(1));     // U2 = P1 + P6
+  combine(mh, nh, c12, ldc, c21, ldc, c21, ldc, T(1));   // U3 = U2 + P7
+  combine(mh, nh, c12, ldc, c22, ldc, c12, ldc, T(1));   // U4 = U2 + P5
+  combine(mh, nh, c21, ldc, c22, ldc, c22, ldc, T(1));   // C22 = U3 + P5
+  combine(mh, nh, c12, ldc, c11, ldc, c12, ldc, T(1));   // C12 = U4 + P3
+  combine(kh, nh, y, ldy, b21, ldb, y, ldy, T(-1));      // T4
+  product(a22, lda, y, ldy, c11, ldc);                   // P4
+  combine(mh, nh, c21, ldc, c11, ldc, c21, ldc, T(-1));  // C21 = U3 - P4
+  product(a12, lda, b21, ldb, c11, ldc);                 // P2
+  combine(mh, nh, x, ldx, c11, ldc, c11, ldc, T(1));     // C11 = P1 + P2
+}
+
+template <class T>
+void strassenRec(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc, int cutoff,
+                 T* workspace) {
+  if (std::min({m, n, k}) <= std::max(cutoff, 1)) {
+    ppc::core::gemm(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+  const int me = m & ~1;
+  const int ne = n & ~1;
+  const int ke = k & ~1;
+  winogradLevel(me, ne, ke, a, lda, b, ldb, c, ldc, cutoff, workspace);
+  if (ke != k) {
+    ppc::core::gemm(me, ne, 1, a + ke, lda, b + ke * ldb, ldb, c, ldc, true);
+  }
+  if (ne != n) {
+    ppc::core::gemm(m, 1, k, a, lda, b + ne, ldb, c + ne, ldc);
+  }
+  if (me != m) {
+    ppc::core::gemm(1, ne, k, a + me * lda, lda, b, ldb, c + me * ldc, ldc);
+  }
+}
+
+template <class T>
+std::vector<T> strassenSquare(const std::vector<T>& a, const std::vector<T>& b, int n, int cutoff) {
+  if (n <= 0) return {};
+  if (cutoff <= 0) cutoff = ppc::core::strassenCutoff();
+  std::vector<T> c(static_cast<size_t>(n) * n);
+  std::vector<T> workspace(ppc::core::strassenWorkspaceSize(n, n, n, cutoff));
+  strassenRec(n, n, n, a.data(), n, b.data(), n, c.data(), n, cutoff, workspace.data());
+  return c;
+}
+
+double bestTime(int repeats, auto&& run) {
+  double best = 1e30;
+  for (int r = 0; r < repeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+int tuneCutoff() {
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (int size : {64, 128, 256}) {
+    const int n = 2 * size;
+    std::vector<double> a(n * n);
+    std::vector<double> b(n * n);
+    std::vector<double> c(n * n);
+    for (auto& value : a) value = dist(gen);
+    for (auto& value : b) value = dist(gen);
+    std::vector<double> workspace(ppc::core::strassenWorkspaceSize(n, n, n, size));
+    const double direct = bestTime(2, [&] { ppc::core::gemm(n, n, n, a.data(), n, b.data(), n, c.data(), n); });
+    const double split = bestTime(
+        2, [&] { ppc::core::strassen(n, n, n, a.data(), n, b.data(), n, c.data(), n, size, workspace.data()); });
+    if (split < direct) return size;
+  }
+  return 512;
+}
+
+}  // namespace
+
+size_t ppc::core::strassenWorkspaceSize(int m, int n, int k, int cutoff) {
+  size_t size = 0;
+  while (std::min({m, n, k}) > std::max(cutoff, 1)) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    size += static_cast<size_t>(m) * std::max(k, n) + static_cast<size_t>(k) * n;
+  }
+  return size;
+}
+
+void ppc::core::strassen(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc,
+                         int cutoff, double* workspace) {
+  strassenRec(m, n, k, a, lda, b, ldb, c, ldc, cutoff, workspace);
+}
+
+void ppc::core::strassen(int m, int n, int k, const float* a, int lda, const float* b, int ldb, float* c, int ldc,
+                         int cutoff, float* workspace) {
+  strassenRec(m, n, k, a, lda, b, ldb, c, ldc, cutoff, workspace);
+}
+
+std::vector<double> ppc::core::strassen(const std::vector<double>& a, const std::vector<double>& b, int n,
+                                        int cutoff) {
+  return strassenSquare(a, b, n, cutoff);
+}
+
+std::vector<float> ppc::core::strassen(const std::vector<float>& a, const std::vector<float>& b, int n, int cutoff) {
+  return strassenSquare(a, b, n, cutoff);
+}
+
+int ppc::core::strassenCutoff() {
+  static const int cutoff = tuneCutoff();
+  return cutoff;
+}
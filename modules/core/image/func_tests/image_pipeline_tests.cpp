@@ -0,0 +1,194 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/image/include/image_pipeline.hpp"
+#include "core/image/include/separable_filter.hpp"
+#include "core/image/include/sobel_edges.hpp"
+
+namespace {
+
+std::vector<uint8_t> randomImage(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> image(size);
+  for (auto &value : image) value = static_cast<uint8_t>(dist(gen));
+  return image;
+}
+
+ppc::core::ImagePipeline edges() {
+  ppc::core::ImagePipeline pipeline(3);
+  pipeline.grayscale().gaussian(1.4).sobel().threshold(60.0F);
+  return pipeline;
+}
+
+// the same chain as full-image passes in double, with the blur from separableFilter
+std::vector<double> reference(const std::vector<uint8_t> &rgb, size_t width, size_t height, double sigma) {
+  std::vector<double> gray(width * height);
+  for (size_t i = 0; i < gray.size(); ++i) {
+    gray[i] = 0.299 * rgb[3 * i] + 0.587 * rgb[3 * i + 1] + 0.114 * rgb[3 * i + 2];
+  }
+  std::vector<double> blurred(gray.size());
+  ppc::core::gaussianBlur(gray.data(), blurred.data(), width, height, 1, sigma, -1, 1);
+  const auto w = static_cast<int64_t>(width);
+  const auto h = static_cast<int64_t>(height);
+  const auto at = [&](int64_t x, int64_t y) {
+    return blurred[std::clamp<int64_t>(y, 0, h - 1) * w + std::clamp<int64_t>(x, 0, w - 1)];
+  };
+  std::vector<double> magnitude(gray.size());
+  for (int64_t y = 0; y < h; ++y) {
+    for (int64_t x = 0; x < w; ++x) {
+      const double gx = at(x + 1, y - 1) - at(x - 1, y - 1) + 2.0 * (at(x + 1, y) - at(x - 1, y)) + at(x + 1, y + 1) -
+                        at(x - 1, y + 1);
+      const double gy = at(x - 1, y + 1) + 2.0 * at(x, y + 1) + at(x + 1, y + 1) - at(x - 1, y - 1) -
+                        2.0 * at(x, y - 1) - at(x + 1, y - 1);
+      magnitude[y * w + x] = std::sqrt(gx * gx + gy * gy);
+    }
+  }
+  return magnitude;
+}
+
+}  // namespace
+
+TEST(image_pipeline_tests, matches_separate_full_image_passes) {
+  const size_t width = 131;
+  const size_t height = 77;
+  const auto src = randomImage(width * height * 3, 1);
+  ppc::core::ImagePipeline pipeline(3);
+  pipeline.grayscale().gaussian(1.1).sobel();
+  std::vector<uint8_t> dst(width * height);
+  pipeline.tile(40, 24).run(src.data(), dst.data(), width, height, 1);
+  const auto expected = reference(src, width, height, 1.1);
+  for (size_t i = 0; i < dst.size(); ++i) {
+    ASSERT_NEAR(dst[i], std::min(expected[i], 255.0), 0.51) << i;
+  }
+}
+
+TEST(image_pipeline_tests, tiles_and_threads_do_not_change_the_result) {
+  const size_t width = 389;
+  const size_t height = 263;
+  const auto src = randomImage(width * height * 3, 2);
+  auto pipeline = edges();
+  std::vector<uint8_t> unfused(width * height);
+  pipeline.runUnfused(src.data(), unfused.data(), width, height, 1);
+  ASSERT_GT(std::count(unfused.begin(), unfused.end(), 255), 0);
+  ASSERT_GT(std::count(unfused.begin(), unfused.end(), 0), 0);
+  // tiles narrower than the halo, uneven tiles, single rows and one tile for the whole image
+  const std::vector<std::pair<size_t, size_t>> tiles = {{0, 0}, {2, 5}, {3, 50}, {64, 1}, {97, 41}, {1000, 1000}};
+  for (auto [tw, th] : tiles) {
+    for (int threads : {0, 1, 3}) {
+      std::vector<uint8_t> fused(width * height);
+      pipeline.tile(tw, th).run(src.data(), fused.data(), width, height, threads);
+      ASSERT_EQ(fused, unfused) << tw << "x" << th << " threads " << threads;
+    }
+  }
+  std::vector<uint8_t> unfused_team(width * height);
+  pipeline.runUnfused(src.data(), unfused_team.data(), width, height, 3);
+  ASSERT_EQ(unfused_team, unfused);
+}
+
+TEST(image_pipeline_tests, custom_stages_run_in_order) {
+  const size_t width = 20;
+  const size_t height = 9;
+  const auto src = randomImage(width * height * 2, 3);
+  // swap the two channels, then the horizontal difference to the right neighbour of each channel
+  ppc::core::ImagePipeline pipeline(2);
+  pipeline.add({2, 2, 0, 0, [](const float *const *rows, float *out, size_t pixels) {
+                  for (size_t i = 0; i < pixels; ++i) {
+                    out[2 * i] = rows[0][2 * i + 1];
+                    out[2 * i + 1] = rows[0][2 * i];
+                  }
+                }});
+  pipeline.add({2, 2, 1, 0, [](const float *const *rows, float *out, size_t pixels) {
+    for (size_t i = 0; i < 2 * pixels; ++i) out[i] = 128.0F + (rows[0][i + 2] - rows[0][i]) / 2.0F;
+  }});
+  ASSERT_EQ(pipeline.channelsIn(), 2U);
+  ASSERT_EQ(pipeline.channelsOut(), 2U);
+  std::vector<uint8_t> dst(src.size());
+  pipeline.tile(7, 4).run(src.data(), dst.data(), width, height);
+  for (size_t y = 0; y < height; ++y) {
+    for (size_t x = 0; x < width; ++x) {
+      const size_t right = std::min(x + 1, width - 1);
+      for (size_t c = 0; c < 2; ++c) {
+        const float left_value = src[(y * width + x) * 2 + 1 - c];
+        const float right_value = src[(y * width + right) * 2 + 1 - c];
+        const float expected = 128.0F + (right_value - left_value) / 2.0F;
+        ASSERT_NEAR(dst[(y * width + x) * 2 + c], expected, 0.5F);
+      }
+    }
+  }
+}
+
+TEST(image_pipeline_tests, empty_pipeline_copies_the_image) {
+  const auto src = randomImage(15 * 11 * 4, 4);
+  std::vector<uint8_t> dst(src.size());
+  ppc::core::ImagePipeline(4).tile(4, 4).run(src.data(), dst.data(), 15, 11);
+  ASSERT_EQ(dst, src);
+}
+
+TEST(image_pipeline_tests, row_ranges_piece_together_the_image) {
+  const size_t width = 157;
+  const size_t height = 93;
+  const auto src = randomImage(width * height * 3, 5);
+  auto pipeline = edges();
+  std::vector<uint8_t> whole(width * height);
+  pipeline.run(src.data(), whole.data(), width, height, 1);
+  std::vector<uint8_t> pieces(whole.size());
+  const std::vector<std::pair<size_t, size_t>> bands = {{0, 1}, {1, 4}, {4, 50}, {30, 92}, {92, 93}, {93, 93}};
+  for (auto [first, last] : bands) {
+    pipeline.runRows(src.data(), pieces.data(), width, height, first, last);
+  }
+  ASSERT_EQ(pieces, whole);
+  EXPECT_THROW(pipeline.runRows(src.data(), pieces.data(), width, height, 5, 94), std::out_of_range);
+  EXPECT_THROW(pipeline.runRows(src.data(), pieces.data(), width, height, 6, 5), std::out_of_range);
+}
+
+TEST(image_pipeline_tests, sobel_edges_match_the_per_pixel_loop) {
+  // the integer loop of the Sobel tasks, neighbours indexed with size_t and clamped from above
+  for (auto [width, height] : {std::pair<size_t, size_t>{1, 1}, {5, 3}, {67, 41}}) {
+    const auto src = randomImage(width * height * 3, 6);
+    std::vector<uint8_t> expected(width * height);
+    for (size_t i = 0; i < height; ++i) {
+      for (size_t j = 0; j < width; ++j) {
+        int gx = 0;
+        int gy = 0;
+        for (int dy = -1; dy <= 1; ++dy) {
+          for (int dx = -1; dx <= 1; ++dx) {
+            const size_t pixel = std::min(i + dy, height - 1) * width + std::min(j + dx, width - 1);
+            const auto luma =
+                static_cast<uint8_t>(0.299 * src[3 * pixel] + 0.587 * src[3 * pixel + 1] + 0.114 * src[3 * pixel + 2]);
+            gx += dx * (dy == 0 ? 2 : 1) * luma;
+            gy += dy * (dx == 0 ? 2 : 1) * luma;
+          }
+        }
+        expected[i * width + j] = static_cast<int>(std::sqrt(gx * gx + gy * gy)) >= 200 ? 255 : 0;
+      }
+    }
+    std::vector<uint8_t> dst(width * height);
+    ppc::core::sobelEdges(200.0F).run(src.data(), dst.data(), width, height);
+    ppc::core::sobelEdgesWrappedBorders(src.data(), dst.data(), width, height, 200.0F);
+    ASSERT_EQ(dst, expected) << width << " x " << height;
+  }
+}
+
+TEST(image_pipeline_tests, invalid_arguments_throw) {
+  std::vector<uint8_t> image(16 * 3, 1);
+  std::vector<uint8_t> out(16 * 3);
+  EXPECT_THROW(ppc::core::ImagePipeline(0), std::invalid_argument);
+  EXPECT_THROW(ppc::core::ImagePipeline(1).grayscale(), std::invalid_argument);
+  EXPECT_THROW(ppc::core::ImagePipeline(3).sobel(), std::invalid_argument);
+  EXPECT_THROW(ppc::core::ImagePipeline(1).gaussian(0.0), std::invalid_argument);
+  EXPECT_THROW(ppc::core::ImagePipeline(1).add({1, 1, 0, 0, nullptr}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::ImagePipeline(1).add({1, 0, 0, 0, [](const float *const *, float *, size_t) {}}),
+               std::invalid_argument);
+  EXPECT_THROW(edges().run(image.data(), out.data(), 4, 4, -1), std::invalid_argument);
+  EXPECT_THROW(edges().runUnfused(image.data(), out.data(), 4, 4, -1), std::invalid_argument);
+  EXPECT_NO_THROW(edges().run(image.data(), out.data(), 4, 4));
+}
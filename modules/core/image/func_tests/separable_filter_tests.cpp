@@ -0,0 +1,166 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/image/include/separable_filter.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> randomImage(size_t size, double max, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(0.0, max);
+  std::vector<T> image(size);
+  for (auto &value : image) value = static_cast<T>(dist(gen));
+  return image;
+}
+
+// the full 2D stencil of the outer product of the kernels, in double
+template <class T>
+std::vector<double> reference(const std::vector<T> &src, size_t width, size_t height, size_t channels,
+                              const std::vector<double> &kx, const std::vector<double> &ky) {
+  const auto rx = static_cast<int64_t>(kx.size() / 2);
+  const auto ry = static_cast<int64_t>(ky.size() / 2);
+  const auto w = static_cast<int64_t>(width);
+  const auto h = static_cast<int64_t>(height);
+  std::vector<double> dst(src.size());
+  for (int64_t y = 0; y < h; ++y) {
+    for (int64_t x = 0; x < w; ++x) {
+      for (size_t c = 0; c < channels; ++c) {
+        double sum = 0.0;
+        for (int64_t i = -ry; i <= ry; ++i) {
+          for (int64_t j = -rx; j <= rx; ++j) {
+            const auto sy = static_cast<size_t>(std::clamp<int64_t>(y + i, 0, h - 1));
+            const auto sx = static_cast<size_t>(std::clamp<int64_t>(x + j, 0, w - 1));
+            sum += ky[i + ry] * kx[j + rx] * static_cast<double>(src[(sy * width + sx) * channels + c]);
+          }
+        }
+        dst[(y * w + x) * channels + c] = sum;
+      }
+    }
+  }
+  return dst;
+}
+
+template <class T>
+void checkAgainstReference(size_t width, size_t height, size_t channels, const std::vector<double> &kx,
+                           const std::vector<double> &ky, double max, double tolerance, int threads) {
+  const auto src = randomImage<T>(width * height * channels, max, static_cast<unsigned>(width * 31 + height));
+  std::vector<T> dst(src.size());
+  ppc::core::separableFilter(src.data(), dst.data(), width, height, channels, kx, ky, threads);
+  const auto expected = reference(src, width, height, channels, kx, ky);
+  for (size_t i = 0; i < dst.size(); ++i) {
+    ASSERT_NEAR(static_cast<double>(dst[i]), expected[i], tolerance) << i;
+  }
+}
+
+}  // namespace
+
+TEST(separable_filter_tests, gaussian_kernel_is_normalized_and_symmetric) {
+  for (double sigma : {0.3, 1.0, 2.5, 10.0}) {
+    const auto kernel = ppc::core::gaussianKernel(sigma);
+    ASSERT_EQ(kernel.size(), 2 * static_cast<size_t>(std::ceil(3.0 * sigma)) + 1);
+    ASSERT_NEAR(std::accumulate(kernel.begin(), kernel.end(), 0.0), 1.0, 1e-12);
+    ASSERT_TRUE(std::equal(kernel.begin(), kernel.end(), kernel.rbegin()));
+    ASSERT_EQ(std::max_element(kernel.begin(), kernel.end()) - kernel.begin(), static_cast<int64_t>(kernel.size() / 2));
+  }
+  ASSERT_EQ(ppc::core::gaussianKernel(1.0, 0), std::vector<double>{1.0});
+  ASSERT_EQ(ppc::core::gaussianKernel(1.0, 4).size(), 9U);
+}
+
+TEST(separable_filter_tests, floating_point_matches_the_2d_stencil) {
+  const auto g = ppc::core::gaussianKernel(1.7);
+  checkAgainstReference<float>(37, 29, 1, g, g, 255.0, 1e-3, 1);
+  checkAgainstReference<float>(37, 29, 3, g, ppc::core::gaussianKernel(0.8), 255.0, 1e-3, 1);
+  checkAgainstReference<double>(300, 257, 1, g, g, 1.0, 1e-12, 3);
+  // any kernel, and radii wider than the image
+  checkAgainstReference<float>(5, 4, 2, {-1.0, 0.0, 1.0}, {0.5, 1.5, 2.0, 0.25, -1.0}, 1.0, 1e-5, 0);
+  const auto wide = ppc::core::gaussianKernel(4.0);
+  checkAgainstReference<double>(3, 7, 1, wide, wide, 100.0, 1e-10, 0);
+}
+
+TEST(separable_filter_tests, integer_pixels_are_within_one_of_the_exact_value) {
+  const auto g = ppc::core::gaussianKernel(2.2);
+  checkAgainstReference<uint8_t>(301, 299, 1, g, g, 256.0, 1.0, 3);
+  checkAgainstReference<uint8_t>(45, 17, 3, g, ppc::core::gaussianKernel(0.6), 256.0, 1.0, 1);
+  checkAgainstReference<uint16_t>(263, 271, 1, g, g, 65536.0, 1.0, 3);
+  checkAgainstReference<uint16_t>(19, 33, 4, ppc::core::gaussianKernel(5.0), g, 65536.0, 1.0, 1);
+  const std::vector<double> box(7, 1.0 / 7.0);
+  checkAgainstReference<uint8_t>(64, 48, 1, box, {1.0}, 256.0, 1.0, 1);
+}
+
+TEST(separable_filter_tests, flat_images_stay_flat) {
+  for (double sigma : {0.5, 3.0, 15.0}) {
+    std::vector<uint8_t> gray(120 * 80, 255);
+    std::vector<uint8_t> gray_out(gray.size());
+    ppc::core::gaussianBlur(gray.data(), gray_out.data(), 120, 80, 1, sigma);
+    ASSERT_EQ(gray_out, gray);
+    std::vector<uint16_t> deep(50 * 70 * 3, 65535);
+    std::vector<uint16_t> deep_out(deep.size());
+    ppc::core::gaussianBlur(deep.data(), deep_out.data(), 50, 70, 3, sigma);
+    ASSERT_EQ(deep_out, deep);
+  }
+}
+
+TEST(separable_filter_tests, threads_do_not_change_the_result) {
+  const size_t width = 517;
+  const size_t height = 389;
+  const auto bytes = randomImage<uint8_t>(width * height, 256.0, 1);
+  const auto floats = randomImage<float>(width * height, 1.0, 2);
+  std::vector<uint8_t> bytes_serial(bytes.size());
+  std::vector<float> floats_serial(floats.size());
+  ppc::core::gaussianBlur(bytes.data(), bytes_serial.data(), width, height, 1, 6.0, -1, 1);
+  ppc::core::gaussianBlur(floats.data(), floats_serial.data(), width, height, 1, 6.0, -1, 1);
+  for (int threads : {0, 2, 3, 7}) {
+    std::vector<uint8_t> bytes_out(bytes.size());
+    std::vector<float> floats_out(floats.size());
+    ppc::core::gaussianBlur(bytes.data(), bytes_out.data(), width, height, 1, 6.0, -1, threads);
+    ppc::core::gaussianBlur(floats.data(), floats_out.data(), width, height, 1, 6.0, -1, threads);
+    ASSERT_EQ(bytes_out, bytes_serial);
+    ASSERT_EQ(floats_out, floats_serial);
+  }
+}
+
+TEST(separable_filter_tests, row_ranges_piece_together_the_image) {
+  const size_t width = 203;
+  const size_t height = 97;
+  const auto src = randomImage<uint16_t>(width * height * 2, 65536.0, 3);
+  const auto kx = ppc::core::gaussianKernel(1.2);
+  const auto ky = ppc::core::gaussianKernel(3.4);
+  std::vector<uint16_t> whole(src.size());
+  ppc::core::separableFilter(src.data(), whole.data(), width, height, 2, kx, ky, 1);
+  std::vector<uint16_t> pieces(src.size());
+  // single rows, bands shorter than the kernel, and overlapping bands
+  const std::vector<std::pair<size_t, size_t>> bands = {{0, 1}, {1, 5}, {5, 55}, {40, 90}, {90, 97}, {97, 97}};
+  for (auto [first, last] : bands) {
+    ppc::core::separableFilterRows(src.data(), pieces.data(), width, height, 2, kx, ky, first, last);
+  }
+  ASSERT_EQ(pieces, whole);
+  EXPECT_THROW(ppc::core::separableFilterRows(src.data(), pieces.data(), width, height, 2, kx, ky, 10, 98),
+               std::out_of_range);
+}
+
+TEST(separable_filter_tests, invalid_arguments_throw) {
+  std::vector<uint8_t> image(16, 1);
+  std::vector<uint8_t> out(16);
+  std::vector<float> floats(16, 1.0F);
+  std::vector<float> floats_out(16);
+  EXPECT_THROW(ppc::core::gaussianKernel(0.0), std::invalid_argument);
+  EXPECT_THROW(ppc::core::gaussianKernel(-1.0), std::invalid_argument);
+  EXPECT_THROW(ppc::core::gaussianKernel(1.0, -2), std::invalid_argument);
+  EXPECT_THROW(ppc::core::separableFilter(image.data(), out.data(), 4, 4, 1, {0.5, 0.5}, {1.0}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::separableFilter(image.data(), out.data(), 4, 4, 1, {1.0}, {0.6, 0.6, -0.2}),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::core::separableFilter(image.data(), out.data(), 4, 4, 1, {0.5, 0.5, 0.5}, {1.0}),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::core::gaussianBlur(image.data(), out.data(), 4, 4, 1, 1.0, -1, -1), std::invalid_argument);
+  EXPECT_NO_THROW(ppc::core::separableFilter(floats.data(), floats_out.data(), 4, 4, 1, {0.6, 0.6, -0.2}, {2.0}));
+}
@@ -0,0 +1,87 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_IMAGE_PIPELINE_HPP_
+#define MODULES_CORE_INCLUDE_IMAGE_PIPELINE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ppc::core {
+
+// One operator of an ImagePipeline, applied to a segment of one row at a time. Point-wise
+// operators have rx = ry = 0; stencils read rx pixels left and right and ry rows above and below.
+struct ImageStage {
+  size_t channels_in = 1;
+  size_t channels_out = 1;
+  size_t rx = 0;
+  size_t ry = 0;
+  // Fills out[0 .. pixels * channels_out). rows[k], k = 0 .. 2 * ry, points at the input pixel
+  // under out[0] in row y - ry + k, and every row can be read rx pixels before and after the
+  // segment. Input beyond the image border repeats the edge pixel.
+  std::function<void(const float* const* rows, float* out, size_t pixels)> apply;
+};
+
+// A chain of point-wise and stencil operators run over an 8-bit image with interleaved channels.
+//
+// Stages are fused over tiles: the input of a tile is read once with the halo of every stage
+// together, each stage fills a tile-sized float buffer from the previous one, shrinking it by its
+// own halo, and only the last stage's output is written to dst, rounded and clamped to 0 .. 255.
+// Tiles are sized so that the buffers stay in L2, so intermediate images never go to memory. Every
+// stage repeats the edge pixels of its own input at the image border, exactly as if it ran as a
+// separate full-image pass, and the result does not depend on the tiling or the team.
+//
+// Built with OpenMP, tiles are shared among threads, unless the call is made from inside a
+// parallel region or the image is small; threads caps the team (0: the OpenMP default, 1: serial).
+class ImagePipeline {
+ public:
+  explicit ImagePipeline(size_t channels = 1);
+
+  // Appends a stage; throws std::invalid_argument unless it reads as many channels as the
+  // pipeline has at this point and has an apply function.
+  ImagePipeline& add(ImageStage stage);
+
+  // 0.299 R + 0.587 G + 0.114 B (ITU-R BT.601 luma) of 3-channel pixels.
+  ImagePipeline& grayscale();
+  // gaussianKernel(sigma, radius) along columns, then along rows, of every channel.
+  ImagePipeline& gaussian(double sigma, int radius = -1);
+  // Sobel gradient magnitude sqrt(gx^2 + gy^2) of 1-channel pixels.
+  ImagePipeline& sobel();
+  // above where a value is at least level, below elsewhere, for every channel.
+  ImagePipeline& threshold(float level, float below = 0.0F, float above = 255.0F);
+
+  // Output tile size in pixels; 0 picks one for the L2 cache.
+  ImagePipeline& tile(size_t width, size_t height);
+
+  size_t channelsIn() const { return channels_in; }
+  size_t channelsOut() const { return channels_out; }
+
+  // dst (channelsOut() values per pixel) = the stages applied to src (channelsIn() values).
+  // src and dst must not overlap.
+  void run(const uint8_t* src, uint8_t* dst, size_t width, size_t height, int threads = 0) const;
+
+  // Rows first_row .. last_row - 1 of run, serially, for callers that split an image among their
+  // own TBB or std::thread workers. Throws std::out_of_range unless first_row <= last_row <= height.
+  void runRows(const uint8_t* src, uint8_t* dst, size_t width, size_t height, size_t first_row,
+               size_t last_row) const;
+
+  // The same result with every stage a full-image pass between full-size float images, as a chain
+  // of separate tasks would run it; kept to measure the fused run against.
+  void runUnfused(const uint8_t* src, uint8_t* dst, size_t width, size_t height, int threads = 0) const;
+
+ private:
+  size_t channels_in;
+  size_t channels_out;
+  size_t tile_width = 0;
+  size_t tile_height = 0;
+  std::vector<ImageStage> stages;
+
+  // the tile set by tile(), or else the L2-sized one, capped at the image
+  std::pair<size_t, size_t> tileSize(size_t width, size_t height) const;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_IMAGE_PIPELINE_HPP_
@@ -0,0 +1,25 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SOBEL_EDGES_HPP_
+#define MODULES_CORE_INCLUDE_SOBEL_EDGES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/image/include/image_pipeline.hpp"
+
+namespace ppc::core {
+
+// Edge map of an 8-bit RGB image as one fused ImagePipeline: the BT.601 luma truncated to 8 bits
+// (not rounded like grayscale()), the Sobel magnitude and 255 where it reaches level, 0 elsewhere.
+ImagePipeline sobelEdges(float level);
+
+// Redoes row 0 and column 0 of a sobelEdges result in dst for a stencil that indexes its
+// neighbours with size_t and clamps only from above: the neighbours at -1 wrap to the last row and
+// column instead of repeating the edge. The Sobel tasks were written that way and their expected
+// images keep those borders.
+void sobelEdgesWrappedBorders(const uint8_t* rgb, uint8_t* dst, size_t width, size_t height, float level);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SOBEL_EDGES_HPP_
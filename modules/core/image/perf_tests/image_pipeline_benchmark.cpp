@@ -0,0 +1,118 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/image/include/image_pipeline.hpp"
+#include "core/perf/include/perf.hpp"
+
+// An edge detector (grayscale, Gaussian blur, Sobel magnitude, threshold) over an RGB image, run
+// fused over tiles and as full-image passes. Each line reads
+// image_pipeline_benchmark/<pipeline>/<run>:pipeline:<pixels/s>:<bytes/s>, counting the RGB input.
+
+namespace {
+
+constexpr size_t kWidth = 3840;
+constexpr size_t kHeight = 2160;
+
+using PipelineRun = std::function<void(const uint8_t *, uint8_t *)>;
+
+class PipelineBenchmarkTask : public ppc::core::Task {
+ public:
+  PipelineBenchmarkTask(std::shared_ptr<ppc::core::TaskData> taskData_, PipelineRun run_)
+      : Task(std::move(taskData_)), pipeline_run(std::move(run_)) {}
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs_count[0] == 3 * taskData->outputs_count[0];
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    pipeline_run(taskData->inputs[0], taskData->outputs[0]);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  PipelineRun pipeline_run;
+};
+
+std::vector<uint8_t> edges(const std::string &name, const ppc::core::ImagePipeline &pipeline, bool fused) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> in(kWidth * kHeight * 3);
+  // smooth gradients with noise, so that the threshold keeps some of the pixels
+  for (size_t y = 0; y < kHeight; ++y) {
+    for (size_t x = 0; x < kWidth; ++x) {
+      for (size_t c = 0; c < 3; ++c) {
+        in[(y * kWidth + x) * 3 + c] = static_cast<uint8_t>(((x / 64 + y / 48 + c) % 4) * 60 + dist(gen) % 16);
+      }
+    }
+  }
+  std::vector<uint8_t> out(kWidth * kHeight);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(in.data());
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(out.data());
+  taskData->outputs_count.emplace_back(out.size());
+  auto task = std::make_shared<PipelineBenchmarkTask>(taskData, [&](const uint8_t *src, uint8_t *dst) {
+    if (fused) {
+      pipeline.run(src, dst, kWidth, kHeight);
+    } else {
+      pipeline.runUnfused(src, dst, kWidth, kHeight);
+    }
+  });
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  ppc::core::Perf perfAnalyzer(task);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  ppc::core::Perf::print_throughput_statistic(perfAttr, perfResults,
+                                              "image_pipeline_benchmark/" + name + (fused ? "/fused" : "/unfused"),
+                                              kWidth * kHeight, in.size());
+  return out;
+}
+
+void benchmark(const std::string &name, const ppc::core::ImagePipeline &pipeline) {
+  const auto fused = edges(name, pipeline, true);
+  const auto unfused = edges(name, pipeline, false);
+  EXPECT_EQ(fused, unfused) << name;
+}
+
+}  // namespace
+
+TEST(image_pipeline_benchmark, sobel_edges) {
+  ppc::core::ImagePipeline pipeline(3);
+  benchmark("sobel_edges", pipeline.grayscale().gaussian(1.0).sobel().threshold(100.0F));
+}
+
+TEST(image_pipeline_benchmark, wide_blur_edges) {
+  ppc::core::ImagePipeline pipeline(3);
+  benchmark("wide_blur_edges", pipeline.grayscale().gaussian(3.0).sobel().threshold(40.0F));
+}
@@ -0,0 +1,307 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/image/include/image_pipeline.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "core/image/include/separable_filter.hpp"
+
+namespace {
+
+// below this many pixels a thread team costs more than it saves
+constexpr size_t kParallelPixels = 1 << 16;
+// the widest tile buffer holds at most this many bytes, so that it and the one it fills share L2
+constexpr size_t kTileBytes = 512 * 1024;
+constexpr size_t kMinTile = 32;
+
+// pixels x0 .. x1 - 1 of rows y0 .. y1 - 1; halos reach past the image, so corners can be negative
+struct Rect {
+  ptrdiff_t x0, y0, x1, y1;
+
+  ptrdiff_t width() const { return x1 - x0; }
+  ptrdiff_t height() const { return y1 - y0; }
+
+  Rect expand(size_t dx, size_t dy) const {
+    const auto sx = static_cast<ptrdiff_t>(dx);
+    const auto sy = static_cast<ptrdiff_t>(dy);
+    return {x0 - sx, y0 - sy, x1 + sx, y1 + sy};
+  }
+
+  Rect clip(size_t width, size_t height) const {
+    return {std::max<ptrdiff_t>(x0, 0), std::max<ptrdiff_t>(y0, 0), std::min(x1, static_cast<ptrdiff_t>(width)),
+            std::min(y1, static_cast<ptrdiff_t>(height))};
+  }
+};
+
+Rect spanning(size_t x0, size_t y0, size_t x1, size_t y1) {
+  return {static_cast<ptrdiff_t>(x0), static_cast<ptrdiff_t>(y0), static_cast<ptrdiff_t>(x1),
+          static_cast<ptrdiff_t>(y1)};
+}
+
+// float pixels of rect with channels interleaved values each, row-major
+struct Buffer {
+  Rect rect{};
+  size_t channels = 1;
+  std::vector<float> values;
+
+  void reset(const Rect& r, size_t c) {
+    rect = r;
+    channels = c;
+    const auto size = static_cast<size_t>(r.width() * r.height()) * c;
+    if (values.size() < size) values.resize(size);
+  }
+
+  float* at(ptrdiff_t x, ptrdiff_t y) {
+    return values.data() + static_cast<size_t>((y - rect.y0) * rect.width() + (x - rect.x0)) * channels;
+  }
+};
+
+// The buffers of one tile: buffers[s] is the input of stage s with its halo, the last one the
+// output of the last stage.
+class TileRunner {
+ public:
+  TileRunner(const std::vector<ppc::core::ImageStage>& stages_, size_t channels_in_, size_t width_, size_t height_)
+      : stages(stages_), channels_in(channels_in_), width(width_), height(height_), buffers(stages_.size() + 1) {}
+
+  // dst pixels of tile, with team threads sharing the rows of every step
+  void run(const uint8_t* src, uint8_t* dst, const Rect& tile, int team) {
+    // regions[s]: what stage s writes, i.e. the tile grown by the halos of the stages after it
+    std::vector<Rect> regions(stages.size());
+    size_t after_x = 0;
+    size_t after_y = 0;
+    for (size_t s = stages.size(); s-- > 0;) {
+      regions[s] = tile.expand(after_x, after_y).clip(width, height);
+      after_x += stages[s].rx;
+      after_y += stages[s].ry;
+    }
+
+    const Rect first = stages.empty() ? tile : regions[0].expand(stages[0].rx, stages[0].ry);
+    buffers[0].reset(first, channels_in);
+    load(src, buffers[0], team);
+    for (size_t s = 0; s < stages.size(); ++s) {
+      const bool last = s + 1 == stages.size();
+      const Rect out = last ? tile : regions[s + 1].expand(stages[s + 1].rx, stages[s + 1].ry);
+      buffers[s + 1].reset(out, stages[s].channels_out);
+      apply(stages[s], buffers[s], buffers[s + 1], regions[s], team);
+      // the image ends wherever out reaches past regions[s], so the border is the edge repeated
+      if (!last) pad(buffers[s + 1], regions[s]);
+    }
+    store(buffers[stages.size()], dst, team);
+  }
+
+ private:
+  const std::vector<ppc::core::ImageStage>& stages;
+  size_t channels_in;
+  size_t width;
+  size_t height;
+  std::vector<Buffer> buffers;
+
+  void load(const uint8_t* src, Buffer& buffer, int team) const {
+    const Rect& r = buffer.rect;
+    const Rect inner = r.clip(width, height);
+    const size_t c = channels_in;
+    const auto span = static_cast<size_t>(inner.width()) * c;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(team) if (team > 1)
+#endif
+    for (ptrdiff_t y = r.y0; y < r.y1; ++y) {
+      const auto sy = static_cast<size_t>(std::clamp<ptrdiff_t>(y, 0, static_cast<ptrdiff_t>(height) - 1));
+      const uint8_t* row = src + (sy * width + static_cast<size_t>(inner.x0)) * c;
+      float* out = buffer.at(inner.x0, y);
+      for (size_t i = 0; i < span; ++i) out[i] = row[i];
+      for (ptrdiff_t x = r.x0; x < inner.x0; ++x) std::copy(out, out + c, buffer.at(x, y));
+      for (ptrdiff_t x = inner.x1; x < r.x1; ++x) std::copy(out + span - c, out + span, buffer.at(x, y));
+    }
+  }
+
+  static void apply(const ppc::core::ImageStage& stage, Buffer& in, Buffer& out, const Rect& region, int team) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(team) if (team > 1)
+#endif
+    {
+      std::vector<const float*> rows(2 * stage.ry + 1);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (ptrdiff_t y = region.y0; y < region.y1; ++y) {
+        for (size_t k = 0; k < rows.size(); ++k) {
+          rows[k] = in.at(region.x0, y - static_cast<ptrdiff_t>(stage.ry) + static_cast<ptrdiff_t>(k));
+        }
+        stage.apply(rows.data(), out.at(region.x0, y), static_cast<size_t>(region.width()));
+      }
+    }
+  }
+
+  static void pad(Buffer& buffer, const Rect& inner) {
+    const Rect& r = buffer.rect;
+    const size_t c = buffer.channels;
+    for (ptrdiff_t y = inner.y0; y < inner.y1; ++y) {
+      const float* left = buffer.at(inner.x0, y);
+      const float* right = buffer.at(inner.x1 - 1, y);
+      for (ptrdiff_t x = r.x0; x < inner.x0; ++x) std::copy(left, left + c, buffer.at(x, y));
+      for (ptrdiff_t x = inner.x1; x < r.x1; ++x) std::copy(right, right + c, buffer.at(x, y));
+    }
+    const auto row = static_cast<size_t>(r.width()) * c;
+    for (ptrdiff_t y = r.y0; y < inner.y0; ++y) std::copy_n(buffer.at(r.x0, inner.y0), row, buffer.at(r.x0, y));
+    for (ptrdiff_t y = inner.y1; y < r.y1; ++y) std::copy_n(buffer.at(r.x0, inner.y1 - 1), row, buffer.at(r.x0, y));
+  }
+
+  void store(Buffer& buffer, uint8_t* dst, int team) const {
+    const Rect& r = buffer.rect;
+    const size_t row = static_cast<size_t>(r.width()) * buffer.channels;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(team) if (team > 1)
+#endif
+    for (ptrdiff_t y = r.y0; y < r.y1; ++y) {
+      const float* in = buffer.at(r.x0, y);
+      uint8_t* out = dst + (static_cast<size_t>(y) * width + static_cast<size_t>(r.x0)) * buffer.channels;
+      for (size_t i = 0; i < row; ++i) out[i] = static_cast<uint8_t>(std::clamp(in[i], 0.0F, 255.0F) + 0.5F);
+    }
+  }
+};
+
+}  // namespace
+
+ppc::core::ImagePipeline::ImagePipeline(size_t channels) : channels_in(channels), channels_out(channels) {
+  if (channels == 0) throw std::invalid_argument("ImagePipeline: images need at least one channel");
+}
+
+ppc::core::ImagePipeline& ppc::core::ImagePipeline::add(ImageStage stage) {
+  if (stage.channels_in != channels_out || stage.channels_out == 0 || !stage.apply) {
+    throw std::invalid_argument("ImagePipeline: the stage does not fit the channels of the pipeline");
+  }
+  channels_out = stage.channels_out;
+  stages.push_back(std::move(stage));
+  return *this;
+}
+
+ppc::core::ImagePipeline& ppc::core::ImagePipeline::grayscale() {
+  return add({3, 1, 0, 0, [](const float* const* rows, float* out, size_t pixels) {
+                const float* in = rows[0];
+                for (size_t i = 0; i < pixels; ++i) {
+                  out[i] = 0.299F * in[3 * i] + 0.587F * in[3 * i + 1] + 0.114F * in[3 * i + 2];
+                }
+              }});
+}
+
+ppc::core::ImagePipeline& ppc::core::ImagePipeline::gaussian(double sigma, int radius) {
+  const auto kernel = gaussianKernel(sigma, radius);
+  const std::vector<float> w(kernel.begin(), kernel.end());
+  const size_t r = w.size() / 2;
+  const size_t c = channels_out;
+  add({c, c, 0, r, [w, c](const float* const* rows, float* out, size_t pixels) {
+         const size_t n = pixels * c;
+         for (size_t i = 0; i < n; ++i) out[i] = w[0] * rows[0][i];
+         for (size_t k = 1; k < w.size(); ++k) {
+           for (size_t i = 0; i < n; ++i) out[i] += w[k] * rows[k][i];
+         }
+       }});
+  return add({c, c, r, 0, [w, r, c](const float* const* rows, float* out, size_t pixels) {
+                const size_t n = pixels * c;
+                const float* in = rows[0] - r * c;
+                for (size_t i = 0; i < n; ++i) out[i] = w[0] * in[i];
+                for (size_t k = 1; k < w.size(); ++k) {
+                  for (size_t i = 0; i < n; ++i) out[i] += w[k] * in[i + k * c];
+                }
+              }});
+}
+
+ppc::core::ImagePipeline& ppc::core::ImagePipeline::sobel() {
+  return add({1, 1, 1, 1, [](const float* const* rows, float* out, size_t pixels) {
+                const float* a = rows[0];
+                const float* b = rows[1];
+                const float* c = rows[2];
+                for (size_t i = 0; i < pixels; ++i) {
+                  const float gx = (a[i + 1] - a[i - 1]) + 2.0F * (b[i + 1] - b[i - 1]) + (c[i + 1] - c[i - 1]);
+                  const float gy = (c[i - 1] + 2.0F * c[i] + c[i + 1]) - (a[i - 1] + 2.0F * a[i] + a[i + 1]);
+                  out[i] = std::sqrt(gx * gx + gy * gy);
+                }
+              }});
+}
+
+ppc::core::ImagePipeline& ppc::core::ImagePipeline::threshold(float level, float below, float above) {
+  const size_t c = channels_out;
+  return add({c, c, 0, 0, [c, level, below, above](const float* const* rows, float* out, size_t pixels) {
+                const float* in = rows[0];
+                for (size_t i = 0; i < pixels * c; ++i) out[i] = in[i] >= level ? above : below;
+              }});
+}
+
+ppc::core::ImagePipeline& ppc::core::ImagePipeline::tile(size_t width, size_t height) {
+  tile_width = width;
+  tile_height = height;
+  return *this;
+}
+
+void ppc::core::ImagePipeline::run(const uint8_t* src, uint8_t* dst, size_t width, size_t height, int threads) const {
+  if (threads < 0) throw std::invalid_argument("ImagePipeline: threads must not be negative");
+  if (width == 0 || height == 0) return;
+  const auto [tw, th] = tileSize(width, height);
+  const size_t tiles_x = (width + tw - 1) / tw;
+  const auto tiles = static_cast<int64_t>(tiles_x * ((height + th - 1) / th));
+
+#ifdef _OPENMP
+  int team = 1;
+  if (width * height >= kParallelPixels && !omp_in_parallel()) team = threads == 0 ? omp_get_max_threads() : threads;
+#pragma omp parallel num_threads(team)
+#endif
+  {
+    TileRunner runner(stages, channels_in, width, height);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int64_t t = 0; t < tiles; ++t) {
+      const size_t x0 = static_cast<size_t>(t) % tiles_x * tw;
+      const size_t y0 = static_cast<size_t>(t) / tiles_x * th;
+      runner.run(src, dst, spanning(x0, y0, std::min(width, x0 + tw), std::min(height, y0 + th)), 1);
+    }
+  }
+}
+
+void ppc::core::ImagePipeline::runRows(const uint8_t* src, uint8_t* dst, size_t width, size_t height,
+                                       size_t first_row, size_t last_row) const {
+  if (first_row > last_row || last_row > height) throw std::out_of_range("ImagePipeline: rows out of range");
+  if (width == 0 || first_row == last_row) return;
+  const auto [tw, th] = tileSize(width, height);
+  TileRunner runner(stages, channels_in, width, height);
+  for (size_t y = first_row; y < last_row; y += th) {
+    for (size_t x = 0; x < width; x += tw) {
+      runner.run(src, dst, spanning(x, y, std::min(width, x + tw), std::min(last_row, y + th)), 1);
+    }
+  }
+}
+
+std::pair<size_t, size_t> ppc::core::ImagePipeline::tileSize(size_t width, size_t height) const {
+  size_t halo = 0;
+  size_t widest = channels_in;
+  for (const auto& stage : stages) {
+    halo += std::max(stage.rx, stage.ry);
+    widest = std::max(widest, stage.channels_out);
+  }
+  // a tile twice as wide as it is tall, since stages are called once per row, fills kTileBytes in the
+  // widest buffer with its halo
+  const auto side = static_cast<size_t>(std::sqrt(static_cast<double>(kTileBytes / (2 * sizeof(float) * widest))));
+  const size_t fit = std::max(kMinTile, side > 2 * halo ? side - 2 * halo : 0);
+  return {std::min(width, tile_width == 0 ? 2 * fit : tile_width),
+          std::min(height, tile_height == 0 ? fit : tile_height)};
+}
+
+void ppc::core::ImagePipeline::runUnfused(const uint8_t* src, uint8_t* dst, size_t width, size_t height,
+                                          int threads) const {
+  if (threads < 0) throw std::invalid_argument("ImagePipeline: threads must not be negative");
+  if (width == 0 || height == 0) return;
+  int team = 1;
+#ifdef _OPENMP
+  if (width * height >= kParallelPixels && !omp_in_parallel()) team = threads == 0 ? omp_get_max_threads() : threads;
+#endif
+  TileRunner runner(stages, channels_in, width, height);
+  runner.run(src, dst, spanning(0, 0, width, height), team);
+}
@@ -0,0 +1,372 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/image/include/separable_filter.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+// below this many pixels a thread team costs more than it saves
+constexpr size_t kParallelPixels = 1 << 16;
+constexpr int kWeightBits = 16;
+constexpr uint32_t kOne = uint32_t{1} << kWeightBits;
+constexpr size_t kLanes = 8;
+
+// 8-bit pixels are filtered in fixed point: row-filtered values are uint16 with 8 fraction bits,
+// which still leaves the column pass a sum below 2^32 (65280 * 2^16 + rounding). 16-bit pixels
+// would leave no fraction bits and too few weight bits in 32-bit lanes, so they go through float.
+template <class T>
+struct Pass {
+  using Mid = T;
+  using Weight = T;
+};
+
+template <>
+struct Pass<uint8_t> {
+  using Mid = uint16_t;
+  using Weight = uint32_t;
+};
+
+template <>
+struct Pass<uint16_t> {
+  using Mid = float;
+  using Weight = float;
+};
+
+template <class T>
+using Mid = typename Pass<T>::Mid;
+template <class T>
+using Weight = typename Pass<T>::Weight;
+
+constexpr int kRowShift = kWeightBits - 8;
+constexpr int kColumnShift = kWeightBits + 8;
+
+// Q16 weights summing to exactly 2^16: every weight is rounded down and the units still missing
+// go to the weights that lost the most, so none turns negative and flat images stay flat.
+std::vector<uint32_t> fixedWeights(const std::vector<double>& kernel) {
+  std::vector<uint32_t> weights(kernel.size());
+  std::vector<double> loss(kernel.size());
+  uint32_t sum = 0;
+  for (size_t k = 0; k < kernel.size(); ++k) {
+    const double scaled = kernel[k] * kOne;
+    weights[k] = static_cast<uint32_t>(std::floor(scaled));
+    loss[k] = scaled - weights[k];
+    sum += weights[k];
+  }
+  std::vector<size_t> order(kernel.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return loss[a] > loss[b]; });
+  for (size_t k = 0; sum < kOne; ++k, ++sum) ++weights[order[k % order.size()]];
+  return weights;
+}
+
+template <class T>
+std::vector<Weight<T>> weightsOf(const std::vector<double>& kernel) {
+  if (kernel.size() % 2 == 0) throw std::invalid_argument("separableFilter: kernels need an odd number of taps");
+  if constexpr (std::is_integral_v<T>) {
+    const bool negative = std::any_of(kernel.begin(), kernel.end(), [](double w) { return !(w >= 0.0); });
+    if (negative || std::abs(std::accumulate(kernel.begin(), kernel.end(), 0.0) - 1.0) > 1e-6) {
+      throw std::invalid_argument("separableFilter: integer pixels need non-negative kernels that sum to 1");
+    }
+  }
+  if constexpr (std::is_integral_v<Weight<T>>) {
+    return fixedWeights(kernel);
+  } else {
+    return std::vector<Weight<T>>(kernel.begin(), kernel.end());
+  }
+}
+
+// values first .. n - 1 of one filtered row; pad holds the row with taps / 2 edge pixels repeated
+// on either side, step values apart
+template <class T>
+void rowPassScalar(const T* pad, Mid<T>* out, size_t n, const Weight<T>* w, size_t taps, size_t step, size_t first) {
+  for (size_t i = first; i < n; ++i) {
+    if constexpr (std::is_integral_v<Weight<T>>) {
+      uint32_t acc = uint32_t{1} << (kRowShift - 1);
+      for (size_t k = 0; k < taps; ++k) acc += w[k] * pad[i + k * step];
+      out[i] = static_cast<Mid<T>>(acc >> kRowShift);
+    } else {
+      Mid<T> acc = 0;
+      for (size_t k = 0; k < taps; ++k) acc += w[k] * static_cast<Mid<T>>(pad[i + k * step]);
+      out[i] = acc;
+    }
+  }
+}
+
+template <class T>
+void columnPassScalar(const Mid<T>* const* rows, T* out, size_t n, const Weight<T>* w, size_t taps, size_t first) {
+  for (size_t i = first; i < n; ++i) {
+    if constexpr (std::is_integral_v<Weight<T>>) {
+      uint32_t acc = uint32_t{1} << (kColumnShift - 1);
+      for (size_t k = 0; k < taps; ++k) acc += w[k] * rows[k][i];
+      out[i] = static_cast<T>(acc >> kColumnShift);
+    } else {
+      Mid<T> acc = 0;
+      for (size_t k = 0; k < taps; ++k) acc += w[k] * rows[k][i];
+      if constexpr (std::is_integral_v<T>) {
+        out[i] = static_cast<T>(std::min(acc + 0.5F, static_cast<float>(std::numeric_limits<T>::max())));
+      } else {
+        out[i] = acc;
+      }
+    }
+  }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+bool hasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+__attribute__((target("avx2"))) inline __m256i load8(const uint8_t* p) {
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+}
+
+__attribute__((target("avx2"))) inline __m256i load8(const uint16_t* p) {
+  return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+__attribute__((target("avx2"))) inline __m256 load8f(const float* p) { return _mm256_loadu_ps(p); }
+
+__attribute__((target("avx2"))) inline __m256 load8f(const uint16_t* p) { return _mm256_cvtepi32_ps(load8(p)); }
+
+// the eight 32-bit lanes hold values that fit the destination, so the saturating packs only narrow
+__attribute__((target("avx2"))) inline __m128i narrow16(__m256i v) {
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08));
+}
+
+__attribute__((target("avx2"))) inline void store8(uint16_t* p, __m256i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), narrow16(v));
+}
+
+__attribute__((target("avx2"))) inline void store8(uint8_t* p, __m256i v) {
+  const __m128i words = narrow16(v);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(words, words));
+}
+
+__attribute__((target("avx2"))) inline void store8f(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+
+// rounded like the scalar pass: + 0.5, capped, truncated
+__attribute__((target("avx2"))) inline void store8f(uint16_t* p, __m256 v) {
+  v = _mm256_min_ps(_mm256_add_ps(v, _mm256_set1_ps(0.5F)), _mm256_set1_ps(65535.0F));
+  store8(p, _mm256_cvttps_epi32(v));
+}
+
+// Eight neighbouring outputs per step: tap k of output i + j is pad[i + j + k * step], so every
+// tap is one unaligned load of eight values times a broadcast weight. Unsigned 32-bit products and
+// sums cannot wrap because the weights sum to 2^16.
+__attribute__((target("avx2"))) size_t rowPassAvx2(const uint8_t* pad, uint16_t* out, size_t n, const uint32_t* w,
+                                                   size_t taps, size_t step) {
+  const __m256i round = _mm256_set1_epi32(1 << (kRowShift - 1));
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    __m256i acc = round;
+    for (size_t k = 0; k < taps; ++k) {
+      const __m256i weight = _mm256_set1_epi32(static_cast<int>(w[k]));
+      acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(weight, load8(pad + i + k * step)));
+    }
+    store8(out + i, _mm256_srli_epi32(acc, kRowShift));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t columnPassAvx2(const uint16_t* const* rows, uint8_t* out, size_t n,
+                                                      const uint32_t* w, size_t taps) {
+  const __m256i round = _mm256_set1_epi32(1 << (kColumnShift - 1));
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    __m256i acc = round;
+    for (size_t k = 0; k < taps; ++k) {
+      const __m256i weight = _mm256_set1_epi32(static_cast<int>(w[k]));
+      acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(weight, load8(rows[k] + i)));
+    }
+    store8(out + i, _mm256_srli_epi32(acc, kColumnShift));
+  }
+  return i;
+}
+
+// the same sums in the same order as the scalar passes, so both give the same results
+template <class T>
+__attribute__((target("avx2"))) size_t rowPassAvx2(const T* pad, float* out, size_t n, const float* w, size_t taps,
+                                                   size_t step) {
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t k = 0; k < taps; ++k) {
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(w[k]), load8f(pad + i + k * step)));
+    }
+    _mm256_storeu_ps(out + i, acc);
+  }
+  return i;
+}
+
+template <class T>
+__attribute__((target("avx2"))) size_t columnPassAvx2(const float* const* rows, T* out, size_t n, const float* w,
+                                                      size_t taps) {
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t k = 0; k < taps; ++k) {
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(w[k]), _mm256_loadu_ps(rows[k] + i)));
+    }
+    store8f(out + i, acc);
+  }
+  return i;
+}
+
+#else
+
+bool hasAvx2() { return false; }
+
+#endif
+
+template <class T>
+void rowPass(const T* pad, Mid<T>* out, size_t n, const std::vector<Weight<T>>& w, size_t step) {
+  size_t first = 0;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  static const bool avx2 = hasAvx2();
+  if constexpr (!std::is_same_v<T, double>) {
+    if (avx2) first = rowPassAvx2(pad, out, n, w.data(), w.size(), step);
+  }
+#endif
+  rowPassScalar(pad, out, n, w.data(), w.size(), step, first);
+}
+
+template <class T>
+void columnPass(const Mid<T>* const* rows, T* out, size_t n, const std::vector<Weight<T>>& w) {
+  size_t first = 0;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  static const bool avx2 = hasAvx2();
+  if constexpr (!std::is_same_v<T, double>) {
+    if (avx2) first = columnPassAvx2(rows, out, n, w.data(), w.size());
+  }
+#endif
+  columnPassScalar(rows, out, n, w.data(), w.size(), first);
+}
+
+// Output rows first_row .. last_row - 1. Source row s is filtered along x into ring slot
+// s % ring_rows once the first output row needing it comes up, and stays until the last one is done.
+template <class T>
+void filterBand(const T* src, T* dst, size_t width, size_t height, size_t channels, const std::vector<Weight<T>>& wx,
+                const std::vector<Weight<T>>& wy, size_t first_row, size_t last_row) {
+  const size_t rx = wx.size() / 2;
+  const size_t ry = wy.size() / 2;
+  const size_t row_size = width * channels;
+  const size_t ring_rows = wy.size();
+  std::vector<T> pad((width + 2 * rx) * channels);
+  std::vector<Mid<T>> ring(ring_rows * row_size);
+  std::vector<const Mid<T>*> rows(wy.size());
+
+  size_t next = first_row > ry ? first_row - ry : 0;
+  for (size_t y = first_row; y < last_row; ++y) {
+    for (; next <= std::min(y + ry, height - 1); ++next) {
+      const T* row = src + next * row_size;
+      for (size_t x = 0; x < rx; ++x) {
+        std::memcpy(pad.data() + x * channels, row, channels * sizeof(T));
+        std::memcpy(pad.data() + (rx + width + x) * channels, row + row_size - channels, channels * sizeof(T));
+      }
+      std::memcpy(pad.data() + rx * channels, row, row_size * sizeof(T));
+      rowPass(pad.data(), ring.data() + (next % ring_rows) * row_size, row_size, wx, channels);
+    }
+    for (size_t k = 0; k < wy.size(); ++k) {
+      const size_t s = std::clamp<size_t>(y + k, ry, height - 1 + ry) - ry;
+      rows[k] = ring.data() + (s % ring_rows) * row_size;
+    }
+    columnPass(rows.data(), dst + y * row_size, row_size, wy);
+  }
+}
+
+}  // namespace
+
+std::vector<double> ppc::core::gaussianKernel(double sigma, int radius) {
+  if (!(sigma > 0.0) || std::isinf(sigma)) throw std::invalid_argument("gaussianKernel: sigma must be positive");
+  if (radius < -1) throw std::invalid_argument("gaussianKernel: radius must be -1 or non-negative");
+  const int r = radius == -1 ? static_cast<int>(std::ceil(3.0 * sigma)) : radius;
+  std::vector<double> kernel(2 * r + 1);
+  for (int x = -r; x <= r; ++x) kernel[x + r] = std::exp(-(x * x) / (2.0 * sigma * sigma));
+  const double sum = std::accumulate(kernel.begin(), kernel.end(), 0.0);
+  for (auto& w : kernel) w /= sum;
+  return kernel;
+}
+
+template <class T>
+void ppc::core::separableFilter(const T* src, T* dst, size_t width, size_t height, size_t channels,
+                                const std::vector<double>& kernel_x, const std::vector<double>& kernel_y,
+                                int threads) {
+  if (threads < 0) throw std::invalid_argument("separableFilter: threads must not be negative");
+  const auto wx = weightsOf<T>(kernel_x);
+  const auto wy = weightsOf<T>(kernel_y);
+  if (width == 0 || height == 0 || channels == 0) return;
+  int team = 1;
+#ifdef _OPENMP
+  if (width * height >= kParallelPixels && !omp_in_parallel()) team = threads == 0 ? omp_get_max_threads() : threads;
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(team)
+#endif
+  {
+    int t = 0;
+#ifdef _OPENMP
+#pragma omp single
+    team = omp_get_num_threads();
+    t = omp_get_thread_num();
+#endif
+    filterBand(src, dst, width, height, channels, wx, wy, height * t / team, height * (t + 1) / team);
+  }
+}
+
+template <class T>
+void ppc::core::separableFilterRows(const T* src, T* dst, size_t width, size_t height, size_t channels,
+                                    const std::vector<double>& kernel_x, const std::vector<double>& kernel_y,
+                                    size_t first_row, size_t last_row) {
+  if (first_row > last_row || last_row > height) throw std::out_of_range("separableFilterRows: rows out of range");
+  const auto wx = weightsOf<T>(kernel_x);
+  const auto wy = weightsOf<T>(kernel_y);
+  if (width == 0 || channels == 0) return;
+  filterBand(src, dst, width, height, channels, wx, wy, first_row, last_row);
+}
+
+template <class T>
+void ppc::core::gaussianBlur(const T* src, T* dst, size_t width, size_t height, size_t channels, double sigma,
+                             int radius, int threads) {
+  const auto kernel = gaussianKernel(sigma, radius);
+  separableFilter(src, dst, width, height, channels, kernel, kernel, threads);
+}
+
+template void ppc::core::separableFilter(const uint8_t*, uint8_t*, size_t, size_t, size_t, const std::vector<double>&,
+                                         const std::vector<double>&, int);
+template void ppc::core::separableFilter(const uint16_t*, uint16_t*, size_t, size_t, size_t,
+                                         const std::vector<double>&, const std::vector<double>&, int);
+template void ppc::core::separableFilter(const float*, float*, size_t, size_t, size_t, const std::vector<double>&,
+                                         const std::vector<double>&, int);
+template void ppc::core::separableFilter(const double*, double*, size_t, size_t, size_t, const std::vector<double>&,
+                                         const std::vector<double>&, int);
+
+template void ppc::core::separableFilterRows(const uint8_t*, uint8_t*, size_t, size_t, size_t,
+                                             const std::vector<double>&, const std::vector<double>&, size_t, size_t);
+template void ppc::core::separableFilterRows(const uint16_t*, uint16_t*, size_t, size_t, size_t,
+                                             const std::vector<double>&, const std::vector<double>&, size_t, size_t);
+template void ppc::core::separableFilterRows(const float*, float*, size_t, size_t, size_t, const std::vector<double>&,
+                                             const std::vector<double>&, size_t, size_t);
+template void ppc::core::separableFilterRows(const double*, double*, size_t, size_t, size_t,
+                                             const std::vector<double>&, const std::vector<double>&, size_t, size_t);
+
+template void ppc::core::gaussianBlur(const uint8_t*, uint8_t*, size_t, size_t, size_t, double, int, int);
+template void ppc::core::gaussianBlur(const uint16_t*, uint16_t*, size_t, size_t, size_t, double, int, int);
+template void ppc::core::gaussianBlur(const float*, float*, size_t, size_t, size_t, double, int, int);
+template void ppc::core::gaussianBlur(const double*, double*, size_t, size_t, size_t, double, int, int);
@@ -0,0 +1,45 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/image/include/sobel_edges.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+uint8_t truncatedLuma(double r, double g, double b) { return static_cast<uint8_t>(0.299 * r + 0.587 * g + 0.114 * b); }
+
+}  // namespace
+
+ppc::core::ImagePipeline ppc::core::sobelEdges(float level) {
+  ImagePipeline pipeline(3);
+  pipeline.add({3, 1, 0, 0, [](const float* const* rows, float* out, size_t pixels) {
+    const float* in = rows[0];
+    for (size_t i = 0; i < pixels; ++i) out[i] = truncatedLuma(in[3 * i], in[3 * i + 1], in[3 * i + 2]);
+  }});
+  // gx^2 + gy^2 is an integer below 2^24, exact in float, so its float sqrt reaches an integer level
+  // exactly when the integer sqrt of the per-pixel loops does
+  return pipeline.sobel().threshold(level);
+}
+
+void ppc::core::sobelEdgesWrappedBorders(const uint8_t* rgb, uint8_t* dst, size_t width, size_t height, float level) {
+  constexpr int kGx[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+  constexpr int kGy[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+  if (width == 0 || height == 0) return;
+  auto edge = [&](size_t i, size_t j) {
+    int gx = 0;
+    int gy = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        // i + dy and j + dx are -1 only as size_t, which the min sends to the last row or column
+        const size_t pixel = std::min(i + dy, height - 1) * width + std::min(j + dx, width - 1);
+        const uint8_t* p = rgb + pixel * 3;
+        const int value = truncatedLuma(p[0], p[1], p[2]);
+        gx += kGx[dy + 1][dx + 1] * value;
+        gy += kGy[dy + 1][dx + 1] * value;
+      }
+    }
+    dst[i * width + j] = std::sqrt(static_cast<double>(gx * gx + gy * gy)) >= level ? 255 : 0;
+  };
+  for (size_t j = 0; j < width; ++j) edge(0, j);
+  for (size_t i = 1; i < height; ++i) edge(i, 0);
+}
@@ -0,0 +1,87 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/io/include/mapped_file.hpp"
+
+namespace {
+
+std::string tempPath(const std::string &name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+void writeBytes(const std::string &path, const std::vector<uint8_t> &bytes) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+std::vector<uint8_t> readBytes(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+std::vector<uint8_t> pattern(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<uint8_t>(i * 7 + i / 251);
+  return bytes;
+}
+
+}  // namespace
+
+TEST(mapped_file_tests, maps_unaligned_ranges) {
+  const auto path = tempPath("ppc_mapped_file_read.bin");
+  const auto bytes = pattern(3 * 65536 + 123);
+  writeBytes(path, bytes);
+  for (uint64_t offset : {0ULL, 1ULL, 4095ULL, 4096ULL, 65537ULL}) {
+    const uint64_t length = bytes.size() - offset - 5;
+    ppc::core::MappedFile file(path, offset, length, false);
+    ASSERT_EQ(file.size(), length);
+    EXPECT_TRUE(std::equal(file.data(), file.data() + length, bytes.begin() + static_cast<ptrdiff_t>(offset)))
+        << offset;
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(mapped_file_tests, writes_reach_the_file) {
+  const auto path = tempPath("ppc_mapped_file_write.bin");
+  auto bytes = pattern(10000);
+  writeBytes(path, bytes);
+  {
+    ppc::core::MappedFile file(path, 5000, 100, true);
+    for (uint64_t i = 0; i < file.size(); ++i) file.data()[i] = 0xAB;
+  }
+  std::fill(bytes.begin() + 5000, bytes.begin() + 5100, 0xAB);
+  EXPECT_EQ(readBytes(path), bytes);
+  std::filesystem::remove(path);
+}
+
+TEST(mapped_file_tests, overlapping_views_share_the_file) {
+  const auto path = tempPath("ppc_mapped_file_shared.bin");
+  writeBytes(path, pattern(20000));
+  {
+    ppc::core::MappedFile writer(path, 100, 10000, true);
+    ppc::core::MappedFile reader(path, 5000, 10000, false);
+    writer.data()[6000] = 0x5A;
+    EXPECT_EQ(reader.data()[1100], 0x5A);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(mapped_file_tests, zero_length_maps_nothing) {
+  const auto path = tempPath("ppc_mapped_file_empty.bin");
+  writeBytes(path, {});
+  ppc::core::MappedFile file(path, 0, 0, false);
+  EXPECT_EQ(file.data(), nullptr);
+  EXPECT_EQ(file.size(), 0U);
+  std::filesystem::remove(path);
+}
+
+TEST(mapped_file_tests, missing_file_throws) {
+  EXPECT_THROW(ppc::core::MappedFile(tempPath("ppc_mapped_file_missing.bin"), 0, 16, false), std::runtime_error);
+}
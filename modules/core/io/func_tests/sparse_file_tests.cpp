@@ -0,0 +1,112 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/io/include/mapped_file.hpp"
+#include "core/io/include/sparse_file.hpp"
+
+namespace {
+
+std::string tempPath(const std::string &name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+// 3x4 matrix [[1, 0, 2, 0], [0, 0, 0, 0], [0, 3, 0, 4]]
+const std::vector<int> kRowPtr = {0, 2, 2, 4};
+const std::vector<int> kColIndex = {0, 2, 1, 3};
+const std::vector<double> kValues = {1.0, 2.0, 3.0, 4.0};
+
+std::string writeSample(const std::string &name) {
+  const auto path = tempPath(name);
+  ppc::core::writeSparseFile(path, ppc::core::SparseLayout::CRS, 3, 4, kRowPtr.data(), kColIndex.data(),
+                             kValues.data());
+  return path;
+}
+
+template <class T>
+void poke(const std::string &path, uint64_t offset, T value) {
+  ppc::core::MappedFile file(path, offset, sizeof(T), true);
+  *reinterpret_cast<T *>(file.data()) = value;
+}
+
+}  // namespace
+
+TEST(sparse_file_tests, crs_roundtrip) {
+  const auto path = writeSample("ppc_sparse_file_crs.spm");
+  {
+    ppc::core::SparseFile file(path);
+    EXPECT_EQ(file.layout(), ppc::core::SparseLayout::CRS);
+    EXPECT_EQ(file.header().n_rows, 3);
+    EXPECT_EQ(file.header().n_cols, 4);
+    ASSERT_EQ(file.header().nnz, 4);
+    EXPECT_EQ(std::vector<int64_t>(file.ptr(), file.ptr() + 4), (std::vector<int64_t>{0, 2, 2, 4}));
+    EXPECT_EQ(std::vector<int32_t>(file.index(), file.index() + 4), kColIndex);
+    EXPECT_EQ(std::vector<double>(file.values(), file.values() + 4), kValues);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_file_tests, ccs_roundtrip_uses_columns_as_major) {
+  // the same matrix by columns
+  const std::vector<int> col_ptr = {0, 1, 2, 3, 4};
+  const std::vector<int> row_index = {0, 2, 0, 2};
+  const std::vector<double> values = {1.0, 3.0, 2.0, 4.0};
+  const auto path = tempPath("ppc_sparse_file_ccs.spm");
+  ppc::core::writeSparseFile(path, ppc::core::SparseLayout::CCS, 3, 4, col_ptr.data(), row_index.data(),
+                             values.data());
+  {
+    ppc::core::SparseFile file(path);
+    EXPECT_EQ(file.layout(), ppc::core::SparseLayout::CCS);
+    EXPECT_EQ(file.header().nMajor(), 4);
+    EXPECT_EQ(std::vector<int64_t>(file.ptr(), file.ptr() + 5), (std::vector<int64_t>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(std::vector<int32_t>(file.index(), file.index() + 4), row_index);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_file_tests, rejects_foreign_and_truncated_files) {
+  const auto path = writeSample("ppc_sparse_file_bad_header.spm");
+  const uint64_t size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 1);
+  EXPECT_THROW(ppc::core::SparseFile{path}, std::runtime_error);
+  std::filesystem::resize_file(path, size);
+  poke<char>(path, 0, 'X');
+  EXPECT_THROW(ppc::core::readSparseFileHeader(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_file_tests, rejects_inconsistent_sizes) {
+  const auto path = writeSample("ppc_sparse_file_bad_sizes.spm");
+  const ppc::core::SparseFileHeader header = ppc::core::readSparseFileHeader(path);
+  poke<int64_t>(path, offsetof(ppc::core::SparseFileHeader, nnz), -1);
+  EXPECT_THROW(ppc::core::readSparseFileHeader(path), std::runtime_error);
+  poke<int64_t>(path, offsetof(ppc::core::SparseFileHeader, nnz), header.nnz);
+  poke<uint64_t>(path, offsetof(ppc::core::SparseFileHeader, values_offset), header.values_offset + 64);
+  EXPECT_THROW(ppc::core::readSparseFileHeader(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_file_tests, rejects_bad_pointers) {
+  const auto path = writeSample("ppc_sparse_file_bad_ptr.spm");
+  const ppc::core::SparseFileHeader header = ppc::core::readSparseFileHeader(path);
+  poke<int64_t>(path, header.ptr_offset + 2 * sizeof(int64_t), 1);
+  EXPECT_THROW(ppc::core::SparseFile{path}, std::runtime_error);
+  poke<int64_t>(path, header.ptr_offset + 2 * sizeof(int64_t), 2);
+  poke<int64_t>(path, header.ptr_offset + 3 * sizeof(int64_t), 3);
+  EXPECT_THROW(ppc::core::SparseFile{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_file_tests, rejects_index_out_of_range) {
+  const auto path = writeSample("ppc_sparse_file_bad_index.spm");
+  const ppc::core::SparseFileHeader header = ppc::core::readSparseFileHeader(path);
+  poke<int32_t>(path, header.index_offset + 3 * sizeof(int32_t), 4);
+  EXPECT_THROW(ppc::core::SparseFile{path}, std::runtime_error);
+  poke<int32_t>(path, header.index_offset + 3 * sizeof(int32_t), -1);
+  EXPECT_THROW(ppc::core::SparseFile{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
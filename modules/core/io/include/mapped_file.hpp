@@ -0,0 +1,39 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_MAPPED_FILE_HPP_
+#define MODULES_CORE_INCLUDE_MAPPED_FILE_HPP_
+
+#include <cstdint>
+#include <string>
+
+namespace ppc::core {
+
+// Maps the byte range [offset, offset + length) of an existing file into memory. The offset needs
+// no alignment; a zero length maps nothing and data() is null. Throws std::runtime_error when the
+// file cannot be opened or mapped. Writes through a writable mapping reach the file.
+class MappedFile {
+ public:
+  MappedFile(const std::string &path, uint64_t offset, uint64_t length, bool writable);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  [[nodiscard]] uint8_t *data() const { return ptr; }
+  [[nodiscard]] uint64_t size() const { return length; }
+
+ private:
+  uint8_t *view{};
+  uint8_t *ptr{};
+  uint64_t view_length{};
+  uint64_t length{};
+#ifdef _WIN32
+  void *file_handle{};
+  void *mapping_handle{};
+#else
+  int fd{-1};
+#endif
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_MAPPED_FILE_HPP_
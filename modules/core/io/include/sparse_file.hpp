@@ -0,0 +1,74 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SPARSE_FILE_HPP_
+#define MODULES_CORE_INCLUDE_SPARSE_FILE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "core/io/include/mapped_file.hpp"
+
+namespace ppc::core {
+
+enum class SparseLayout : uint32_t { CRS = 0, CCS = 1 };
+
+// Binary compressed sparse matrix: this 64-byte header, then ptr (int64, n_major + 1 entries),
+// index (int32, nnz entries) and values (double, nnz entries). n_major is n_rows for CRS and
+// n_cols for CCS. Every section starts on a 64-byte boundary, so the arrays, or any slice of
+// rows, can be used straight from a MappedFile.
+struct SparseFileHeader {
+  char magic[8];
+  uint32_t layout;
+  uint32_t reserved;
+  int64_t n_rows;
+  int64_t n_cols;
+  int64_t nnz;
+  uint64_t ptr_offset;
+  uint64_t index_offset;
+  uint64_t values_offset;
+
+  [[nodiscard]] int64_t nMajor() const { return layout == static_cast<uint32_t>(SparseLayout::CCS) ? n_cols : n_rows; }
+  [[nodiscard]] int64_t nMinor() const { return layout == static_cast<uint32_t>(SparseLayout::CCS) ? n_rows : n_cols; }
+  [[nodiscard]] uint64_t fileSize() const { return values_offset + nnz * sizeof(double); }
+};
+
+// Header with the magic and the section offsets for a matrix of this shape.
+SparseFileHeader makeSparseFileHeader(SparseLayout layout, int64_t n_rows, int64_t n_cols, int64_t nnz);
+
+// Creates (or truncates) the file at its full size and writes the header; the arrays are left for
+// the caller to fill through a writable MappedFile, e.g. one slice of rows at a time.
+void createSparseFile(const std::string &path, const SparseFileHeader &header);
+
+// Writes a whole matrix; ptr has n_major + 1 entries and ptr[n_major] is the number of nonzeros.
+void writeSparseFile(const std::string &path, SparseLayout layout, int64_t n_rows, int64_t n_cols, const int *ptr,
+                     const int *index, const double *values);
+
+// Reads and checks the header only: magic, layout, non-negative sizes, 32-bit indexable dimensions,
+// section offsets as makeSparseFileHeader lays them out and a file large enough to hold them.
+// Throws std::runtime_error naming the file.
+SparseFileHeader readSparseFileHeader(const std::string &path);
+
+// Maps a whole sparse file. On top of the header checks the constructor verifies that ptr starts
+// at 0, never decreases and ends at nnz, and that every index lies in [0, n_minor), so code that
+// walks the arrays needs no bounds checks of its own. Throws std::runtime_error naming the file.
+class SparseFile {
+ public:
+  explicit SparseFile(const std::string &path);
+
+  [[nodiscard]] const SparseFileHeader &header() const { return hdr; }
+  [[nodiscard]] SparseLayout layout() const { return static_cast<SparseLayout>(hdr.layout); }
+  [[nodiscard]] const int64_t *ptr() const { return reinterpret_cast<const int64_t *>(base() + hdr.ptr_offset); }
+  [[nodiscard]] const int32_t *index() const { return reinterpret_cast<const int32_t *>(base() + hdr.index_offset); }
+  [[nodiscard]] const double *values() const { return reinterpret_cast<const double *>(base() + hdr.values_offset); }
+
+ private:
+  [[nodiscard]] const uint8_t *base() const { return file->data(); }
+
+  SparseFileHeader hdr{};
+  std::unique_ptr<MappedFile> file;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SPARSE_FILE_HPP_
@@ -0,0 +1,81 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/io/include/mapped_file.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <stdexcept>
+
+namespace ppc::core {
+
+namespace {
+
+uint64_t mappingGranularity() {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwAllocationGranularity;
+#else
+  return static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const std::string &path, uint64_t offset, uint64_t length_, bool writable) : length(length_) {
+  if (length == 0) return;
+  uint64_t aligned_offset = offset / mappingGranularity() * mappingGranularity();
+  view_length = length + (offset - aligned_offset);
+#ifdef _WIN32
+  file_handle = CreateFileA(path.c_str(), GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+                            FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file_handle == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open " + path);
+  mapping_handle = CreateFileMappingA(file_handle, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_handle == nullptr) {
+    CloseHandle(file_handle);
+    throw std::runtime_error("Cannot map " + path);
+  }
+  view = static_cast<uint8_t *>(MapViewOfFile(mapping_handle, writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+                                              static_cast<DWORD>(aligned_offset >> 32),
+                                              static_cast<DWORD>(aligned_offset & 0xFFFFFFFFu), view_length));
+  if (view == nullptr) {
+    CloseHandle(mapping_handle);
+    CloseHandle(file_handle);
+    throw std::runtime_error("Cannot map " + path);
+  }
+#else
+  fd = open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Cannot open " + path);
+  void *addr = mmap(nullptr, view_length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd,
+                    static_cast<off_t>(aligned_offset));
+  if (addr == MAP_FAILED) {
+    close(fd);
+    throw std::runtime_error("Cannot map " + path);
+  }
+  view = static_cast<uint8_t *>(addr);
+  if (!writable) madvise(addr, view_length, MADV_SEQUENTIAL);
+#endif
+  ptr = view + (offset - aligned_offset);
+}
+
+MappedFile::~MappedFile() {
+  if (view == nullptr) return;
+#ifdef _WIN32
+  UnmapViewOfFile(view);
+  CloseHandle(mapping_handle);
+  CloseHandle(file_handle);
+#else
+  munmap(view, view_length);
+  close(fd);
+#endif
+}
+
+}  // namespace ppc::core
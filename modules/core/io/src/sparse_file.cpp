@@ -0,0 +1,98 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/io/include/sparse_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace ppc::core {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'P', 'M', 'A', 'T', 'R', 'X', '2'};
+constexpr uint64_t kSectionAlignment = 64;
+
+static_assert(sizeof(SparseFileHeader) == kSectionAlignment);
+
+uint64_t alignUp(uint64_t value) { return (value + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment; }
+
+}  // namespace
+
+SparseFileHeader makeSparseFileHeader(SparseLayout layout, int64_t n_rows, int64_t n_cols, int64_t nnz) {
+  SparseFileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.layout = static_cast<uint32_t>(layout);
+  header.n_rows = n_rows;
+  header.n_cols = n_cols;
+  header.nnz = nnz;
+  header.ptr_offset = alignUp(sizeof(SparseFileHeader));
+  header.index_offset = alignUp(header.ptr_offset + (header.nMajor() + 1) * sizeof(int64_t));
+  header.values_offset = alignUp(header.index_offset + nnz * sizeof(int32_t));
+  return header;
+}
+
+void createSparseFile(const std::string &path, const SparseFileHeader &header) {
+  { std::ofstream file(path, std::ios::binary | std::ios::trunc); }
+  std::filesystem::resize_file(path, header.fileSize());
+  MappedFile file(path, 0, sizeof(header), true);
+  std::memcpy(file.data(), &header, sizeof(header));
+}
+
+void writeSparseFile(const std::string &path, SparseLayout layout, int64_t n_rows, int64_t n_cols, const int *ptr,
+                     const int *index, const double *values) {
+  const int64_t n_major = layout == SparseLayout::CCS ? n_cols : n_rows;
+  const SparseFileHeader header = makeSparseFileHeader(layout, n_rows, n_cols, ptr[n_major]);
+  createSparseFile(path, header);
+  MappedFile file(path, 0, header.fileSize(), true);
+  std::copy(ptr, ptr + n_major + 1, reinterpret_cast<int64_t *>(file.data() + header.ptr_offset));
+  std::copy(index, index + header.nnz, reinterpret_cast<int32_t *>(file.data() + header.index_offset));
+  std::copy(values, values + header.nnz, reinterpret_cast<double *>(file.data() + header.values_offset));
+}
+
+SparseFileHeader readSparseFileHeader(const std::string &path) {
+  SparseFileHeader header{};
+  std::ifstream in(path, std::ios::binary);
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.layout > 1) {
+    throw std::runtime_error("Not a sparse matrix file: " + path);
+  }
+  // the bounds keep every offset computation below far from overflow
+  const auto file_size = static_cast<int64_t>(std::filesystem::file_size(path));
+  constexpr int64_t kMaxDimension = std::numeric_limits<int32_t>::max();
+  if (header.n_rows < 0 || header.n_rows > kMaxDimension || header.n_cols < 0 || header.n_cols > kMaxDimension ||
+      header.nnz < 0 || header.nnz > file_size) {
+    throw std::runtime_error("Bad sparse matrix sizes in " + path);
+  }
+  const SparseFileHeader expected =
+      makeSparseFileHeader(static_cast<SparseLayout>(header.layout), header.n_rows, header.n_cols, header.nnz);
+  if (header.ptr_offset != expected.ptr_offset || header.index_offset != expected.index_offset ||
+      header.values_offset != expected.values_offset) {
+    throw std::runtime_error("Bad sparse matrix section offsets in " + path);
+  }
+  if (static_cast<uint64_t>(file_size) < header.fileSize()) {
+    throw std::runtime_error("Truncated sparse matrix file: " + path);
+  }
+  return header;
+}
+
+SparseFile::SparseFile(const std::string &path) : hdr(readSparseFileHeader(path)) {
+  file = std::make_unique<MappedFile>(path, 0, hdr.fileSize(), false);
+  const int64_t *p = ptr();
+  const int64_t n_major = hdr.nMajor();
+  if (p[0] != 0 || p[n_major] != hdr.nnz) {
+    throw std::runtime_error("Sparse matrix pointers do not span the nonzeros in " + path);
+  }
+  for (int64_t i = 0; i < n_major; ++i) {
+    if (p[i + 1] < p[i]) throw std::runtime_error("Decreasing sparse matrix pointers in " + path);
+  }
+  const int32_t *idx = index();
+  const int64_t n_minor = hdr.nMinor();
+  if (std::any_of(idx, idx + hdr.nnz, [n_minor](int32_t j) { return j < 0 || j >= n_minor; })) {
+    throw std::runtime_error("Sparse matrix index out of range in " + path);
+  }
+}
+
+}  // namespace ppc::core
@@ -0,0 +1,93 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/sort_inputs.hpp"
+
+using ppc::core::makeSortInput;
+using ppc::core::SortInput;
+
+TEST(sort_inputs_tests, every_input_has_n_keys_and_a_distinct_name) {
+  std::set<std::string> names;
+  for (auto input : ppc::core::sortInputs()) {
+    names.insert(ppc::core::sortInputName(input));
+    ASSERT_EQ(makeSortInput<int32_t>(input, 1000).size(), 1000U);
+    ASSERT_EQ(makeSortInput<double>(input, 777).size(), 777U);
+    ASSERT_TRUE(makeSortInput<uint64_t>(input, 0).empty());
+  }
+  ASSERT_EQ(names.size(), ppc::core::sortInputs().size());
+}
+
+TEST(sort_inputs_tests, same_seed_gives_same_keys) {
+  ASSERT_EQ(makeSortInput<int64_t>(SortInput::kZipf, 5000, 7), makeSortInput<int64_t>(SortInput::kZipf, 5000, 7));
+  ASSERT_NE(makeSortInput<int64_t>(SortInput::kUniform, 5000, 7), makeSortInput<int64_t>(SortInput::kUniform, 5000, 8));
+}
+
+TEST(sort_inputs_tests, ordered_inputs) {
+  const auto sorted = makeSortInput<uint32_t>(SortInput::kSorted, 10000);
+  ASSERT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+  const auto reverse = makeSortInput<float>(SortInput::kReverse, 10000);
+  ASSERT_TRUE(std::is_sorted(reverse.begin(), reverse.end(), std::greater<>()));
+  const auto pipe = makeSortInput<int32_t>(SortInput::kOrganPipe, 10000);
+  ASSERT_TRUE(std::is_sorted(pipe.begin(), pipe.begin() + 5000));
+  ASSERT_TRUE(std::is_sorted(pipe.begin() + 5000, pipe.end(), std::greater<>()));
+}
+
+TEST(sort_inputs_tests, repeated_keys) {
+  const auto few = makeSortInput<int64_t>(SortInput::kFewUnique, 100000);
+  ASSERT_LE(std::set<int64_t>(few.begin(), few.end()).size(), 16U);
+  const auto equal = makeSortInput<double>(SortInput::kAllEqual, 1000);
+  ASSERT_TRUE(std::all_of(equal.begin(), equal.end(), [&](double key) { return key == equal[0]; }));
+
+  // the most frequent Zipf key takes about a seventh of the keys, and the rest are spread
+  auto zipf = makeSortInput<int32_t>(SortInput::kZipf, 100000);
+  std::sort(zipf.begin(), zipf.end());
+  size_t longest = 0;
+  for (auto first = zipf.begin(); first != zipf.end();) {
+    auto last = std::upper_bound(first, zipf.end(), *first);
+    longest = std::max<size_t>(longest, last - first);
+    first = last;
+  }
+  ASSERT_GT(longest, 10000U);
+  ASSERT_LT(longest, 18000U);
+  ASSERT_GT(std::set<int32_t>(zipf.begin(), zipf.end()).size(), 5000U);
+}
+
+TEST(sort_inputs_tests, normal_keys_have_negatives) {
+  const auto keys = makeSortInput<double>(SortInput::kNormal, 100000);
+  const auto negatives = std::count_if(keys.begin(), keys.end(), [](double key) { return key < 0.0; });
+  ASSERT_GT(negatives, 45000);
+  ASSERT_LT(negatives, 55000);
+  const auto ints = makeSortInput<int32_t>(SortInput::kNormal, 100000);
+  ASSERT_TRUE(std::any_of(ints.begin(), ints.end(), [](int32_t key) { return key < -1000000; }));
+}
+
+TEST(sort_inputs_tests, special_floating_point_values) {
+  const auto keys = makeSortInput<double>(SortInput::kSpecial, 100000);
+  size_t nan = 0;
+  size_t inf = 0;
+  size_t denormal = 0;
+  size_t negative_zero = 0;
+  for (double key : keys) {
+    nan += static_cast<size_t>(std::isnan(key));
+    inf += static_cast<size_t>(std::isinf(key));
+    denormal += static_cast<size_t>(std::fpclassify(key) == FP_SUBNORMAL);
+    negative_zero += static_cast<size_t>(key == 0.0 && std::signbit(key));
+  }
+  ASSERT_GT(nan, 10000U);
+  ASSERT_GT(inf, 10000U);
+  ASSERT_GT(denormal, 10000U);
+  ASSERT_GT(negative_zero, 4000U);
+
+  const auto ints = makeSortInput<int64_t>(SortInput::kSpecial, 10000);
+  ASSERT_NE(std::find(ints.begin(), ints.end(), std::numeric_limits<int64_t>::min()), ints.end());
+  ASSERT_NE(std::find(ints.begin(), ints.end(), std::numeric_limits<int64_t>::max()), ints.end());
+}
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -42,6 +43,11 @@ class Perf {
   void task_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<ppc::core::PerfResults>& perfResults);
   // Pint results for automation checkers
   static void print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  // Print throughput as name:type:items per second:bytes per second, where each of the
+  // perfAttr->num_running runs processed items items taking bytes bytes
+  static void print_throughput_statistic(const std::shared_ptr<PerfAttr>& perfAttr,
+                                         const std::shared_ptr<PerfResults>& perfResults, const std::string& name,
+                                         uint64_t items, uint64_t bytes);
 
  private:
   std::shared_ptr<Task> task;
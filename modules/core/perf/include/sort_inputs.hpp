@@ -0,0 +1,40 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SORT_INPUTS_HPP_
+#define MODULES_CORE_INCLUDE_SORT_INPUTS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+// Key distributions for sort benchmarks; uniform random keys alone hide most of what makes a
+// sort slow or wrong on real data.
+enum class SortInput {
+  kUniform,    // uniform over the whole range of the type ([-1e9, 1e9] for floating point)
+  kSorted,     // uniform keys in ascending order
+  kReverse,    // uniform keys in descending order
+  kFewUnique,  // 16 distinct uniform keys
+  kZipf,       // 2^16 distinct uniform keys drawn with Zipf weights 1 / rank^1.1
+  kOrganPipe,  // 0, 1, ..., n / 2 and back down
+  kAllEqual,   // one key repeated
+  kNormal,     // normal around 0 with negatives: sigma 1 for floating point, 10^6 for integers
+  kSpecial,    // floating point: denormals, NaN, +-inf and +-0 among normal keys;
+               // integers: the minimum, the maximum, 0 and -1 among uniform keys
+};
+
+// Every distribution, in the order of the enum.
+const std::vector<SortInput>& sortInputs();
+
+// Short lower-case name of the distribution for benchmark output, e.g. "few_unique".
+const char* sortInputName(SortInput input);
+
+// n keys of the distribution, the same for the same seed. Instantiated for int32_t, uint32_t,
+// int64_t, uint64_t, float and double.
+template <class T>
+std::vector<T> makeSortInput(SortInput input, size_t n, uint64_t seed = 1);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SORT_INPUTS_HPP_
@@ -91,3 +91,26 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
 }
+
+void ppc::core::Perf::print_throughput_statistic(const std::shared_ptr<PerfAttr>& perfAttr,
+                                                 const std::shared_ptr<PerfResults>& perfResults,
+                                                 const std::string& name, uint64_t items, uint64_t bytes) {
+  std::string type_test_name = "none";
+  if (perfResults->type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
+    type_test_name = "task_run";
+  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
+    type_test_name = "pipeline";
+  }
+
+  double items_per_sec = 0.0;
+  double bytes_per_sec = 0.0;
+  if (perfResults->time_sec > 0.0) {
+    const auto runs = static_cast<double>(perfAttr->num_running);
+    items_per_sec = static_cast<double>(items) * runs / perfResults->time_sec;
+    bytes_per_sec = static_cast<double>(bytes) * runs / perfResults->time_sec;
+  }
+
+  std::stringstream perf_res_str;
+  perf_res_str << std::scientific << std::setprecision(4) << items_per_sec << ":" << bytes_per_sec;
+  std::cout << name << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+}
@@ -0,0 +1,183 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/sort_inputs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+namespace {
+
+constexpr size_t kFewUnique = 16;
+constexpr size_t kZipfKeys = size_t{1} << 16;
+constexpr double kZipfExponent = 1.1;
+
+template <class T>
+T uniformKey(std::mt19937_64& gen) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<T>(std::uniform_real_distribution<double>(-1e9, 1e9)(gen));
+  } else {
+    return std::uniform_int_distribution<T>(std::numeric_limits<T>::min(), std::numeric_limits<T>::max())(gen);
+  }
+}
+
+template <class T>
+std::vector<T> uniformKeys(size_t n, std::mt19937_64& gen) {
+  std::vector<T> keys(n);
+  for (auto& key : keys) key = uniformKey<T>(gen);
+  return keys;
+}
+
+template <class T>
+T normalKey(std::mt19937_64& gen) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<T>(std::normal_distribution<double>(0.0, 1.0)(gen));
+  } else {
+    const auto offset = static_cast<int64_t>(std::llround(std::normal_distribution<double>(0.0, 1e6)(gen)));
+    // unsigned keys are centred in their range instead of wrapping around 0
+    constexpr auto kMiddle = std::is_signed_v<T> ? T{0} : static_cast<T>(std::numeric_limits<T>::max() / 2 + 1);
+    return static_cast<T>(kMiddle + static_cast<T>(offset));
+  }
+}
+
+template <class T>
+T specialKey(std::mt19937_64& gen) {
+  const uint64_t pick = gen();
+  if constexpr (std::is_floating_point_v<T>) {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr int kMantissaBits = std::numeric_limits<T>::digits - 1;
+    constexpr Bits kMantissa = (Bits{1} << kMantissaBits) - 1;
+    constexpr Bits kSign = Bits{1} << (sizeof(T) * 8 - 1);
+    constexpr Bits kExponent = ~kSign & ~kMantissa;
+    const Bits sign = (pick >> 8) % 2 == 0 ? 0 : kSign;
+    const auto random = static_cast<Bits>(gen());
+    Bits bits;
+    switch (pick % 8) {
+      case 0:  // denormal
+        bits = sign | std::max<Bits>(random & kMantissa, 1);
+        break;
+      case 1:  // quiet NaN with a payload
+        bits = sign | kExponent | (Bits{1} << (kMantissaBits - 1)) | (random & (kMantissa >> 1));
+        break;
+      case 2:  // infinity
+        bits = sign | kExponent;
+        break;
+      case 3:  // zero
+        bits = sign;
+        break;
+      default:
+        return normalKey<T>(gen);
+    }
+    T key;
+    std::memcpy(&key, &bits, sizeof(key));
+    return key;
+  } else {
+    switch (pick % 8) {
+      case 0:
+        return std::numeric_limits<T>::min();
+      case 1:
+        return std::numeric_limits<T>::max();
+      case 2:
+        return T{0};
+      case 3:
+        return static_cast<T>(-1);
+      default:
+        return uniformKey<T>(gen);
+    }
+  }
+}
+
+}  // namespace
+
+const std::vector<ppc::core::SortInput>& ppc::core::sortInputs() {
+  static const std::vector<SortInput> inputs = {
+      SortInput::kUniform,   SortInput::kSorted,   SortInput::kReverse, SortInput::kFewUnique, SortInput::kZipf,
+      SortInput::kOrganPipe, SortInput::kAllEqual, SortInput::kNormal,  SortInput::kSpecial};
+  return inputs;
+}
+
+const char* ppc::core::sortInputName(SortInput input) {
+  switch (input) {
+    case SortInput::kUniform:
+      return "uniform";
+    case SortInput::kSorted:
+      return "sorted";
+    case SortInput::kReverse:
+      return "reverse";
+    case SortInput::kFewUnique:
+      return "few_unique";
+    case SortInput::kZipf:
+      return "zipf";
+    case SortInput::kOrganPipe:
+      return "organ_pipe";
+    case SortInput::kAllEqual:
+      return "all_equal";
+    case SortInput::kNormal:
+      return "normal";
+    case SortInput::kSpecial:
+      return "special";
+  }
+  return "unknown";
+}
+
+template <class T>
+std::vector<T> ppc::core::makeSortInput(SortInput input, size_t n, uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<T> keys;
+  switch (input) {
+    case SortInput::kUniform:
+      return uniformKeys<T>(n, gen);
+    case SortInput::kSorted:
+    case SortInput::kReverse:
+      keys = uniformKeys<T>(n, gen);
+      std::sort(keys.begin(), keys.end());
+      if (input == SortInput::kReverse) std::reverse(keys.begin(), keys.end());
+      return keys;
+    case SortInput::kFewUnique: {
+      const auto values = uniformKeys<T>(kFewUnique, gen);
+      keys.resize(n);
+      for (auto& key : keys) key = values[gen() % kFewUnique];
+      return keys;
+    }
+    case SortInput::kZipf: {
+      const auto values = uniformKeys<T>(kZipfKeys, gen);
+      std::vector<double> weights(kZipfKeys);
+      double total = 0.0;
+      for (size_t rank = 0; rank < kZipfKeys; ++rank) {
+        total += 1.0 / std::pow(static_cast<double>(rank + 1), kZipfExponent);
+        weights[rank] = total;
+      }
+      std::uniform_real_distribution<double> dist(0.0, total);
+      keys.resize(n);
+      for (auto& key : keys) {
+        const size_t rank = std::upper_bound(weights.begin(), weights.end(), dist(gen)) - weights.begin();
+        key = values[std::min(rank, kZipfKeys - 1)];
+      }
+      return keys;
+    }
+    case SortInput::kOrganPipe:
+      keys.resize(n);
+      for (size_t i = 0; i < n; ++i) keys[i] = static_cast<T>(i < n / 2 ? i : n - 1 - i);
+      return keys;
+    case SortInput::kAllEqual:
+      return std::vector<T>(n, static_cast<T>(42));
+    case SortInput::kNormal:
+      keys.resize(n);
+      for (auto& key : keys) key = normalKey<T>(gen);
+      return keys;
+    case SortInput::kSpecial:
+      keys.resize(n);
+      for (auto& key : keys) key = specialKey<T>(gen);
+      return keys;
+  }
+  return keys;
+}
+
+template std::vector<int32_t> ppc::core::makeSortInput(SortInput, size_t, uint64_t);
+template std::vector<uint32_t> ppc::core::makeSortInput(SortInput, size_t, uint64_t);
+template std::vector<int64_t> ppc::core::makeSortInput(SortInput, size_t, uint64_t);
+template std::vector<uint64_t> ppc::core::makeSortInput(SortInput, size_t, uint64_t);
+template std::vector<float> ppc::core::makeSortInput(SortInput, size_t, uint64_t);
+template std::vector<double> ppc::core::makeSortInput(SortInput, size_t, uint64_t);
@@ -0,0 +1,169 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/sort/include/external_sort.hpp"
+#include "core/sort/include/radix_sort.hpp"
+
+namespace {
+
+constexpr size_t kBudget = size_t{1} << 20;
+
+// An input and an output file in the temp directory, removed at the end of the test.
+class ExternalSortFiles {
+ public:
+  explicit ExternalSortFiles(const std::string &name)
+      : input_(std::filesystem::temp_directory_path() / ("external_sort_" + name + ".in")),
+        output_(std::filesystem::temp_directory_path() / ("external_sort_" + name + ".out")) {}
+  ExternalSortFiles(const ExternalSortFiles &) = delete;
+  ExternalSortFiles &operator=(const ExternalSortFiles &) = delete;
+  ~ExternalSortFiles() {
+    std::error_code ignored;
+    std::filesystem::remove(input_, ignored);
+    std::filesystem::remove(output_, ignored);
+  }
+
+  [[nodiscard]] std::string input() const { return input_.string(); }
+  [[nodiscard]] std::string output() const { return output_.string(); }
+
+  template <class T>
+  void write(const std::vector<T> &keys) const {
+    std::ofstream out(input_, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(T)));
+  }
+
+  template <class T>
+  [[nodiscard]] std::vector<T> read() const {
+    std::vector<T> keys(std::filesystem::file_size(output_) / sizeof(T));
+    std::ifstream in(output_, std::ios::binary);
+    in.read(reinterpret_cast<char *>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(T)));
+    return keys;
+  }
+
+ private:
+  std::filesystem::path input_;
+  std::filesystem::path output_;
+};
+
+std::vector<int64_t> randomKeys(size_t n, int64_t range, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int64_t> dist(-range, range);
+  std::vector<int64_t> keys(n);
+  for (auto &key : keys) key = dist(gen);
+  return keys;
+}
+
+ppc::core::ExternalSortStats checkSort(const std::string &name, std::vector<int64_t> keys, int threads = 0) {
+  ExternalSortFiles files(name);
+  files.write(keys);
+  const auto stats = ppc::core::externalSort<int64_t>(files.input(), files.output(), kBudget, "", threads);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(files.read<int64_t>(), keys);
+  EXPECT_EQ(stats.bytes, keys.size() * sizeof(int64_t));
+  return stats;
+}
+
+}  // namespace
+
+TEST(external_sort_tests, input_within_budget_is_sorted_in_memory) {
+  const auto stats = checkSort("in_memory", randomKeys(30000, 1000000, 1));
+  EXPECT_EQ(stats.runs, 1U);
+  EXPECT_EQ(stats.merge_passes, 0U);
+  EXPECT_GT(stats.gigabytes_per_second, 0.0);
+  EXPECT_EQ(checkSort("empty", {}).runs, 0U);
+}
+
+TEST(external_sort_tests, runs_merged_in_one_pass) {
+  // runs of a third of the budget: 43690 keys, five runs and a short one
+  const auto stats = checkSort("one_pass", randomKeys(230000, int64_t{1} << 40, 2));
+  EXPECT_EQ(stats.runs, 6U);
+  EXPECT_EQ(stats.merge_passes, 1U);
+}
+
+TEST(external_sort_tests, many_runs_merged_in_several_passes) {
+  // 64 KiB blocks leave room for 6 runs per merge: 24 runs, then 4, then the output
+  const auto stats = checkSort("two_passes", randomKeys(24 * 43690, 1000, 3), 1);
+  EXPECT_EQ(stats.runs, 24U);
+  EXPECT_EQ(stats.merge_passes, 2U);
+}
+
+TEST(external_sort_tests, presorted_and_equal_keys) {
+  std::vector<int64_t> keys(200000);
+  for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int64_t>(keys.size() - i) / 7;
+  checkSort("reversed", keys);
+  checkSort("equal", std::vector<int64_t>(150000, -5));
+}
+
+TEST(external_sort_tests, parallel_matches_serial) {
+  for (int threads : {1, 2, 3}) {
+    checkSort("threads_" + std::to_string(threads), randomKeys(300000, int64_t{1} << 50, 4), threads);
+  }
+}
+
+TEST(external_sort_tests, floating_point_keys_follow_total_order) {
+  std::vector<double> keys(400000);
+  std::mt19937_64 gen(5);
+  std::normal_distribution<double> dist(0.0, 1.0);
+  for (auto &key : keys) key = dist(gen);
+  for (size_t i = 0; i < keys.size(); i += 1000) {
+    keys[i] = -0.0;
+    keys[i + 1] = 0.0;
+    keys[i + 2] = std::numeric_limits<double>::quiet_NaN();
+    keys[i + 3] = -std::numeric_limits<double>::infinity();
+  }
+  ExternalSortFiles files("doubles");
+  files.write(keys);
+  ppc::core::externalSort<double>(files.input(), files.output(), kBudget);
+  ppc::core::radixSort(keys);
+  const auto sorted = files.read<double>();
+  ASSERT_EQ(sorted.size(), keys.size());
+  EXPECT_EQ(std::memcmp(sorted.data(), keys.data(), keys.size() * sizeof(double)), 0);
+}
+
+TEST(external_sort_tests, thirty_two_bit_keys) {
+  std::vector<uint32_t> keys(500000);
+  std::mt19937 gen(6);
+  for (auto &key : keys) key = gen();
+  ExternalSortFiles files("uint32");
+  files.write(keys);
+  const auto stats = ppc::core::externalSort<uint32_t>(files.input(), files.output(), kBudget);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(files.read<uint32_t>(), keys);
+  EXPECT_GT(stats.runs, 1U);
+}
+
+TEST(external_sort_tests, output_may_be_the_input) {
+  // one run sorted in memory and six runs merged in one pass
+  for (size_t n : {30000U, 230000U}) {
+    ExternalSortFiles files("in_place");
+    auto keys = randomKeys(n, 1000000, 9);
+    files.write(keys);
+    ppc::core::externalSort<int64_t>(files.input(), files.input(), kBudget);
+    std::filesystem::rename(files.input(), files.output());
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(files.read<int64_t>(), keys) << n;
+  }
+}
+
+TEST(external_sort_tests, invalid_arguments_throw) {
+  ExternalSortFiles files("invalid");
+  files.write(std::vector<int32_t>{3, 1, 2});
+  EXPECT_THROW(ppc::core::externalSort<int32_t>(files.input(), files.output(), kBudget / 2), std::invalid_argument);
+  EXPECT_THROW(ppc::core::externalSort<int32_t>(files.input(), files.output(), kBudget, "", -1),
+               std::invalid_argument);
+  // 12 bytes are not a whole number of 8-byte keys
+  EXPECT_THROW(ppc::core::externalSort<int64_t>(files.input(), files.output(), kBudget), std::invalid_argument);
+  EXPECT_THROW(ppc::core::externalSort<int32_t>(files.input() + ".missing", files.output(), kBudget),
+               std::runtime_error);
+}
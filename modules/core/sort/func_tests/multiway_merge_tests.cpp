@@ -0,0 +1,113 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/sort/include/multiway_merge.hpp"
+
+namespace {
+
+std::vector<std::vector<int64_t>> sortedRuns(const std::vector<size_t> &sizes, int64_t range, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int64_t> dist(-range, range);
+  std::vector<std::vector<int64_t>> runs;
+  for (size_t size : sizes) {
+    std::vector<int64_t> run(size);
+    for (auto &key : run) key = dist(gen);
+    std::sort(run.begin(), run.end());
+    runs.push_back(std::move(run));
+  }
+  return runs;
+}
+
+template <class T>
+std::vector<std::span<const T>> spans(const std::vector<std::vector<T>> &runs) {
+  return {runs.begin(), runs.end()};
+}
+
+void checkMerge(const std::vector<size_t> &sizes, int64_t range, int threads = 0) {
+  const auto runs = sortedRuns(sizes, range, static_cast<unsigned>(sizes.size() * 31 + range));
+  std::vector<int64_t> expected;
+  for (const auto &run : runs) expected.insert(expected.end(), run.begin(), run.end());
+  std::sort(expected.begin(), expected.end());
+  std::vector<int64_t> out(expected.size());
+  ppc::core::multiwayMerge(spans(runs), out.data(), threads);
+  ASSERT_EQ(out, expected);
+}
+
+}  // namespace
+
+TEST(multiway_merge_tests, co_rank_splits_a_merge) {
+  const std::vector<int> a = {1, 3, 3, 5, 7};
+  const std::vector<int> b = {2, 3, 4, 8};
+  // merged: 1 2 3a 3a 3b 4 5 7 8, equal keys of a first
+  const std::vector<size_t> expected = {0, 1, 1, 2, 3, 3, 3, 4, 5, 5};
+  for (size_t k = 0; k <= a.size() + b.size(); ++k) {
+    EXPECT_EQ(ppc::core::coRank(k, a.data(), a.size(), b.data(), b.size()), expected[k]);
+  }
+}
+
+TEST(multiway_merge_tests, empty_and_single_runs) {
+  checkMerge({}, 10);
+  checkMerge({0, 0}, 10);
+  checkMerge({100}, 10);
+  checkMerge({0, 50, 0}, 10);
+}
+
+TEST(multiway_merge_tests, two_runs) { checkMerge({1000, 377}, 1000000); }
+
+TEST(multiway_merge_tests, many_runs_of_uneven_length) {
+  checkMerge({5, 1000, 1, 0, 333, 64, 2, 900, 17}, 1000000);
+  checkMerge({400, 400, 400, 400, 400}, 3);
+}
+
+TEST(multiway_merge_tests, above_parallel_threshold) {
+  checkMerge({100000, 30000, 70000, 1}, 1000000000);
+  checkMerge({50000, 50000, 50000}, 2, 3);
+}
+
+TEST(multiway_merge_tests, splits_give_exact_shares_with_duplicates) {
+  const auto runs = sortedRuns({300, 17, 250, 0, 99}, 4, 1);
+  const auto views = spans(runs);
+  std::vector<size_t> previous(runs.size(), 0);
+  for (size_t rank = 0; rank <= 666; rank += 37) {
+    const std::vector<size_t> split = ppc::core::multiwaySplit(views, rank);
+    size_t total = 0;
+    for (size_t i = 0; i < runs.size(); ++i) {
+      total += split[i];
+      ASSERT_GE(split[i], previous[i]);
+      // whatever precedes the split is not above whatever follows it in any run
+      for (size_t j = 0; j < runs.size(); ++j) {
+        if (split[i] > 0 && split[j] < runs[j].size()) {
+          ASSERT_LE(runs[i][split[i] - 1], runs[j][split[j]]);
+        }
+      }
+    }
+    ASSERT_EQ(total, rank);
+    previous = split;
+  }
+}
+
+TEST(multiway_merge_tests, stable_for_equal_keys) {
+  // -0.0 and +0.0 compare equal but keep their sign, which shows the run every zero came from
+  const std::vector<std::vector<double>> runs = {{-0.0, 1.0}, {0.0, 0.0}, {-0.0}, {-1.0, -0.0}};
+  std::vector<double> out(7);
+  ppc::core::multiwayMerge(spans(runs), out.data(), 1);
+  const std::vector<bool> negative = {true, true, false, false, true, true, false};
+  for (size_t i = 0; i < out.size(); ++i) EXPECT_EQ(std::signbit(out[i]), negative[i]) << i;
+  EXPECT_EQ(out.front(), -1.0);
+  EXPECT_EQ(out.back(), 1.0);
+}
+
+TEST(multiway_merge_tests, rejects_negative_threads) {
+  const std::vector<std::vector<float>> runs = {{1.0F}};
+  std::vector<float> out(1);
+  EXPECT_THROW(ppc::core::multiwayMerge(spans(runs), out.data(), -1), std::invalid_argument);
+}
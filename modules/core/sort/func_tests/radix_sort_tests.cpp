@@ -0,0 +1,200 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "core/sort/include/merge_sort.hpp"
+#include "core/sort/include/radix_sort.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> randomKeys(size_t n, T lo, T hi, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<T> keys(n);
+  if constexpr (std::is_floating_point_v<T>) {
+    std::uniform_real_distribution<T> dist(lo, hi);
+    for (auto &key : keys) key = dist(gen);
+  } else {
+    std::uniform_int_distribution<T> dist(lo, hi);
+    for (auto &key : keys) key = dist(gen);
+  }
+  return keys;
+}
+
+template <class T>
+void checkSorted(std::vector<T> keys, int digit_bits = 0, int threads = 0) {
+  std::vector<T> expected = keys;
+  std::sort(expected.begin(), expected.end());
+  ppc::core::radixSort(keys, digit_bits, threads);
+  ASSERT_EQ(keys, expected);
+}
+
+// keys are in order and equal keys keep the order of their positions, which is the payload
+template <class T, class V>
+void checkStablePairs(const std::vector<T> &input, const std::vector<T> &keys, const std::vector<V> &positions) {
+  ASSERT_EQ(keys.size(), input.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(keys[i], input[static_cast<size_t>(positions[i])]);
+    if (i > 0) {
+      ASSERT_FALSE(keys[i] < keys[i - 1]);
+      if (keys[i] == keys[i - 1]) {
+        ASSERT_LT(positions[i - 1], positions[i]);
+      }
+    }
+  }
+}
+
+// bit patterns, so -0.0 / +0.0 and NaNs are told apart
+std::vector<uint64_t> bitsOf(const std::vector<double> &keys) {
+  std::vector<uint64_t> bits(keys.size());
+  std::transform(keys.begin(), keys.end(), bits.begin(), [](double key) { return std::bit_cast<uint64_t>(key); });
+  return bits;
+}
+
+}  // namespace
+
+TEST(radix_sort_tests, empty_and_single_key) {
+  std::vector<int32_t> empty;
+  ppc::core::radixSort(empty);
+  EXPECT_TRUE(empty.empty());
+  std::vector<double> one = {-3.5};
+  ppc::core::radixSort(one);
+  EXPECT_EQ(one, std::vector<double>{-3.5});
+}
+
+TEST(radix_sort_tests, int32_with_negatives) {
+  checkSorted(randomKeys<int32_t>(1000, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(), 1));
+}
+
+TEST(radix_sort_tests, int64_with_negatives) {
+  checkSorted(randomKeys<int64_t>(5000, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), 2));
+}
+
+TEST(radix_sort_tests, unsigned_keys) {
+  checkSorted(randomKeys<uint32_t>(5000, 0, std::numeric_limits<uint32_t>::max(), 3));
+  checkSorted(randomKeys<uint64_t>(5000, 0, std::numeric_limits<uint64_t>::max(), 4));
+}
+
+TEST(radix_sort_tests, float_and_double_with_negatives) {
+  checkSorted(randomKeys<float>(5000, -1e6F, 1e6F, 5));
+  checkSorted(randomKeys<double>(5000, -1e300, 1e300, 6));
+}
+
+TEST(radix_sort_tests, every_digit_width) {
+  const std::vector<int64_t> keys = randomKeys<int64_t>(3000, -1000000000000, 1000000000000, 7);
+  for (int digit_bits : {1, 5, 8, 11, 13, 16}) checkSorted(keys, digit_bits);
+}
+
+TEST(radix_sort_tests, narrow_range_and_duplicates) {
+  checkSorted(randomKeys<int32_t>(10000, 1000000, 1000015, 8));
+  checkSorted(std::vector<double>(777, 2.5));
+}
+
+TEST(radix_sort_tests, above_parallel_threshold) {
+  checkSorted(randomKeys<int32_t>(300000, -50000, 50000, 9));
+  checkSorted(randomKeys<double>(300000, -1.0, 1.0, 10), 16);
+}
+
+TEST(radix_sort_tests, staged_scatter_beyond_cache) {
+  // 16 MB of keys and more go through the write-combining scatter, odd sizes leave partial lines
+  checkSorted(randomKeys<double>((size_t{1} << 21) + 3, -1e6, 1e6, 11));
+  checkSorted(randomKeys<int32_t>((size_t{1} << 22) + 5, std::numeric_limits<int32_t>::min(), 7, 12), 8);
+}
+
+TEST(radix_sort_tests, serial_when_asked) { checkSorted(randomKeys<int64_t>(200000, -5, 1000000, 13), 0, 1); }
+
+TEST(radix_sort_tests, caller_scratch) {
+  // sorting consecutive slices with the matching slices of one buffer, as a bucketed sort does
+  std::vector<double> keys = randomKeys<double>(90001, -1e3, 1e3, 14);
+  std::vector<double> expected = keys;
+  std::vector<double> scratch(keys.size());
+  const std::vector<size_t> bounds = {0, 1, 40000, 40007, keys.size()};
+  for (size_t b = 0; b + 1 < bounds.size(); ++b) {
+    ppc::core::radixSort(keys.data() + bounds[b], bounds[b + 1] - bounds[b], scratch.data() + bounds[b]);
+    std::sort(expected.data() + bounds[b], expected.data() + bounds[b + 1]);
+  }
+  EXPECT_EQ(keys, expected);
+  EXPECT_THROW(ppc::core::radixSort(keys.data(), keys.size(), static_cast<double *>(nullptr)), std::invalid_argument);
+}
+
+TEST(radix_sort_tests, ieee_total_order) {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double denormal = std::numeric_limits<double>::denorm_min();
+  std::vector<double> keys = {nan, 1.0, -0.0, -nan, inf, 0.0, -denormal, -inf, denormal, -1.0};
+  const std::vector<double> expected = {-nan, -inf, -1.0, -denormal, -0.0, 0.0, denormal, 1.0, inf, nan};
+  ppc::core::radixSort(keys);
+  EXPECT_EQ(bitsOf(keys), bitsOf(expected));
+}
+
+TEST(radix_sort_tests, rejects_digit_width) {
+  std::vector<float> keys = {2.0F, 1.0F};
+  EXPECT_THROW(ppc::core::radixSort(keys, 17), std::invalid_argument);
+  EXPECT_THROW(ppc::core::radixSort(keys, -1), std::invalid_argument);
+  EXPECT_THROW(ppc::core::radixSort(keys, 8, -2), std::invalid_argument);
+}
+
+TEST(radix_sort_tests, pairs_are_stable) {
+  const std::vector<int32_t> input = randomKeys<int32_t>(200000, -300, 300, 14);
+  std::vector<int32_t> keys = input;
+  std::vector<uint64_t> positions(input.size());
+  for (size_t i = 0; i < positions.size(); ++i) positions[i] = i;
+  ppc::core::radixSortPairs(keys, positions);
+  checkStablePairs(input, keys, positions);
+
+  const std::vector<double> doubles = randomKeys<double>(3001, -4.0, 4.0, 15);
+  std::vector<double> rounded(doubles.size());
+  // half-integers: repeated keys, but no -0.0 / +0.0 that compare equal and still get ordered
+  std::transform(doubles.begin(), doubles.end(), rounded.begin(), [](double key) { return std::floor(key) + 0.5; });
+  std::vector<double> double_keys = rounded;
+  std::vector<float> tags(rounded.size());
+  for (size_t i = 0; i < tags.size(); ++i) tags[i] = static_cast<float>(i);
+  ppc::core::radixSortPairs(double_keys, tags, 5, 1);
+  checkStablePairs(rounded, double_keys, tags);
+}
+
+TEST(radix_sort_tests, argsort) {
+  const std::vector<int64_t> keys = randomKeys<int64_t>(100000, -1000, 1000, 16);
+  const std::vector<uint32_t> index = ppc::core::radixArgsort(keys);
+  std::vector<uint32_t> expected(keys.size());
+  for (size_t i = 0; i < expected.size(); ++i) expected[i] = static_cast<uint32_t>(i);
+  std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+  EXPECT_EQ(index, expected);
+  EXPECT_TRUE(ppc::core::radixArgsort(std::vector<float>{}).empty());
+}
+
+TEST(radix_sort_tests, rejects_payload_width) {
+  std::vector<int32_t> keys = {2, 1};
+  std::vector<uint16_t> values = {0, 1};
+  EXPECT_THROW(ppc::core::radixSortPayload(keys.data(), values.data(), sizeof(uint16_t), keys.size()),
+               std::invalid_argument);
+}
+
+TEST(radix_sort_tests, merge_sort_pairs_with_comparator) {
+  const std::vector<int32_t> input = randomKeys<int32_t>(5000, 0, 50, 17);
+  std::vector<int32_t> keys = input;
+  std::vector<int32_t> positions(input.size());
+  for (size_t i = 0; i < positions.size(); ++i) positions[i] = static_cast<int32_t>(i);
+  ppc::core::mergeSortPairs(keys, positions, std::greater<>());
+  std::vector<int32_t> negated_input(input.size());
+  std::vector<int32_t> negated(keys.size());
+  std::transform(input.begin(), input.end(), negated_input.begin(), std::negate<>());
+  std::transform(keys.begin(), keys.end(), negated.begin(), std::negate<>());
+  checkStablePairs(negated_input, negated, positions);
+
+  const std::vector<double> doubles = randomKeys<double>(777, -1.0, 1.0, 18);
+  std::vector<uint32_t> expected(doubles.size());
+  for (size_t i = 0; i < expected.size(); ++i) expected[i] = static_cast<uint32_t>(i);
+  std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return doubles[a] < doubles[b]; });
+  EXPECT_EQ(ppc::core::mergeArgsort(doubles), expected);
+}
@@ -0,0 +1,119 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/sort/include/sample_sort.hpp"
+
+namespace {
+
+std::vector<int64_t> randomKeys(size_t n, int64_t range, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int64_t> dist(-range, range);
+  std::vector<int64_t> keys(n);
+  for (auto &key : keys) key = dist(gen);
+  return keys;
+}
+
+void checkSort(std::vector<int64_t> keys, int threads = 0) {
+  auto expected = keys;
+  std::sort(expected.begin(), expected.end());
+  ppc::core::sampleSort(keys, std::less<>(), threads);
+  ASSERT_EQ(keys, expected);
+}
+
+}  // namespace
+
+TEST(sample_sort_tests, short_inputs) {
+  checkSort({});
+  checkSort({5});
+  checkSort(randomKeys(1000, 100, 1));
+  checkSort(randomKeys(1025, 1000000, 2));
+}
+
+TEST(sample_sort_tests, sizes_off_the_block_grid) {
+  // the last block of the input is partial and one bucket block goes to the overflow buffer
+  for (size_t n : {3001, 40961, 100003}) {
+    checkSort(randomKeys(n, int64_t{1} << 40, static_cast<unsigned>(n)), 1);
+  }
+}
+
+TEST(sample_sort_tests, few_distinct_keys_use_equal_buckets) {
+  checkSort(randomKeys(200000, 3, 3));
+  checkSort(std::vector<int64_t>(100000, 7));
+  auto keys = randomKeys(150000, 1 << 20, 4);
+  for (size_t i = 0; i < keys.size(); i += 3) keys[i] = 42;
+  checkSort(keys);
+}
+
+TEST(sample_sort_tests, presorted_inputs) {
+  std::vector<int64_t> keys(300000);
+  for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int64_t>(i / 5);
+  checkSort(keys);
+  std::reverse(keys.begin(), keys.end());
+  checkSort(keys);
+  // one inversion is enough to take the samplesort path
+  std::reverse(keys.begin(), keys.end());
+  std::swap(keys[1000], keys[250000]);
+  checkSort(keys, 1);
+  checkSort(keys);
+}
+
+TEST(sample_sort_tests, parallel_matches_serial) {
+  for (int threads : {0, 2, 3, 4}) {
+    checkSort(randomKeys(1 << 18, int64_t{1} << 50, 5), threads);
+    checkSort(randomKeys((1 << 17) + 77, 1000, 6), threads);
+  }
+}
+
+TEST(sample_sort_tests, custom_comparator) {
+  auto keys = randomKeys(100000, 1 << 30, 7);
+  auto expected = keys;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  ppc::core::sampleSort(keys, std::greater<>());
+  ASSERT_EQ(keys, expected);
+
+  // a comparator that sees only part of the key: equal keys may come out in any order
+  std::vector<uint32_t> values(200000);
+  std::mt19937 gen(8);
+  for (auto &value : values) value = gen();
+  auto by_low_byte = [](uint32_t a, uint32_t b) { return (a & 0xFF) < (b & 0xFF); };
+  auto sorted = values;
+  ppc::core::sampleSort(sorted, by_low_byte, 3);
+  ASSERT_TRUE(std::is_sorted(sorted.begin(), sorted.end(), by_low_byte));
+  std::sort(values.begin(), values.end());
+  std::sort(sorted.begin(), sorted.end());
+  ASSERT_EQ(sorted, values);
+}
+
+TEST(sample_sort_tests, non_trivial_keys) {
+  std::vector<std::string> words(70000);
+  std::mt19937 gen(9);
+  for (auto &word : words) word = "key" + std::to_string(gen() % 50000);
+  auto expected = words;
+  std::sort(expected.begin(), expected.end());
+  ppc::core::sampleSort(words);
+  ASSERT_EQ(words, expected);
+}
+
+TEST(sample_sort_tests, floating_point_keys) {
+  std::vector<double> keys(1 << 17);
+  std::mt19937_64 gen(10);
+  std::normal_distribution<double> dist(0.0, 1e3);
+  for (auto &key : keys) key = dist(gen);
+  auto expected = keys;
+  std::sort(expected.begin(), expected.end());
+  ppc::core::sampleSort(keys);
+  ASSERT_EQ(keys, expected);
+}
+
+TEST(sample_sort_tests, negative_threads_throw) {
+  std::vector<int> keys = {3, 1, 2};
+  EXPECT_THROW(ppc::core::sampleSort(keys, std::less<>(), -1), std::invalid_argument);
+}
@@ -0,0 +1,155 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/sort/include/radix_sort.hpp"
+#include "core/sort/include/selection.hpp"
+
+namespace {
+
+std::vector<int64_t> randomKeys(size_t n, int64_t range, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int64_t> dist(-range, range);
+  std::vector<int64_t> keys(n);
+  for (auto &key : keys) key = dist(gen);
+  return keys;
+}
+
+void checkNthElement(std::vector<int64_t> keys, size_t nth, int threads = 0) {
+  auto sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+  ppc::core::nthElement(keys, nth, threads);
+  ASSERT_EQ(keys[nth], sorted[nth]);
+  ASSERT_TRUE(std::all_of(keys.begin(), keys.begin() + nth, [&](int64_t key) { return key <= sorted[nth]; }));
+  ASSERT_TRUE(std::all_of(keys.begin() + nth, keys.end(), [&](int64_t key) { return key >= sorted[nth]; }));
+  std::sort(keys.begin(), keys.end());
+  ASSERT_EQ(keys, sorted);
+}
+
+}  // namespace
+
+TEST(selection_tests, radix_select_matches_sorted_ranks) {
+  for (int64_t range : {int64_t{3}, int64_t{1000}, int64_t{1} << 40}) {
+    const auto keys = randomKeys(100003, range, static_cast<unsigned>(range % 1000));
+    auto sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t rank : {size_t{0}, size_t{1}, size_t{777}, keys.size() / 2, keys.size() - 1}) {
+      ASSERT_EQ(ppc::core::radixSelect(keys, rank), sorted[rank]);
+      ASSERT_EQ(ppc::core::radixSelect(keys, rank, 1), sorted[rank]);
+    }
+  }
+  ASSERT_EQ(ppc::core::radixSelect(std::vector<int32_t>(1000, 9), 500), 9);
+  ASSERT_EQ(ppc::core::radixSelect(std::vector<uint32_t>{7}, 0), 7U);
+}
+
+TEST(selection_tests, skewed_keys_are_narrowed_digit_by_digit) {
+  // one far outlier puts every other key into the lowest bucket of the first digit
+  auto keys = randomKeys(200000, 1 << 20, 3);
+  keys[777] = int64_t{1} << 61;
+  auto sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t rank : {size_t{0}, size_t{4321}, keys.size() / 2, keys.size() - 2, keys.size() - 1}) {
+    ASSERT_EQ(ppc::core::radixSelect(keys, rank), sorted[rank]);
+    ASSERT_EQ(ppc::core::radixSelect(keys, rank, 1), sorted[rank]);
+  }
+  const auto q = ppc::core::quantiles(keys, {0.1, 0.5, 0.5, 0.9, 1.0});
+  const size_t last = keys.size() - 1;
+  ASSERT_EQ(q, (std::vector<int64_t>{sorted[static_cast<size_t>(std::llround(0.1 * last))], sorted[last / 2 + 1],
+                                     sorted[last / 2 + 1], sorted[static_cast<size_t>(std::llround(0.9 * last))],
+                                     sorted[last]}));
+}
+
+TEST(selection_tests, quantiles_use_nearest_rank) {
+  std::vector<int32_t> keys(1001);
+  for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int32_t>((i * 7919) % keys.size());
+  const auto q = ppc::core::quantiles(keys, {0.0, 0.25, 0.5, 0.999, 1.0, 0.5});
+  ASSERT_EQ(q, (std::vector<int32_t>{0, 250, 500, 999, 1000, 500}));
+
+  const auto wide = randomKeys(1 << 18, int64_t{1} << 60, 1);
+  auto sorted = wide;
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<double> levels;
+  for (int i = 0; i <= 100; ++i) levels.push_back(i / 100.0);
+  const auto percentiles = ppc::core::quantiles(wide, levels, 3);
+  for (size_t i = 0; i < levels.size(); ++i) {
+    ASSERT_EQ(percentiles[i], sorted[static_cast<size_t>(std::llround(levels[i] * (wide.size() - 1)))]);
+  }
+}
+
+TEST(selection_tests, top_k_for_heap_and_select_paths) {
+  const auto keys = randomKeys(300000, 1 << 20, 2);
+  auto sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t k : {size_t{1}, size_t{10}, size_t{1024}, size_t{1025}, size_t{50000}, keys.size()}) {
+    for (int threads : {1, 3}) {
+      const auto top = ppc::core::topK(keys, k, threads);
+      ASSERT_EQ(top, std::vector<int64_t>(sorted.begin(), sorted.begin() + k));
+    }
+  }
+  ASSERT_TRUE(ppc::core::topK(keys, 0).empty());
+  ASSERT_EQ(ppc::core::topK(std::vector<int64_t>{4, 2}, 5), (std::vector<int64_t>{2, 4}));
+  // ties at the k-th key are made up by copies of it
+  const auto few = randomKeys(200000, 2, 3);
+  auto few_sorted = few;
+  std::sort(few_sorted.begin(), few_sorted.end());
+  ASSERT_EQ(ppc::core::topK(few, 100000), std::vector<int64_t>(few_sorted.begin(), few_sorted.begin() + 100000));
+}
+
+TEST(selection_tests, nth_element_partitions_around_the_rank) {
+  const auto keys = randomKeys(200000, 1 << 30, 4);
+  for (size_t nth : {size_t{0}, size_t{12345}, keys.size() / 2, keys.size() - 1}) {
+    checkNthElement(keys, nth);
+    checkNthElement(keys, nth, 1);
+  }
+  checkNthElement(randomKeys(150001, 5, 5), 75000, 3);
+  checkNthElement({5, 1, 4}, 1);
+}
+
+TEST(selection_tests, partial_sort_sorts_the_smallest_keys) {
+  const auto keys = randomKeys(250000, int64_t{1} << 50, 6);
+  auto sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t k : {size_t{0}, size_t{1}, size_t{1000}, size_t{100000}, keys.size(), keys.size() + 10}) {
+    auto partial = keys;
+    ppc::core::partialSort(partial, k);
+    const size_t m = std::min(k, keys.size());
+    ASSERT_TRUE(std::equal(partial.begin(), partial.begin() + m, sorted.begin()));
+    std::sort(partial.begin(), partial.end());
+    ASSERT_EQ(partial, sorted);
+  }
+}
+
+TEST(selection_tests, floating_point_keys_follow_total_order) {
+  std::vector<double> keys(100000);
+  std::mt19937_64 gen(7);
+  std::normal_distribution<double> dist(0.0, 1.0);
+  for (auto &key : keys) key = dist(gen);
+  keys[10] = -0.0;
+  keys[20] = 0.0;
+  keys[30] = std::numeric_limits<double>::quiet_NaN();
+  keys[40] = -std::numeric_limits<double>::infinity();
+  auto sorted = keys;
+  ppc::core::radixSort(sorted);
+  const auto top = ppc::core::topK(keys, 2000);
+  for (size_t i = 0; i < top.size(); ++i) ASSERT_EQ(top[i], sorted[i]);
+  ASSERT_TRUE(std::isnan(ppc::core::radixSelect(keys, keys.size() - 1)));
+  const size_t zero = std::find(sorted.begin(), sorted.end(), 0.0) - sorted.begin();
+  ASSERT_TRUE(std::signbit(ppc::core::radixSelect(keys, zero)));
+  ASSERT_FALSE(std::signbit(ppc::core::radixSelect(keys, zero + 1)));
+}
+
+TEST(selection_tests, invalid_arguments_throw) {
+  std::vector<int32_t> keys = {3, 1, 2};
+  EXPECT_THROW(ppc::core::radixSelect(keys, 3), std::out_of_range);
+  EXPECT_THROW(ppc::core::nthElement(keys, 5), std::out_of_range);
+  EXPECT_THROW(ppc::core::quantiles(keys, {1.5}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::quantiles(std::vector<int32_t>{}, {0.5}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::topK(keys, 2, -1), std::invalid_argument);
+}
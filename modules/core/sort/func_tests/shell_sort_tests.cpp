@@ -0,0 +1,98 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/sort/include/shell_sort.hpp"
+
+namespace {
+
+std::vector<int32_t> randomKeys(size_t n, int32_t range, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int32_t> dist(-range, range);
+  std::vector<int32_t> keys(n);
+  for (auto &key : keys) key = dist(gen);
+  return keys;
+}
+
+void checkSort(std::vector<int32_t> keys, ppc::core::ShellGaps gaps = ppc::core::ShellGaps::kCiura,
+               int threads = 0) {
+  auto expected = keys;
+  std::sort(expected.begin(), expected.end());
+  ppc::core::shellSort(keys, gaps, threads);
+  ASSERT_EQ(keys, expected);
+}
+
+}  // namespace
+
+TEST(shell_sort_tests, gap_sequences) {
+  using ppc::core::ShellGaps;
+  EXPECT_EQ(ppc::core::shellGaps(1000), (std::vector<size_t>{701, 301, 132, 57, 23, 10, 4, 1}));
+  EXPECT_EQ(ppc::core::shellGaps(5000), (std::vector<size_t>{3937, 1750, 701, 301, 132, 57, 23, 10, 4, 1}));
+  EXPECT_EQ(ppc::core::shellGaps(600, ShellGaps::kTokuda), (std::vector<size_t>{525, 233, 103, 46, 20, 9, 4, 1}));
+  EXPECT_EQ(ppc::core::shellGaps(1100, ShellGaps::kSedgewick), (std::vector<size_t>{1073, 281, 77, 23, 8, 1}));
+  EXPECT_EQ(ppc::core::shellGaps(20, ShellGaps::kHalving), (std::vector<size_t>{10, 5, 2, 1}));
+  EXPECT_TRUE(ppc::core::shellGaps(1).empty());
+  EXPECT_EQ(ppc::core::shellGaps(2), (std::vector<size_t>{1}));
+}
+
+TEST(shell_sort_tests, every_sequence_sorts) {
+  using ppc::core::ShellGaps;
+  for (auto gaps : {ShellGaps::kCiura, ShellGaps::kTokuda, ShellGaps::kSedgewick, ShellGaps::kHalving}) {
+    for (size_t n : {0, 1, 2, 7, 8, 9, 100, 1013, 40000}) {
+      checkSort(randomKeys(n, 1 << 30, static_cast<unsigned>(n)), gaps, 1);
+    }
+  }
+}
+
+TEST(shell_sort_tests, duplicates_and_extremes) {
+  checkSort(randomKeys(30000, 2, 1), ppc::core::ShellGaps::kCiura, 1);
+  auto keys = randomKeys(30000, 1 << 30, 2);
+  for (size_t i = 0; i < keys.size(); i += 7) keys[i] = (i % 2 == 0) ? INT32_MIN : INT32_MAX;
+  checkSort(keys, ppc::core::ShellGaps::kCiura, 1);
+}
+
+TEST(shell_sort_tests, presorted_inputs) {
+  std::vector<int32_t> keys(100000);
+  for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int32_t>(i / 3);
+  checkSort(keys, ppc::core::ShellGaps::kCiura, 1);
+  std::reverse(keys.begin(), keys.end());
+  checkSort(keys, ppc::core::ShellGaps::kCiura, 1);
+
+  // a few sorted runs go to the k-way merge
+  auto runs = randomKeys(100000, 1 << 20, 3);
+  for (size_t first = 0; first < runs.size(); first += 10000) {
+    std::sort(runs.begin() + static_cast<ptrdiff_t>(first), runs.begin() + static_cast<ptrdiff_t>(first + 10000));
+  }
+  checkSort(runs, ppc::core::ShellGaps::kCiura, 1);
+
+  // keys displaced by a few positions go to insertion sort
+  std::mt19937 gen(4);
+  for (size_t i = 0; i + 5 < keys.size(); i += 50) std::swap(keys[i], keys[i + gen() % 5]);
+  checkSort(keys, ppc::core::ShellGaps::kCiura, 1);
+
+  // two interleaved sorted sequences have few descents but too many inversions for insertion sort
+  std::vector<int32_t> zipped(100000);
+  for (size_t i = 0; i < zipped.size(); ++i) zipped[i] = static_cast<int32_t>(i % 2 == 0 ? i : zipped.size() - i);
+  std::sort(zipped.begin(), zipped.begin() + 50000);
+  checkSort(zipped, ppc::core::ShellGaps::kCiura, 1);
+}
+
+TEST(shell_sort_tests, parallel_matches_serial) {
+  for (int threads : {0, 2, 3, 4}) {
+    checkSort(randomKeys(1 << 18, 1 << 30, 5), ppc::core::ShellGaps::kCiura, threads);
+    checkSort(randomKeys((1 << 17) + 5, 100, 6), ppc::core::ShellGaps::kTokuda, threads);
+  }
+  std::vector<int32_t> sorted(1 << 17);
+  for (size_t i = 0; i < sorted.size(); ++i) sorted[i] = static_cast<int32_t>(i);
+  checkSort(sorted, ppc::core::ShellGaps::kCiura, 4);
+}
+
+TEST(shell_sort_tests, negative_threads_throw) {
+  std::vector<int32_t> keys = {3, 1, 2};
+  EXPECT_THROW(ppc::core::shellSort(keys, ppc::core::ShellGaps::kCiura, -1), std::invalid_argument);
+}
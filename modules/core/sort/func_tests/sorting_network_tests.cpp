@@ -0,0 +1,89 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/sort/include/sorting_network.hpp"
+
+namespace {
+
+std::vector<int32_t> randomKeys(size_t n, int32_t lo, int32_t hi, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int32_t> dist(lo, hi);
+  std::vector<int32_t> keys(n);
+  for (auto &key : keys) key = dist(gen);
+  return keys;
+}
+
+void checkSorted(std::vector<int32_t> keys, int threads = 0) {
+  std::vector<int32_t> expected = keys;
+  std::sort(expected.begin(), expected.end());
+  ppc::core::networkSort(keys, threads);
+  ASSERT_EQ(keys, expected);
+}
+
+void checkMerge(std::vector<int32_t> a, std::vector<int32_t> b) {
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  std::vector<int32_t> expected(a.size() + b.size());
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+  ASSERT_EQ(ppc::core::networkMerge(a, b), expected);
+}
+
+}  // namespace
+
+TEST(sorting_network_tests, empty_and_short) {
+  checkSorted({});
+  checkSorted({5});
+  checkSorted({3, -1, 2});
+  checkSorted(randomKeys(8, -5, 5, 1));
+}
+
+TEST(sorting_network_tests, every_size_around_blocks) {
+  for (size_t n = 9; n <= 300; ++n) checkSorted(randomKeys(n, -1000, 1000, static_cast<unsigned>(n)));
+}
+
+TEST(sorting_network_tests, extreme_keys_and_duplicates) {
+  const int32_t min = std::numeric_limits<int32_t>::min();
+  const int32_t max = std::numeric_limits<int32_t>::max();
+  checkSorted(randomKeys(5000, min, max, 2));
+  checkSorted(randomKeys(5000, 0, 3, 3));
+  checkSorted(std::vector<int32_t>(1000, max));
+}
+
+TEST(sorting_network_tests, presorted_inputs) {
+  std::vector<int32_t> keys = randomKeys(10007, -100000, 100000, 4);
+  std::sort(keys.begin(), keys.end());
+  checkSorted(keys);
+  std::reverse(keys.begin(), keys.end());
+  checkSorted(keys);
+}
+
+TEST(sorting_network_tests, above_parallel_threshold) {
+  checkSorted(randomKeys(300001, -50000, 50000, 5));
+  checkSorted(randomKeys(200000, -7, 7, 6), 1);
+}
+
+TEST(sorting_network_tests, merge_runs_of_any_length) {
+  for (size_t na : {0, 1, 7, 8, 15, 16, 17, 33, 100}) {
+    for (size_t nb : {0, 1, 8, 16, 31, 64, 1000}) checkMerge(randomKeys(na, -50, 50, 7), randomKeys(nb, -50, 50, 8));
+  }
+}
+
+TEST(sorting_network_tests, merge_disjoint_runs) {
+  // one run is drained before the other is touched
+  std::vector<int32_t> low = randomKeys(1003, 0, 1000, 9);
+  std::vector<int32_t> high = randomKeys(517, 2000, 3000, 10);
+  checkMerge(low, high);
+  checkMerge(high, low);
+}
+
+TEST(sorting_network_tests, rejects_negative_threads) {
+  std::vector<int32_t> keys = {2, 1};
+  EXPECT_THROW(ppc::core::networkSort(keys, -1), std::invalid_argument);
+}
@@ -0,0 +1,48 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_EXTERNAL_SORT_HPP_
+#define MODULES_CORE_INCLUDE_EXTERNAL_SORT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ppc::core {
+
+struct ExternalSortStats {
+  uint64_t bytes = 0;
+  // sorted runs written by run generation, 1 when the input fits the budget
+  size_t runs = 0;
+  // passes over the data after run generation, the last one writes the output
+  size_t merge_passes = 0;
+  double run_seconds = 0.0;
+  double merge_seconds = 0.0;
+  // input bytes per second of the whole sort, in GB (10^9 bytes)
+  double gigabytes_per_second = 0.0;
+};
+
+// Ascending sort of a binary file of native Key values into output, for files larger than
+// memory. Instantiated for int32_t, uint32_t, int64_t, uint64_t, float and double; floating point
+// keys follow the IEEE 754 totalOrder like radixSort.
+//
+// At most memory_budget bytes (at least 1 MiB) of keys are held at a time. Run generation cuts the
+// input into runs of a third of the budget and radix sorts each in memory while the next run is
+// read and the previous one written by a second thread; the runs go to one file in temp_dir (the
+// system temp directory when empty), removed before returning. The runs are then merged in
+// streaming passes: every run is read in two blocks, one being merged while the other is read
+// ahead, the keys up to the smallest last key of the loaded blocks are merged by multiwayMerge
+// into one of two output blocks, and the other output block is written meanwhile. Three quarters
+// of the budget go to the input blocks; when that leaves less than 64 KiB per block, groups of runs
+// are merged into longer runs first.
+//
+// output is written only after the whole input has been read, so input and output may be the same
+// file. threads is passed to radixSort and multiwayMerge (0: the OpenMP default). I/O failures throw
+// std::runtime_error, a budget below 1 MiB, negative threads or an input that is not a whole
+// number of keys std::invalid_argument.
+template <class Key>
+ExternalSortStats externalSort(const std::string& input, const std::string& output, size_t memory_budget,
+                               const std::string& temp_dir = "", int threads = 0);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_EXTERNAL_SORT_HPP_
@@ -0,0 +1,101 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_MERGE_SORT_HPP_
+#define MODULES_CORE_INCLUDE_MERGE_SORT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+namespace ppc::core {
+
+// Stable merges and merge sorts of keys with a payload kept in a separate array (structure of
+// arrays), for any comparator. They complement radixSortPairs for keys the radix sort cannot
+// order and for tasks whose algorithm is a merge sort.
+
+// Merges the sorted runs a and b into out; of equal keys those of a come first.
+template <class Key, class Value, class Compare = std::less<Key>>
+void mergePairs(const Key* a_keys, const Value* a_values, size_t na, const Key* b_keys, const Value* b_values,
+                size_t nb, Key* out_keys, Value* out_values, Compare comp = Compare()) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t k = 0;
+  while (i < na && j < nb) {
+    if (comp(b_keys[j], a_keys[i])) {
+      out_keys[k] = b_keys[j];
+      out_values[k++] = b_values[j++];
+    } else {
+      out_keys[k] = a_keys[i];
+      out_values[k++] = a_values[i++];
+    }
+  }
+  std::copy(a_keys + i, a_keys + na, out_keys + k);
+  std::copy(a_values + i, a_values + na, out_values + k);
+  std::copy(b_keys + j, b_keys + nb, out_keys + k + (na - i));
+  std::copy(b_values + j, b_values + nb, out_values + k + (na - i));
+}
+
+// Bottom-up stable merge sort: runs of kRun keys are insertion sorted in place, then merge
+// passes alternate between the arrays and one n-sized buffer per array.
+template <class Key, class Value, class Compare = std::less<Key>>
+void mergeSortPairs(Key* keys, Value* values, size_t n, Compare comp = Compare()) {
+  constexpr size_t kRun = 32;
+  for (size_t first = 0; first < n; first += kRun) {
+    const size_t last = std::min(first + kRun, n);
+    for (size_t i = first + 1; i < last; ++i) {
+      Key key = keys[i];
+      Value value = values[i];
+      size_t j = i;
+      for (; j > first && comp(key, keys[j - 1]); --j) {
+        keys[j] = keys[j - 1];
+        values[j] = values[j - 1];
+      }
+      keys[j] = key;
+      values[j] = value;
+    }
+  }
+  if (n <= kRun) return;
+
+  std::vector<Key> key_buffer(n);
+  std::vector<Value> value_buffer(n);
+  Key* src_keys = keys;
+  Value* src_values = values;
+  Key* dst_keys = key_buffer.data();
+  Value* dst_values = value_buffer.data();
+  for (size_t width = kRun; width < n; width *= 2) {
+    for (size_t first = 0; first < n; first += 2 * width) {
+      const size_t middle = std::min(first + width, n);
+      const size_t last = std::min(first + 2 * width, n);
+      mergePairs(src_keys + first, src_values + first, middle - first, src_keys + middle, src_values + middle,
+                 last - middle, dst_keys + first, dst_values + first, comp);
+    }
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+  if (src_keys != keys) {
+    std::copy(src_keys, src_keys + n, keys);
+    std::copy(src_values, src_values + n, values);
+  }
+}
+
+template <class Key, class Value, class Compare = std::less<Key>>
+void mergeSortPairs(std::vector<Key>& keys, std::vector<Value>& values, Compare comp = Compare()) {
+  mergeSortPairs(keys.data(), values.data(), keys.size(), comp);
+}
+
+// Stable argsort for any comparator: keys[index[0]], keys[index[1]], ... are in order.
+template <class Key, class Compare = std::less<Key>>
+std::vector<uint32_t> mergeArgsort(const std::vector<Key>& keys, Compare comp = Compare()) {
+  std::vector<Key> sorted = keys;
+  std::vector<uint32_t> index(keys.size());
+  std::iota(index.begin(), index.end(), 0);
+  mergeSortPairs(sorted.data(), index.data(), sorted.size(), comp);
+  return index;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_MERGE_SORT_HPP_
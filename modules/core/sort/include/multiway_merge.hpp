@@ -0,0 +1,58 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_MULTIWAY_MERGE_HPP_
+#define MODULES_CORE_INCLUDE_MULTIWAY_MERGE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ppc::core {
+
+// Co-rank of the stable merge of sorted a and b (ties: a first): how many of the first k merged
+// keys come from a. Output slice [k0, k1) of the merge is then the merge of a[coRank(k0),
+// coRank(k1)) and the matching slice of b, so threads can split one merge into equal shares of
+// output (merge path) and write them independently.
+template <class T>
+size_t coRank(size_t k, const T* a, size_t na, const T* b, size_t nb) {
+  size_t lo = k > nb ? k - nb : 0;
+  size_t hi = std::min(k, na);
+  while (lo < hi) {
+    const size_t i = lo + (hi - lo) / 2;
+    if (b[k - i - 1] < a[i]) {
+      hi = i;
+    } else {
+      lo = i + 1;
+    }
+  }
+  return lo;
+}
+
+// Stable k-way merge of sorted runs into out (the total size, not overlapping the runs); of equal
+// keys those of lower runs come first. Instantiated for int32_t, uint32_t, int64_t, uint64_t,
+// float and double.
+//
+// The output is split into one equal share per thread by multiwaySplit, and each share is merged
+// in a single pass over its parts of the runs: a copy for one run, a branch-free two-way merge for
+// two, and a loser tree for more, which costs log2(k) comparisons per key and replays only the
+// path of the run that produced the last key. Built with OpenMP, the shares go to a thread team
+// unless the call is made from inside a parallel region or the runs are short; threads caps the
+// team (0: the OpenMP default). Callers with threads of their own use the two functions below.
+template <class T>
+void multiwayMerge(const std::vector<std::span<const T>>& runs, T* out, int threads = 0);
+
+// Multisequence selection: the positions in every run where the first rank keys of the merge end.
+// Each step takes the middle key of the widest remaining interval as a pivot and narrows every
+// interval by its co-rank, so a split costs O(k^2 log^2 n) comparisons however the keys repeat.
+template <class T>
+std::vector<size_t> multiwaySplit(const std::vector<std::span<const T>>& runs, size_t rank);
+
+// Merges runs[i][first[i], last[i]) for all i into out, where first and last are two splits.
+template <class T>
+void multiwayMergePart(const std::vector<std::span<const T>>& runs, const std::vector<size_t>& first,
+                       const std::vector<size_t>& last, T* out);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_MULTIWAY_MERGE_HPP_
@@ -0,0 +1,62 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ORDERED_BITS_HPP_
+#define MODULES_CORE_INCLUDE_ORDERED_BITS_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ppc::core {
+
+// The unsigned integer as wide as Key (int32_t, uint32_t, int64_t, uint64_t, float or double).
+template <class Key>
+using OrderedBits = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+
+// Maps the bits of a key to an unsigned integer with the same order, the digits every radix
+// kernel works on: signed integers get their sign bit flipped, floating point keys get the sign
+// bit flipped when positive and all bits flipped when negative, which orders them by the IEEE 754
+// totalOrder (-NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN).
+template <class Key>
+constexpr OrderedBits<Key> toOrderedBits(OrderedBits<Key> bits) {
+  constexpr OrderedBits<Key> kSignBit = OrderedBits<Key>{1} << (sizeof(Key) * 8 - 1);
+  if constexpr (std::is_floating_point_v<Key>) {
+    return (bits & kSignBit) != 0 ? ~bits : bits ^ kSignBit;
+  } else if constexpr (std::is_signed_v<Key>) {
+    return bits ^ kSignBit;
+  } else {
+    return bits;
+  }
+}
+
+template <class Key>
+constexpr OrderedBits<Key> fromOrderedBits(OrderedBits<Key> bits) {
+  constexpr OrderedBits<Key> kSignBit = OrderedBits<Key>{1} << (sizeof(Key) * 8 - 1);
+  if constexpr (std::is_floating_point_v<Key>) {
+    return (bits & kSignBit) != 0 ? bits ^ kSignBit : ~bits;
+  } else if constexpr (std::is_signed_v<Key>) {
+    return bits ^ kSignBit;
+  } else {
+    return bits;
+  }
+}
+
+// Keys go through memcpy, so NaN payloads survive and no value passes an FP register.
+template <class Key>
+OrderedBits<Key> orderedBits(Key key) {
+  OrderedBits<Key> bits;
+  std::memcpy(&bits, &key, sizeof(bits));
+  return toOrderedBits<Key>(bits);
+}
+
+template <class Key>
+Key keyFromOrderedBits(OrderedBits<Key> bits) {
+  bits = fromOrderedBits<Key>(bits);
+  Key key;
+  std::memcpy(&key, &bits, sizeof(key));
+  return key;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ORDERED_BITS_HPP_
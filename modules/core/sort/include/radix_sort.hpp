@@ -0,0 +1,79 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_RADIX_SORT_HPP_
+#define MODULES_CORE_INCLUDE_RADIX_SORT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::core {
+
+// Stable ascending LSD radix sort of n keys in place. Instantiated for int32_t, uint32_t,
+// int64_t, uint64_t, float and double.
+//
+// Keys are mapped to unsigned integers with the same order: signed integers get their sign bit
+// flipped, floating point keys get the sign bit flipped when positive and all bits flipped when
+// negative. Floating point keys therefore follow the IEEE 754 totalOrder (std::strong_order):
+// -NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN, and sorting is bit exact.
+//
+// digit_bits is the width of one digit, 1 to 16 (8, 11 and 16 are the useful ones); 0 picks 8
+// for short inputs and 11 otherwise. One read computes the histograms of every digit, and digits
+// that are the same for all keys are skipped, so the number of passes follows the range the keys
+// actually span instead of the key width. Passes alternate between data and one n-sized buffer.
+// Built with OpenMP, every pass is split across threads with per-thread histograms whose prefix
+// sums keep the sort stable, unless the call is made from inside a parallel region or n is small.
+// threads caps the team (0: the OpenMP default); sequential tasks and callers running on TBB or
+// std::thread workers pass 1 so they sort serially instead of starting a team of their own.
+//
+// Memory is the keys plus one n-sized buffer whatever the digit width. Once the keys outgrow the
+// cache, the scatter stages keys per digit in cache-line sized slots and writes whole lines with
+// non-temporal stores (software write-combining), for digits of up to 11 bits.
+template <class Key>
+void radixSort(Key* data, size_t n, int digit_bits = 0, int threads = 0);
+
+// The same sort with the n-sized buffer supplied by the caller, e.g. a slice of a larger array
+// when many small ranges are sorted one after another; scratch must not overlap data and its
+// contents are unspecified afterwards.
+template <class Key>
+void radixSort(Key* data, size_t n, Key* scratch, int digit_bits = 0, int threads = 0);
+
+template <class Key>
+void radixSort(std::vector<Key>& data, int digit_bits = 0, int threads = 0) {
+  radixSort(data.data(), data.size(), digit_bits, threads);
+}
+
+// Stable sort of keys that carry a payload of payload_bytes (4 or 8) bytes each, stored as a
+// separate array: payload word i moves together with keys[i]. Passes read and write the keys and
+// payloads as two dense streams, so a pass moves n * (sizeof(Key) + payload_bytes) bytes and the
+// digits are computed from keys alone. Payload scatters are never staged.
+template <class Key>
+void radixSortPayload(Key* keys, void* payload, size_t payload_bytes, size_t n, int digit_bits = 0, int threads = 0);
+
+template <class Key, class Value>
+void radixSortPairs(Key* keys, Value* values, size_t n, int digit_bits = 0, int threads = 0) {
+  static_assert(std::is_trivially_copyable_v<Value> && (sizeof(Value) == 4 || sizeof(Value) == 8),
+                "payloads are moved as 4 or 8 byte words; sort an index and gather wider records");
+  radixSortPayload(keys, static_cast<void*>(values), sizeof(Value), n, digit_bits, threads);
+}
+
+template <class Key, class Value>
+void radixSortPairs(std::vector<Key>& keys, std::vector<Value>& values, int digit_bits = 0, int threads = 0) {
+  radixSortPairs(keys.data(), values.data(), keys.size(), digit_bits, threads);
+}
+
+// Stable argsort: the permutation with keys[index[0]] <= keys[index[1]] <= ... in the order of
+// radixSort, keys left untouched. Sorts a copy of the keys with 32-bit indices as the payload,
+// so n is limited to 2^32 - 1.
+template <class Key>
+std::vector<uint32_t> radixArgsort(const Key* keys, size_t n, int digit_bits = 0, int threads = 0);
+
+template <class Key>
+std::vector<uint32_t> radixArgsort(const std::vector<Key>& keys, int digit_bits = 0, int threads = 0) {
+  return radixArgsort(keys.data(), keys.size(), digit_bits, threads);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_RADIX_SORT_HPP_
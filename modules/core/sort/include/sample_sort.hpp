@@ -0,0 +1,417 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SAMPLE_SORT_HPP_
+#define MODULES_CORE_INCLUDE_SAMPLE_SORT_HPP_
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ppc::core {
+
+// In-place parallel super scalar samplesort (after IPS4o) for any strict weak order comp; the
+// comparison-based counterpart of radixSort. Not stable.
+//
+// Every level draws a random sample, takes up to 255 splitters from it and classifies keys
+// without branches by descending an implicit search tree of the splitters, a batch of keys at a
+// time. When the sample repeats a splitter, every splitter gets an extra bucket for the keys
+// equal to it, which is never sorted again, so inputs with few distinct keys finish in one or two
+// levels. Classified keys go to per-bucket blocks of 1 KB, and full blocks are written back over
+// the part of the input already read, so the only extra memory is the blocks themselves (a few
+// hundred KB per thread). Blocks are then permuted into their buckets in place, and the partial
+// blocks at the bucket edges are fixed up. Buckets of at most kBaseCase keys are left to
+// std::sort.
+//
+// Built with OpenMP, large inputs are split into one stripe per thread: threads classify their
+// stripes, then move blocks between buckets under a lock per bucket. Buckets bigger than a
+// thread's share are partitioned by the whole team again, the rest go to threads one bucket at a
+// time. No parallel region is started from inside another one or for small inputs; threads caps
+// the team (0: the OpenMP default, 1: serial).
+template <class T, class Compare>
+class SampleSorter {
+ public:
+  static constexpr size_t kBaseCase = 1 << 10;
+  static constexpr size_t kParallelKeys = 1 << 16;
+  static constexpr size_t kMaxLogBuckets = 8;
+  static constexpr size_t kBlock = 1024 / sizeof(T) > 0 ? 1024 / sizeof(T) : 1;
+
+  SampleSorter(Compare comp, int team) : comp_(std::move(comp)), team_(team), workspaces_(team) {}
+
+  void sort(T* data, size_t n) {
+    // sorted and reverse sorted inputs cost one scan; any other input stops it at an early inversion
+    if (std::is_sorted(data, data + n, comp_)) return;
+    if (std::is_sorted(data, data + n, [this](const T& a, const T& b) { return comp_(b, a); })) {
+      std::reverse(data, data + n);
+      return;
+    }
+    if (team_ > 1 && n >= kParallelKeys) {
+      sortParallel(data, n);
+    } else {
+      sortSerial(data, n, workspaces_[0]);
+    }
+  }
+
+ private:
+  static constexpr size_t kBatch = 8;
+
+  struct Workspace {
+    std::vector<T> buffers;  // one partial block per bucket
+    std::vector<T> swap;     // two blocks in flight during the permutation
+    std::vector<T> carry;    // overhang of the last bucket this thread cleans up
+    size_t carried = 0;
+  };
+
+  // One partitioning step. Bucket b holds the keys classified b and ends up in [bounds[b],
+  // bounds[b + 1]); in blocks, its slots are [ceil(bounds[b] / kBlock), ceil(bounds[b + 1] / kBlock)).
+  struct Level {
+    size_t log_k = 0;
+    size_t k = 0;  // leaves of the search tree
+    bool equal_buckets = false;
+    std::vector<T> tree;       // tree[1 .. k - 1], children of node i at 2i and 2i + 1
+    std::vector<T> splitters;  // sorted, the last one repeated up to k entries
+
+    size_t n = 0;
+    size_t buckets = 0;
+    size_t slots = 0;
+    std::vector<size_t> counts;  // keys classified b by thread t at [t * buckets + b]
+    std::vector<size_t> stripe_end;
+    std::vector<size_t> bounds;
+    std::vector<char> full;  // slots that held a full block after classification
+    std::vector<ptrdiff_t> write;
+    std::vector<ptrdiff_t> read;
+    std::vector<std::mutex> locks;
+    std::vector<T> overflow;  // the block due to the slot that runs past n
+    bool overflowed = false;
+  };
+
+  static size_t logCeil(size_t x) {
+    size_t log = 0;
+    while ((size_t{1} << log) < x) ++log;
+    return log;
+  }
+
+  void buildClassifier(T* data, size_t n, Level& level) const {
+    level.log_k = std::clamp<size_t>(logCeil(n / kBaseCase), 2, kMaxLogBuckets);
+    level.k = size_t{1} << level.log_k;
+    const size_t oversampling = std::max<size_t>(1, logCeil(n) / 5);
+    const size_t sample = oversampling * level.k - 1;
+
+    // the sample is moved to the front of the input, where it is sorted like any other keys
+    uint64_t state = n * 0x9E3779B97F4A7C15ULL + 1;
+    for (size_t i = 0; i < sample; ++i) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      std::swap(data[i], data[i + state % (n - i)]);
+    }
+    std::sort(data, data + sample, comp_);
+
+    level.splitters.clear();
+    level.equal_buckets = false;
+    for (size_t i = 1; i < level.k; ++i) {
+      const T& splitter = data[oversampling * i - 1];
+      if (level.splitters.empty() || comp_(level.splitters.back(), splitter)) {
+        level.splitters.push_back(splitter);
+      } else {
+        level.equal_buckets = true;
+      }
+    }
+    const T last = level.splitters.back();
+    level.splitters.resize(level.k, last);
+    level.tree.resize(level.k);
+    fillTree(level, 1, 0, level.k - 1);
+    level.buckets = level.equal_buckets ? 2 * level.k : level.k;
+  }
+
+  static void fillTree(Level& level, size_t node, size_t first, size_t last) {
+    if (first == last) return;
+    const size_t middle = first + (last - first) / 2;
+    level.tree[node] = level.splitters[middle];
+    fillTree(level, 2 * node, first, middle);
+    fillTree(level, 2 * node + 1, middle + 1, last);
+  }
+
+  // Bucket of every key in x[0, m): the tree descent counts the splitters below the key, and with
+  // equal buckets one more comparison tells whether the key equals the next splitter.
+  void classify(const Level& level, const T* x, size_t m, size_t* ids) const {
+    for (size_t i = 0; i < m; ++i) ids[i] = 1;
+    for (size_t l = 0; l < level.log_k; ++l) {
+      for (size_t i = 0; i < m; ++i) ids[i] = 2 * ids[i] + static_cast<size_t>(comp_(level.tree[ids[i]], x[i]));
+    }
+    for (size_t i = 0; i < m; ++i) {
+      const size_t b = ids[i] - level.k;
+      if (level.equal_buckets) {
+        ids[i] = 2 * b + static_cast<size_t>((b + 1 < level.k) & !comp_(x[i], level.splitters[b]));
+      } else {
+        ids[i] = b;
+      }
+    }
+  }
+
+  size_t classifyOne(const Level& level, const T& x) const {
+    size_t id = 0;
+    classify(level, &x, 1, &id);
+    return id;
+  }
+
+  void prepare(T* data, size_t n, int team, Level& level, Workspace* ws) const {
+    buildClassifier(data, n, level);
+    level.n = n;
+    level.slots = (n + kBlock - 1) / kBlock;
+    level.counts.assign(team * level.buckets, 0);
+    level.stripe_end.assign(team, 0);
+    level.bounds.assign(level.buckets + 1, 0);
+    level.full.assign(level.slots, 0);
+    level.write.assign(level.buckets, 0);
+    level.read.assign(level.buckets, 0);
+    level.locks = std::vector<std::mutex>(level.buckets);
+    level.overflow.resize(kBlock);
+    level.overflowed = false;
+    for (int t = 0; t < team; ++t) {
+      ws[t].buffers.resize(level.buckets * kBlock);
+      ws[t].swap.resize(2 * kBlock);
+      ws[t].carry.resize(kBlock);
+    }
+  }
+
+  // Moves the keys of the stripe of thread t into its bucket blocks; every block that fills up is
+  // written back to the start of the stripe, over keys already classified.
+  void classifyStripe(T* data, Level& level, Workspace& ws, int t, int team) const {
+    const size_t first_slot = level.slots * t / team;
+    const size_t last_slot = level.slots * (t + 1) / team;
+    const size_t last = std::min(last_slot * kBlock, level.n);
+    size_t* count = &level.counts[t * level.buckets];
+    T* buffers = ws.buffers.data();
+    size_t ids[kBatch];
+    size_t write = first_slot * kBlock;
+    for (size_t i = first_slot * kBlock; i < last; i += kBatch) {
+      const size_t m = std::min(kBatch, last - i);
+      classify(level, data + i, m, ids);
+      for (size_t j = 0; j < m; ++j) {
+        T* block = buffers + ids[j] * kBlock;
+        const size_t fill = count[ids[j]]++ % kBlock;
+        block[fill] = std::move(data[i + j]);
+        if (fill + 1 == kBlock) {
+          std::move(block, block + kBlock, data + write);
+          write += kBlock;
+        }
+      }
+    }
+    level.stripe_end[t] = write;
+    for (size_t s = first_slot; s < last_slot; ++s) level.full[s] = s < write / kBlock;
+  }
+
+  void computeBounds(Level& level, int team) const {
+    for (size_t b = 0; b < level.buckets; ++b) {
+      size_t size = 0;
+      for (int t = 0; t < team; ++t) size += level.counts[t * level.buckets + b];
+      level.bounds[b + 1] = level.bounds[b] + size;
+      level.write[b] = static_cast<ptrdiff_t>((level.bounds[b] + kBlock - 1) / kBlock);
+      level.read[b] = static_cast<ptrdiff_t>((level.bounds[b + 1] + kBlock - 1) / kBlock) - 1;
+    }
+  }
+
+  // Takes the last unread full block of bucket b into block; slots [write, read] of a bucket are
+  // either full and unread or empty, slots below write hold blocks already in place.
+  bool readBlock(T* data, Level& level, size_t b, T* block) const {
+    std::lock_guard<std::mutex> lock(level.locks[b]);
+    while (level.read[b] >= level.write[b] && level.full[level.read[b]] == 0) --level.read[b];
+    if (level.read[b] < level.write[b]) return false;
+    T* slot = data + level.read[b] * kBlock;
+    std::move(slot, slot + kBlock, block);
+    --level.read[b];
+    return true;
+  }
+
+  // Writes block to the next slot of its bucket. Returns false when that slot held an unread block,
+  // which is then left in other.
+  bool writeBlock(T* data, Level& level, T* block, T* other) const {
+    const size_t b = classifyOne(level, block[0]);
+    std::lock_guard<std::mutex> lock(level.locks[b]);
+    ptrdiff_t s = level.write[b];
+    // blocks that already sit in a slot of their bucket stay there
+    while (s <= level.read[b] && level.full[s] != 0 && classifyOne(level, data[s * kBlock]) == b) ++s;
+    level.write[b] = s + 1;
+    T* slot = data + s * kBlock;
+    if (s <= level.read[b] && level.full[s] != 0) {
+      std::move(slot, slot + kBlock, other);
+      std::move(block, block + kBlock, slot);
+      return false;
+    }
+    if (static_cast<size_t>(s + 1) * kBlock > level.n) {
+      std::move(block, block + kBlock, level.overflow.data());
+      level.overflowed = true;
+    } else {
+      std::move(block, block + kBlock, slot);
+    }
+    return true;
+  }
+
+  void permuteBlocks(T* data, Level& level, Workspace& ws, int t, int team) const {
+    T* block = ws.swap.data();
+    T* other = block + kBlock;
+    const size_t first = level.buckets * t / team;
+    for (size_t step = 0; step < level.buckets;) {
+      if (!readBlock(data, level, (first + step) % level.buckets, block)) {
+        ++step;
+        continue;
+      }
+      while (!writeBlock(data, level, block, other)) std::swap(block, other);
+    }
+  }
+
+  // Full blocks of bucket b end at end(b) and may run into the next bucket; those keys are the
+  // overhang of b. The block written to the overflow buffer stands for the slot past n.
+  size_t blocksEnd(const Level& level, size_t b) const { return static_cast<size_t>(level.write[b]) * kBlock; }
+
+  size_t takeOverhang(T* data, Level& level, size_t b, T* out) const {
+    const size_t first_slot = (level.bounds[b] + kBlock - 1) / kBlock;
+    const size_t end = blocksEnd(level, b);
+    if (end <= first_slot * kBlock || end <= level.bounds[b + 1]) return 0;
+    const size_t tail = level.n / kBlock * kBlock;
+    for (size_t p = level.bounds[b + 1]; p < end; ++p) {
+      *out++ = std::move(level.overflowed && p >= tail ? level.overflow[p - tail] : data[p]);
+    }
+    return end - level.bounds[b + 1];
+  }
+
+  // Fills the gaps of bucket b, its head before the first full block and its tail after the last
+  // one, with its overhang and the partial blocks of every thread.
+  void fillBucket(T* data, Level& level, Workspace* ws, size_t b, T* overhang, size_t overhang_size,
+                  int team) const {
+    const size_t first_slot = (level.bounds[b] + kBlock - 1) / kBlock;
+    const size_t end = std::max(blocksEnd(level, b), first_slot * kBlock);
+    const size_t tail = level.n / kBlock * kBlock;
+    if (level.overflowed && end > level.n && first_slot * kBlock < end) {
+      std::move(level.overflow.data(), level.overflow.data() + (level.bounds[b + 1] - tail), data + tail);
+    }
+    const size_t head_end = std::min(first_slot * kBlock, level.bounds[b + 1]);
+    size_t pos = level.bounds[b];
+    auto put = [&](T* src, size_t m) {
+      for (size_t i = 0; i < m; ++i) {
+        if (pos == head_end) pos = end;
+        data[pos++] = std::move(src[i]);
+      }
+    };
+    put(overhang, overhang_size);
+    for (int t = 0; t < team; ++t) {
+      put(ws[t].buffers.data() + b * kBlock, level.counts[t * level.buckets + b] % kBlock);
+    }
+  }
+
+  // The overhang of a bucket lies in the head of the next one, so a thread cleaning up buckets
+  // [first, last) saves the overhang of last - 1 before any thread starts filling heads.
+  void saveCarry(T* data, Level& level, Workspace& ws, int t, int team) const {
+    const size_t last = level.buckets * (t + 1) / team;
+    const size_t first = level.buckets * t / team;
+    ws.carried = first < last ? takeOverhang(data, level, last - 1, ws.carry.data()) : 0;
+  }
+
+  void cleanup(T* data, Level& level, Workspace* ws, int t, int team) const {
+    const size_t first = level.buckets * t / team;
+    const size_t last = level.buckets * (t + 1) / team;
+    T* overhang = ws[t].swap.data();
+    for (size_t b = first; b < last; ++b) {
+      if (b + 1 == last) {
+        fillBucket(data, level, ws, b, ws[t].carry.data(), ws[t].carried, team);
+      } else {
+        fillBucket(data, level, ws, b, overhang, takeOverhang(data, level, b, overhang), team);
+      }
+    }
+  }
+
+  bool isLeaf(const Level& level, size_t b) const { return level.equal_buckets && b % 2 == 1; }
+
+  void sortSerial(T* data, size_t n, Workspace& ws) const {
+    if (n <= kBaseCase) {
+      std::sort(data, data + n, comp_);
+      return;
+    }
+    Level level;
+    prepare(data, n, 1, level, &ws);
+    classifyStripe(data, level, ws, 0, 1);
+    computeBounds(level, 1);
+    permuteBlocks(data, level, ws, 0, 1);
+    saveCarry(data, level, ws, 0, 1);
+    cleanup(data, level, &ws, 0, 1);
+    for (size_t b = 0; b < level.buckets; ++b) {
+      if (!isLeaf(level, b)) sortSerial(data + level.bounds[b], level.bounds[b + 1] - level.bounds[b], ws);
+    }
+  }
+
+  void sortParallel(T* data, size_t n) {
+#ifdef _OPENMP
+    int team = team_;
+    Level level;
+    prepare(data, n, team, level, workspaces_.data());
+#pragma omp parallel num_threads(team)
+    {
+#pragma omp single
+      team = omp_get_num_threads();
+      const int t = omp_get_thread_num();
+      classifyStripe(data, level, workspaces_[t], t, team);
+#pragma omp barrier
+#pragma omp single
+      computeBounds(level, team);
+      permuteBlocks(data, level, workspaces_[t], t, team);
+#pragma omp barrier
+      saveCarry(data, level, workspaces_[t], t, team);
+#pragma omp barrier
+      cleanup(data, level, workspaces_.data(), t, team);
+    }
+
+    // buckets bigger than a thread's share are partitioned by the whole team again
+    std::vector<size_t> small;
+    for (size_t b = 0; b < level.buckets; ++b) {
+      const size_t size = level.bounds[b + 1] - level.bounds[b];
+      if (isLeaf(level, b) || size <= 1) continue;
+      if (size >= kParallelKeys && size > n / team_) {
+        sortParallel(data + level.bounds[b], size);
+      } else {
+        small.push_back(b);
+      }
+    }
+#pragma omp parallel for schedule(dynamic, 1) num_threads(team_)
+    for (int i = 0; i < static_cast<int>(small.size()); ++i) {
+      const size_t b = small[i];
+      sortSerial(data + level.bounds[b], level.bounds[b + 1] - level.bounds[b], workspaces_[omp_get_thread_num()]);
+    }
+#else
+    sortSerial(data, n, workspaces_[0]);
+#endif
+  }
+
+  Compare comp_;
+  int team_;
+  std::vector<Workspace> workspaces_;
+};
+
+template <class T, class Compare = std::less<T>>
+void sampleSort(T* data, size_t n, Compare comp = Compare(), int threads = 0) {
+  if (threads < 0) throw std::invalid_argument("sampleSort: threads must not be negative");
+  int team = 1;
+#ifdef _OPENMP
+  if (n >= SampleSorter<T, Compare>::kParallelKeys && !omp_in_parallel()) {
+    team = threads == 0 ? omp_get_max_threads() : threads;
+  }
+#endif
+  SampleSorter<T, Compare>(std::move(comp), team).sort(data, n);
+}
+
+template <class T, class Compare = std::less<T>>
+void sampleSort(std::vector<T>& data, Compare comp = Compare(), int threads = 0) {
+  sampleSort(data.data(), data.size(), std::move(comp), threads);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SAMPLE_SORT_HPP_
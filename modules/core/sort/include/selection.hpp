@@ -0,0 +1,82 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SELECTION_HPP_
+#define MODULES_CORE_INCLUDE_SELECTION_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace ppc::core {
+
+// Selection in the order of radixSort, for callers that need a few ranks of the sorted keys
+// rather than all of them. Instantiated for int32_t, uint32_t, int64_t, uint64_t, float and
+// double; floating point keys follow the IEEE 754 totalOrder. Built with OpenMP, every pass over
+// the keys is split across threads unless the call is made from inside a parallel region or n is
+// small; threads caps the team (0: the OpenMP default, 1: serial), and negative threads throw
+// std::invalid_argument.
+
+// The key at position rank of the sorted keys (std::out_of_range unless rank < n).
+//
+// One pass finds the lowest and highest key, which fixes the digit: the 11 bits below the highest
+// bit in which keys differ. A second pass builds the histogram of that digit with one histogram per
+// thread, its prefix sums name the bucket holding rank, and a third pass gathers the keys of that
+// bucket, about n / 2048 of them for spread keys, for std::nth_element. A bucket of more than
+// 16384 keys, as skewed inputs give, is narrowed the same way on the next 11 bits of its keys.
+template <class Key>
+Key radixSelect(const Key* data, size_t n, size_t rank, int threads = 0);
+
+template <class Key>
+Key radixSelect(const std::vector<Key>& data, size_t rank, int threads = 0) {
+  return radixSelect(data.data(), data.size(), rank, threads);
+}
+
+// Nearest-rank quantiles: the keys at positions round(q * (n - 1)) of the sorted keys for every q
+// of levels, each in [0, 1] (std::invalid_argument otherwise; n must not be 0). All levels share
+// the passes of radixSelect, with one gather for all the buckets they fall in.
+template <class Key>
+std::vector<Key> quantiles(const Key* data, size_t n, const std::vector<double>& levels, int threads = 0);
+
+template <class Key>
+std::vector<Key> quantiles(const std::vector<Key>& data, const std::vector<double>& levels, int threads = 0) {
+  return quantiles(data.data(), data.size(), levels, threads);
+}
+
+// The k smallest keys in ascending order (all of them when k >= n), the input left untouched.
+//
+// Up to k = 1024 every thread keeps a max-heap of the k smallest keys of its chunk, so a key is
+// compared with the heap top and mostly dropped, and the heaps are merged at the end. Larger k
+// select the k-th key by radixSelect, gather the keys below it and radix sort them.
+template <class Key>
+std::vector<Key> topK(const Key* data, size_t n, size_t k, int threads = 0);
+
+template <class Key>
+std::vector<Key> topK(const std::vector<Key>& data, size_t k, int threads = 0) {
+  return topK(data.data(), data.size(), k, threads);
+}
+
+// Rearranges data like std::nth_element: data[nth] is the key radixSelect finds, the keys before
+// it are not greater and the keys after it not less (std::out_of_range unless nth < n). After the
+// selection one more pass places every key below, equal to and above it through an n-sized buffer,
+// keeping the order of each part.
+template <class Key>
+void nthElement(Key* data, size_t n, size_t nth, int threads = 0);
+
+template <class Key>
+void nthElement(std::vector<Key>& data, size_t nth, int threads = 0) {
+  nthElement(data.data(), data.size(), nth, threads);
+}
+
+// Rearranges data like std::partial_sort: the first min(k, n) positions hold the smallest keys in
+// ascending order, the others the rest in unspecified order. nthElement followed by radixSort of
+// the first k keys.
+template <class Key>
+void partialSort(Key* data, size_t n, size_t k, int threads = 0);
+
+template <class Key>
+void partialSort(std::vector<Key>& data, size_t k, int threads = 0) {
+  partialSort(data.data(), data.size(), k, threads);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SELECTION_HPP_
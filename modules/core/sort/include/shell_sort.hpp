@@ -0,0 +1,41 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SHELL_SORT_HPP_
+#define MODULES_CORE_INCLUDE_SHELL_SORT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+// Gap sequences for Shell sort. Halving (n / 2, n / 4, ..., 1) is the textbook one and needs
+// O(n^2) comparisons in the worst case; the others grow geometrically from 1 and do far fewer:
+// Ciura's experimentally found 1, 4, 10, 23, 57, 132, 301, 701, 1750 extended by a factor of 2.25,
+// Tokuda's ceil((9^k - 4^k) / (5 * 4^(k - 1))) and Sedgewick's 4^k + 3 * 2^(k - 1) + 1.
+enum class ShellGaps { kCiura, kTokuda, kSedgewick, kHalving };
+
+// The gaps of the sequence below n, largest first, ending with 1 (none for n < 2).
+std::vector<size_t> shellGaps(size_t n, ShellGaps gaps = ShellGaps::kCiura);
+
+// Ascending Shell sort of n int32 keys in place.
+//
+// For every gap h of at least 8, eight neighbouring subsequences are h-sorted together in the
+// lanes of an AVX2 register: their keys are adjacent in memory, so one load fetches the next key
+// of each, and a lane stops shifting as soon as its key is in place. Other targets and smaller gaps
+// run the scalar insertion. Before that one scan measures how sorted the keys already are: sorted
+// and reverse sorted keys are done, up to 64 ascending runs are merged by multiwayMerge, and keys
+// with few descents get an insertion sort that falls back to the gaps after 8 moves per key.
+//
+// Built with OpenMP, every thread sorts one chunk this way and the chunks are joined by
+// multiwayMerge, unless the call is made from inside a parallel region or n is small; threads caps
+// the team (0: the OpenMP default, 1: serial).
+void shellSort(int32_t* data, size_t n, ShellGaps gaps = ShellGaps::kCiura, int threads = 0);
+
+inline void shellSort(std::vector<int32_t>& data, ShellGaps gaps = ShellGaps::kCiura, int threads = 0) {
+  shellSort(data.data(), data.size(), gaps, threads);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SHELL_SORT_HPP_
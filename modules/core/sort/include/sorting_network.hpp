@@ -0,0 +1,44 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SORTING_NETWORK_HPP_
+#define MODULES_CORE_INCLUDE_SORTING_NETWORK_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+// Ascending sort of n int32 keys in place built from vectorized compare-exchange networks.
+//
+// Blocks of 64 keys are loaded into eight AVX2 registers, the columns are sorted by the 19
+// comparator network for 8 inputs (every comparator is one min and one max of two registers)
+// and an in-register 8 x 8 transpose turns the columns into eight sorted runs of 8. Runs are
+// then merged pairwise, log2(n / 8) passes between data and one n-sized buffer, by networkMerge.
+// The instruction set is picked at run time: AVX-512 merges 16 keys per step, AVX2 merges 8, and
+// other targets run the same network on scalars with branch-free min/max.
+//
+// Built with OpenMP, run sorting and every merge pass are split across threads unless the call
+// is made from inside a parallel region or n is small; threads caps the team (0: the OpenMP
+// default, 1: serial). Merge passes give every thread an equal share of output cut by coRank
+// (merge path), so the last passes keep all threads busy. The sort is not stable, which is
+// irrelevant for plain keys.
+void networkSort(int32_t* data, size_t n, int threads = 0);
+
+inline void networkSort(std::vector<int32_t>& data, int threads = 0) { networkSort(data.data(), data.size(), threads); }
+
+// Merges the sorted runs a and b into out (na + nb keys, not overlapping the inputs). While both
+// runs have keys left, the next vector is taken from the run with the smaller head and pushed
+// through a bitonic merge network against the vector of keys still pending, which leaves the
+// lower half ready to store; runs shorter than one vector are merged with scalar code.
+void networkMerge(const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out);
+
+inline std::vector<int32_t> networkMerge(const std::vector<int32_t>& a, const std::vector<int32_t>& b) {
+  std::vector<int32_t> out(a.size() + b.size());
+  networkMerge(a.data(), a.size(), b.data(), b.size(), out.data());
+  return out;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SORTING_NETWORK_HPP_
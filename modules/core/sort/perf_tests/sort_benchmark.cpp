@@ -0,0 +1,186 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/perf/include/sort_inputs.hpp"
+#include "core/sort/include/ordered_bits.hpp"
+#include "core/sort/include/radix_sort.hpp"
+#include "core/sort/include/sample_sort.hpp"
+#include "core/sort/include/selection.hpp"
+#include "core/sort/include/shell_sort.hpp"
+#include "core/sort/include/sorting_network.hpp"
+
+// Every sort engine the sort tasks are built on, timed on every distribution of sortInputs.
+// Each line reads sort_benchmark/<engine>/<distribution>:pipeline:<keys/s>:<bytes/s>, and a
+// run costs one copy of the keys in pre_processing besides the sort.
+//
+// The scope is the core engines, not the sort tasks themselves: core cannot link the task
+// libraries, and the task perf suites are held to two tests each, so per-task timings over these
+// distributions stay out of the tree. Tasks that wrap an engine add little beyond a copy of the keys.
+
+namespace {
+
+constexpr size_t kKeys = size_t{1} << 20;
+
+template <class T>
+class SortBenchmarkTask : public ppc::core::Task {
+ public:
+  SortBenchmarkTask(std::shared_ptr<ppc::core::TaskData> taskData_, std::function<void(std::vector<T> &)> sort_)
+      : Task(std::move(taskData_)), sort(std::move(sort_)) {}
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs_count[0] == taskData->outputs_count[0];
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    auto *input = reinterpret_cast<T *>(taskData->inputs[0]);
+    keys.assign(input, input + taskData->inputs_count[0]);
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    sort(keys);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(keys.begin(), keys.end(), reinterpret_cast<T *>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  std::function<void(std::vector<T> &)> sort;
+  std::vector<T> keys;
+};
+
+// the order of radixSort, under which NaN and -0.0 have a place
+template <class T>
+bool totalLess(T a, T b) {
+  return ppc::core::orderedBits(a) < ppc::core::orderedBits(b);
+}
+
+// Times sort on a copy of in through the task pipeline, prints the throughput line under name and
+// returns the keys as sort left them.
+template <class T>
+std::vector<T> timeEngine(const std::string &name, const std::vector<T> &in,
+                          const std::function<void(std::vector<T> &)> &sort) {
+  std::vector<T> input = in;
+  std::vector<T> out(in.size());
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(input.data()));
+  taskData->inputs_count.emplace_back(input.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  auto task = std::make_shared<SortBenchmarkTask<T>>(taskData, sort);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  ppc::core::Perf perfAnalyzer(task);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  ppc::core::Perf::print_throughput_statistic(perfAttr, perfResults, "sort_benchmark/" + name, in.size(),
+                                              in.size() * sizeof(T));
+  return out;
+}
+
+template <class T>
+void benchmark(const std::string &engine, const std::function<void(std::vector<T> &)> &sort) {
+  for (auto input : ppc::core::sortInputs()) {
+    const std::string name = engine + "/" + ppc::core::sortInputName(input);
+    std::vector<T> out = timeEngine<T>(name, ppc::core::makeSortInput<T>(input, kKeys), sort);
+    EXPECT_TRUE(std::is_sorted(out.begin(), out.end(), totalLess<T>)) << name;
+  }
+}
+
+// The k smallest of kKeys uniform doubles by topK, partialSort and radixSelect, next to a full
+// radixSort that gets them too; lines read sort_benchmark/<engine>/k<k>:pipeline:<keys/s>:<bytes/s>.
+// Every engine leaves the k-th smallest key at position k - 1 of its output, which is checked.
+void selectionBenchmark(size_t k) {
+  const std::vector<double> in = ppc::core::makeSortInput<double>(ppc::core::SortInput::kUniform, kKeys);
+  std::vector<double> sorted = in;
+  ppc::core::radixSort(sorted);
+  const std::vector<std::pair<std::string, std::function<void(std::vector<double> &)>>> engines = {
+      {"radix_sort", [](std::vector<double> &keys) { ppc::core::radixSort(keys); }},
+      {"top_k",
+       [k](std::vector<double> &keys) {
+         const std::vector<double> top = ppc::core::topK(keys, k);
+         std::copy(top.begin(), top.end(), keys.begin());
+       }},
+      {"partial_sort", [k](std::vector<double> &keys) { ppc::core::partialSort(keys, k); }},
+      {"radix_select", [k](std::vector<double> &keys) { keys[k - 1] = ppc::core::radixSelect(keys, k - 1); }},
+  };
+  for (const auto &[engine, select] : engines) {
+    const std::string name = engine + "/k" + std::to_string(k);
+    const std::vector<double> out = timeEngine<double>(name, in, select);
+    EXPECT_EQ(ppc::core::orderedBits(out[k - 1]), ppc::core::orderedBits(sorted[k - 1])) << name;
+  }
+}
+
+}  // namespace
+
+// eremin, smirnov, zakharov, soloninko, kashirin
+TEST(sort_benchmark, radix_sort_int32) {
+  benchmark<int32_t>("radix_sort_int32", [](std::vector<int32_t> &keys) { ppc::core::radixSort(keys); });
+}
+
+// konovalov, mitin, morgachev, petrov, nogin
+TEST(sort_benchmark, radix_sort_double) {
+  benchmark<double>("radix_sort_double", [](std::vector<double> &keys) { ppc::core::radixSort(keys); });
+}
+
+// alexseev, chuvashov, ryabkov, shmelev
+TEST(sort_benchmark, network_sort_int32) {
+  benchmark<int32_t>("network_sort_int32", [](std::vector<int32_t> &keys) { ppc::core::networkSort(keys); });
+}
+
+// makhinya, polozov
+TEST(sort_benchmark, sample_sort_int32) {
+  benchmark<int32_t>("sample_sort_int32", [](std::vector<int32_t> &keys) { ppc::core::sampleSort(keys); });
+}
+
+TEST(sort_benchmark, sample_sort_double) {
+  benchmark<double>("sample_sort_double",
+                    [](std::vector<double> &keys) { ppc::core::sampleSort(keys, totalLess<double>); });
+}
+
+// derun, kiselev, shemiakina, Vasilev, benduyzhko
+TEST(sort_benchmark, shell_sort_int32) {
+  benchmark<int32_t>("shell_sort_int32", [](std::vector<int32_t> &keys) { ppc::core::shellSort(keys); });
+}
+
+TEST(sort_benchmark, std_sort_int32) {
+  benchmark<int32_t>("std_sort_int32", [](std::vector<int32_t> &keys) { std::sort(keys.begin(), keys.end()); });
+}
+
+TEST(sort_benchmark, std_sort_double) {
+  benchmark<double>("std_sort_double",
+                    [](std::vector<double> &keys) { std::sort(keys.begin(), keys.end(), totalLess<double>); });
+}
+
+// k of a handful, a few thousand (past the heap path of topK) and a quarter of the keys
+TEST(sort_benchmark, selection_small_k) { selectionBenchmark(16); }
+
+TEST(sort_benchmark, selection_medium_k) { selectionBenchmark(4096); }
+
+TEST(sort_benchmark, selection_large_k) { selectionBenchmark(kKeys / 4); }
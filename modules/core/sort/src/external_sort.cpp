@@ -0,0 +1,335 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/external_sort.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sort/include/multiway_merge.hpp"
+#include "core/sort/include/ordered_bits.hpp"
+#include "core/sort/include/radix_sort.hpp"
+
+namespace {
+
+constexpr size_t kMinBudget = size_t{1} << 20;
+// shorter blocks turn the merge into random I/O, so more runs are merged in several passes
+constexpr size_t kMinBlockBytes = size_t{1} << 16;
+
+using Clock = std::chrono::steady_clock;
+
+template <class Key>
+using Bits = ppc::core::OrderedBits<Key>;
+
+// Keys are sorted and merged in the ordered bits of radixSort, so the merge agrees with the run
+// sort on -0.0 and NaN.
+template <class Key>
+void toOrdered(Bits<Key>* keys, size_t n) {
+  for (size_t i = 0; i < n; ++i) keys[i] = ppc::core::toOrderedBits<Key>(keys[i]);
+}
+
+template <class Key>
+void fromOrdered(Bits<Key>* keys, size_t n) {
+  for (size_t i = 0; i < n; ++i) keys[i] = ppc::core::fromOrderedBits<Key>(keys[i]);
+}
+
+// A file in the temp directory that is removed when it goes out of scope.
+class TempFile {
+ public:
+  explicit TempFile(const std::filesystem::path& dir) {
+    std::random_device random;
+    do {
+      path_ = dir / ("ppc_external_sort_" + std::to_string(random()) + ".tmp");
+    } while (std::filesystem::exists(path_));
+  }
+  TempFile(const TempFile&) = delete;
+  TempFile& operator=(const TempFile&) = delete;
+  ~TempFile() {
+    std::error_code ignored;
+    std::filesystem::remove(path_, ignored);
+  }
+
+  [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+
+ private:
+  std::filesystem::path path_;
+};
+
+// Streams are unbuffered: every read and write moves a whole block straight to or from its
+// buffer. Runs are not mapped with MappedFile: a mapping leaves the resident size to the page
+// cache instead of the budget, and the read ahead would still have to touch every page of the
+// next block on a second thread, which is what the explicit block reads already do. Writes
+// would also need every run file sized up front, since a mapping cannot grow its file.
+std::ifstream openRead(const std::filesystem::path& path, uint64_t offset) {
+  std::ifstream in;
+  in.rdbuf()->pubsetbuf(nullptr, 0);
+  in.open(path, std::ios::binary);
+  if (!in || !in.seekg(static_cast<std::streamoff>(offset))) {
+    throw std::runtime_error("externalSort: cannot read " + path.string());
+  }
+  return in;
+}
+
+std::ofstream openWrite(const std::filesystem::path& path) {
+  std::ofstream out;
+  out.rdbuf()->pubsetbuf(nullptr, 0);
+  out.open(path, std::ios::binary | std::ios::trunc);
+  if (!out) throw std::runtime_error("externalSort: cannot write " + path.string());
+  return out;
+}
+
+void readExact(std::ifstream& in, void* data, size_t bytes) {
+  in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+  if (static_cast<size_t>(in.gcount()) != bytes) throw std::runtime_error("externalSort: short read");
+}
+
+void writeExact(std::ofstream& out, const void* data, size_t bytes) {
+  if (!out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes))) {
+    throw std::runtime_error("externalSort: write failed");
+  }
+}
+
+struct Run {
+  uint64_t first;
+  uint64_t size;
+};
+
+// One input of a merge: the block being merged (front, consumed up to pos) and the block read
+// ahead (back, filled by next).
+template <class T>
+struct RunReader {
+  std::ifstream in;
+  uint64_t left = 0;
+  std::vector<T> front;
+  std::vector<T> back;
+  size_t pos = 0;
+  size_t size = 0;
+  std::future<size_t> next;
+
+  void readAhead() {
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(left, back.size()));
+    left -= count;
+    next = std::async(std::launch::async, [this, count] {
+      readExact(in, back.data(), count * sizeof(T));
+      return count;
+    });
+  }
+
+  // true when keys are left in front or on the way
+  bool refill() {
+    if (pos < size) return true;
+    if (!next.valid()) return false;
+    size = next.get();
+    pos = 0;
+    std::swap(front, back);
+    if (left > 0) readAhead();
+    return true;
+  }
+
+  [[nodiscard]] bool exhaustedAfterFront() const { return left == 0 && !next.valid(); }
+};
+
+// Merges the runs of path into out, turning the keys back from the ordered mapping when last.
+template <class Key>
+void mergeRuns(const std::filesystem::path& path, const std::vector<Run>& runs, std::ofstream& out,
+               size_t memory_budget, bool last, int threads) {
+  using T = Bits<Key>;
+  const size_t block_keys = std::max<size_t>(1, memory_budget / 4 * 3 / (2 * runs.size()) / sizeof(T));
+  const size_t out_keys = std::max<size_t>(1, memory_budget / 8 / sizeof(T));
+
+  std::vector<RunReader<T>> readers(runs.size());
+  for (size_t i = 0; i < runs.size(); ++i) {
+    auto& reader = readers[i];
+    reader.in = openRead(path, runs[i].first * sizeof(T));
+    reader.left = runs[i].size;
+    reader.front.resize(static_cast<size_t>(std::min<uint64_t>(block_keys, runs[i].size)));
+    reader.back.resize(reader.front.size());
+    reader.readAhead();
+  }
+
+  std::vector<T> out_block(out_keys);
+  std::vector<T> written_block(out_keys);
+  size_t out_size = 0;
+  std::future<void> write;
+  auto flush = [&] {
+    if (write.valid()) write.get();
+    std::swap(out_block, written_block);
+    write = std::async(std::launch::async, [&, count = out_size] {
+      if (last) fromOrdered<Key>(written_block.data(), count);
+      writeExact(out, written_block.data(), count * sizeof(T));
+    });
+    out_size = 0;
+  };
+
+  std::vector<std::span<const T>> parts;
+  std::vector<size_t> owners;
+  for (;;) {
+    // every key up to the smallest last key of a block with more keys behind it can be merged now
+    T bound = std::numeric_limits<T>::max();
+    bool any = false;
+    for (auto& reader : readers) {
+      if (!reader.refill()) continue;
+      any = true;
+      if (!reader.exhaustedAfterFront()) bound = std::min(bound, reader.front[reader.size - 1]);
+    }
+    if (!any) break;
+
+    parts.clear();
+    owners.clear();
+    size_t total = 0;
+    for (size_t i = 0; i < readers.size(); ++i) {
+      auto& reader = readers[i];
+      if (reader.pos == reader.size) continue;
+      const T* first = reader.front.data() + reader.pos;
+      const T* end = std::upper_bound(first, first + (reader.size - reader.pos), bound);
+      if (end == first) continue;
+      parts.emplace_back(first, end);
+      owners.push_back(i);
+      total += parts.back().size();
+    }
+    const size_t take = std::min(total, out_keys - out_size);
+    if (take < total) {
+      const auto split = ppc::core::multiwaySplit(parts, take);
+      for (size_t i = 0; i < parts.size(); ++i) parts[i] = parts[i].first(split[i]);
+    }
+    ppc::core::multiwayMerge(parts, out_block.data() + out_size, threads);
+    for (size_t i = 0; i < parts.size(); ++i) readers[owners[i]].pos += parts[i].size();
+    out_size += take;
+    if (out_size == out_keys) flush();
+  }
+  if (out_size > 0) flush();
+  if (write.valid()) write.get();
+}
+
+}  // namespace
+
+template <class Key>
+ppc::core::ExternalSortStats ppc::core::externalSort(const std::string& input, const std::string& output,
+                                                     size_t memory_budget, const std::string& temp_dir,
+                                                     int threads) {
+  using T = Bits<Key>;
+  if (threads < 0) throw std::invalid_argument("externalSort: threads must not be negative");
+  if (memory_budget < kMinBudget) throw std::invalid_argument("externalSort: memory budget below 1 MiB");
+  std::error_code error;
+  const uint64_t bytes = std::filesystem::file_size(input, error);
+  if (error) throw std::runtime_error("externalSort: cannot read " + input);
+  if (bytes % sizeof(Key) != 0) throw std::invalid_argument("externalSort: input is not a whole number of keys");
+  const std::filesystem::path dir = temp_dir.empty() ? std::filesystem::temp_directory_path() : temp_dir.c_str();
+
+  ExternalSortStats stats;
+  stats.bytes = bytes;
+  const auto start = Clock::now();
+  const uint64_t n = bytes / sizeof(Key);
+  // a run, the run being read or written and the buffer of radixSort
+  const size_t run_keys = memory_budget / (3 * sizeof(T));
+
+  // output is opened, and so truncated, only once the whole input has been read, which lets the
+  // two name the same file
+  std::ifstream in = openRead(input, 0);
+  std::ofstream out;
+  if (n <= run_keys) {
+    std::vector<T> keys(static_cast<size_t>(n));
+    readExact(in, keys.data(), keys.size() * sizeof(T));
+    in.close();
+    out = openWrite(output);
+    toOrdered<Key>(keys.data(), keys.size());
+    radixSort(keys.data(), keys.size(), 0, threads);
+    fromOrdered<Key>(keys.data(), keys.size());
+    writeExact(out, keys.data(), keys.size() * sizeof(T));
+    stats.runs = n > 0 ? 1 : 0;
+    stats.run_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  } else {
+    TempFile runs_file(dir);
+    std::vector<Run> runs;
+    {
+      std::ofstream runs_out = openWrite(runs_file.path());
+      std::vector<T> current(run_keys);
+      std::vector<T> other(run_keys);
+      auto readRun = [&](std::vector<T>& keys, uint64_t first) {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(run_keys, n - first));
+        readExact(in, keys.data(), count * sizeof(T));
+        return count;
+      };
+      uint64_t first = 0;
+      size_t count = readRun(current, 0);
+      size_t sorted = 0;
+      // other holds the sorted run of the previous step, written while current is sorted and then
+      // refilled with the next run
+      while (count > 0) {
+        const uint64_t next = first + count;
+        auto io = std::async(std::launch::async, [&, sorted] {
+          if (sorted > 0) writeExact(runs_out, other.data(), sorted * sizeof(T));
+          return next < n ? readRun(other, next) : size_t{0};
+        });
+        toOrdered<Key>(current.data(), count);
+        radixSort(current.data(), count, 0, threads);
+        const size_t next_count = io.get();
+        runs.push_back({first, count});
+        std::swap(current, other);
+        sorted = count;
+        first = next;
+        count = next_count;
+      }
+      writeExact(runs_out, other.data(), sorted * sizeof(T));
+      runs_out.close();
+      if (!runs_out) throw std::runtime_error("externalSort: write failed");
+    }
+    in.close();
+    out = openWrite(output);
+    stats.runs = runs.size();
+    const auto merge_start = Clock::now();
+    stats.run_seconds = std::chrono::duration<double>(merge_start - start).count();
+
+    const size_t fan_in = std::max<size_t>(2, memory_budget / 4 * 3 / (2 * kMinBlockBytes));
+    std::unique_ptr<TempFile> source;
+    std::unique_ptr<TempFile> target;
+    const std::filesystem::path* path = &runs_file.path();
+    while (runs.size() > fan_in) {
+      target = std::make_unique<TempFile>(dir);
+      std::ofstream pass_out = openWrite(target->path());
+      std::vector<Run> merged;
+      for (size_t i = 0; i < runs.size(); i += fan_in) {
+        const std::vector<Run> group(runs.begin() + i, runs.begin() + std::min(i + fan_in, runs.size()));
+        mergeRuns<Key>(*path, group, pass_out, memory_budget, false, threads);
+        merged.push_back({group.front().first, group.back().first + group.back().size - group.front().first});
+      }
+      pass_out.close();
+      if (!pass_out) throw std::runtime_error("externalSort: write failed");
+      runs = std::move(merged);
+      source = std::move(target);
+      path = &source->path();
+      ++stats.merge_passes;
+    }
+    mergeRuns<Key>(*path, runs, out, memory_budget, true, threads);
+    ++stats.merge_passes;
+    stats.merge_seconds = std::chrono::duration<double>(Clock::now() - merge_start).count();
+  }
+  out.close();
+  if (!out) throw std::runtime_error("externalSort: cannot write " + output);
+
+  const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  stats.gigabytes_per_second = seconds > 0.0 ? static_cast<double>(bytes) / seconds * 1e-9 : 0.0;
+  return stats;
+}
+
+template ppc::core::ExternalSortStats ppc::core::externalSort<int32_t>(const std::string&, const std::string&, size_t,
+                                                                       const std::string&, int);
+template ppc::core::ExternalSortStats ppc::core::externalSort<uint32_t>(const std::string&, const std::string&,
+                                                                        size_t, const std::string&, int);
+template ppc::core::ExternalSortStats ppc::core::externalSort<int64_t>(const std::string&, const std::string&, size_t,
+                                                                       const std::string&, int);
+template ppc::core::ExternalSortStats ppc::core::externalSort<uint64_t>(const std::string&, const std::string&,
+                                                                        size_t, const std::string&, int);
+template ppc::core::ExternalSortStats ppc::core::externalSort<float>(const std::string&, const std::string&, size_t,
+                                                                     const std::string&, int);
+template ppc::core::ExternalSortStats ppc::core::externalSort<double>(const std::string&, const std::string&, size_t,
+                                                                      const std::string&, int);
@@ -0,0 +1,198 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/multiway_merge.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// below this many keys a thread team costs more than it saves
+constexpr size_t kParallelKeys = 1 << 16;
+
+template <class T>
+void mergeTwo(const T* a, const T* a_end, const T* b, const T* b_end, T* out) {
+  while (a != a_end && b != b_end) {
+    const bool take_b = *b < *a;
+    *out++ = take_b ? *b : *a;
+    b += take_b;
+    a += !take_b;
+  }
+  out = std::copy(a, a_end, out);
+  std::copy(b, b_end, out);
+}
+
+// Tournament over k sources: node 0 keeps the overall winner, internal nodes 1..k-1 keep the
+// loser of the match played there, and source i is the leaf k + i. Exhausted sources lose every
+// match, ties go to the lower source, so the merge is stable.
+template <class T>
+class LoserTree {
+ public:
+  LoserTree(std::vector<const T*> heads, std::vector<const T*> ends)
+      : heads_(std::move(heads)), ends_(std::move(ends)), nodes_(heads_.size()) {
+    nodes_[0] = play(1);
+  }
+
+  void merge(T* out, size_t n) {
+    const size_t k = heads_.size();
+    for (size_t i = 0; i < n; ++i) {
+      size_t winner = nodes_[0];
+      *out++ = *heads_[winner]++;
+      for (size_t node = (winner + k) / 2; node > 0; node /= 2) {
+        if (beats(nodes_[node], winner)) std::swap(nodes_[node], winner);
+      }
+      nodes_[0] = winner;
+    }
+  }
+
+ private:
+  bool beats(size_t a, size_t b) const {
+    if (heads_[a] == ends_[a]) return false;
+    if (heads_[b] == ends_[b]) return true;
+    if (*heads_[a] < *heads_[b]) return true;
+    if (*heads_[b] < *heads_[a]) return false;
+    return a < b;
+  }
+
+  // plays the matches below node and returns the winner
+  size_t play(size_t node) {
+    const size_t k = heads_.size();
+    if (node >= k) return node - k;
+    const size_t left = play(2 * node);
+    const size_t right = play(2 * node + 1);
+    if (beats(left, right)) {
+      nodes_[node] = right;
+      return left;
+    }
+    nodes_[node] = left;
+    return right;
+  }
+
+  std::vector<const T*> heads_;
+  std::vector<const T*> ends_;
+  std::vector<size_t> nodes_;
+};
+
+}  // namespace
+
+template <class T>
+std::vector<size_t> ppc::core::multiwaySplit(const std::vector<std::span<const T>>& runs, size_t rank) {
+  const size_t k = runs.size();
+  // the split of run i lies in [lo[i], hi[i]]; keys are ordered by (value, run) so none are equal
+  std::vector<size_t> lo(k, 0);
+  std::vector<size_t> hi(k);
+  std::vector<size_t> below(k);
+  for (size_t i = 0; i < k; ++i) hi[i] = runs[i].size();
+  for (;;) {
+    size_t j = 0;
+    for (size_t i = 1; i < k; ++i) {
+      if (hi[i] - lo[i] > hi[j] - lo[j]) j = i;
+    }
+    if (k == 0 || lo[j] == hi[j]) return lo;
+    const size_t mid = lo[j] + (hi[j] - lo[j]) / 2;
+    const T& pivot = runs[j][mid];
+    size_t less = 0;
+    for (size_t i = 0; i < k; ++i) {
+      const auto first = runs[i].begin() + lo[i];
+      const auto last = runs[i].begin() + hi[i];
+      if (i < j) {
+        below[i] = std::upper_bound(first, last, pivot) - runs[i].begin();
+      } else if (i > j) {
+        below[i] = std::lower_bound(first, last, pivot) - runs[i].begin();
+      } else {
+        below[i] = mid;
+      }
+      less += below[i];
+    }
+    if (less < rank) {
+      // the pivot and everything before it belong to the first rank keys
+      for (size_t i = 0; i < k; ++i) lo[i] = std::max(lo[i], below[i]);
+      lo[j] = mid + 1;
+    } else {
+      for (size_t i = 0; i < k; ++i) hi[i] = std::min(hi[i], below[i]);
+    }
+  }
+}
+
+template <class T>
+void ppc::core::multiwayMergePart(const std::vector<std::span<const T>>& runs, const std::vector<size_t>& first,
+                                  const std::vector<size_t>& last, T* out) {
+  std::vector<const T*> heads;
+  std::vector<const T*> ends;
+  size_t n = 0;
+  for (size_t i = 0; i < runs.size(); ++i) {
+    if (first[i] == last[i]) continue;
+    heads.push_back(runs[i].data() + first[i]);
+    ends.push_back(runs[i].data() + last[i]);
+    n += last[i] - first[i];
+  }
+  if (heads.size() == 1) {
+    std::copy(heads[0], ends[0], out);
+  } else if (heads.size() == 2) {
+    mergeTwo(heads[0], ends[0], heads[1], ends[1], out);
+  } else if (heads.size() > 2) {
+    LoserTree<T>(std::move(heads), std::move(ends)).merge(out, n);
+  }
+}
+
+template <class T>
+void ppc::core::multiwayMerge(const std::vector<std::span<const T>>& runs, T* out, int threads) {
+  if (threads < 0) throw std::invalid_argument("multiwayMerge: threads must not be negative");
+  size_t n = 0;
+  for (const auto& run : runs) n += run.size();
+  int team = 1;
+#ifdef _OPENMP
+  if (n >= kParallelKeys && !omp_in_parallel()) team = threads == 0 ? omp_get_max_threads() : threads;
+#endif
+  // splits[t]: where the share of thread t starts in every run
+  std::vector<std::vector<size_t>> splits(team + 1);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(team)
+#endif
+  {
+    int t = 0;
+#ifdef _OPENMP
+#pragma omp single
+    team = omp_get_num_threads();
+    t = omp_get_thread_num();
+#endif
+    const size_t first = n * t / team;
+    const size_t last = n * (t + 1) / team;
+    splits[t] = multiwaySplit(runs, first);
+    if (t + 1 == team) splits[team] = multiwaySplit(runs, last);
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+    multiwayMergePart(runs, splits[t], splits[t + 1], out + first);
+  }
+}
+
+template void ppc::core::multiwayMerge(const std::vector<std::span<const int32_t>>&, int32_t*, int);
+template void ppc::core::multiwayMerge(const std::vector<std::span<const uint32_t>>&, uint32_t*, int);
+template void ppc::core::multiwayMerge(const std::vector<std::span<const int64_t>>&, int64_t*, int);
+template void ppc::core::multiwayMerge(const std::vector<std::span<const uint64_t>>&, uint64_t*, int);
+template void ppc::core::multiwayMerge(const std::vector<std::span<const float>>&, float*, int);
+template void ppc::core::multiwayMerge(const std::vector<std::span<const double>>&, double*, int);
+template std::vector<size_t> ppc::core::multiwaySplit(const std::vector<std::span<const int32_t>>&, size_t);
+template std::vector<size_t> ppc::core::multiwaySplit(const std::vector<std::span<const uint32_t>>&, size_t);
+template std::vector<size_t> ppc::core::multiwaySplit(const std::vector<std::span<const int64_t>>&, size_t);
+template std::vector<size_t> ppc::core::multiwaySplit(const std::vector<std::span<const uint64_t>>&, size_t);
+template std::vector<size_t> ppc::core::multiwaySplit(const std::vector<std::span<const float>>&, size_t);
+template std::vector<size_t> ppc::core::multiwaySplit(const std::vector<std::span<const double>>&, size_t);
+template void ppc::core::multiwayMergePart(const std::vector<std::span<const int32_t>>&, const std::vector<size_t>&,
+                                          const std::vector<size_t>&, int32_t*);
+template void ppc::core::multiwayMergePart(const std::vector<std::span<const uint32_t>>&, const std::vector<size_t>&,
+                                          const std::vector<size_t>&, uint32_t*);
+template void ppc::core::multiwayMergePart(const std::vector<std::span<const int64_t>>&, const std::vector<size_t>&,
+                                          const std::vector<size_t>&, int64_t*);
+template void ppc::core::multiwayMergePart(const std::vector<std::span<const uint64_t>>&, const std::vector<size_t>&,
+                                          const std::vector<size_t>&, uint64_t*);
+template void ppc::core::multiwayMergePart(const std::vector<std::span<const float>>&, const std::vector<size_t>&,
+                                          const std::vector<size_t>&, float*);
+template void ppc::core::multiwayMergePart(const std::vector<std::span<const double>>&, const std::vector<size_t>&,
+                                          const std::vector<size_t>&, double*);
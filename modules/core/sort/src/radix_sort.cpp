@@ -0,0 +1,336 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/radix_sort.hpp"
+
+#include "core/sort/include/ordered_bits.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__SSE2__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// below this many keys a thread team costs more than the sort
+constexpr size_t kParallelKeys = size_t{1} << 16;
+// below this many keys clearing 2048-bucket histograms costs more than the extra 8-bit passes
+constexpr size_t kWideDigitKeys = size_t{1} << 12;
+// from this many bytes on the keys no longer stay in cache between passes and the scatter goes
+// through staging lines; wider digits than kStagedDigitBits would need a staging area beyond L2
+constexpr size_t kStagedBytes = size_t{1} << 24;
+constexpr int kStagedDigitBits = 11;
+constexpr size_t kLineBytes = 64;
+
+template <class Key>
+using Bits = ppc::core::OrderedBits<Key>;
+
+// Keys are moved as raw bits, so NaN payloads survive and no value goes through an FP register.
+template <class Key>
+Bits<Key> load(const Key* p) {
+  Bits<Key> bits;
+  std::memcpy(&bits, p, sizeof(bits));
+  return bits;
+}
+
+template <class Key>
+void store(Key* p, Bits<Key> bits) {
+  std::memcpy(p, &bits, sizeof(bits));
+}
+
+template <class Key>
+void streamStore(Key* p, Bits<Key> bits) {
+#if defined(__SSE2__) && defined(__x86_64__)
+  if constexpr (sizeof(Key) == 8) {
+    _mm_stream_si64(reinterpret_cast<long long*>(p), static_cast<long long>(bits));
+  } else {
+    _mm_stream_si32(reinterpret_cast<int*>(p), static_cast<int>(bits));
+  }
+#else
+  store(p, bits);
+#endif
+}
+
+// slot of p within its cache line
+template <class Key>
+size_t lineSlot(const Key* p) {
+  return reinterpret_cast<uintptr_t>(p) / sizeof(Key) % (kLineBytes / sizeof(Key));
+}
+
+// Where one thread writes in one pass: offsets[d] is the position of its next key of digit d.
+// With stage set, keys are first collected per digit in a cache line's worth of slots laid out
+// like dst, and a full line goes out at once with non-temporal stores: dst lines are never read
+// for ownership, the source and the histograms stay in cache, and the number of open write
+// streams no longer has to fit the write-combining buffers of the core.
+// A payload of kPayload bytes per key, kept in its own array, follows every move of its key.
+template <class Key>
+struct Scatter {
+  const Key* src;
+  Key* dst;
+  const unsigned char* src_payload;
+  unsigned char* dst_payload;
+  size_t first;
+  size_t last;
+  int shift;
+  Bits<Key> mask;
+  size_t* offsets;
+  Bits<Key>* stage;
+};
+
+// The first pass reads the original keys and the last one writes them back; the passes in
+// between move the order-preserving images.
+template <class Key, size_t kPayload, bool kFirst, bool kLast>
+void scatterDirect(const Scatter<Key>& s) {
+  for (size_t i = s.first; i < s.last; ++i) {
+    Bits<Key> bits = load(s.src + i);
+    if constexpr (kFirst) bits = ppc::core::toOrderedBits<Key>(bits);
+    const size_t pos = s.offsets[(bits >> s.shift) & s.mask]++;
+    store(s.dst + pos, kLast ? ppc::core::fromOrderedBits<Key>(bits) : bits);
+    if constexpr (kPayload > 0) std::memcpy(s.dst_payload + pos * kPayload, s.src_payload + i * kPayload, kPayload);
+  }
+}
+
+// keys only: payloads would need staging lines of their own
+template <class Key, bool kFirst, bool kLast>
+void scatterStaged(const Scatter<Key>& s, size_t buckets) {
+  constexpr size_t kLine = kLineBytes / sizeof(Key);
+  // the first line of a digit may start before this thread's range of it
+  std::vector<size_t> begin(s.offsets, s.offsets + buckets);
+  for (size_t i = s.first; i < s.last; ++i) {
+    Bits<Key> bits = load(s.src + i);
+    if constexpr (kFirst) bits = ppc::core::toOrderedBits<Key>(bits);
+    const size_t d = (bits >> s.shift) & s.mask;
+    const size_t pos = s.offsets[d]++;
+    const size_t slot = lineSlot(s.dst + pos);
+    Bits<Key>* line = s.stage + d * kLine;
+    line[slot] = kLast ? ppc::core::fromOrderedBits<Key>(bits) : bits;
+    if (slot == kLine - 1) {
+      // keys of this digit in the line before pos; the line may also hold the end of another digit
+      const size_t run = std::min(slot, pos - begin[d]);
+      for (size_t j = slot - run; j <= slot; ++j) streamStore(s.dst + pos - (slot - j), line[j]);
+    }
+  }
+  for (size_t d = 0; d < buckets; ++d) {
+    if (s.offsets[d] == begin[d]) continue;
+    const size_t tail = s.offsets[d] - 1;
+    const size_t slot = lineSlot(s.dst + tail);
+    if (slot == kLine - 1) continue;
+    const size_t run = std::min(slot, tail - begin[d]);
+    const Bits<Key>* line = s.stage + d * kLine;
+    for (size_t j = slot - run; j <= slot; ++j) store(s.dst + tail - (slot - j), line[j]);
+  }
+#if defined(__SSE2__) && defined(__x86_64__)
+  _mm_sfence();
+#endif
+}
+
+template <class Key, size_t kPayload, bool kFirst, bool kLast>
+void scatter(const Scatter<Key>& s, size_t buckets) {
+  if constexpr (kPayload == 0) {
+    if (s.stage != nullptr) {
+      scatterStaged<Key, kFirst, kLast>(s, buckets);
+      return;
+    }
+  }
+  scatterDirect<Key, kPayload, kFirst, kLast>(s);
+}
+
+template <class Key, size_t kPayload>
+void scatterPass(bool first_pass, bool last_pass, const Scatter<Key>& s, size_t buckets) {
+  if (first_pass && last_pass) {
+    scatter<Key, kPayload, true, true>(s, buckets);
+  } else if (first_pass) {
+    scatter<Key, kPayload, true, false>(s, buckets);
+  } else if (last_pass) {
+    scatter<Key, kPayload, false, true>(s, buckets);
+  } else {
+    scatter<Key, kPayload, false, false>(s, buckets);
+  }
+}
+
+template <class Key, size_t kPayload>
+void radixSortImpl(Key* data, unsigned char* payload, size_t n, int digit_bits, int max_threads,
+                   Key* scratch = nullptr) {
+  if (digit_bits == 0) digit_bits = n < kWideDigitKeys ? 8 : 11;
+  if (digit_bits < 1 || digit_bits > 16) throw std::invalid_argument("radixSort: digit_bits must be in [1, 16]");
+  if (max_threads < 0) throw std::invalid_argument("radixSort: threads must not be negative");
+  if (n < 2) return;
+
+  constexpr int kKeyBits = sizeof(Key) * 8;
+  const int passes = (kKeyBits + digit_bits - 1) / digit_bits;
+  const size_t buckets = size_t{1} << digit_bits;
+  const Bits<Key> mask = static_cast<Bits<Key>>(buckets - 1);
+
+  int threads = 1;
+#ifdef _OPENMP
+  if (n >= kParallelKeys && !omp_in_parallel()) threads = max_threads == 0 ? omp_get_max_threads() : max_threads;
+#endif
+  // counts[t][p * buckets + d]: keys with digit d at pass p in the range of thread t; before a
+  // pass the row of that pass becomes the position where thread t writes its first key of digit d
+  std::vector<std::vector<size_t>> counts(threads);
+  std::vector<int> order;
+  // left uninitialized, so its pages are first touched by the threads that scatter into them
+  std::unique_ptr<Key[]> buffer(scratch == nullptr ? new Key[n] : nullptr);
+  Key* const keys_buffer = scratch == nullptr ? buffer.get() : scratch;
+  std::unique_ptr<unsigned char[]> payload_buffer(kPayload > 0 ? new unsigned char[n * kPayload] : nullptr);
+  const bool staged = kPayload == 0 && digit_bits <= kStagedDigitBits && n * sizeof(Key) >= kStagedBytes;
+  const size_t stage_size = staged ? buckets * (kLineBytes / sizeof(Key)) : 0;
+  std::vector<Bits<Key>> stages(stage_size * threads);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads)
+#endif
+  {
+    int t = 0;
+#ifdef _OPENMP
+#pragma omp single
+    threads = omp_get_num_threads();
+    t = omp_get_thread_num();
+#endif
+    const size_t first = n * t / threads;
+    const size_t last = n * (t + 1) / threads;
+    std::vector<size_t>& count = counts[t];
+    count.assign(static_cast<size_t>(passes) * buckets, 0);
+    for (size_t i = first; i < last; ++i) {
+      const Bits<Key> bits = ppc::core::toOrderedBits<Key>(load(data + i));
+      for (int p = 0; p < passes; ++p) ++count[p * buckets + ((bits >> (p * digit_bits)) & mask)];
+    }
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+    {
+      // a digit shared by all keys leaves the order as it is, so its pass is skipped
+      for (int p = 0; p < passes; ++p) {
+        bool constant = false;
+        for (size_t d = 0; d < buckets && !constant; ++d) {
+          size_t total = 0;
+          for (int u = 0; u < threads; ++u) total += counts[u][p * buckets + d];
+          constant = total == n;
+        }
+        if (!constant) order.push_back(p);
+      }
+    }
+
+    Key* src = data;
+    Key* dst = keys_buffer;
+    unsigned char* src_payload = payload;
+    unsigned char* dst_payload = payload_buffer.get();
+    const size_t steps = order.size();
+    for (size_t step = 0; step < steps; ++step) {
+      const int p = order[step];
+      size_t* offsets = count.data() + p * buckets;
+      if (step > 0 && threads > 1) {
+        // the keys of this thread's range changed with the previous pass, the serial counts did not
+        std::fill(offsets, offsets + buckets, 0);
+        for (size_t i = first; i < last; ++i) ++offsets[(load(src + i) >> (p * digit_bits)) & mask];
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+      }
+#ifdef _OPENMP
+#pragma omp single
+#endif
+      {
+        size_t offset = 0;
+        for (size_t d = 0; d < buckets; ++d) {
+          for (int u = 0; u < threads; ++u) {
+            const size_t keys = counts[u][p * buckets + d];
+            counts[u][p * buckets + d] = offset;
+            offset += keys;
+          }
+        }
+      }
+      Bits<Key>* stage = staged ? stages.data() + t * stage_size : nullptr;
+      const Scatter<Key> pass{src, dst, src_payload, dst_payload, first, last, p * digit_bits, mask, offsets, stage};
+      scatterPass<Key, kPayload>(step == 0, step + 1 == steps, pass, buckets);
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+      std::swap(src, dst);
+      std::swap(src_payload, dst_payload);
+    }
+    if (src != data) {
+      std::memcpy(data + first, src + first, (last - first) * sizeof(Key));
+      if constexpr (kPayload > 0) {
+        std::memcpy(payload + first * kPayload, src_payload + first * kPayload, (last - first) * kPayload);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <class Key>
+void ppc::core::radixSort(Key* data, size_t n, int digit_bits, int threads) {
+  radixSortImpl<Key, 0>(data, nullptr, n, digit_bits, threads);
+}
+
+template <class Key>
+void ppc::core::radixSort(Key* data, size_t n, Key* scratch, int digit_bits, int threads) {
+  if (scratch == nullptr && n >= 2) throw std::invalid_argument("radixSort: scratch must not be null");
+  radixSortImpl<Key, 0>(data, nullptr, n, digit_bits, threads, scratch);
+}
+
+template <class Key>
+void ppc::core::radixSortPayload(Key* keys, void* payload, size_t payload_bytes, size_t n, int digit_bits,
+                                 int threads) {
+  auto* bytes = static_cast<unsigned char*>(payload);
+  if (payload_bytes == 4) {
+    radixSortImpl<Key, 4>(keys, bytes, n, digit_bits, threads);
+  } else if (payload_bytes == 8) {
+    radixSortImpl<Key, 8>(keys, bytes, n, digit_bits, threads);
+  } else {
+    throw std::invalid_argument("radixSortPayload: payload_bytes must be 4 or 8");
+  }
+}
+
+template <class Key>
+std::vector<uint32_t> ppc::core::radixArgsort(const Key* keys, size_t n, int digit_bits, int threads) {
+  if (n > std::numeric_limits<uint32_t>::max()) throw std::invalid_argument("radixArgsort: too many keys");
+  std::vector<Key> sorted(keys, keys + n);
+  std::vector<uint32_t> index(n);
+  std::iota(index.begin(), index.end(), 0);
+  radixSortImpl<Key, sizeof(uint32_t)>(sorted.data(), reinterpret_cast<unsigned char*>(index.data()), n, digit_bits,
+                                       threads);
+  return index;
+}
+
+template void ppc::core::radixSort(int32_t*, size_t, int, int);
+template void ppc::core::radixSort(uint32_t*, size_t, int, int);
+template void ppc::core::radixSort(int64_t*, size_t, int, int);
+template void ppc::core::radixSort(uint64_t*, size_t, int, int);
+template void ppc::core::radixSort(float*, size_t, int, int);
+template void ppc::core::radixSort(double*, size_t, int, int);
+
+template void ppc::core::radixSort(int32_t*, size_t, int32_t*, int, int);
+template void ppc::core::radixSort(uint32_t*, size_t, uint32_t*, int, int);
+template void ppc::core::radixSort(int64_t*, size_t, int64_t*, int, int);
+template void ppc::core::radixSort(uint64_t*, size_t, uint64_t*, int, int);
+template void ppc::core::radixSort(float*, size_t, float*, int, int);
+template void ppc::core::radixSort(double*, size_t, double*, int, int);
+
+template void ppc::core::radixSortPayload(int32_t*, void*, size_t, size_t, int, int);
+template void ppc::core::radixSortPayload(uint32_t*, void*, size_t, size_t, int, int);
+template void ppc::core::radixSortPayload(int64_t*, void*, size_t, size_t, int, int);
+template void ppc::core::radixSortPayload(uint64_t*, void*, size_t, size_t, int, int);
+template void ppc::core::radixSortPayload(float*, void*, size_t, size_t, int, int);
+template void ppc::core::radixSortPayload(double*, void*, size_t, size_t, int, int);
+template std::vector<uint32_t> ppc::core::radixArgsort(const int32_t*, size_t, int, int);
+template std::vector<uint32_t> ppc::core::radixArgsort(const uint32_t*, size_t, int, int);
+template std::vector<uint32_t> ppc::core::radixArgsort(const int64_t*, size_t, int, int);
+template std::vector<uint32_t> ppc::core::radixArgsort(const uint64_t*, size_t, int, int);
+template std::vector<uint32_t> ppc::core::radixArgsort(const float*, size_t, int, int);
+template std::vector<uint32_t> ppc::core::radixArgsort(const double*, size_t, int, int);
@@ -0,0 +1,354 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/selection.hpp"
+
+#include "core/sort/include/ordered_bits.hpp"
+#include "core/sort/include/radix_sort.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// below this many keys a thread team costs more than it saves
+constexpr size_t kParallelKeys = size_t{1} << 16;
+constexpr int kDigitBits = 11;
+constexpr size_t kBuckets = size_t{1} << kDigitBits;
+// up to this k every thread keeps a heap, larger k go through radixSelect
+constexpr size_t kHeapKeys = 1 << 10;
+// a bucket with more keys than this goes through another histogram level instead of nth_element
+constexpr size_t kNarrowKeys = size_t{1} << 14;
+
+template <class Key>
+using Bits = ppc::core::OrderedBits<Key>;
+
+int teamSize(size_t n, int threads) {
+  if (threads < 0) throw std::invalid_argument("selection: threads must not be negative");
+  int team = 1;
+#ifdef _OPENMP
+  if (n >= kParallelKeys && !omp_in_parallel()) team = threads == 0 ? omp_get_max_threads() : threads;
+#endif
+  return team;
+}
+
+// Runs body(t, first, last) on equal chunks of [0, n), one per thread of a team of at most team
+// threads; per-thread results sized by team leave the slots of missing threads untouched.
+template <class Body>
+void forChunks(size_t n, int team, const Body& body) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(team)
+#endif
+  {
+    size_t t = 0;
+    size_t size = 1;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+    size = omp_get_num_threads();
+#endif
+    body(t, n * t / size, n * (t + 1) / size);
+  }
+}
+
+// Keys gathered by an earlier level, already as ordered bits; one type for every deeper level, so
+// the recursion of selectLevel instantiates once.
+template <class T>
+struct GatheredBits {
+  const T* keys;
+  T operator()(size_t i) const { return keys[i]; }
+};
+
+// Sets selected[r] to the key at position ranks[r] of the sorted keys get(0), ..., get(n - 1),
+// given as ordered bits.
+template <class T, class Get>
+void selectLevel(size_t n, const Get& get, const std::vector<size_t>& ranks, std::vector<T>& selected, int threads) {
+  const int team = teamSize(n, threads);
+
+  std::vector<T> lows(team, std::numeric_limits<T>::max());
+  std::vector<T> highs(team, 0);
+  forChunks(n, team, [&](size_t t, size_t first, size_t last) {
+    T low = std::numeric_limits<T>::max();
+    T high = 0;
+    for (size_t i = first; i < last; ++i) {
+      const T bits = get(i);
+      low = std::min(low, bits);
+      high = std::max(high, bits);
+    }
+    lows[t] = low;
+    highs[t] = high;
+  });
+  const T low = *std::min_element(lows.begin(), lows.end());
+  const T high = *std::max_element(highs.begin(), highs.end());
+  if (low == high) {
+    std::fill(selected.begin(), selected.end(), low);
+    return;
+  }
+
+  // the bits above the highest differing one are the same in every key
+  const int shift = std::max(0, static_cast<int>(std::bit_width(low ^ high)) - kDigitBits);
+  auto digit = [shift](T bits) { return static_cast<size_t>(bits >> shift) & (kBuckets - 1); };
+  std::vector<std::vector<size_t>> counts(team);
+  forChunks(n, team, [&](size_t t, size_t first, size_t last) {
+    auto& count = counts[t];
+    count.assign(kBuckets, 0);
+    for (size_t i = first; i < last; ++i) ++count[digit(get(i))];
+  });
+  // starts[d]: the rank of the first key in bucket d
+  std::vector<size_t> starts(kBuckets + 1, 0);
+  for (const auto& count : counts) {
+    if (count.empty()) continue;
+    for (size_t d = 0; d < kBuckets; ++d) starts[d + 1] += count[d];
+  }
+  std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+  // wanted[d]: the index of bucket d among the buckets holding a rank, -1 for the others
+  std::vector<int> wanted(kBuckets, -1);
+  std::vector<size_t> buckets;
+  std::vector<size_t> bucket_of(ranks.size());
+  for (size_t r = 0; r < ranks.size(); ++r) {
+    const size_t d = std::upper_bound(starts.begin(), starts.end(), ranks[r]) - starts.begin() - 1;
+    if (wanted[d] < 0) {
+      wanted[d] = static_cast<int>(buckets.size());
+      buckets.push_back(d);
+    }
+    bucket_of[r] = wanted[d];
+  }
+  std::vector<std::vector<std::vector<T>>> gathered(team);
+  forChunks(n, team, [&](size_t t, size_t first, size_t last) {
+    auto& local = gathered[t];
+    local.resize(buckets.size());
+    for (size_t i = first; i < last; ++i) {
+      const T bits = get(i);
+      const int w = wanted[digit(bits)];
+      if (w >= 0) local[w].push_back(bits);
+    }
+  });
+
+  std::vector<size_t> order(ranks.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ranks[a] < ranks[b]; });
+  for (size_t w = 0; w < buckets.size(); ++w) {
+    std::vector<T> keys;
+    for (const auto& local : gathered) {
+      if (!local.empty()) keys.insert(keys.end(), local[w].begin(), local[w].end());
+    }
+    if (keys.size() > kNarrowKeys) {
+      // skewed keys crowd one bucket: its keys share every bit from shift up, so the next level
+      // picks its digit from the bits below and the bucket shrinks by up to 2^11 again
+      std::vector<size_t> inner_ranks;
+      std::vector<size_t> inner_of;
+      for (size_t r : order) {
+        if (bucket_of[r] != w) continue;
+        inner_ranks.push_back(ranks[r] - starts[buckets[w]]);
+        inner_of.push_back(r);
+      }
+      std::vector<T> inner(inner_ranks.size());
+      selectLevel(keys.size(), GatheredBits<T>{keys.data()}, inner_ranks, inner, threads);
+      for (size_t i = 0; i < inner.size(); ++i) selected[inner_of[i]] = inner[i];
+      continue;
+    }
+    // ranks of one bucket in ascending order, each nth_element on what the previous left above it
+    auto from = keys.begin();
+    for (size_t r : order) {
+      if (bucket_of[r] != w) continue;
+      const auto nth = keys.begin() + static_cast<std::ptrdiff_t>(ranks[r] - starts[buckets[w]]);
+      std::nth_element(from, nth, keys.end());
+      selected[r] = *nth;
+      from = nth;
+    }
+  }
+}
+
+// The ordered bits of the keys at the given ranks, in the order of ranks.
+template <class Key>
+std::vector<Bits<Key>> selectBits(const Key* data, size_t n, const std::vector<size_t>& ranks, int threads) {
+  for (size_t rank : ranks) {
+    if (rank >= n) throw std::out_of_range("selection: rank out of range");
+  }
+  std::vector<Bits<Key>> selected(ranks.size());
+  selectLevel(n, [data](size_t i) { return ppc::core::orderedBits(data[i]); }, ranks, selected, threads);
+  return selected;
+}
+
+}  // namespace
+
+template <class Key>
+Key ppc::core::radixSelect(const Key* data, size_t n, size_t rank, int threads) {
+  return keyFromOrderedBits<Key>(selectBits(data, n, {rank}, threads)[0]);
+}
+
+template <class Key>
+std::vector<Key> ppc::core::quantiles(const Key* data, size_t n, const std::vector<double>& levels, int threads) {
+  if (n == 0) throw std::invalid_argument("quantiles: no keys");
+  std::vector<size_t> ranks;
+  for (double q : levels) {
+    if (!(q >= 0.0 && q <= 1.0)) throw std::invalid_argument("quantiles: levels must lie in [0, 1]");
+    ranks.push_back(static_cast<size_t>(std::llround(q * static_cast<double>(n - 1))));
+  }
+  std::vector<Key> keys;
+  for (auto bits : selectBits(data, n, ranks, threads)) keys.push_back(keyFromOrderedBits<Key>(bits));
+  return keys;
+}
+
+template <class Key>
+std::vector<Key> ppc::core::topK(const Key* data, size_t n, size_t k, int threads) {
+  using T = Bits<Key>;
+  k = std::min(k, n);
+  if (k == 0) {
+    teamSize(n, threads);
+    return {};
+  }
+  const int team = teamSize(n, threads);
+  std::vector<std::vector<T>> locals(team);
+  if (k <= kHeapKeys) {
+    forChunks(n, team, [&](size_t t, size_t first, size_t last) {
+      auto& heap = locals[t];
+      heap.reserve(k);
+      for (size_t i = first; i < last; ++i) {
+        const T bits = orderedBits(data[i]);
+        if (heap.size() < k) {
+          heap.push_back(bits);
+          std::push_heap(heap.begin(), heap.end());
+        } else if (bits < heap.front()) {
+          std::pop_heap(heap.begin(), heap.end());
+          heap.back() = bits;
+          std::push_heap(heap.begin(), heap.end());
+        }
+      }
+    });
+  } else {
+    const T kth = selectBits(data, n, {k - 1}, threads)[0];
+    forChunks(n, team, [&](size_t t, size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        const T bits = orderedBits(data[i]);
+        if (bits < kth) locals[t].push_back(bits);
+      }
+    });
+    // the keys below the k-th are fewer than k, copies of it make up the rest
+    size_t below = 0;
+    for (const auto& local : locals) below += local.size();
+    locals[0].insert(locals[0].end(), k - below, kth);
+  }
+  std::vector<T> smallest;
+  for (const auto& local : locals) smallest.insert(smallest.end(), local.begin(), local.end());
+  if (k <= kHeapKeys) {
+    std::sort(smallest.begin(), smallest.end());
+  } else {
+    radixSort(smallest, 0, threads);
+  }
+  std::vector<Key> keys(k);
+  for (size_t i = 0; i < k; ++i) keys[i] = keyFromOrderedBits<Key>(smallest[i]);
+  return keys;
+}
+
+template <class Key>
+void ppc::core::nthElement(Key* data, size_t n, size_t nth, int threads) {
+  using T = Bits<Key>;
+  const T pivot = selectBits(data, n, {nth}, threads)[0];
+  const int team = teamSize(n, threads);
+  // counts[t]: the keys of chunk t below and equal to the pivot
+  std::vector<std::pair<size_t, size_t>> counts(team + 1);
+  std::unique_ptr<Key[]> buffer(new Key[n]);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(team)
+#endif
+  {
+    size_t t = 0;
+    size_t size = 1;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+    size = omp_get_num_threads();
+#endif
+    const size_t first = n * t / size;
+    const size_t last = n * (t + 1) / size;
+    size_t below = 0;
+    size_t equal = 0;
+    for (size_t i = first; i < last; ++i) {
+      const T bits = orderedBits(data[i]);
+      below += static_cast<size_t>(bits < pivot);
+      equal += static_cast<size_t>(bits == pivot);
+    }
+    counts[t + 1] = {below, equal};
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+    // the keys below the pivot of all chunks come first, then the equal ones, then the rest
+    size_t all_below = 0;
+    size_t all_equal = 0;
+    size_t below_before = 0;
+    size_t equal_before = 0;
+    for (size_t c = 1; c <= size; ++c) {
+      if (c == t + 1) {
+        below_before = all_below;
+        equal_before = all_equal;
+      }
+      all_below += counts[c].first;
+      all_equal += counts[c].second;
+    }
+    // pos[0], pos[1], pos[2]: where the next key below, equal to and above the pivot goes; the
+    // part is computed rather than branched on, which random keys would mispredict
+    const size_t above_before = first - below_before - equal_before;
+    size_t pos[3] = {below_before, all_below + equal_before, all_below + all_equal + above_before};
+    for (size_t i = first; i < last; ++i) {
+      const T bits = orderedBits(data[i]);
+      const size_t part = static_cast<size_t>(bits >= pivot) + static_cast<size_t>(bits > pivot);
+      buffer[pos[part]++] = data[i];
+    }
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+    std::copy(buffer.get() + first, buffer.get() + last, data + first);
+  }
+}
+
+template <class Key>
+void ppc::core::partialSort(Key* data, size_t n, size_t k, int threads) {
+  k = std::min(k, n);
+  if (k == 0) {
+    teamSize(n, threads);
+    return;
+  }
+  if (k < n) nthElement(data, n, k - 1, threads);
+  radixSort(data, k, 0, threads);
+}
+
+template int32_t ppc::core::radixSelect(const int32_t*, size_t, size_t, int);
+template uint32_t ppc::core::radixSelect(const uint32_t*, size_t, size_t, int);
+template int64_t ppc::core::radixSelect(const int64_t*, size_t, size_t, int);
+template uint64_t ppc::core::radixSelect(const uint64_t*, size_t, size_t, int);
+template float ppc::core::radixSelect(const float*, size_t, size_t, int);
+template double ppc::core::radixSelect(const double*, size_t, size_t, int);
+template std::vector<int32_t> ppc::core::quantiles(const int32_t*, size_t, const std::vector<double>&, int);
+template std::vector<uint32_t> ppc::core::quantiles(const uint32_t*, size_t, const std::vector<double>&, int);
+template std::vector<int64_t> ppc::core::quantiles(const int64_t*, size_t, const std::vector<double>&, int);
+template std::vector<uint64_t> ppc::core::quantiles(const uint64_t*, size_t, const std::vector<double>&, int);
+template std::vector<float> ppc::core::quantiles(const float*, size_t, const std::vector<double>&, int);
+template std::vector<double> ppc::core::quantiles(const double*, size_t, const std::vector<double>&, int);
+template std::vector<int32_t> ppc::core::topK(const int32_t*, size_t, size_t, int);
+template std::vector<uint32_t> ppc::core::topK(const uint32_t*, size_t, size_t, int);
+template std::vector<int64_t> ppc::core::topK(const int64_t*, size_t, size_t, int);
+template std::vector<uint64_t> ppc::core::topK(const uint64_t*, size_t, size_t, int);
+template std::vector<float> ppc::core::topK(const float*, size_t, size_t, int);
+template std::vector<double> ppc::core::topK(const double*, size_t, size_t, int);
+template void ppc::core::nthElement(int32_t*, size_t, size_t, int);
+template void ppc::core::nthElement(uint32_t*, size_t, size_t, int);
+template void ppc::core::nthElement(int64_t*, size_t, size_t, int);
+template void ppc::core::nthElement(uint64_t*, size_t, size_t, int);
+template void ppc::core::nthElement(float*, size_t, size_t, int);
+template void ppc::core::nthElement(double*, size_t, size_t, int);
+template void ppc::core::partialSort(int32_t*, size_t, size_t, int);
+template void ppc::core::partialSort(uint32_t*, size_t, size_t, int);
+template void ppc::core::partialSort(int64_t*, size_t, size_t, int);
+template void ppc::core::partialSort(uint64_t*, size_t, size_t, int);
+template void ppc::core::partialSort(float*, size_t, size_t, int);
+template void ppc::core::partialSort(double*, size_t, size_t, int);
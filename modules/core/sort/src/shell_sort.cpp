@@ -0,0 +1,207 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/shell_sort.hpp"
+
+#include "core/sort/include/multiway_merge.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+namespace {
+
+// below this many keys a thread team costs more than it saves
+constexpr size_t kParallelKeys = 1 << 16;
+// at most this many ascending runs are merged instead of sorted
+constexpr size_t kMergeRuns = 64;
+// keys with at most one descent per kNearlySorted keys try insertion sort first, which gives up
+// after kInsertionMoves moves per key
+constexpr size_t kNearlySorted = 16;
+constexpr size_t kInsertionMoves = 8;
+constexpr size_t kLanes = 8;
+
+void hSortScalar(int32_t* data, size_t n, size_t h, size_t first) {
+  for (size_t i = first; i < n; ++i) {
+    const int32_t key = data[i];
+    size_t j = i;
+    for (; j >= h && key < data[j - h]; j -= h) data[j] = data[j - h];
+    data[j] = key;
+  }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+bool hasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+// Keys i .. i + 7 belong to eight different subsequences when h >= 8, and their predecessors
+// i - h .. i + 7 - h are already h-sorted, so the eight insertions run in lockstep: every step
+// loads the keys one gap back, lanes whose key is bigger shift it up, the others drop their key
+// into place and go idle.
+__attribute__((target("avx2"))) void hSortAvx2(int32_t* data, size_t n, size_t h) {
+  size_t i = h;
+  for (; i + kLanes <= n; i += kLanes) {
+    const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i active = _mm256_set1_epi32(-1);
+    size_t j = i;
+    for (; j >= h; j -= h) {
+      const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j - h));
+      const __m256i move = _mm256_and_si256(active, _mm256_cmpgt_epi32(prev, key));
+      if (_mm256_testz_si256(move, move) != 0) break;
+      __m256i slot = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j));
+      slot = _mm256_blendv_epi8(slot, key, _mm256_andnot_si256(move, active));
+      slot = _mm256_blendv_epi8(slot, prev, move);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + j), slot);
+      active = move;
+    }
+    if (j != i) {
+      const __m256i slot = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + j), _mm256_blendv_epi8(slot, key, active));
+    }
+  }
+  hSortScalar(data, n, h, i);
+}
+
+#else
+
+bool hasAvx2() { return false; }
+
+#endif
+
+void hSort(int32_t* data, size_t n, size_t h) {
+  static const bool avx2 = hasAvx2();
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  if (avx2 && h >= kLanes) {
+    hSortAvx2(data, n, h);
+    return;
+  }
+#endif
+  hSortScalar(data, n, h, h);
+}
+
+// Insertion sort that gives up after limit moves; the keys stay a permutation either way.
+bool insertionSortBounded(int32_t* data, size_t n, size_t limit) {
+  size_t moves = 0;
+  for (size_t i = 1; i < n; ++i) {
+    const int32_t key = data[i];
+    size_t j = i;
+    for (; j > 0 && key < data[j - 1]; --j) data[j] = data[j - 1];
+    data[j] = key;
+    moves += i - j;
+    if (moves > limit) return false;
+  }
+  return true;
+}
+
+void sortChunk(int32_t* data, size_t n, ppc::core::ShellGaps gaps) {
+  if (n < 2) return;
+  size_t descents = 0;
+  size_t ascents = 0;
+  for (size_t i = 1; i < n; ++i) {
+    descents += static_cast<size_t>(data[i] < data[i - 1]);
+    ascents += static_cast<size_t>(data[i - 1] < data[i]);
+  }
+  if (descents == 0) return;
+  if (ascents == 0) {
+    std::reverse(data, data + n);
+    return;
+  }
+  if (descents < kMergeRuns) {
+    std::vector<std::span<const int32_t>> runs;
+    size_t first = 0;
+    for (size_t i = 1; i <= n; ++i) {
+      if (i == n || data[i] < data[i - 1]) {
+        runs.emplace_back(data + first, i - first);
+        first = i;
+      }
+    }
+    std::unique_ptr<int32_t[]> merged(new int32_t[n]);
+    ppc::core::multiwayMerge(runs, merged.get(), 1);
+    std::memcpy(data, merged.get(), n * sizeof(int32_t));
+    return;
+  }
+  if (descents <= n / kNearlySorted && insertionSortBounded(data, n, kInsertionMoves * n)) return;
+  for (size_t h : ppc::core::shellGaps(n, gaps)) hSort(data, n, h);
+}
+
+}  // namespace
+
+std::vector<size_t> ppc::core::shellGaps(size_t n, ShellGaps gaps) {
+  std::vector<size_t> sequence;
+  if (n < 2) return sequence;
+  switch (gaps) {
+    case ShellGaps::kCiura:
+      for (size_t h : {1, 4, 10, 23, 57, 132, 301, 701, 1750}) {
+        if (h < n) sequence.push_back(h);
+      }
+      for (size_t h = 1750 * 9 / 4; sequence.back() >= 1750 && h < n; h = h * 9 / 4) sequence.push_back(h);
+      break;
+    case ShellGaps::kTokuda:
+      for (double h = 1.0; std::ceil(h) < static_cast<double>(n); h = 2.25 * h + 1.0) {
+        sequence.push_back(static_cast<size_t>(std::ceil(h)));
+      }
+      break;
+    case ShellGaps::kSedgewick:
+      sequence.push_back(1);
+      for (size_t k = 1; (size_t{1} << 2 * k) + 3 * (size_t{1} << (k - 1)) + 1 < n; ++k) {
+        sequence.push_back((size_t{1} << 2 * k) + 3 * (size_t{1} << (k - 1)) + 1);
+      }
+      break;
+    case ShellGaps::kHalving:
+      for (size_t h = n / 2; h > 0; h /= 2) sequence.insert(sequence.begin(), h);
+      break;
+  }
+  std::reverse(sequence.begin(), sequence.end());
+  return sequence;
+}
+
+void ppc::core::shellSort(int32_t* data, size_t n, ShellGaps gaps, int threads) {
+  if (threads < 0) throw std::invalid_argument("shellSort: threads must not be negative");
+  if (n < 2) return;
+  int team = 1;
+#ifdef _OPENMP
+  if (n >= kParallelKeys && !omp_in_parallel()) team = threads == 0 ? omp_get_max_threads() : threads;
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(team)
+#endif
+  {
+    int t = 0;
+#ifdef _OPENMP
+#pragma omp single
+    team = omp_get_num_threads();
+    t = omp_get_thread_num();
+#endif
+    const size_t first = n * t / team;
+    sortChunk(data + first, n * (t + 1) / team - first, gaps);
+  }
+  if (team == 1) return;
+
+  std::vector<std::span<const int32_t>> chunks;
+  bool ordered = true;
+  for (int t = 0; t < team; ++t) {
+    const size_t first = n * t / team;
+    const size_t last = n * (t + 1) / team;
+    if (first == last) continue;
+    if (!chunks.empty() && data[first] < chunks.back().back()) ordered = false;
+    chunks.emplace_back(data + first, last - first);
+  }
+  if (ordered) return;
+  // left uninitialized, so its pages are first touched by the threads that merge into them
+  std::unique_ptr<int32_t[]> merged(new int32_t[n]);
+  multiwayMerge(chunks, merged.get(), team);
+  std::memcpy(data, merged.get(), n * sizeof(int32_t));
+}
@@ -0,0 +1,339 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/sorting_network.hpp"
+
+#include "core/sort/include/multiway_merge.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+// a block is 8 x 8 keys, eight registers of eight lanes
+constexpr size_t kRun = 8;
+constexpr size_t kBlock = kRun * kRun;
+// below this many keys a thread team costs more than it saves
+constexpr size_t kParallelKeys = 1 << 16;
+
+// comparators of the optimal 8 input network, grouped by layers that touch disjoint keys
+constexpr int kNetwork8[19][2] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3},
+                                  {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+enum class Isa { kScalar, kAvx2, kAvx512 };
+
+void compareExchange(int32_t& a, int32_t& b) {
+  const int32_t lo = std::min(a, b);
+  b = std::max(a, b);
+  a = lo;
+}
+
+void sortRunScalar(int32_t* run) {
+  for (const auto& c : kNetwork8) compareExchange(run[c[0]], run[c[1]]);
+}
+
+void mergeScalar(const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out) {
+  const int32_t* a_end = a + na;
+  const int32_t* b_end = b + nb;
+  while (a != a_end && b != b_end) {
+    const bool take_b = *b < *a;
+    *out++ = take_b ? *b : *a;
+    b += take_b;
+    a += !take_b;
+  }
+  out = std::copy(a, a_end, out);
+  std::copy(b, b_end, out);
+}
+
+// Called once the vector loop stops: pending holds keys no larger than anything left in a and b,
+// and at least one of a and b has fewer keys than a vector.
+void mergeTail(const int32_t* pending, size_t np, const int32_t* a, const int32_t* a_end, const int32_t* b,
+               const int32_t* b_end, int32_t* out) {
+  if (a_end - a > b_end - b) {
+    std::swap(a, b);
+    std::swap(a_end, b_end);
+  }
+  int32_t head[32];
+  mergeScalar(pending, np, a, a_end - a, head);
+  mergeScalar(head, np + (a_end - a), b, b_end - b, out);
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+Isa detectIsa() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return Isa::kAvx512;
+  if (__builtin_cpu_supports("avx2")) return Isa::kAvx2;
+  return Isa::kScalar;
+}
+
+__attribute__((target("avx2"))) inline void minMax(__m256i& a, __m256i& b) {
+  const __m256i lo = _mm256_min_epi32(a, b);
+  b = _mm256_max_epi32(a, b);
+  a = lo;
+}
+
+// sorts a bitonic vector: compare-exchange at lane distances 4, 2 and 1
+__attribute__((target("avx2"))) inline __m256i bitonicFinish(__m256i x) {
+  __m256i t = _mm256_permute2x128_si256(x, x, 1);
+  x = _mm256_blend_epi32(_mm256_min_epi32(x, t), _mm256_max_epi32(x, t), 0xF0);
+  t = _mm256_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+  x = _mm256_blend_epi32(_mm256_min_epi32(x, t), _mm256_max_epi32(x, t), 0xCC);
+  t = _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm256_blend_epi32(_mm256_min_epi32(x, t), _mm256_max_epi32(x, t), 0xAA);
+}
+
+// sorted lo and hi become the lower and the upper half of their merge, both sorted
+__attribute__((target("avx2"))) inline void bitonicMerge(__m256i& lo, __m256i& hi) {
+  hi = _mm256_permutevar8x32_epi32(hi, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+  minMax(lo, hi);
+  lo = bitonicFinish(lo);
+  hi = bitonicFinish(hi);
+}
+
+__attribute__((target("avx2"))) void sortBlockAvx2(int32_t* block) {
+  __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 8));
+  __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 16));
+  __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 24));
+  __m256i r4 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+  __m256i r5 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 40));
+  __m256i r6 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 48));
+  __m256i r7 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 56));
+  // kNetwork8 on whole registers sorts the eight columns
+  minMax(r0, r2);
+  minMax(r1, r3);
+  minMax(r4, r6);
+  minMax(r5, r7);
+  minMax(r0, r4);
+  minMax(r1, r5);
+  minMax(r2, r6);
+  minMax(r3, r7);
+  minMax(r0, r1);
+  minMax(r2, r3);
+  minMax(r4, r5);
+  minMax(r6, r7);
+  minMax(r2, r4);
+  minMax(r3, r5);
+  minMax(r1, r4);
+  minMax(r3, r6);
+  minMax(r1, r2);
+  minMax(r3, r4);
+  minMax(r5, r6);
+  // transpose, so column c becomes run c
+  const __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+  const __m256i t1 = _mm256_unpackhi_epi32(r0, r1);
+  const __m256i t2 = _mm256_unpacklo_epi32(r2, r3);
+  const __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+  const __m256i t4 = _mm256_unpacklo_epi32(r4, r5);
+  const __m256i t5 = _mm256_unpackhi_epi32(r4, r5);
+  const __m256i t6 = _mm256_unpacklo_epi32(r6, r7);
+  const __m256i t7 = _mm256_unpackhi_epi32(r6, r7);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  auto* out = reinterpret_cast<__m256i*>(block);
+  _mm256_storeu_si256(out, _mm256_permute2x128_si256(u0, u4, 0x20));
+  _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(u1, u5, 0x20));
+  _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(u2, u6, 0x20));
+  _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(u3, u7, 0x20));
+  _mm256_storeu_si256(out + 4, _mm256_permute2x128_si256(u0, u4, 0x31));
+  _mm256_storeu_si256(out + 5, _mm256_permute2x128_si256(u1, u5, 0x31));
+  _mm256_storeu_si256(out + 6, _mm256_permute2x128_si256(u2, u6, 0x31));
+  _mm256_storeu_si256(out + 7, _mm256_permute2x128_si256(u3, u7, 0x31));
+}
+
+// The run with the smaller head supplies the next vector: every key it holds is at most the
+// heads of both runs, so the lower half of its merge with the pending vector is final.
+__attribute__((target("avx2"))) void mergeAvx2(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+                                               int32_t* out) {
+  constexpr size_t kLanes = 8;
+  if (na < kLanes || nb < kLanes) {
+    mergeScalar(a, na, b, nb, out);
+    return;
+  }
+  const int32_t* a_end = a + na;
+  const int32_t* b_end = b + nb;
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+  __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+  a += kLanes;
+  b += kLanes;
+  for (;;) {
+    bitonicMerge(lo, hi);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lo);
+    out += kLanes;
+    const bool take_a = a != a_end && (b == b_end || *a <= *b);
+    const int32_t*& next = take_a ? a : b;
+    if (static_cast<size_t>((take_a ? a_end : b_end) - next) < kLanes) break;
+    lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next));
+    next += kLanes;
+  }
+  int32_t pending[kLanes];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(pending), hi);
+  mergeTail(pending, kLanes, a, a_end, b, b_end, out);
+}
+
+// The same network on 16 lanes: distances 8 and 4 swap 256 and 128 bit halves, and masked min
+// and max write the two halves of every compare-exchange. Only masked forms are used: the plain
+// ones start from an undefined vector that GCC 12 reports as maybe uninitialized.
+constexpr __mmask16 kAllLanes = 0xFFFF;
+
+__attribute__((target("avx512f"))) inline __m512i compareExchange(__m512i x, __m512i t, __mmask16 upper) {
+  return _mm512_mask_max_epi32(_mm512_mask_min_epi32(x, ~upper, x, t), upper, x, t);
+}
+
+__attribute__((target("avx512f"))) inline __m512i bitonicFinish(__m512i x) {
+  constexpr __mmask8 kAllWords = 0xFF;
+  constexpr auto kSwapPairs = static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(1, 0, 3, 2));
+  constexpr auto kSwapNeighbours = static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(2, 3, 0, 1));
+  x = compareExchange(x, _mm512_maskz_shuffle_i64x2(kAllWords, x, x, _MM_SHUFFLE(1, 0, 3, 2)), 0xFF00);
+  x = compareExchange(x, _mm512_maskz_shuffle_i64x2(kAllWords, x, x, _MM_SHUFFLE(2, 3, 0, 1)), 0xF0F0);
+  x = compareExchange(x, _mm512_maskz_shuffle_epi32(kAllLanes, x, kSwapPairs), 0xCCCC);
+  return compareExchange(x, _mm512_maskz_shuffle_epi32(kAllLanes, x, kSwapNeighbours), 0xAAAA);
+}
+
+__attribute__((target("avx512f"))) inline void bitonicMerge(__m512i& lo, __m512i& hi) {
+  const __m512i reverse = _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  hi = _mm512_maskz_permutexvar_epi32(kAllLanes, reverse, hi);
+  const __m512i min = _mm512_maskz_min_epi32(kAllLanes, lo, hi);
+  hi = bitonicFinish(_mm512_maskz_max_epi32(kAllLanes, lo, hi));
+  lo = bitonicFinish(min);
+}
+
+__attribute__((target("avx512f"))) void mergeAvx512(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+                                                    int32_t* out) {
+  constexpr size_t kLanes = 16;
+  if (na < kLanes || nb < kLanes) {
+    mergeAvx2(a, na, b, nb, out);
+    return;
+  }
+  const int32_t* a_end = a + na;
+  const int32_t* b_end = b + nb;
+  __m512i lo = _mm512_loadu_si512(a);
+  __m512i hi = _mm512_loadu_si512(b);
+  a += kLanes;
+  b += kLanes;
+  for (;;) {
+    bitonicMerge(lo, hi);
+    _mm512_storeu_si512(out, lo);
+    out += kLanes;
+    const bool take_a = a != a_end && (b == b_end || *a <= *b);
+    const int32_t*& next = take_a ? a : b;
+    if (static_cast<size_t>((take_a ? a_end : b_end) - next) < kLanes) break;
+    lo = _mm512_loadu_si512(next);
+    next += kLanes;
+  }
+  int32_t pending[kLanes];
+  _mm512_storeu_si512(pending, hi);
+  mergeTail(pending, kLanes, a, a_end, b, b_end, out);
+}
+
+#else
+
+Isa detectIsa() { return Isa::kScalar; }
+
+#endif
+
+Isa isa() {
+  static const Isa detected = detectIsa();
+  return detected;
+}
+
+// every aligned group of kRun keys is sorted, and so are the keys past the last full group
+void sortRuns(int32_t* data, size_t n) {
+  size_t i = 0;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  if (isa() != Isa::kScalar) {
+    for (; i + kBlock <= n; i += kBlock) sortBlockAvx2(data + i);
+  }
+#endif
+  for (; i + kRun <= n; i += kRun) sortRunScalar(data + i);
+  for (size_t j = i + 1; j < n; ++j) {
+    const int32_t key = data[j];
+    size_t k = j;
+    for (; k > i && key < data[k - 1]; --k) data[k] = data[k - 1];
+    data[k] = key;
+  }
+}
+
+}  // namespace
+
+void ppc::core::networkMerge(const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  if (isa() == Isa::kAvx512) {
+    mergeAvx512(a, na, b, nb, out);
+    return;
+  }
+  if (isa() == Isa::kAvx2) {
+    mergeAvx2(a, na, b, nb, out);
+    return;
+  }
+#endif
+  mergeScalar(a, na, b, nb, out);
+}
+
+void ppc::core::networkSort(int32_t* data, size_t n, int threads) {
+  if (threads < 0) throw std::invalid_argument("networkSort: threads must not be negative");
+  if (n < 2) return;
+  int team = 1;
+#ifdef _OPENMP
+  if (n >= kParallelKeys && !omp_in_parallel()) team = threads == 0 ? omp_get_max_threads() : threads;
+#endif
+  // left uninitialized, so its pages are first touched by the threads that merge into them
+  std::unique_ptr<int32_t[]> buffer(new int32_t[n]);
+  int32_t* src = data;
+  int32_t* dst = buffer.get();
+  const auto blocks = static_cast<int64_t>((n + kBlock - 1) / kBlock);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(team)
+#endif
+  {
+    int t = 0;
+#ifdef _OPENMP
+#pragma omp single
+    team = omp_get_num_threads();
+    t = omp_get_thread_num();
+#pragma omp for schedule(static)
+#endif
+    for (int64_t k = 0; k < blocks; ++k) {
+      const size_t first = k * kBlock;
+      sortRuns(data + first, std::min(kBlock, n - first));
+    }
+    // every pass splits the output into equal shares, so the last passes with only a few pairs
+    // (the last one merges two halves) keep the whole team busy
+    const size_t out_first = n * t / team;
+    const size_t out_last = n * (t + 1) / team;
+    for (size_t width = kRun; width < n; width *= 2) {
+      for (size_t first = out_first / (2 * width) * (2 * width); first < out_last; first += 2 * width) {
+        const size_t middle = std::min(first + width, n);
+        const size_t last = std::min(first + 2 * width, n);
+        const size_t from = std::max(first, out_first) - first;
+        const size_t to = std::min(last, out_last) - first;
+        const size_t a_from = ppc::core::coRank(from, src + first, middle - first, src + middle, last - middle);
+        const size_t a_to = ppc::core::coRank(to, src + first, middle - first, src + middle, last - middle);
+        networkMerge(src + first + a_from, a_to - a_from, src + middle + (from - a_from), (to - a_to) - (from - a_from),
+                     dst + first + from);
+      }
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+      std::swap(src, dst);
+    }
+  }
+  if (src != data) std::memcpy(data, src, n * sizeof(int32_t));
+}
@@ -0,0 +1,145 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/transpose/include/transpose.hpp"
+
+namespace {
+
+std::vector<double> randomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> matrix(rows * cols);
+  for (auto &value : matrix) value = dist(gen);
+  return matrix;
+}
+
+struct CRS {
+  int rows;
+  int cols;
+  std::vector<int> ptr;
+  std::vector<int> index;
+  std::vector<std::complex<double>> values;
+};
+
+CRS randomCRS(int rows, int cols, double density, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  CRS matrix{rows, cols, {0}, {}, {}};
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      if (dist(gen) < density) {
+        matrix.index.push_back(j);
+        matrix.values.emplace_back(dist(gen), dist(gen));
+      }
+    }
+    matrix.ptr.push_back(static_cast<int>(matrix.index.size()));
+  }
+  return matrix;
+}
+
+void checkTranspose(int rows, int cols) {
+  std::vector<double> src = randomMatrix(rows, cols, 1);
+  std::vector<double> dst = ppc::core::transpose(src, rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      ASSERT_EQ(dst[j * rows + i], src[i * cols + j]);
+    }
+  }
+}
+
+void checkTransposeCRS(int rows, int cols, double density, int threads = 0) {
+  CRS a = randomCRS(rows, cols, density, 2);
+  const int nnz = a.ptr[rows];
+  CRS t{cols, rows, std::vector<int>(cols + 1), std::vector<int>(nnz), std::vector<std::complex<double>>(nnz)};
+  ppc::core::transposeCRS(rows, cols, a.ptr.data(), a.index.data(), a.values.data(), t.ptr.data(), t.index.data(),
+                          t.values.data(), threads);
+
+  // the reference walks the columns of A, so entries of every row of T come in row order of A
+  int pos = 0;
+  for (int j = 0; j < cols; ++j) {
+    ASSERT_EQ(t.ptr[j], pos);
+    for (int i = 0; i < rows; ++i) {
+      for (int k = a.ptr[i]; k < a.ptr[i + 1]; ++k) {
+        if (a.index[k] != j) continue;
+        ASSERT_EQ(t.index[pos], i);
+        ASSERT_EQ(t.values[pos], a.values[k]);
+        ++pos;
+      }
+    }
+  }
+  ASSERT_EQ(t.ptr[cols], nnz);
+}
+
+}  // namespace
+
+TEST(transpose_tests, single_element) { checkTranspose(1, 1); }
+
+TEST(transpose_tests, row_and_column_vectors) {
+  checkTranspose(1, 100);
+  checkTranspose(100, 1);
+}
+
+TEST(transpose_tests, whole_tiles) { checkTranspose(64, 64); }
+
+TEST(transpose_tests, partial_tiles_and_recursion) {
+  checkTranspose(7, 13);
+  checkTranspose(100, 37);
+  checkTranspose(257, 129);
+}
+
+TEST(transpose_tests, block_of_larger_matrix) {
+  // dst[2:2+cols, 1:1+rows] = src[3:3+rows, 5:5+cols]^T, everything else untouched
+  const int rows = 45;
+  const int cols = 70;
+  const int lds = 80;
+  const int ldd = 50;
+  std::vector<double> src = randomMatrix(rows + 3, lds, 3);
+  std::vector<double> dst(static_cast<size_t>(cols + 2) * ldd, 7.0);
+  ppc::core::transpose(rows, cols, src.data() + 3 * lds + 5, lds, dst.data() + 2 * ldd + 1, ldd);
+  for (int i = 0; i < cols + 2; ++i) {
+    for (int j = 0; j < ldd; ++j) {
+      const bool inside = i >= 2 && j >= 1 && j < 1 + rows;
+      ASSERT_EQ(dst[i * ldd + j], inside ? src[(j - 1 + 3) * lds + i - 2 + 5] : 7.0);
+    }
+  }
+}
+
+TEST(transpose_tests, in_place_square) {
+  for (int n : {1, 8, 33, 100, 130}) {
+    const int ld = n + 3;
+    std::vector<double> a = randomMatrix(n, ld, 4);
+    std::vector<double> original = a;
+    ppc::core::transposeInPlace(n, a.data(), ld);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < ld; ++j) {
+        ASSERT_EQ(a[i * ld + j], j < n ? original[j * ld + i] : original[i * ld + j]);
+      }
+    }
+  }
+}
+
+TEST(transpose_tests, float_matches_double) {
+  std::vector<double> src = randomMatrix(50, 90, 5);
+  std::vector<float> src32(src.begin(), src.end());
+  std::vector<float> dst32 = ppc::core::transpose(src32, 50, 90);
+  std::vector<double> dst = ppc::core::transpose(src, 50, 90);
+  for (size_t i = 0; i < dst.size(); ++i) ASSERT_EQ(dst32[i], static_cast<float>(dst[i]));
+}
+
+TEST(transpose_tests, sparse_with_empty_rows_and_columns) { checkTransposeCRS(60, 45, 0.05); }
+
+TEST(transpose_tests, sparse_above_parallel_threshold) { checkTransposeCRS(700, 500, 0.3); }
+
+TEST(transpose_tests, sparse_empty) { checkTransposeCRS(5, 4, 0.0); }
+
+TEST(transpose_tests, sparse_thread_caps) {
+  for (int threads : {1, 2, 3}) checkTransposeCRS(700, 500, 0.3, threads);
+  const int ptr[] = {0, 0};
+  EXPECT_THROW(ppc::core::transposeCRS<double>(1, 1, ptr, nullptr, nullptr, nullptr, nullptr, nullptr, -1),
+               std::invalid_argument);
+}
@@ -0,0 +1,35 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRANSPOSE_HPP_
+#define MODULES_CORE_INCLUDE_TRANSPOSE_HPP_
+
+#include <vector>
+
+namespace ppc::core {
+
+// dst (cols x rows, leading dimension ldd) = transpose of the row-major src (rows x cols,
+// leading dimension lds). Cache-oblivious: the longer side is halved until both sides fit a
+// leaf that stays in L1, and leaves are moved in 8 x 8 tiles held in registers, so both src
+// and dst are touched a full cache line at a time; the tiles are shuffled with AVX2 when the CPU
+// has it. src and dst must not overlap.
+void transpose(int rows, int cols, const double* src, int lds, double* dst, int ldd);
+void transpose(int rows, int cols, const float* src, int lds, float* dst, int ldd);
+
+std::vector<double> transpose(const std::vector<double>& src, int rows, int cols);
+std::vector<float> transpose(const std::vector<float>& src, int rows, int cols);
+
+// In-place transpose of a square n x n matrix with leading dimension ld: diagonal quadrants
+// recurse in place, the two off-diagonal quadrants are transposed into each other.
+void transposeInPlace(int n, double* a, int ld);
+void transposeInPlace(int n, float* a, int ld);
+
+// CRS of a rows x cols matrix to CRS of its transpose (the CCS of the original) by a counting
+// sort, so each result row keeps source row order. threads caps the OpenMP team (0: default,
+// 1 for sequential, TBB or std::thread callers); negative values throw std::invalid_argument.
+template <class V>
+void transposeCRS(int rows, int cols, const int* ptr, const int* index, const V* values, int* t_ptr, int* t_index,
+                  V* t_values, int threads = 0);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TRANSPOSE_HPP_
@@ -0,0 +1,281 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/transpose/include/transpose.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// 8 x 8 doubles are eight cache lines and fit the vector register file of AVX2 targets;
+// a leaf of 32 x 32 keeps its source and destination (16 KB) in L1
+constexpr int kTile = 8;
+constexpr int kLeaf = 32;
+// below this many nonzeros a thread team costs more than the counting sort
+constexpr int64_t kParallelNonzeros = 1 << 16;
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+bool hasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+// 4 x 4 doubles: pairs of rows are interleaved, then the 128-bit halves of the pairs swapped
+__attribute__((target("avx2"))) inline void transpose4x4(const double* src, int lds, double* dst, int ldd) {
+  const __m256d r0 = _mm256_loadu_pd(src);
+  const __m256d r1 = _mm256_loadu_pd(src + lds);
+  const __m256d r2 = _mm256_loadu_pd(src + 2 * lds);
+  const __m256d r3 = _mm256_loadu_pd(src + 3 * lds);
+  const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+  const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+  const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+  const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+  _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+  _mm256_storeu_pd(dst + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+  _mm256_storeu_pd(dst + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+  _mm256_storeu_pd(dst + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+__attribute__((target("avx2"))) void transposeTileAvx2(const double* src, int lds, double* dst, int ldd) {
+  transpose4x4(src, lds, dst, ldd);
+  transpose4x4(src + 4, lds, dst + 4 * ldd, ldd);
+  transpose4x4(src + 4 * lds, lds, dst + 4, ldd);
+  transpose4x4(src + 4 * lds + 4, lds, dst + 4 * ldd + 4, ldd);
+}
+
+// 8 x 8 floats in eight registers: interleave pairs of rows, gather 4 x 4 blocks within each
+// 128-bit lane, then swap the lanes
+__attribute__((target("avx2"))) void transposeTileAvx2(const float* src, int lds, float* dst, int ldd) {
+  __m256 r[kTile];
+  __m256 t[kTile];
+  for (int i = 0; i < kTile; ++i) r[i] = _mm256_loadu_ps(src + i * lds);
+  for (int i = 0; i < kTile; i += 2) {
+    t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+  }
+  for (int i = 0; i < kTile; i += 4) {
+    r[i] = _mm256_shuffle_ps(t[i], t[i + 2], 0x44);
+    r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], 0xEE);
+    r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+    r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xEE);
+  }
+  for (int i = 0; i < 4; ++i) {
+    _mm256_storeu_ps(dst + i * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+    _mm256_storeu_ps(dst + (i + 4) * ldd, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+  }
+}
+
+#endif
+
+// Constant trip counts let the compiler keep the tile in registers and turn the loops into
+// shuffles: rows of src are loaded whole and rows of dst are stored whole. On AVX2 hardware the
+// shuffles are written out instead of left to the baseline SSE2 code generation.
+template <class T>
+void transposeTile(const T* src, int lds, T* dst, int ldd) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  static const bool avx2 = hasAvx2();
+  if (avx2) {
+    transposeTileAvx2(src, lds, dst, ldd);
+    return;
+  }
+#endif
+  T tile[kTile][kTile];
+  for (int r = 0; r < kTile; ++r) {
+    for (int c = 0; c < kTile; ++c) {
+      tile[c][r] = src[r * lds + c];
+    }
+  }
+  for (int r = 0; r < kTile; ++r) {
+    for (int c = 0; c < kTile; ++c) {
+      dst[r * ldd + c] = tile[r][c];
+    }
+  }
+}
+
+template <class T>
+void transposeLeaf(int rows, int cols, const T* src, int lds, T* dst, int ldd) {
+  const int full_rows = rows / kTile * kTile;
+  const int full_cols = cols / kTile * kTile;
+  for (int i = 0; i < full_rows; i += kTile) {
+    for (int j = 0; j < full_cols; j += kTile) {
+      transposeTile(src + i * lds + j, lds, dst + j * ldd + i, ldd);
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int j = i < full_rows ? full_cols : 0; j < cols; ++j) {
+      dst[j * ldd + i] = src[i * lds + j];
+    }
+  }
+}
+
+// splits keep a multiple of the tile on the first half, so only the matrix edge has partial tiles
+int splitPoint(int extent) { return std::max(kTile, extent / 2 / kTile * kTile); }
+
+template <class T>
+void transposeRec(int rows, int cols, const T* src, int lds, T* dst, int ldd) {
+  if (rows <= kLeaf && cols <= kLeaf) {
+    transposeLeaf(rows, cols, src, lds, dst, ldd);
+  } else if (rows >= cols) {
+    const int half = splitPoint(rows);
+    transposeRec(half, cols, src, lds, dst, ldd);
+    transposeRec(rows - half, cols, src + half * lds, lds, dst + half, ldd);
+  } else {
+    const int half = splitPoint(cols);
+    transposeRec(rows, half, src, lds, dst, ldd);
+    transposeRec(rows, cols - half, src + half, lds, dst + half * ldd, ldd);
+  }
+}
+
+// x (rows x cols) and y (cols x rows) of the same matrix become each other's transposes
+template <class T>
+void swapTransposedRec(int rows, int cols, T* x, T* y, int ld) {
+  if (rows > kLeaf || cols > kLeaf) {
+    if (rows >= cols) {
+      const int half = splitPoint(rows);
+      swapTransposedRec(half, cols, x, y, ld);
+      swapTransposedRec(rows - half, cols, x + half * ld, y + half, ld);
+    } else {
+      const int half = splitPoint(cols);
+      swapTransposedRec(rows, half, x, y, ld);
+      swapTransposedRec(rows, cols - half, x + half, y + half * ld, ld);
+    }
+    return;
+  }
+  const int full_rows = rows / kTile * kTile;
+  const int full_cols = cols / kTile * kTile;
+  T tile[kTile][kTile];
+  for (int i = 0; i < full_rows; i += kTile) {
+    for (int j = 0; j < full_cols; j += kTile) {
+      T* xt = x + i * ld + j;
+      T* yt = y + j * ld + i;
+      for (int r = 0; r < kTile; ++r) {
+        for (int c = 0; c < kTile; ++c) {
+          tile[r][c] = xt[r * ld + c];
+        }
+      }
+      transposeTile(yt, ld, xt, ld);
+      for (int r = 0; r < kTile; ++r) {
+        for (int c = 0; c < kTile; ++c) {
+          yt[c * ld + r] = tile[r][c];
+        }
+      }
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int j = i < full_rows ? full_cols : 0; j < cols; ++j) {
+      std::swap(x[i * ld + j], y[j * ld + i]);
+    }
+  }
+}
+
+template <class T>
+void transposeInPlaceRec(int n, T* a, int ld) {
+  if (n <= kLeaf) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        std::swap(a[i * ld + j], a[j * ld + i]);
+      }
+    }
+    return;
+  }
+  const int half = splitPoint(n);
+  transposeInPlaceRec(half, a, ld);
+  transposeInPlaceRec(n - half, a + half * ld + half, ld);
+  swapTransposedRec(half, n - half, a + half, a + half * ld, ld);
+}
+
+}  // namespace
+
+void ppc::core::transpose(int rows, int cols, const double* src, int lds, double* dst, int ldd) {
+  transposeRec(rows, cols, src, lds, dst, ldd);
+}
+
+void ppc::core::transpose(int rows, int cols, const float* src, int lds, float* dst, int ldd) {
+  transposeRec(rows, cols, src, lds, dst, ldd);
+}
+
+std::vector<double> ppc::core::transpose(const std::vector<double>& src, int rows, int cols) {
+  std::vector<double> dst(src.size());
+  transpose(rows, cols, src.data(), cols, dst.data(), rows);
+  return dst;
+}
+
+std::vector<float> ppc::core::transpose(const std::vector<float>& src, int rows, int cols) {
+  std::vector<float> dst(src.size());
+  transpose(rows, cols, src.data(), cols, dst.data(), rows);
+  return dst;
+}
+
+void ppc::core::transposeInPlace(int n, double* a, int ld) { transposeInPlaceRec(n, a, ld); }
+
+void ppc::core::transposeInPlace(int n, float* a, int ld) { transposeInPlaceRec(n, a, ld); }
+
+template <class V>
+void ppc::core::transposeCRS(int rows, int cols, const int* ptr, const int* index, const V* values, int* t_ptr,
+                             int* t_index, V* t_values, int max_threads) {
+  if (max_threads < 0) throw std::invalid_argument("transposeCRS: threads must not be negative");
+  int threads = 1;
+#ifdef _OPENMP
+  if (ptr[rows] >= kParallelNonzeros && !omp_in_parallel()) {
+    threads = max_threads == 0 ? omp_get_max_threads() : max_threads;
+  }
+#endif
+  // counts[t][c]: entries of column c in the row range of thread t; after the scan it holds
+  // the position where thread t writes its first entry of column c
+  std::vector<std::vector<int>> counts(threads, std::vector<int>(cols, 0));
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads)
+#endif
+  {
+    int t = 0;
+#ifdef _OPENMP
+#pragma omp single
+    threads = omp_get_num_threads();
+    t = omp_get_thread_num();
+#endif
+    const int64_t first = static_cast<int64_t>(rows) * t / threads;
+    const int64_t last = static_cast<int64_t>(rows) * (t + 1) / threads;
+    std::vector<int>& count = counts[t];
+    for (int64_t k = ptr[first]; k < ptr[last]; ++k) ++count[index[k]];
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+    {
+      int offset = 0;
+      for (int c = 0; c < cols; ++c) {
+        t_ptr[c] = offset;
+        for (int u = 0; u < threads; ++u) {
+          const int entries = counts[u][c];
+          counts[u][c] = offset;
+          offset += entries;
+        }
+      }
+      t_ptr[cols] = offset;
+    }
+    for (int64_t i = first; i < last; ++i) {
+      for (int k = ptr[i]; k < ptr[i + 1]; ++k) {
+        const int pos = count[index[k]]++;
+        t_index[pos] = static_cast<int>(i);
+        t_values[pos] = values[k];
+      }
+    }
+  }
+}
+
+template void ppc::core::transposeCRS(int, int, const int*, const int*, const float*, int*, int*, float*, int);
+template void ppc::core::transposeCRS(int, int, const int*, const int*, const double*, int*, int*, double*, int);
+template void ppc::core::transposeCRS(int, int, const int*, const int*, const std::complex<double>*, int*, int*,
+                                      std::complex<double>*, int);
@@ -1,4 +1,5 @@
 REM mpiexec -np 4 build\bin\mpi_perf_tests.exe
+build\bin\core_perf_tests.exe
 build\bin\omp_perf_tests.exe
 build\bin\seq_perf_tests.exe
 build\bin\stl_perf_tests.exe
@@ -1,5 +1,6 @@
 #!/bin/bash
 
+./build/bin/core_perf_tests
 ./build/bin/omp_perf_tests
 ./build/bin/seq_perf_tests
 ./build/bin/stl_perf_tests
@@ -0,0 +1,89 @@
+// Copyright 2024 Ermolaev Danila
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "mpi/ermolaev_d_fox_algorithm/include/ops_mpi.hpp"
+
+using ermolaev_d_fox_mpi::FoxAlgorithmMPI;
+using ermolaev_d_fox_mpi::GridSchedule;
+
+namespace {
+
+std::vector<double> getRandomMatrix(int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  std::vector<double> matrix(n * n);
+  for (auto& value : matrix) value = dist(gen);
+  return matrix;
+}
+
+// Runs the MPI task on every rank and checks C against ppc::core::gemm on the root.
+void checkProduct(int n, GridSchedule schedule) {
+  boost::mpi::communicator world;
+  std::vector<double> A;
+  std::vector<double> B;
+  std::vector<double> C;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    A = getRandomMatrix(n, 1);
+    B = getRandomMatrix(n, 2);
+    C.resize(n * n);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(A.data()));
+    taskDataPar->inputs_count.emplace_back(A.size());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(B.data()));
+    taskDataPar->inputs_count.emplace_back(B.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(C.data()));
+    taskDataPar->outputs_count.emplace_back(C.size());
+  }
+
+  FoxAlgorithmMPI foxAlgorithmMpi(taskDataPar, schedule);
+  ASSERT_EQ(foxAlgorithmMpi.validation(), true);
+  foxAlgorithmMpi.pre_processing();
+  foxAlgorithmMpi.run();
+  foxAlgorithmMpi.post_processing();
+
+  if (world.rank() == 0) {
+    std::vector<double> expected = ppc::core::gemm(A, B, n, n, n);
+    for (int i = 0; i < n * n; i++) {
+      ASSERT_NEAR(expected[i], C[i], 1e-9);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ermolaev_d_fox_algorithm_mpi, Fox_Single_Element) { checkProduct(1, GridSchedule::Fox); }
+
+TEST(ermolaev_d_fox_algorithm_mpi, Fox_Size_Divisible_By_Grid) { checkProduct(60, GridSchedule::Fox); }
+
+TEST(ermolaev_d_fox_algorithm_mpi, Fox_Padded_Blocks) { checkProduct(37, GridSchedule::Fox); }
+
+TEST(ermolaev_d_fox_algorithm_mpi, Cannon_Single_Element) { checkProduct(1, GridSchedule::Cannon); }
+
+TEST(ermolaev_d_fox_algorithm_mpi, Cannon_Size_Divisible_By_Grid) { checkProduct(60, GridSchedule::Cannon); }
+
+TEST(ermolaev_d_fox_algorithm_mpi, Cannon_Padded_Blocks) { checkProduct(37, GridSchedule::Cannon); }
+
+TEST(ermolaev_d_fox_algorithm_mpi, Empty_Matrix) { checkProduct(0, GridSchedule::Cannon); }
+
+TEST(ermolaev_d_fox_algorithm_mpi, Validation_Rejects_Non_Square_Input) {
+  boost::mpi::communicator world;
+  std::vector<double> A(10);
+  std::vector<double> B(10);
+  std::vector<double> C(10);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(A.data()));
+    taskDataPar->inputs_count.emplace_back(A.size());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(B.data()));
+    taskDataPar->inputs_count.emplace_back(B.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(C.data()));
+    taskDataPar->outputs_count.emplace_back(C.size());
+  }
+  FoxAlgorithmMPI foxAlgorithmMpi(taskDataPar);
+  ASSERT_EQ(foxAlgorithmMpi.validation(), world.rank() != 0);
+}
@@ -0,0 +1,47 @@
+// Copyright 2024 Ermolaev Danila
+#pragma once
+
+#include <boost/mpi/cartesian_communicator.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ermolaev_d_fox_mpi {
+
+// Fox broadcasts A(i, i + s) along block row i at stage s and shifts B up, Cannon skews A and B
+// once and then shifts A left and B up at every stage.
+enum class GridSchedule { Fox, Cannon };
+
+// C = A * B for n x n row-major doubles on a q x q Cartesian grid of processes, q = floor(sqrt(p));
+// ranks beyond q * q stay idle. Inputs (root only) are A and B, the output is C, all of size n * n.
+// The matrices are zero-padded to q * block and every process owns one block of A, B and C:
+// blocks are scattered from the root, the shifts of every stage are posted as Isend/Irecv (and
+// Ibcast for Fox) before the local GEMM so communication overlaps it, and C is gathered back.
+class FoxAlgorithmMPI : public ppc::core::Task {
+ public:
+  explicit FoxAlgorithmMPI(std::shared_ptr<ppc::core::TaskData> taskData_, GridSchedule schedule_ = GridSchedule::Fox)
+      : Task(std::move(taskData_)), schedule(schedule_) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  void runFox();
+  void runCannon();
+
+  GridSchedule schedule;
+  boost::mpi::communicator world;
+  std::unique_ptr<boost::mpi::cartesian_communicator> grid;
+  int n = 0;
+  int q = 0;
+  int block = 0;
+  std::vector<double> local_a, local_b, local_c;
+  std::vector<double> result;
+};
+
+}  // namespace ermolaev_d_fox_mpi
@@ -0,0 +1,73 @@
+// Copyright 2024 Ermolaev Danila
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/timer.hpp>
+#include <random>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/ermolaev_d_fox_algorithm/include/ops_mpi.hpp"
+
+using ermolaev_d_fox_mpi::FoxAlgorithmMPI;
+using ermolaev_d_fox_mpi::GridSchedule;
+
+namespace {
+
+std::vector<double> getRandomMatrix(int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  std::vector<double> matrix(n * n);
+  for (auto& value : matrix) value = dist(gen);
+  return matrix;
+}
+
+void runPerf(GridSchedule schedule, bool pipeline) {
+  boost::mpi::communicator world;
+  const int n = 600;
+  std::vector<double> A;
+  std::vector<double> B;
+  std::vector<double> C;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    A = getRandomMatrix(n, 1);
+    B = getRandomMatrix(n, 2);
+    C.resize(n * n);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(A.data()));
+    taskDataPar->inputs_count.emplace_back(A.size());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(B.data()));
+    taskDataPar->inputs_count.emplace_back(B.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(C.data()));
+    taskDataPar->outputs_count.emplace_back(C.size());
+  }
+
+  auto foxAlgorithmMpi = std::make_shared<FoxAlgorithmMPI>(taskDataPar, schedule);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(foxAlgorithmMpi);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    std::vector<double> expected = ppc::core::gemm(A, B, n, n, n);
+    for (int i = 0; i < n * n; i++) {
+      ASSERT_NEAR(expected[i], C[i], 1e-9);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ermolaev_d_fox_algorithm_mpi_perf_test, test_pipeline_run) { runPerf(GridSchedule::Fox, true); }
+
+TEST(ermolaev_d_fox_algorithm_mpi_perf_test, test_task_run) { runPerf(GridSchedule::Fox, false); }
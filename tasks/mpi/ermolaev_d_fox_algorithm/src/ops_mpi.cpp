@@ -0,0 +1,222 @@
+// Copyright 2024 Ermolaev Danila
+#include "mpi/ermolaev_d_fox_algorithm/include/ops_mpi.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <boost/mpi/request.hpp>
+#include <cmath>
+#include <vector>
+
+#include "core/gemm/include/gemm.hpp"
+
+namespace {
+
+constexpr int kTagA = 0;
+constexpr int kTagB = 1;
+
+// Row-major n x n matrix to q * q blocks of block x block, zero-padded, in the rank order of grid.
+std::vector<double> packBlocks(const double* src, int n, int block, const boost::mpi::cartesian_communicator& grid) {
+  const size_t tile = static_cast<size_t>(block) * block;
+  std::vector<double> packed(tile * grid.size(), 0.0);
+  for (int rank = 0; rank < grid.size(); rank++) {
+    const std::vector<int> coords = grid.coordinates(rank);
+    double* dst = packed.data() + rank * tile;
+    for (int r = 0; r < block; r++) {
+      const int row = coords[0] * block + r;
+      const int col = coords[1] * block;
+      if (row >= n || col >= n) continue;
+      const int cols = std::min(block, n - col);
+      std::copy(src + static_cast<size_t>(row) * n + col, src + static_cast<size_t>(row) * n + col + cols,
+                dst + static_cast<size_t>(r) * block);
+    }
+  }
+  return packed;
+}
+
+void unpackBlocks(const std::vector<double>& packed, int n, int block, const boost::mpi::cartesian_communicator& grid,
+                  double* dst) {
+  const size_t tile = static_cast<size_t>(block) * block;
+  for (int rank = 0; rank < grid.size(); rank++) {
+    const std::vector<int> coords = grid.coordinates(rank);
+    const double* src = packed.data() + rank * tile;
+    for (int r = 0; r < block; r++) {
+      const int row = coords[0] * block + r;
+      const int col = coords[1] * block;
+      if (row >= n || col >= n) continue;
+      const int cols = std::min(block, n - col);
+      std::copy(src + static_cast<size_t>(r) * block, src + static_cast<size_t>(r) * block + cols,
+                dst + static_cast<size_t>(row) * n + col);
+    }
+  }
+}
+
+// Sends `data` to the destination of the shift and receives the block of the source into `next`.
+void shiftBlock(const boost::mpi::cartesian_communicator& grid, int dim, int disp, int tag,
+                const std::vector<double>& data, std::vector<double>& next) {
+  const auto [source, dest] = grid.shifted_ranks(dim, disp);
+  std::array<boost::mpi::request, 2> requests = {grid.isend(dest, tag, data.data(), static_cast<int>(data.size())),
+                                                 grid.irecv(source, tag, next.data(), static_cast<int>(next.size()))};
+  boost::mpi::wait_all(requests.begin(), requests.end());
+}
+
+}  // namespace
+
+namespace ermolaev_d_fox_mpi {
+
+bool FoxAlgorithmMPI::validation() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    if (taskData->inputs.size() != 2 || taskData->outputs.size() != 1) return false;
+    const auto size = taskData->inputs_count[0];
+    const auto side = static_cast<size_t>(std::lround(std::sqrt(size)));
+    return size == taskData->inputs_count[1] && size == taskData->outputs_count[0] && side * side == size;
+  }
+  return true;
+}
+
+bool FoxAlgorithmMPI::pre_processing() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    n = static_cast<int>(std::lround(std::sqrt(taskData->inputs_count[0])));
+  }
+  boost::mpi::broadcast(world, n, 0);
+
+  q = static_cast<int>(std::sqrt(world.size()));
+  while ((q + 1) * (q + 1) <= world.size()) q++;
+  block = std::max(1, (n + q - 1) / q);
+
+  const bool active = world.rank() < q * q;
+  boost::mpi::communicator active_comm = world.split(active ? 0 : 1);
+  grid.reset();
+  if (!active) return true;
+
+  boost::mpi::cartesian_topology topology({{q, true}, {q, true}});
+  grid = std::make_unique<boost::mpi::cartesian_communicator>(active_comm, topology, false);
+
+  const size_t tile = static_cast<size_t>(block) * block;
+  local_a.resize(tile);
+  local_b.resize(tile);
+  local_c.assign(tile, 0.0);
+  if (grid->rank() == 0) {
+    std::vector<double> packed_a = packBlocks(reinterpret_cast<double*>(taskData->inputs[0]), n, block, *grid);
+    std::vector<double> packed_b = packBlocks(reinterpret_cast<double*>(taskData->inputs[1]), n, block, *grid);
+    boost::mpi::scatter(*grid, packed_a.data(), local_a.data(), static_cast<int>(tile), 0);
+    boost::mpi::scatter(*grid, packed_b.data(), local_b.data(), static_cast<int>(tile), 0);
+  } else {
+    boost::mpi::scatter(*grid, local_a.data(), static_cast<int>(tile), 0);
+    boost::mpi::scatter(*grid, local_b.data(), static_cast<int>(tile), 0);
+  }
+  return true;
+}
+
+void FoxAlgorithmMPI::runFox() {
+  const std::vector<int> coords = grid->coordinates(grid->rank());
+  const int row = coords[0];
+  // block row of the grid, ranked by column
+  boost::mpi::cartesian_communicator row_comm(*grid, std::vector<int>{1});
+  const size_t tile = local_a.size();
+  std::vector<double> stage_a(tile);
+  std::vector<double> next_a(tile);
+  std::vector<double> next_b(tile);
+  const auto [b_source, b_dest] = grid->shifted_ranks(0, -1);
+
+  auto postBroadcast = [&](int stage, std::vector<double>& buffer, MPI_Request& request) {
+    const int root = (row + stage) % q;
+    if (row_comm.rank() == root) buffer = local_a;
+    MPI_Ibcast(buffer.data(), static_cast<int>(tile), MPI_DOUBLE, root, static_cast<MPI_Comm>(row_comm), &request);
+  };
+
+  MPI_Request bcast = MPI_REQUEST_NULL;
+  postBroadcast(0, stage_a, bcast);
+  MPI_Wait(&bcast, MPI_STATUS_IGNORE);
+  for (int stage = 0; stage < q; stage++) {
+    // while this stage multiplies, the next A block is broadcast and B moves one block up
+    const bool last = stage + 1 == q;
+    std::array<boost::mpi::request, 2> shifts;
+    if (!last) {
+      postBroadcast(stage + 1, next_a, bcast);
+      shifts = {grid->isend(b_dest, kTagB, local_b.data(), static_cast<int>(tile)),
+                grid->irecv(b_source, kTagB, next_b.data(), static_cast<int>(tile))};
+    }
+    ppc::core::gemm(block, block, block, stage_a.data(), block, local_b.data(), block, local_c.data(), block, true);
+    if (!last) {
+      MPI_Wait(&bcast, MPI_STATUS_IGNORE);
+      boost::mpi::wait_all(shifts.begin(), shifts.end());
+      stage_a.swap(next_a);
+      local_b.swap(next_b);
+    }
+  }
+}
+
+void FoxAlgorithmMPI::runCannon() {
+  const std::vector<int> coords = grid->coordinates(grid->rank());
+  const size_t tile = local_a.size();
+  std::vector<double> next_a(tile);
+  std::vector<double> next_b(tile);
+
+  // initial skew: A(i, j) moves i blocks left, B(i, j) moves j blocks up
+  if (coords[0] != 0) {
+    shiftBlock(*grid, 1, -coords[0], kTagA, local_a, next_a);
+    local_a.swap(next_a);
+  }
+  if (coords[1] != 0) {
+    shiftBlock(*grid, 0, -coords[1], kTagB, local_b, next_b);
+    local_b.swap(next_b);
+  }
+
+  const auto [a_source, a_dest] = grid->shifted_ranks(1, -1);
+  const auto [b_source, b_dest] = grid->shifted_ranks(0, -1);
+  for (int stage = 0; stage < q; stage++) {
+    const bool last = stage + 1 == q;
+    std::array<boost::mpi::request, 4> shifts;
+    if (!last) {
+      shifts = {grid->isend(a_dest, kTagA, local_a.data(), static_cast<int>(tile)),
+                grid->irecv(a_source, kTagA, next_a.data(), static_cast<int>(tile)),
+                grid->isend(b_dest, kTagB, local_b.data(), static_cast<int>(tile)),
+                grid->irecv(b_source, kTagB, next_b.data(), static_cast<int>(tile))};
+    }
+    ppc::core::gemm(block, block, block, local_a.data(), block, local_b.data(), block, local_c.data(), block, true);
+    if (!last) {
+      boost::mpi::wait_all(shifts.begin(), shifts.end());
+      local_a.swap(next_a);
+      local_b.swap(next_b);
+    }
+  }
+}
+
+bool FoxAlgorithmMPI::run() {
+  internal_order_test();
+  if (!grid) return true;
+  if (n > 0) {
+    if (schedule == GridSchedule::Fox) {
+      runFox();
+    } else {
+      runCannon();
+    }
+  }
+
+  const int tile = static_cast<int>(local_c.size());
+  if (grid->rank() == 0) {
+    std::vector<double> packed(static_cast<size_t>(tile) * grid->size());
+    boost::mpi::gather(*grid, local_c.data(), tile, packed.data(), 0);
+    result.assign(static_cast<size_t>(n) * n, 0.0);
+    unpackBlocks(packed, n, block, *grid, result.data());
+  } else {
+    boost::mpi::gather(*grid, local_c.data(), tile, 0);
+  }
+  return true;
+}
+
+bool FoxAlgorithmMPI::post_processing() {
+  internal_order_test();
+  if (world.rank() == 0) {
+    std::copy(result.begin(), result.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+  }
+  return true;
+}
+
+}  // namespace ermolaev_d_fox_mpi
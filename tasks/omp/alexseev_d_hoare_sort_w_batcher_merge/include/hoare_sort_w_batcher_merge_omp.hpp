@@ -33,6 +33,4 @@ class HoareSortWBatcherMergeOMP : public ppc::core::Task {
  private:
   std::vector<int> array{};
 };
-
-void CompExch(int &a, int &b);
 }  // namespace alexseev_omp
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <omp.h>
 
 #include <algorithm>
+#include <random>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -124,7 +125,12 @@ TEST(alexseev_d_hoare_sort_w_batcher_merge_omp, test_pipeline_run) {
       -655, -765, 7,    389,  574,  253,  -290, 614,   395,   -871, -408, -611,  -827, -231, -824,  -931, 657,  220,
       662,  -30,  -747, 256,  -861, 191,  -330, -505,  48,    44,   536,  -924,  -28,  -236, 437,   378,  -35,  546,
       795,  -5326};
-  ;
+  // the literal alone is sorted in microseconds; random keys after it give the timer work to measure
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  const size_t literal_keys = inputArray.size();
+  inputArray.resize(1 << 22);
+  std::generate(inputArray.begin() + literal_keys, inputArray.end(), [&] { return dist(gen); });
 
   // Sequential
   std::vector<int> outputArraySeq(inputArray.size());
@@ -278,6 +284,12 @@ TEST(alexseev_d_hoare_sort_w_batcher_merge_omp, test_task_run) {
       -655, -765, 7,    389,  574,  253,  -290, 614,   395,   -871, -408, -611,  -827, -231, -824,  -931, 657,  220,
       662,  -30,  -747, 256,  -861, 191,  -330, -505,  48,    44,   536,  -924,  -28,  -236, 437,   378,  -35,  546,
       795,  -5326};
+  // the literal alone is sorted in microseconds; random keys after it give the timer work to measure
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  const size_t literal_keys = inputArray.size();
+  inputArray.resize(1 << 22);
+  std::generate(inputArray.begin() + literal_keys, inputArray.end(), [&] { return dist(gen); });
 
   // Sequential
   std::vector<int> outputArraySeq(inputArray.size());
@@ -7,6 +7,8 @@
 #include <random>
 #include <thread>
 
+#include "core/sort/include/sorting_network.hpp"
+
 using namespace std::chrono_literals;
 
 // Sequential implementation of sorting
@@ -59,12 +61,8 @@ bool alexseev_omp::HoareSortWBatcherMergeSequential::post_processing() {
 void alexseev_omp::HoareSortWBatcherMergeSequential::HoareSortWBatcherMergeSeq(std::vector<int> &arr, size_t l,
                                                                                size_t r) {
   if (arr.size() <= 1) return;
-  int n = r - l + 1;
-  for (int p = 1; p < n; p += p)
-    for (int k = p; k > 0; k /= 2)
-      for (int j = k % p; j + k < n; j += (k + k))
-        for (int i = 0; i < n - j - k; ++i)
-          if ((j + i) / (p + p) == (j + i + k) / (p + p)) CompExch(arr[l + j + i], arr[l + j + i + k]);
+  // vectorized odd-even networks: 8 x 8 blocks sorted in registers, then bitonic merges of runs
+  ppc::core::networkSort(arr.data() + l, r - l + 1, 1);
 }
 
 // OMP implementation of sorting
@@ -120,19 +118,6 @@ bool alexseev_omp::HoareSortWBatcherMergeOMP::post_processing() {
 void alexseev_omp::HoareSortWBatcherMergeOMP::HoareSortWBatcherMergeParallel(std::vector<int> &arr, size_t l,
                                                                              size_t r) {
   if (arr.size() <= 1) return;
-  int n = r - l + 1;
-
-  for (int p = 1; p < n; p += p)
-    for (int k = p; k > 0; k /= 2)
-      for (int j = k % p; j + k < n; j += (k + k))
-#pragma omp parallel for
-        for (int i = 0; i < n - j - k; ++i)
-          if ((j + i) / (p + p) == (j + i + k) / (p + p)) {
-            CompExch(arr[l + j + i], arr[l + j + i + k]);
-          }
-}
-
-// Additional functions
-void alexseev_omp::CompExch(int &a, int &b) {
-  if (a > b) std::swap(a, b);
+  // one parallel region for the whole sort instead of one per comparator layer
+  ppc::core::networkSort(arr.data() + l, r - l + 1);
 }
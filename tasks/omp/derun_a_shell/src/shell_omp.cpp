@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/sort/include/shell_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool ShellOMP::pre_processing() {
@@ -40,81 +42,9 @@ bool ShellOMP::post_processing() {
   return true;
 }
 
-std::vector<int> ShellOMP::merge(const std::vector<std::vector<int>>& chunks) {
-  std::vector<int> result;
-
-  // Merge the sorted chunks
-  for (const auto& chunk : chunks) {
-    // Merge the current chunk with the result vector
-    std::vector<int> merged;
-    merged.reserve(result.size() + chunk.size());
-    auto resultIter = result.begin();
-    auto chunkIter = chunk.begin();
-
-    while (resultIter != result.end() && chunkIter != chunk.end()) {
-      if (*resultIter < *chunkIter) {
-        merged.push_back(*resultIter);
-        ++resultIter;
-      } else {
-        merged.push_back(*chunkIter);
-        ++chunkIter;
-      }
-    }
-
-    // Copy remaining elements from result vector
-    while (resultIter != result.end()) {
-      merged.push_back(*resultIter);
-      ++resultIter;
-    }
-
-    // Copy remaining elements from current chunk
-    while (chunkIter != chunk.end()) {
-      merged.push_back(*chunkIter);
-      ++chunkIter;
-    }
-
-    // Update result vector with merged vector
-    result = std::move(merged);
-  }
-
-  return result;
-}
-
 void ShellOMP::shell_sort_parallel(std::vector<int>& input) {
-  int numProcs = omp_get_num_procs();
-  int size = static_cast<int>(input.size());
-  int chunkSize = size / numProcs;
-  int remainder = size % numProcs;
-
-  std::vector<std::vector<int>> chunks(numProcs);
-
-#pragma omp parallel for
-  for (int i = 0; i < numProcs; ++i) {
-    int startIdx = i * chunkSize;
-    int endIdx = startIdx + chunkSize;
-    if (i == numProcs - 1) {
-      endIdx += remainder;  // Add remaining elements to the last chunk
-    }
-    chunks[i].assign(input.begin() + startIdx, input.begin() + endIdx);
-    shell_sort(chunks[i]);
-  }
-
-#pragma omp barrier
-
-  input = merge(chunks);
-}
-
-void ShellOMP::shell_sort(std::vector<int>& vec) {
-  for (int interval = static_cast<int>(vec.size()) / 2; interval > 0; interval /= 2) {
-    for (int i = interval; i < static_cast<int>(vec.size()); i++) {
-      int tmp = vec[i];
-      int j = i;
-      for (; j >= interval && vec[j - interval] > tmp; j -= interval) {
-        vec[j] = vec[j - interval];
-      }
-      vec[j] = tmp;
-    }
-  }
+  // every thread sorts one chunk with Ciura gaps, then the chunks are merged in one k-way pass
+  ppc::core::shellSort(input);
 }
 
 bool ShellOMP::checkSorted(std::vector<int> input) { return std::is_sorted(input.begin(), input.end()); }
@@ -1,13 +1,11 @@
 // Copyright 2024 Eremin Alexander
 #include "omp/eremin_a_int_radixsort/include/ops_seq.hpp"
 
-#include <omp.h>
-
 #include <algorithm>
-#include <cmath>
-#include <iostream>
 #include <thread>
 
+#include "core/sort/include/radix_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool RadixSortTaskOMP::pre_processing() {
@@ -32,103 +30,11 @@ bool RadixSortTaskOMP::validation() {
          taskData->inputs[0] != nullptr && taskData->inputs_count[0] != 0;
 }
 
-std::vector<int> radixSort(std::vector<int> vec) {
-  std::vector<int> VectorForSort_;
-  VectorForSort_ = vec;
-  int numDevider = 0;
-  int maxNum = 0;
-  int MinKey;
-  int MaxKey;
-
-  for (size_t i = 0; i < VectorForSort_.size(); i++) {
-    if (maxNum <= VectorForSort_[i]) {
-      maxNum = VectorForSort_[i];
-    }
-  }
-
-  if (maxNum == 0) {
-    numDevider = 1;
-  } else
-    numDevider = log10(abs(maxNum)) + 1;
-
-  for (int dev = 0; dev < numDevider; dev++) {
-    int devider = pow(10, dev);
-
-    MinKey = VectorForSort_[0] % (devider * 10) / devider;
-
-    MaxKey = MinKey;
-
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      int digit = VectorForSort_[i] % (devider * 10) / devider;
-      if (digit < MinKey) {
-        MinKey = digit;
-      }
-      if (digit > MaxKey) {
-        MaxKey = digit;
-      }
-    }
-
-    std::vector<int> count(MaxKey - MinKey + 1);
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]++;
-    }
-
-    int size = VectorForSort_.size();
-    for (int i = count.size() - 1; i >= 0; i--) {
-      size -= count[i];
-      count[i] = size;
-    }
-    std::vector<int> temp(VectorForSort_.size());
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      temp[count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]] = VectorForSort_[i];
-      count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]++;
-    }
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      VectorForSort_[i] = temp[i];
-    }
-  }
-  vec = VectorForSort_;
-  return vec;
-}
-
-std::vector<int> myMerge(std::vector<int>* OneVector, std::vector<int>* TwoVector) {
-  std::vector<int> result(OneVector->size() + TwoVector->size());
-  std::merge((*OneVector).begin(), (*OneVector).end(), (*TwoVector).begin(), (*TwoVector).end(), result.begin());
-  return result;
-}
-
 bool RadixSortTaskOMP::run() {
   internal_order_test();
   try {
-    std::vector<int> result;
-    int VectorSize = VectorForSort.size();
-
-#pragma omp parallel shared(result, VectorSize)
-    {
-      int currentThread = omp_get_thread_num();
-      int threadNum = omp_get_num_threads();
-
-      if (threadNum >= VectorSize) {
-        threadNum = VectorSize;
-      }
-
-      if (currentThread < VectorSize) {
-        int step = VectorSize / threadNum;
-        int left = step * currentThread;
-        int righ = step * (currentThread + 1);
-        if (currentThread == threadNum - 1) {
-          righ += VectorSize - step * threadNum;
-        }
-
-        std::vector<int> VectorForSortLocal(VectorForSort.begin() + left, VectorForSort.begin() + righ);
-
-        VectorForSortLocal = radixSort(VectorForSortLocal);
-
-#pragma omp critical
-        { result = myMerge(&result, &VectorForSortLocal); }
-      }
-    }
-    VectorForSort = result;
+    // every pass is split across the OpenMP team inside the engine, so there is no merge step
+    ppc::core::radixSort(VectorForSort);
   } catch (...) {
     return false;
   }
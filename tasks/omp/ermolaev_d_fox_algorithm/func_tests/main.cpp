@@ -1,10 +1,31 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <random>
 #include <vector>
 
 #include "omp/ermolaev_d_fox_algorithm/include/ops_omp.hpp"
 
+namespace {
+
+template <class Fox, class T, class Acc>
+void runFox(std::vector<T> &A, std::vector<T> &B, std::vector<Acc> &C) {
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(A.data()));
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(B.data()));
+  taskData->inputs_count.emplace_back(A.size());
+  taskData->inputs_count.emplace_back(B.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(C.data()));
+  taskData->outputs_count.emplace_back(C.size());
+  Fox fox(taskData);
+  ASSERT_TRUE(fox.validation());
+  ASSERT_TRUE(fox.pre_processing());
+  ASSERT_TRUE(fox.run());
+  ASSERT_TRUE(fox.post_processing());
+}
+
+}  // namespace
+
 TEST(ermolaev_d_fox_algorithm_omp, Test_Matrix_Multiplication_Simple_56) {
   constexpr size_t matrix_size = 56;
   std::vector<double> A(matrix_size * matrix_size, 1.0);
@@ -207,4 +228,39 @@ TEST(ermolaev_d_fox_algorithm_omp, Test_Matrix_Multiplication_Random_64) {
   for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
     ASSERT_NEAR(C[i], expected[i], tolerance);
   }
-}
\ No newline at end of file
+}
+
+TEST(ermolaev_d_fox_algorithm_omp, Float_And_Mixed_Within_Error_Bounds) {
+  // |C - fl(C)| <= gamma(n) |A| |B| elementwise, gamma(n) = n u / (1 - n u) with u = 2^-24
+  constexpr size_t matrix_size = 300;
+  constexpr int tile = 128;
+  auto gamma = [](size_t terms) { return terms * 0x1p-24 / (1.0 - terms * 0x1p-24); };
+  std::mt19937 gen(4);
+  std::uniform_real_distribution<float> dis(-1.0F, 1.0F);
+  std::vector<float> A(matrix_size * matrix_size);
+  std::vector<float> B(matrix_size * matrix_size);
+  for (auto &value : A) value = dis(gen);
+  for (auto &value : B) value = dis(gen);
+  std::vector<double> exact(matrix_size * matrix_size, 0.0);
+  std::vector<double> magnitude(matrix_size * matrix_size, 0.0);
+  for (size_t i = 0; i < matrix_size; ++i) {
+    for (size_t k = 0; k < matrix_size; ++k) {
+      for (size_t j = 0; j < matrix_size; ++j) {
+        const double product = static_cast<double>(A[i * matrix_size + k]) * B[k * matrix_size + j];
+        exact[i * matrix_size + j] += product;
+        magnitude[i * matrix_size + j] += std::abs(product);
+      }
+    }
+  }
+
+  std::vector<float> single(matrix_size * matrix_size);
+  std::vector<double> mixed(matrix_size * matrix_size);
+  runFox<FoxAlgorithmOMPFloat>(A, B, single);
+  runFox<FoxAlgorithmOMPMixed>(A, B, mixed);
+
+  for (size_t i = 0; i < matrix_size * matrix_size; ++i) {
+    // float sums run over all of n, mixed ones over one tile before they reach double C
+    ASSERT_LE(std::abs(single[i] - exact[i]), gamma(matrix_size + 1) * magnitude[i]) << "float at " << i;
+    ASSERT_LE(std::abs(mixed[i] - exact[i]), gamma(tile + 1) * magnitude[i]) << "mixed at " << i;
+  }
+}
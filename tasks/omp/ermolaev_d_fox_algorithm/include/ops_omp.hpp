@@ -7,17 +7,24 @@
 
 #include "core/task/include/task.hpp"
 
-class FoxAlgorithmOMP : public ppc::core::Task {
+// Inputs are two n x n matrices of T, the output is n x n of Acc. Instantiated for double,
+// float and the mixed float -> double mode.
+template <class T, class Acc = T>
+class BasicFoxAlgorithmOMP : public ppc::core::Task {
  public:
-  explicit FoxAlgorithmOMP(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  explicit BasicFoxAlgorithmOMP(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
   bool post_processing() override;
 
  private:
-  double* matrix_A;
-  double* matrix_B;
-  double* matrix_C;
+  T* matrix_A;
+  T* matrix_B;
+  Acc* matrix_C;
   size_t data_size;
-};
\ No newline at end of file
+};
+
+using FoxAlgorithmOMP = BasicFoxAlgorithmOMP<double>;
+using FoxAlgorithmOMPFloat = BasicFoxAlgorithmOMP<float>;
+using FoxAlgorithmOMPMixed = BasicFoxAlgorithmOMP<float, double>;
@@ -43,7 +43,7 @@ TEST(ermolaev_d_fox_algorithm_omp, test_pipline_run) {
   auto testTask = std::make_shared<FoxAlgorithmOMP>(taskData);
 
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 1;
+  perfAttr->num_running = 10;
   perfAttr->current_timer = &timer_for_test;
 
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -88,7 +88,7 @@ TEST(ermolaev_d_fox_algorithm_omp, test_task_run) {
   auto testTask = std::make_shared<FoxAlgorithmOMP>(taskData);
 
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 1;
+  perfAttr->num_running = 10;
   perfAttr->current_timer = &timer_for_test;
 
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -100,4 +100,4 @@ TEST(ermolaev_d_fox_algorithm_omp, test_task_run) {
   for (size_t i = 0; i < matrix_size * matrix_size; i++) {
     ASSERT_NEAR(C[i], expected[i], tolerance);
   }
-}
\ No newline at end of file
+}
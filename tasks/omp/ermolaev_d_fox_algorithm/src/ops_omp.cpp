@@ -2,38 +2,22 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iostream>
 #include <thread>
 
+#include "core/gemm/include/block_matrix.hpp"
+
 using namespace std::chrono_literals;
 namespace {
-std::vector<std::vector<double>> multiply_block(const std::vector<std::vector<double>>& block_A,
-                                                const std::vector<std::vector<double>>& block_B) {
-  size_t blockSize = block_A.size();
-  std::vector<std::vector<double>> block_C(blockSize, std::vector<double>(blockSize, 0.0));
-  for (size_t i = 0; i < blockSize; ++i) {
-    for (size_t j = 0; j < blockSize; ++j) {
-      for (size_t k = 0; k < blockSize; ++k) {
-        block_C[i][j] += block_A[i][k] * block_B[k][j];
-      }
-    }
-  }
-  return block_C;
-}
-
-int calculateBlockSize(int n, int cacheSize = 1024, int elementSize = 8) {
-  int b = std::sqrt((cacheSize) / (elementSize * 2));
-
-  while (n % b != 0) {
-    b--;
-  }
-  return b;
-}
+// tiles of 128 x 128 doubles: three of them (A, B and C) stay in a 512 KB L2
+constexpr int kTileSize = 128;
 }  // namespace
 
-bool FoxAlgorithmOMP::validation() {
+template <class T, class Acc>
+bool BasicFoxAlgorithmOMP<T, Acc>::validation() {
   internal_order_test();
   return !taskData->inputs_count.empty() && taskData->inputs_count.size() == 2 &&
          taskData->inputs_count[0] == taskData->inputs_count[1] && taskData->outputs_count.size() == 1 &&
@@ -41,7 +25,8 @@ bool FoxAlgorithmOMP::validation() {
          taskData->inputs[1] != nullptr && taskData->outputs[0] != nullptr;
 }
 
-bool FoxAlgorithmOMP::pre_processing() {
+template <class T, class Acc>
+bool BasicFoxAlgorithmOMP<T, Acc>::pre_processing() {
   try {
     internal_order_test();
     data_size = static_cast<size_t>(sqrt(taskData->inputs_count[0]));
@@ -49,9 +34,9 @@ bool FoxAlgorithmOMP::pre_processing() {
       std::cerr << "Data size error: input count does not match expected size of square matrix." << std::endl;
       return false;
     }
-    matrix_A = reinterpret_cast<double*>(taskData->inputs[0]);
-    matrix_B = reinterpret_cast<double*>(taskData->inputs[1]);
-    matrix_C = reinterpret_cast<double*>(taskData->outputs[0]);
+    matrix_A = reinterpret_cast<T*>(taskData->inputs[0]);
+    matrix_B = reinterpret_cast<T*>(taskData->inputs[1]);
+    matrix_C = reinterpret_cast<Acc*>(taskData->outputs[0]);
     for (size_t i = 0; i < data_size; ++i) {
       for (size_t j = 0; j < data_size; ++j) {
         matrix_C[i * data_size + j] = 0;
@@ -63,44 +48,19 @@ bool FoxAlgorithmOMP::pre_processing() {
   return matrix_A != nullptr && matrix_B != nullptr;
 }
 
-bool FoxAlgorithmOMP::run() {
+template <class T, class Acc>
+bool BasicFoxAlgorithmOMP<T, Acc>::run() {
   internal_order_test();
   double start = omp_get_wtime();
   try {
     int n = static_cast<int>(data_size);
-    int blockSize = calculateBlockSize(n);
-    int numBlocks = n / blockSize;
-
-#pragma omp parallel
-    {
-      std::vector<std::vector<double>> block_A;
-      std::vector<std::vector<double>> block_B;
-      std::vector<std::vector<double>> block_C;
-#pragma omp for nowait
-      for (int stage = 0; stage < numBlocks; ++stage) {
-        for (int i = 0; i < numBlocks; ++i) {
-          for (int j = 0; j < numBlocks; ++j) {
-            int k = (i + stage) % numBlocks;
-            block_A.assign(blockSize, std::vector<double>(blockSize));
-            block_B.assign(blockSize, std::vector<double>(blockSize));
-            block_C.assign(blockSize, std::vector<double>(blockSize, 0.0));
-            for (int row = 0; row < blockSize; ++row) {
-              for (int col = 0; col < blockSize; ++col) {
-                block_A[row][col] = matrix_A[((i * blockSize) + row) * n + (k * blockSize) + col];
-                block_B[row][col] = matrix_B[((k * blockSize) + row) * n + (j * blockSize) + col];
-              }
-            }
-            block_C = multiply_block(block_A, block_B);
-#pragma omp critical
-            for (int row = 0; row < blockSize; ++row) {
-              for (int col = 0; col < blockSize; ++col) {
-                matrix_C[((i * blockSize) + row) * n + (j * blockSize) + col] += block_C[row][col];
-              }
-            }
-          }
-        }
-      }
-    }
+    int blockSize = std::min(n, kTileSize);
+    auto block_A = ppc::core::BasicBlockMatrix<T>::fromRowMajor(matrix_A, n, blockSize);
+    auto block_B = ppc::core::BasicBlockMatrix<T>::fromRowMajor(matrix_B, n, blockSize);
+    ppc::core::BasicBlockMatrix<Acc> block_C(n, blockSize);
+    ppc::core::multiplyBlocks(block_A, block_B, block_C, ppc::core::BlockSchedule::Fox,
+                              ppc::core::defaultLayers(block_C.grid()));
+    block_C.toRowMajor(matrix_C);
     double finish = omp_get_wtime();
     std::cout << "How measure time in OpenMP: " << finish - start << std::endl;
   } catch (...) {
@@ -109,16 +69,21 @@ bool FoxAlgorithmOMP::run() {
   return true;
 }
 
-bool FoxAlgorithmOMP::post_processing() {
+template <class T, class Acc>
+bool BasicFoxAlgorithmOMP<T, Acc>::post_processing() {
   internal_order_test();
   try {
     for (size_t i = 0; i < data_size; ++i) {
       for (size_t j = 0; j < data_size; ++j) {
-        reinterpret_cast<double*>(taskData->outputs[0])[i * data_size + j] = matrix_C[i * data_size + j];
+        reinterpret_cast<Acc*>(taskData->outputs[0])[i * data_size + j] = matrix_C[i * data_size + j];
       }
     }
   } catch (...) {
     return false;
   }
   return true;
-}
\ No newline at end of file
+}
+
+template class BasicFoxAlgorithmOMP<double>;
+template class BasicFoxAlgorithmOMP<float>;
+template class BasicFoxAlgorithmOMP<float, double>;
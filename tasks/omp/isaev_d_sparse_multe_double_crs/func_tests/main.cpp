@@ -1,9 +1,35 @@
 // Copyright 2024 Isaev Dmitriy
 #include <gtest/gtest.h>
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <filesystem>
+#include <string>
 #include <vector>
 
 #include "omp/isaev_d_sparse_multe_double_crs/include/ops_omp.hpp"
+#include "omp/isaev_d_sparse_multe_double_crs/include/out_of_core.hpp"
+
+namespace {
+
+// The pid keeps concurrent test runs apart and the counter keeps the files of one run apart.
+std::string tempPath(const std::string &name) {
+  static std::atomic<int> counter{0};
+#ifdef _WIN32
+  const int pid = _getpid();
+#else
+  const int pid = static_cast<int>(getpid());
+#endif
+  const std::string unique = name + "_" + std::to_string(pid) + "_" + std::to_string(counter++) + ".crs";
+  return (std::filesystem::temp_directory_path() / unique).string();
+}
+
+}  // namespace
 
 TEST(isaev_d_sparse_multe_double_crs_omp, Test1) {
   // Create data
@@ -340,3 +366,153 @@ TEST(isaev_d_sparse_multe_double_crs_omp, Test5) {
     EXPECT_DOUBLE_EQ(c_seq.values[i], c_par.values[i]);
   }
 }
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_matrix_file_roundtrip) {
+  IsaevOMP::SparseMatrix a = IsaevOMP::getRandomMatrix(37, 23, 0.3, 11);
+  std::string path = tempPath("isaev_d_omp_roundtrip");
+
+  IsaevOMP::writeMatrixFile(a, path);
+  IsaevOMP::SparseMatrix b = IsaevOMP::readMatrixFile(path);
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(a.rows, b.rows);
+  EXPECT_EQ(a.columns, b.columns);
+  EXPECT_EQ(a.row_pointers, b.row_pointers);
+  EXPECT_EQ(a.column_indices, b.column_indices);
+  EXPECT_EQ(a.values, b.values);
+}
+
+void checkOutOfCore(IsaevOMP::SparseMatrix a, IsaevOMP::SparseMatrix b, uint64_t budget, int64_t min_panels) {
+  IsaevOMP::SparseMatrix c_seq;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&a));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&c_seq));
+
+  // Create Task
+  IsaevOMP::SparseMultDoubleCRSompSeq ompTaskSequential(taskDataSeq);
+  ASSERT_EQ(ompTaskSequential.validation(), true);
+  ompTaskSequential.pre_processing();
+  ompTaskSequential.run();
+  ompTaskSequential.post_processing();
+
+  // Create data
+  IsaevOMP::OutOfCoreConfig config;
+  config.a_path = tempPath("isaev_d_omp_a");
+  config.c_path = tempPath("isaev_d_omp_c");
+  config.memory_budget = budget;
+  IsaevOMP::writeMatrixFile(a, config.a_path);
+  IsaevOMP::OutOfCoreStats stats;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOOC = std::make_shared<ppc::core::TaskData>();
+  taskDataOOC->inputs.emplace_back(reinterpret_cast<uint8_t *>(&config));
+  taskDataOOC->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b));
+  taskDataOOC->outputs.emplace_back(reinterpret_cast<uint8_t *>(&stats));
+
+  // Create Task
+  IsaevOMP::SparseMultDoubleCRSompOutOfCore ompTaskOutOfCore(taskDataOOC);
+  ASSERT_EQ(ompTaskOutOfCore.validation(), true);
+  ompTaskOutOfCore.pre_processing();
+  ompTaskOutOfCore.run();
+  ompTaskOutOfCore.post_processing();
+
+  IsaevOMP::SparseMatrix c_ooc = IsaevOMP::readMatrixFile(config.c_path);
+  std::filesystem::remove(config.a_path);
+  std::filesystem::remove(config.c_path);
+
+  EXPECT_GE(stats.panels, min_panels);
+  EXPECT_EQ(stats.nnz, static_cast<int64_t>(c_ooc.values.size()));
+  EXPECT_EQ(c_seq.rows, c_ooc.rows);
+  EXPECT_EQ(c_seq.columns, c_ooc.columns);
+  ASSERT_EQ(c_seq.row_pointers, c_ooc.row_pointers);
+  ASSERT_EQ(c_seq.column_indices, c_ooc.column_indices);
+  for (size_t i = 0; i < c_seq.values.size(); i++) {
+    EXPECT_NEAR(c_seq.values[i], c_ooc.values[i], 1e-9);
+  }
+}
+
+void checkOutOfCore(int n, int m, double chance, uint64_t budget, int64_t min_panels) {
+  checkOutOfCore(IsaevOMP::getRandomMatrix(n, m, chance, 4), IsaevOMP::getRandomMatrix(m, n, chance, 5), budget,
+                 min_panels);
+}
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_out_of_core_single_panel) { checkOutOfCore(40, 30, 0.2, 1 << 30, 1); }
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_out_of_core_many_panels) { checkOutOfCore(120, 90, 0.1, 512, 10); }
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_out_of_core_budget_below_one_row) { checkOutOfCore(20, 50, 0.5, 1, 20); }
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_out_of_core_dense_product) { checkOutOfCore(500, 500, 0.5, 1 << 20, 2); }
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_out_of_core_drops_cancelled_entries) {
+  // rows of A alternate between [1, 1] and [1, -1] and B = [[1, 2], [-1, 2]], so every row of C
+  // has one entry that cancels to exactly zero and the symbolic count overestimates C
+  const int n = 64;
+  IsaevOMP::SparseMatrix a;
+  a.rows = n;
+  a.columns = 2;
+  for (int i = 0; i < n; ++i) {
+    a.row_pointers.push_back(2 * i);
+    a.column_indices.insert(a.column_indices.end(), {0, 1});
+    a.values.insert(a.values.end(), {1.0, i % 2 == 0 ? 1.0 : -1.0});
+  }
+  a.row_pointers.push_back(2 * n);
+  IsaevOMP::SparseMatrix b;
+  b.rows = 2;
+  b.columns = 2;
+  b.row_pointers = {0, 2, 4};
+  b.column_indices = {0, 1, 0, 1};
+  b.values = {1.0, 2.0, -1.0, 2.0};
+  checkOutOfCore(a, b, 256, 4);
+}
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_out_of_core_wrong_sizes) {
+  IsaevOMP::SparseMatrix a = IsaevOMP::getRandomMatrix(10, 7, 0.5, 1);
+  IsaevOMP::SparseMatrix b = IsaevOMP::getRandomMatrix(8, 10, 0.5, 2);
+  IsaevOMP::OutOfCoreConfig config;
+  config.a_path = tempPath("isaev_d_omp_wrong_a");
+  config.c_path = tempPath("isaev_d_omp_wrong_c");
+  config.memory_budget = 1024;
+  IsaevOMP::writeMatrixFile(a, config.a_path);
+  IsaevOMP::OutOfCoreStats stats;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOOC = std::make_shared<ppc::core::TaskData>();
+  taskDataOOC->inputs.emplace_back(reinterpret_cast<uint8_t *>(&config));
+  taskDataOOC->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b));
+  taskDataOOC->outputs.emplace_back(reinterpret_cast<uint8_t *>(&stats));
+
+  IsaevOMP::SparseMultDoubleCRSompOutOfCore ompTaskOutOfCore(taskDataOOC);
+  EXPECT_EQ(ompTaskOutOfCore.validation(), false);
+  std::filesystem::remove(config.a_path);
+}
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test_out_of_core_corrupt_file) {
+  IsaevOMP::SparseMatrix a = IsaevOMP::getRandomMatrix(10, 8, 0.5, 1);
+  IsaevOMP::SparseMatrix b = IsaevOMP::getRandomMatrix(8, 10, 0.5, 2);
+  IsaevOMP::OutOfCoreConfig config;
+  config.a_path = tempPath("isaev_d_omp_corrupt_a");
+  config.c_path = tempPath("isaev_d_omp_corrupt_c");
+  config.memory_budget = 1024;
+  IsaevOMP::writeMatrixFile(a, config.a_path);
+  {
+    // a column index past the last column of A
+    ppc::core::SparseFileHeader header = ppc::core::readSparseFileHeader(config.a_path);
+    ppc::core::MappedFile file(config.a_path, header.index_offset, sizeof(int32_t), true);
+    *reinterpret_cast<int32_t *>(file.data()) = 8;
+  }
+  IsaevOMP::OutOfCoreStats stats;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOOC = std::make_shared<ppc::core::TaskData>();
+  taskDataOOC->inputs.emplace_back(reinterpret_cast<uint8_t *>(&config));
+  taskDataOOC->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b));
+  taskDataOOC->outputs.emplace_back(reinterpret_cast<uint8_t *>(&stats));
+
+  IsaevOMP::SparseMultDoubleCRSompOutOfCore ompTaskOutOfCore(taskDataOOC);
+  EXPECT_EQ(ompTaskOutOfCore.validation(), false);
+  std::filesystem::remove(config.a_path);
+}
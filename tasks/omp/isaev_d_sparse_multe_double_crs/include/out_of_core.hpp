@@ -0,0 +1,47 @@
+// Copyright 2024 Isaev Dmitriy
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/io/include/sparse_file.hpp"
+#include "core/task/include/task.hpp"
+#include "omp/isaev_d_sparse_multe_double_crs/include/ops_omp.hpp"
+
+namespace IsaevOMP {
+
+// A and C are stored in the ppc::core sparse file format with the CRS layout
+void writeMatrixFile(const SparseMatrix &matrix, const std::string &path);
+SparseMatrix readMatrixFile(const std::string &path);
+
+struct OutOfCoreConfig {
+  std::string a_path;      // A as a CRS sparse file, streamed by row panels
+  std::string c_path;      // C is written here in the same format
+  uint64_t memory_budget;  // bytes of A and C panels mapped at the same time, plus the per-thread accumulators
+};
+
+struct OutOfCoreStats {
+  int64_t nnz{};
+  int64_t panels{};
+};
+
+// C = A * B where A and C live on disk and B is resident
+class SparseMultDoubleCRSompOutOfCore : public ppc::core::Task {
+ public:
+  explicit SparseMultDoubleCRSompOutOfCore(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  OutOfCoreConfig *config{};
+  SparseMatrix *B{};
+  OutOfCoreStats *stats{};
+  ppc::core::SparseFileHeader a_header{};
+  std::vector<int64_t> c_row_pointers;
+};
+
+}  // namespace IsaevOMP
@@ -0,0 +1,259 @@
+// Copyright 2024 Isaev Dmitriy
+#include "omp/isaev_d_sparse_multe_double_crs/include/out_of_core.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+namespace IsaevOMP {
+
+using ppc::core::MappedFile;
+using ppc::core::SparseFileHeader;
+using ppc::core::SparseLayout;
+
+namespace {
+
+// Splits rows [0, rows) into panels whose cost in bytes stays within the budget.
+// A panel always holds at least one row, even if that row alone exceeds the budget.
+template <class RowCost>
+std::vector<int64_t> planPanels(int64_t rows, uint64_t budget, RowCost row_cost) {
+  std::vector<int64_t> bounds{0};
+  uint64_t current = 0;
+  for (int64_t i = 0; i < rows; ++i) {
+    uint64_t cost = row_cost(i);
+    if (current + cost > budget && bounds.back() != i) {
+      bounds.push_back(i);
+      current = 0;
+    }
+    current += cost;
+  }
+  if (bounds.back() != rows || rows == 0) bounds.push_back(rows);
+  return bounds;
+}
+
+// What is left of the budget for panels once every thread has its dense accumulator over the columns of C.
+// If the accumulators alone exceed the budget, panels shrink to single rows.
+uint64_t panelBudget(uint64_t budget, int columns, uint64_t bytes_per_column) {
+  uint64_t workspace = static_cast<uint64_t>(omp_get_max_threads()) * columns * bytes_per_column;
+  return budget > workspace ? budget - workspace : 1;
+}
+
+}  // namespace
+
+void writeMatrixFile(const SparseMatrix &matrix, const std::string &path) {
+  ppc::core::writeSparseFile(path, SparseLayout::CRS, matrix.rows, matrix.columns, matrix.row_pointers.data(),
+                             matrix.column_indices.data(), matrix.values.data());
+}
+
+SparseMatrix readMatrixFile(const std::string &path) {
+  ppc::core::SparseFile file(path);
+  const SparseFileHeader &header = file.header();
+  if (file.layout() != SparseLayout::CRS) throw std::runtime_error("Not a CRS matrix file: " + path);
+  SparseMatrix matrix;
+  matrix.rows = static_cast<int>(header.n_rows);
+  matrix.columns = static_cast<int>(header.n_cols);
+  matrix.row_pointers.assign(file.ptr(), file.ptr() + header.n_rows + 1);
+  matrix.column_indices.assign(file.index(), file.index() + header.nnz);
+  matrix.values.assign(file.values(), file.values() + header.nnz);
+  return matrix;
+}
+
+bool SparseMultDoubleCRSompOutOfCore::pre_processing() {
+  internal_order_test();
+  c_row_pointers.assign(a_header.n_rows + 1, 0);
+  *stats = OutOfCoreStats{};
+  return true;
+}
+
+bool SparseMultDoubleCRSompOutOfCore::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 2 || taskData->outputs.size() != 1) return false;
+  config = reinterpret_cast<OutOfCoreConfig *>(taskData->inputs[0]);
+  B = reinterpret_cast<SparseMatrix *>(taskData->inputs[1]);
+  stats = reinterpret_cast<OutOfCoreStats *>(taskData->outputs[0]);
+  if (config == nullptr || B == nullptr || stats == nullptr || config->memory_budget == 0) return false;
+  // A is checked in full once here, so the panels below can trust its pointers and column indices
+  try {
+    a_header = ppc::core::SparseFile(config->a_path).header();
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+  return a_header.layout == static_cast<uint32_t>(SparseLayout::CRS) && a_header.n_cols == B->rows;
+}
+
+bool SparseMultDoubleCRSompOutOfCore::run() {
+  internal_order_test();
+  const int64_t rows = a_header.n_rows;
+  const int columns = B->columns;
+
+  // row pointers of A and C are O(rows) and stay whole, the budget bounds the nonzeros
+  MappedFile a_row_file(config->a_path, a_header.ptr_offset, (rows + 1) * sizeof(int64_t), false);
+  const auto *a_row_pointers = reinterpret_cast<const int64_t *>(a_row_file.data());
+  auto a_row_bytes = [&](int64_t i) {
+    return (a_row_pointers[i + 1] - a_row_pointers[i]) * (sizeof(int32_t) + sizeof(double)) + sizeof(int64_t);
+  };
+
+  // symbolic stage: nonzeros per row of C, streaming column indices of A
+  std::vector<int64_t> bounds =
+      planPanels(rows, panelBudget(config->memory_budget, columns, sizeof(int64_t)), a_row_bytes);
+  for (size_t p = 0; p + 1 < bounds.size(); ++p) {
+    const int64_t first = bounds[p];
+    const int64_t last = bounds[p + 1];
+    const int64_t base = a_row_pointers[first];
+    MappedFile a_cols(config->a_path, a_header.index_offset + base * sizeof(int32_t),
+                      (a_row_pointers[last] - base) * sizeof(int32_t), false);
+    const auto *a_column_indices = reinterpret_cast<const int32_t *>(a_cols.data());
+#pragma omp parallel
+    {
+      std::vector<int64_t> marker(columns, -1);
+#pragma omp for schedule(dynamic, 64)
+      for (int64_t i = first; i < last; ++i) {
+        int64_t count = 0;
+        for (int64_t k = a_row_pointers[i]; k < a_row_pointers[i + 1]; ++k) {
+          int j = a_column_indices[k - base];
+          for (int l = B->row_pointers[j]; l < B->row_pointers[j + 1]; ++l) {
+            int m = B->column_indices[l];
+            if (marker[m] != i) {
+              marker[m] = i;
+              ++count;
+            }
+          }
+        }
+        c_row_pointers[i + 1] = count;
+      }
+    }
+  }
+  for (int64_t i = 0; i < rows; ++i) {
+    c_row_pointers[i + 1] += c_row_pointers[i];
+  }
+
+  const int64_t c_nnz = c_row_pointers[rows];
+  const SparseFileHeader c_header = ppc::core::makeSparseFileHeader(SparseLayout::CRS, rows, columns, c_nnz);
+  ppc::core::createSparseFile(config->c_path, c_header);
+
+  // numeric stage: A panels are read and C panels are written through the mappings. Entries that
+  // cancel to exactly 0.0 are dropped like in the in-memory product, so a row may fill only the
+  // front of the slot the symbolic stage reserved for it; kept[i + 1] counts what row i wrote
+  std::vector<int64_t> kept(rows + 1, 0);
+  auto ac_row_bytes = [&](int64_t i) {
+    return a_row_bytes(i) + (c_row_pointers[i + 1] - c_row_pointers[i]) * (sizeof(int32_t) + sizeof(double));
+  };
+  bounds = planPanels(rows, panelBudget(config->memory_budget, columns, sizeof(double) + sizeof(char) + sizeof(int)),
+                      ac_row_bytes);
+  for (size_t p = 0; p + 1 < bounds.size(); ++p) {
+    const int64_t first = bounds[p];
+    const int64_t last = bounds[p + 1];
+    const int64_t a_base = a_row_pointers[first];
+    const int64_t a_count = a_row_pointers[last] - a_base;
+    const int64_t c_base = c_row_pointers[first];
+    const int64_t c_count = c_row_pointers[last] - c_base;
+    MappedFile a_cols(config->a_path, a_header.index_offset + a_base * sizeof(int32_t),
+                      a_count * sizeof(int32_t), false);
+    MappedFile a_vals(config->a_path, a_header.values_offset + a_base * sizeof(double), a_count * sizeof(double),
+                      false);
+    MappedFile c_cols(config->c_path, c_header.index_offset + c_base * sizeof(int32_t),
+                      c_count * sizeof(int32_t), true);
+    MappedFile c_vals(config->c_path, c_header.values_offset + c_base * sizeof(double), c_count * sizeof(double), true);
+    const auto *a_column_indices = reinterpret_cast<const int32_t *>(a_cols.data());
+    const auto *a_values = reinterpret_cast<const double *>(a_vals.data());
+    auto *c_column_indices = reinterpret_cast<int32_t *>(c_cols.data());
+    auto *c_values = reinterpret_cast<double *>(c_vals.data());
+#pragma omp parallel
+    {
+      std::vector<double> temp(columns, 0.0);
+      std::vector<char> present(columns, 0);
+      std::vector<int> touched;
+#pragma omp for schedule(dynamic, 64)
+      for (int64_t i = first; i < last; ++i) {
+        for (int64_t k = a_row_pointers[i]; k < a_row_pointers[i + 1]; ++k) {
+          int j = a_column_indices[k - a_base];
+          double a_value = a_values[k - a_base];
+          for (int l = B->row_pointers[j]; l < B->row_pointers[j + 1]; ++l) {
+            int m = B->column_indices[l];
+            if (present[m] == 0) {
+              present[m] = 1;
+              touched.push_back(m);
+            }
+            temp[m] += a_value * B->values[l];
+          }
+        }
+        std::sort(touched.begin(), touched.end());
+        const int64_t start = c_row_pointers[i] - c_base;
+        int64_t pos = start;
+        for (int m : touched) {
+          if (temp[m] != 0.0) {
+            c_column_indices[pos] = m;
+            c_values[pos++] = temp[m];
+          }
+          temp[m] = 0.0;
+          present[m] = 0;
+        }
+        kept[i + 1] = pos - start;
+        touched.clear();
+      }
+    }
+    ++stats->panels;
+  }
+
+  for (int64_t i = 0; i < rows; ++i) {
+    kept[i + 1] += kept[i];
+  }
+
+  SparseFileHeader out_header = c_header;
+  if (kept[rows] != c_nnz) {
+    // compaction: the sections of C are sized by nnz, so the rows are streamed into a new file
+    const std::string part_path = config->c_path + ".part";
+    std::filesystem::rename(config->c_path, part_path);
+    out_header = ppc::core::makeSparseFileHeader(SparseLayout::CRS, rows, columns, kept[rows]);
+    ppc::core::createSparseFile(config->c_path, out_header);
+    auto copy_row_bytes = [&](int64_t i) {
+      return (c_row_pointers[i + 1] - c_row_pointers[i] + kept[i + 1] - kept[i]) * (sizeof(int32_t) + sizeof(double));
+    };
+    bounds = planPanels(rows, config->memory_budget, copy_row_bytes);
+    for (size_t p = 0; p + 1 < bounds.size(); ++p) {
+      const int64_t first = bounds[p];
+      const int64_t last = bounds[p + 1];
+      const int64_t src_base = c_row_pointers[first];
+      const int64_t src_count = c_row_pointers[last] - src_base;
+      const int64_t dst_base = kept[first];
+      const int64_t dst_count = kept[last] - dst_base;
+      MappedFile src_cols(part_path, c_header.index_offset + src_base * sizeof(int32_t),
+                          src_count * sizeof(int32_t), false);
+      MappedFile src_vals(part_path, c_header.values_offset + src_base * sizeof(double), src_count * sizeof(double),
+                          false);
+      MappedFile dst_cols(config->c_path, out_header.index_offset + dst_base * sizeof(int32_t),
+                          dst_count * sizeof(int32_t), true);
+      MappedFile dst_vals(config->c_path, out_header.values_offset + dst_base * sizeof(double),
+                          dst_count * sizeof(double), true);
+      const auto *src_column_indices = reinterpret_cast<const int32_t *>(src_cols.data());
+      const auto *src_values = reinterpret_cast<const double *>(src_vals.data());
+      auto *dst_column_indices = reinterpret_cast<int32_t *>(dst_cols.data());
+      auto *dst_values = reinterpret_cast<double *>(dst_vals.data());
+#pragma omp parallel for schedule(dynamic, 64)
+      for (int64_t i = first; i < last; ++i) {
+        const int64_t from = c_row_pointers[i] - src_base;
+        const int64_t to = kept[i] - dst_base;
+        const int64_t count = kept[i + 1] - kept[i];
+        std::copy(src_column_indices + from, src_column_indices + from + count, dst_column_indices + to);
+        std::copy(src_values + from, src_values + from + count, dst_values + to);
+      }
+    }
+    std::filesystem::remove(part_path);
+  }
+
+  MappedFile c_head(config->c_path, out_header.ptr_offset, (rows + 1) * sizeof(int64_t), true);
+  std::copy(kept.begin(), kept.end(), reinterpret_cast<int64_t *>(c_head.data()));
+  c_row_pointers = std::move(kept);
+  stats->nnz = out_header.nnz;
+  return true;
+}
+
+bool SparseMultDoubleCRSompOutOfCore::post_processing() {
+  internal_order_test();
+  return true;
+}
+
+}  // namespace IsaevOMP
@@ -1,6 +1,10 @@
 // Copyright 2024 Kazantsev Evgeny
 #include <gtest/gtest.h>
+#include <omp.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 #include "omp/kazantsev_e_shtrassen_alg/include/ops_omp.hpp"
@@ -222,4 +226,84 @@ TEST(kazantsev_e_matmul_strassen_omp, multSecShtrassenOmp_size) {
   MatMulStrassenSec.post_processing();
 
   ASSERT_EQ(res.size(), out.size());
-}
\ No newline at end of file
+}
+
+TEST(kazantsev_e_matmul_strassen_omp, task_levels_with_odd_blocks) {
+  const int n = 100;
+
+  std::vector<double> A = getRandomMatrix(n);
+  std::vector<double> B = getRandomMatrix(n);
+  std::vector<double> res = multMatrixNoShtrassen(A, B, n);
+
+  // three task levels: 100 -> 50 -> 25 (peeled) -> 12, serial below
+  std::vector<double> out = StrassenMatMul(A, B, n, 4, 3);
+  ASSERT_EQ(res.size(), out.size());
+  for (size_t i = 0; i < res.size(); ++i) {
+    ASSERT_NEAR(res[i], out[i], 1e-6);
+  }
+}
+
+TEST(kazantsev_e_matmul_strassen_omp, thread_counts_give_the_same_product) {
+  const int n = 300;
+
+  std::vector<double> A = getRandomMatrix(n);
+  std::vector<double> B = getRandomMatrix(n);
+  std::vector<double> res = multMatrixNoShtrassen(A, B, n);
+
+  // the default depth grows with the thread count, and with it the task workspace
+  const int max_threads = omp_get_max_threads();
+  for (int threads : {1, 2, 4, 16}) {
+    omp_set_num_threads(threads);
+    std::vector<double> out = StrassenMatMul(A, B, n, 16);
+    ASSERT_EQ(res.size(), out.size());
+    for (size_t i = 0; i < res.size(); ++i) {
+      ASSERT_NEAR(res[i], out[i], 1e-6) << threads;
+    }
+  }
+  omp_set_num_threads(max_threads);
+}
+
+TEST(kazantsev_e_matmul_strassen_omp, float_within_error_bound) {
+  const int n = 256;
+  const int cutoff = 32;
+
+  std::vector<double> A = getRandomMatrix(n);
+  std::vector<double> B = getRandomMatrix(n);
+  std::vector<double> res = multMatrixNoShtrassen(A, B, n);
+  std::vector<float> A32(A.begin(), A.end());
+  std::vector<float> B32(B.begin(), B.end());
+  std::vector<float> out(n * n);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(A32.data()));
+  taskDataSeq->inputs_count.emplace_back(A32.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(B32.data()));
+  taskDataSeq->inputs_count.emplace_back(B32.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<int *>(&n)));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<int *>(&n)));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+
+  MatMulStrassenSecFloat MatMulStrassenSec(taskDataSeq);
+  ASSERT_EQ(MatMulStrassenSec.validation(), true);
+  MatMulStrassenSec.pre_processing();
+  MatMulStrassenSec.run();
+  MatMulStrassenSec.post_processing();
+  std::vector<float> levels = StrassenMatMul(A32, B32, n, cutoff, 2);
+
+  // Higham's normwise bound for Strassen with max-norms:
+  // ((n / n0)^log2(12) * (n0^2 + 5 * n0) - 5 * n) * u * |A| * |B|, n0 = cutoff
+  const double u = std::numeric_limits<float>::epsilon() / 2;
+  const double max_a = *std::max_element(A.begin(), A.end());
+  const double max_b = *std::max_element(B.begin(), B.end());
+  const double growth = std::pow(static_cast<double>(n) / cutoff, std::log2(12.0)) * (cutoff * cutoff + 5 * cutoff);
+  const double bound = (growth - 5 * n) * u * max_a * max_b;
+  double err_task = 0.0;
+  double err_levels = 0.0;
+  for (size_t i = 0; i < res.size(); ++i) {
+    err_task = std::max(err_task, std::abs(res[i] - out[i]));
+    err_levels = std::max(err_levels, std::abs(res[i] - levels[i]));
+  }
+  ASSERT_LE(err_task, bound) << "task";
+  ASSERT_LE(err_levels, bound) << "StrassenMatMul with cutoff " << cutoff;
+}
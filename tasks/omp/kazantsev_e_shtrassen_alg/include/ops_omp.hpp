@@ -7,21 +7,25 @@
 
 #include "core/task/include/task.hpp"
 
-class MatMulStrassenSec : public ppc::core::Task {
+template <class T>
+class BasicMatMulStrassenSec : public ppc::core::Task {
  public:
-  explicit MatMulStrassenSec(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  explicit BasicMatMulStrassenSec(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
   bool post_processing() override;
 
  private:
-  std::vector<double> A;
-  std::vector<double> B;
-  std::vector<double> result;
+  std::vector<T> A;
+  std::vector<T> B;
+  std::vector<T> result;
   int n = 0, m = 0;
 };
 
+using MatMulStrassenSec = BasicMatMulStrassenSec<double>;
+using MatMulStrassenSecFloat = BasicMatMulStrassenSec<float>;
+
 inline std::vector<double> getRandomMatrix(int n) {
   std::random_device dev;
   std::mt19937 gen(dev());
@@ -38,4 +42,9 @@ inline std::vector<double> getRandomMatrix(int n) {
   return matrix;
 }
 
-std::vector<double> multMatrixNoShtrassen(const std::vector<double>& A, const std::vector<double>& B, int n);
\ No newline at end of file
+std::vector<double> multMatrixNoShtrassen(const std::vector<double>& A, const std::vector<double>& B, int n);
+// Strassen with the seven products of the top `depth` levels run as OpenMP tasks, below that
+// serial Strassen-Winograd down to `cutoff`. cutoff <= 0 takes ppc::core::strassenCutoff(),
+// depth < 0 picks enough levels for about four products per thread. T is float or double.
+template <class T>
+std::vector<T> StrassenMatMul(const std::vector<T>& A, const std::vector<T>& B, int n, int cutoff = 0, int depth = -1);
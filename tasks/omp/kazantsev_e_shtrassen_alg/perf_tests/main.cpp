@@ -1,13 +1,16 @@
 // Copyright 2024 Kazantsev Evgeny
 #include <gtest/gtest.h>
+#include <omp.h>
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
 #include "omp/kazantsev_e_shtrassen_alg/include/ops_omp.hpp"
 
 TEST(kazantsev_e_matmul_strassen_omp_perf, test_pipeline_run) {
-  const int n = 128;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = getRandomMatrix(n);
@@ -52,13 +55,12 @@ TEST(kazantsev_e_matmul_strassen_omp_perf, test_pipeline_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(std::round(res[i] * std::pow(10, 3)) / std::pow(10, 3),
-              std::round(out[i] * std::pow(10, 3)) / std::pow(10, 3));
+    ASSERT_NEAR(res[i], out[i], 1e-6);
   }
 }
 
 TEST(kazantsev_e_matmul_strassen_omp_perf, test_task_run) {
-  const int n = 128;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = getRandomMatrix(n);
@@ -103,7 +105,29 @@ TEST(kazantsev_e_matmul_strassen_omp_perf, test_task_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(std::round(res[i] * std::pow(10, 3)) / std::pow(10, 3),
-              std::round(out[i] * std::pow(10, 3)) / std::pow(10, 3));
+    ASSERT_NEAR(res[i], out[i], 1e-6);
   }
+
+  // Thread-count sweep: the same product for team sizes 1, 2, 4, ... up to the default team, one
+  // throughput line (multiply-adds of the classical product per second) for each size
+  const int max_threads = omp_get_max_threads();
+  for (int threads = 1;; threads *= 2) {
+    const int team = std::min(threads, max_threads);
+    omp_set_num_threads(team);
+    std::fill(out.begin(), out.end(), 0.0);
+    auto sweepTask = std::make_shared<MatMulStrassenSec>(taskDataSeq);
+    auto sweepAttr = std::make_shared<ppc::core::PerfAttr>();
+    sweepAttr->num_running = 3;
+    sweepAttr->current_timer = perfAttr->current_timer;
+    auto sweepResults = std::make_shared<ppc::core::PerfResults>();
+    ppc::core::Perf(sweepTask).task_run(sweepAttr, sweepResults);
+    ppc::core::Perf::print_throughput_statistic(sweepAttr, sweepResults,
+                                                "kazantsev_e_matmul_strassen_omp/threads" + std::to_string(team),
+                                                static_cast<uint64_t>(n) * n * n, 3ULL * n * n * sizeof(double));
+    for (size_t i = 0; i < res.size(); ++i) {
+      ASSERT_NEAR(res[i], out[i], 1e-6) << "threads " << team;
+    }
+    if (team == max_threads) break;
+  }
+  omp_set_num_threads(max_threads);
 }
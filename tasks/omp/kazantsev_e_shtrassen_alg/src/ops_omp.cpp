@@ -5,186 +5,207 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <thread>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
+#include "core/gemm/include/strassen.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<double> multMatrixNoShtrassen(const std::vector<double>& A, const std::vector<double>& B, int n) {
-  std::vector<double> C(n * n, 0.0);
-
   if (n == 0) {
     return std::vector<double>();
   }
 
-  for (int i = 0; i < n; ++i) {
-    for (int j = 0; j < n; ++j) {
-      for (int k = 0; k < n; ++k) {
-        C[i * n + j] += A[i * n + k] * B[k * n + j];
-      }
-    }
-  }
-  return C;
+  return ppc::core::gemm(A, B, n, n, n);
 }
 
-// For pre_processing
-int log2(int n) {
-  int res = 1;
-  while ((n >>= 1) != 0) res++;
-  return res;
-}
+namespace {
 
-int getNewDimention(std::vector<double>& a) {
-  int n = std::sqrt(a.size());
-  if (n > 0 && (n & (n - 1)) == 0) {
-    return n;
-  }
-  return 1 << log2(n);
-}
-
-// add column and rows if not enough
-std::vector<double> additionSquareMatrix(std::vector<double>& a, int n) {
-  std::vector<double> res(n * n, 0.0);
-  int size = std::sqrt(a.size());
-
-  for (int i = 0; i < size; i++) {
-    for (int j = 0; j < size; j++) {
-      res[i * size + j] = a[i * size + j];
+// c = a + sign * b on blocks with leading dimensions
+template <class T>
+void addBlocks(int n, const T* a, int lda, const T* b, int ldb, T* c, int ldc, T sign) {
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      c[i * ldc + j] = a[i * lda + j] + sign * b[i * ldb + j];
     }
   }
-  return res;
 }
 
-// divide into four parts
-void splitMatrix(const std::vector<double>& mSplit, std::vector<double>& a11, std::vector<double>& a12,
-                 std::vector<double>& a21, std::vector<double>& a22) {
-  int n = std::sqrt(mSplit.size()) / 2;
-
-  for (int i = 0; i < n; i++) {
-    std::copy(mSplit.begin() + (2 * i) * n, mSplit.begin() + (2 * i + 1) * n, a11.begin() + i * n);
-    std::copy(mSplit.begin() + (2 * i + 1) * n, mSplit.begin() + (2 * i + 2) * n, a12.begin() + i * n);
-    std::copy(mSplit.begin() + ((n * n * 2) + (2 * i * n)), mSplit.begin() + ((n * n * 2) + ((2 * i + 1) * n)),
-              a21.begin() + i * n);
-    std::copy(mSplit.begin() + ((n * n * 2) + ((2 * i + 1) * n)), mSplit.begin() + ((n * n * 2) + ((2 * i + 2) * n)),
-              a22.begin() + i * n);
-  }
+// Operand of one of the seven products: first + sign * second, or just first
+template <class T>
+struct StrassenTerm {
+  const T* first;
+  const T* second;
+  T sign;
+};
+
+// Elements of workspace a task level of size n and the levels below it need: P1, P4 and P5, the
+// ten summed operands of the seven products, and one slice of the next level per product
+int64_t taskWorkspaceSize(int n, int depth, int cutoff) {
+  if (depth == 0 || n <= 2 * cutoff) return 0;
+  const int64_t h = n / 2;
+  return 13 * h * h + 7 * taskWorkspaceSize(n / 2, depth - 1, cutoff);
 }
 
-std::vector<double> mergeMatrix(std::vector<double> a11, std::vector<double> a12, std::vector<double> a21,
-                                std::vector<double> a22) {
-  int n = a11.size();
-  std::vector<double> res(4 * n, 0.0);
-  n = std::sqrt(n);
-
-  for (int i = 0; i < n; i++) {
-    std::copy(a11.begin() + i * n, a11.begin() + (i + 1) * n, res.begin() + (2 * i * n));
-    std::copy(a12.begin() + i * n, a12.begin() + (i + 1) * n, res.begin() + (2 * i + 1) * n);
-    std::copy(a21.begin() + i * n, a21.begin() + (i + 1) * n, res.begin() + ((n * n * 2) + (2 * i * n)));
-    std::copy(a22.begin() + i * n, a22.begin() + (i + 1) * n, res.begin() + ((n * n * 2) + ((2 * i + 1) * n)));
+template <class T>
+void strassenTasks(int n, const T* a, int lda, const T* b, int ldb, T* c, int ldc, int depth, int cutoff,
+                   T* workspace);
+
+// Forms the sums of one product in its slice of the workspace (left first, then right), then
+// recurses into it
+template <class T>
+void strassenProduct(int n, StrassenTerm<T> lhs, int lda, StrassenTerm<T> rhs, int ldb, T* c, int ldc, int depth,
+                     int cutoff, T* sums, T* workspace) {
+  if (lhs.second != nullptr) {
+    addBlocks(n, lhs.first, lda, lhs.second, lda, sums, n, lhs.sign);
+    lhs.first = sums;
+    lda = n;
+    sums += static_cast<int64_t>(n) * n;
   }
-  return res;
+  if (rhs.second != nullptr) {
+    addBlocks(n, rhs.first, ldb, rhs.second, ldb, sums, n, rhs.sign);
+    rhs.first = sums;
+    ldb = n;
+  }
+  strassenTasks(n, lhs.first, lda, rhs.first, ldb, c, ldc, depth, cutoff, workspace);
 }
 
-// summation
-std::vector<double> summation(const std::vector<double>& a, const std::vector<double>& b) {
-  int n = a.size();
-  std::vector<double> res(n);
-
-  for (int i = 0; i < n; i++) {
-    res[i] = a[i] + b[i];
-  }
-  return res;
+// Below the task depth every thread runs the serial Strassen-Winograd on its own workspace
+template <class T>
+void strassenLeaf(int n, const T* a, int lda, const T* b, int ldb, T* c, int ldc, int cutoff) {
+  thread_local std::vector<T> workspace;
+  const size_t size = ppc::core::strassenWorkspaceSize(n, n, n, cutoff);
+  if (workspace.size() < size) workspace.resize(size);
+  ppc::core::strassen(n, n, n, a, lda, b, ldb, c, ldc, cutoff, workspace.data());
 }
 
-// subtraction
-std::vector<double> subtraction(const std::vector<double>& a, const std::vector<double>& b) {
-  int n = a.size();
-  std::vector<double> res(n);
+// The seven products of a level are OpenMP tasks, so products of all levels share one pool
+// of threads and idle threads steal them. P7, P3, P2 and P6 are written straight into the
+// quadrants of C, only P1, P4 and P5 need temporaries. Temporaries and operand sums come from
+// the workspace of taskWorkspaceSize(n) elements, which every task splits among its products.
+template <class T>
+void strassenTasks(int n, const T* a, int lda, const T* b, int ldb, T* c, int ldc, int depth, int cutoff,
+                   T* workspace) {
+  if (depth == 0 || n <= 2 * cutoff) {
+    strassenLeaf(n, a, lda, b, ldb, c, ldc, cutoff);
+    return;
+  }
+  const int h = n / 2;
+  const int ne = 2 * h;
+  const T* a11 = a;
+  const T* a12 = a + h;
+  const T* a21 = a + h * lda;
+  const T* a22 = a21 + h;
+  const T* b11 = b;
+  const T* b12 = b + h;
+  const T* b21 = b + h * ldb;
+  const T* b22 = b21 + h;
+  T* c11 = c;
+  T* c12 = c + h;
+  T* c21 = c + h * ldc;
+  T* c22 = c21 + h;
+  const int64_t hh = static_cast<int64_t>(h) * h;
+  const int next = depth - 1;
+  T* p1 = workspace;
+  T* p4 = p1 + hh;
+  T* p5 = p4 + hh;
+  T* sums = p5 + hh;
+  T* below = sums + 10 * hh;
+  const int64_t slice = taskWorkspaceSize(h, next, cutoff);
+
+#pragma omp task
+  strassenProduct(h, {a11, a22, T(1)}, lda, {b11, b22, T(1)}, ldb, p1, h, next, cutoff, sums, below);
+#pragma omp task
+  strassenProduct(h, {a21, a22, T(1)}, lda, {b11, nullptr, T(0)}, ldb, c21, ldc, next, cutoff, sums + 2 * hh,
+                  below + slice);
+#pragma omp task
+  strassenProduct(h, {a11, nullptr, T(0)}, lda, {b12, b22, -T(1)}, ldb, c12, ldc, next, cutoff, sums + 3 * hh,
+                  below + 2 * slice);
+#pragma omp task
+  strassenProduct(h, {a22, nullptr, T(0)}, lda, {b21, b11, -T(1)}, ldb, p4, h, next, cutoff, sums + 4 * hh,
+                  below + 3 * slice);
+#pragma omp task
+  strassenProduct(h, {a11, a12, T(1)}, lda, {b22, nullptr, T(0)}, ldb, p5, h, next, cutoff, sums + 5 * hh,
+                  below + 4 * slice);
+#pragma omp task
+  strassenProduct(h, {a21, a11, -T(1)}, lda, {b11, b12, T(1)}, ldb, c22, ldc, next, cutoff, sums + 6 * hh,
+                  below + 5 * slice);
+#pragma omp task
+  strassenProduct(h, {a12, a22, -T(1)}, lda, {b21, b22, T(1)}, ldb, c11, ldc, next, cutoff, sums + 8 * hh,
+                  below + 6 * slice);
+#pragma omp taskwait
+
+#pragma omp taskloop grainsize(16)
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < h; j++) {
+      const T q1 = p1[i * h + j];
+      const T q4 = p4[i * h + j];
+      const T q5 = p5[i * h + j];
+      c22[i * ldc + j] += q1 - c21[i * ldc + j] + c12[i * ldc + j];
+      c11[i * ldc + j] += q1 + q4 - q5;
+      c12[i * ldc + j] += q5;
+      c21[i * ldc + j] += q4;
+    }
+  }
 
-  for (int i = 0; i < n; i++) {
-    res[i] = a[i] - b[i];
+  // odd n: rank-1 update from the last column of A, then the last column and row of C
+  if (ne != n) {
+    ppc::core::gemm(ne, ne, 1, a + ne, lda, b + ne * ldb, ldb, c, ldc, true);
+    ppc::core::gemm(n, 1, n, a, lda, b + ne, ldb, c + ne, ldc);
+    ppc::core::gemm(1, ne, n, a + ne * lda, lda, b, ldb, c + ne * ldc, ldc);
   }
-  return res;
 }
 
-// Algorithm Strassen's
-std::vector<double> StrassenMatMul(const std::vector<double>& a, const std::vector<double>& b, int n) {
-  int size = n;
+}  // namespace
 
-  if (size <= 2) {
-    return multMatrixNoShtrassen(a, b, size);
+template <class T>
+std::vector<T> StrassenMatMul(const std::vector<T>& a, const std::vector<T>& b, int n, int cutoff, int depth) {
+  if (n == 0) {
+    return std::vector<T>();
   }
-
-  size = size / 2;
-
-  std::vector<double> a11(size * size);
-  std::vector<double> a12(size * size);
-  std::vector<double> a21(size * size);
-  std::vector<double> a22(size * size);
-
-  std::vector<double> b11(size * size);
-  std::vector<double> b12(size * size);
-  std::vector<double> b21(size * size);
-  std::vector<double> b22(size * size);
-
-  splitMatrix(a, a11, a12, a21, a22);
-  splitMatrix(b, b11, b12, b21, b22);
-
-  std::vector<double> p1;
-  std::vector<double> p2;
-  std::vector<double> p3;
-  std::vector<double> p4;
-  std::vector<double> p5;
-  std::vector<double> p6;
-  std::vector<double> p7;
-
-#pragma omp parallel sections shared(p1, p2, p3, p4, p5, p6, p7)
-  {
-#pragma omp section
-    p1 = StrassenMatMul(summation(a11, a22), summation(b11, b22), size);
-#pragma omp section
-    p2 = StrassenMatMul(summation(a21, a22), b11, size);
-#pragma omp section
-    p3 = StrassenMatMul(a11, subtraction(b12, b22), size);
-#pragma omp section
-    p4 = StrassenMatMul(a22, subtraction(b21, b11), size);
-#pragma omp section
-    p5 = StrassenMatMul(summation(a11, a12), b22, size);
-#pragma omp section
-    p6 = StrassenMatMul(subtraction(a21, a11), summation(b11, b12), size);
-#pragma omp section
-    p7 = StrassenMatMul(subtraction(a12, a22), summation(b21, b22), size);
+  if (cutoff <= 0) cutoff = ppc::core::strassenCutoff();
+  if (depth < 0) {
+    // enough products to keep every thread busy, none when there is a single thread
+    const int threads = omp_get_max_threads();
+    depth = 0;
+    for (int64_t tasks = 1; threads > 1 && tasks < 4 * static_cast<int64_t>(threads); tasks *= 7) depth++;
   }
 
-  std::vector<double> c11 = summation(summation(p1, p4), subtraction(p7, p5));
-  std::vector<double> c12 = summation(p3, p5);
-  std::vector<double> c21 = summation(p2, p4);
-  std::vector<double> c22 = summation(subtraction(p1, p2), summation(p3, p6));
-  return mergeMatrix(c11, c12, c21, c22);
+  std::vector<T> c(n * n);
+  std::vector<T> workspace(taskWorkspaceSize(n, depth, cutoff));
+#pragma omp parallel
+#pragma omp single
+  strassenTasks(n, a.data(), n, b.data(), n, c.data(), n, depth, cutoff, workspace.data());
+  return c;
 }
 
-bool MatMulStrassenSec::pre_processing() {
+template <class T>
+bool BasicMatMulStrassenSec<T>::pre_processing() {
   internal_order_test();
   // Init value for input and output
-  A = std::vector<double>(taskData->inputs_count[0]);
-  B = std::vector<double>(taskData->inputs_count[1]);
+  A = std::vector<T>(taskData->inputs_count[0]);
+  B = std::vector<T>(taskData->inputs_count[1]);
 
   n = *reinterpret_cast<int*>(taskData->inputs[2]);
   m = *reinterpret_cast<int*>(taskData->inputs[3]);
 
-  auto* tmp_ptr_A = reinterpret_cast<double*>(taskData->inputs[0]);
+  auto* tmp_ptr_A = reinterpret_cast<T*>(taskData->inputs[0]);
   for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
     A[i] = tmp_ptr_A[i];
   }
 
-  auto* tmp_ptr_B = reinterpret_cast<double*>(taskData->inputs[1]);
+  auto* tmp_ptr_B = reinterpret_cast<T*>(taskData->inputs[1]);
   for (unsigned i = 0; i < taskData->inputs_count[1]; i++) {
     B[i] = tmp_ptr_B[i];
   }
   return true;
 }
 
-bool MatMulStrassenSec::validation() {
+template <class T>
+bool BasicMatMulStrassenSec<T>::validation() {
   internal_order_test();
   // Check count elements of output
   if (taskData->inputs_count[0] != taskData->inputs_count[1]) return false;
@@ -193,15 +214,22 @@ bool MatMulStrassenSec::validation() {
   return true;
 }
 
-bool MatMulStrassenSec::run() {
+template <class T>
+bool BasicMatMulStrassenSec<T>::run() {
   internal_order_test();
-  n = getNewDimention(A);
+  n = static_cast<int>(std::lround(std::sqrt(A.size())));
   result = StrassenMatMul(A, B, n);
   return true;
 }
 
-bool MatMulStrassenSec::post_processing() {
+template <class T>
+bool BasicMatMulStrassenSec<T>::post_processing() {
   internal_order_test();
-  std::copy(result.begin(), result.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+  std::copy(result.begin(), result.end(), reinterpret_cast<T*>(taskData->outputs[0]));
   return true;
 }
+
+template std::vector<double> StrassenMatMul(const std::vector<double>&, const std::vector<double>&, int, int, int);
+template std::vector<float> StrassenMatMul(const std::vector<float>&, const std::vector<float>&, int, int, int);
+template class BasicMatMulStrassenSec<double>;
+template class BasicMatMulStrassenSec<float>;
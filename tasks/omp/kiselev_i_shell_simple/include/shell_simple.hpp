@@ -20,12 +20,8 @@ class KiselevTaskOMP : public ppc::core::Task {
  private:
   std::vector<int> arr;
   std::vector<int> input_;
-  int ThreadNum, DimSize;
   bool IsSorted();
   static int exp(int arg, int exp);
-  void FindThreadVariables();
-  void MergeBlocks(int Index1, int BlockSize1, int Index2, int BlockSize2);
-  void SeqSorter(int start, int end);
 };
 }  // namespace Kiselev_omp
 #endif  // SHELL_SIMPLE_HPP_INCLUDED
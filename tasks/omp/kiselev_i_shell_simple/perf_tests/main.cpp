@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <omp.h>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -10,16 +12,17 @@
 using namespace Kiselev_omp;
 
 TEST(kiselev_i_shell_simple_omp, test_pipeline_run) {
-  const int count = 100;
+  const int count = 1 << 20;
 
   // Create data
   std::vector<int> in(count, 0);
   std::vector<int> out(count, 0);
   std::vector<int> res(count, 0);
   for (int i = 0; i < count; i++) {
-    in[i] = count - 1 - i;
+    in[i] = i;
     res[i] = i;
   }
+  std::shuffle(in.begin(), in.end(), std::mt19937(42));
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
@@ -49,16 +52,17 @@ TEST(kiselev_i_shell_simple_omp, test_pipeline_run) {
 // task_run
 
 TEST(kiselev_i_shell_simple_omp, test_task_run) {
-  const int count = 100;
+  const int count = 1 << 20;
 
   // Create data
   std::vector<int> in(count, 0);
   std::vector<int> out(count, 0);
   std::vector<int> res(count, 0);
   for (int i = 0; i < count; i++) {
-    in[i] = count - 1 - i;
+    in[i] = i;
     res[i] = i;
   }
+  std::shuffle(in.begin(), in.end(), std::mt19937(42));
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
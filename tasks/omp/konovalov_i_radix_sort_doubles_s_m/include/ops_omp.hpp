@@ -17,7 +17,6 @@ class RadixSortSequentialTask : public ppc::core::Task {
  private:
   size_t input_size;
   double* input_;
-  std::vector<double> ordered[sizeof(double) * 256];
 };
 
 class RadixSortOMPTaskParallel : public ppc::core::Task {
@@ -29,8 +28,6 @@ class RadixSortOMPTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  static void radix_sort_seq(double* input_, size_t input_size);
   size_t input_size;
   double* input_;
-  std::vector<double> ordered[sizeof(double) * 256];
 };
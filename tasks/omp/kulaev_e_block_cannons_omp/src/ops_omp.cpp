@@ -7,6 +7,8 @@
 #include <iostream>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
+
 std::vector<double> cannonMatrixMultiplication(const std::vector<double>& A, const std::vector<double>& B, int n,
                                                int m) {
   int blockSize = std::min(n, m);
@@ -24,14 +26,7 @@ std::vector<double> cannonMatrixMultiplication(const std::vector<double>& A, con
         int j_end = std::min(j + blockSize, m);
         int k_end = std::min(k + blockSize, m);
 
-        for (int ii = i; ii < i_end; ++ii) {
-          for (int kk = k; kk < k_end; ++kk) {
-            double A_ik = A[ii * m + kk];
-            for (int jj = j; jj < j_end; ++jj) {
-              C[ii * m + jj] += A_ik * B[kk * m + jj];
-            }
-          }
-        }
+        ppc::core::gemm(i_end - i, j_end - j, k_end - k, &A[i * m + k], m, &B[k * m + j], m, &C[i * m + j], m, true);
       }
     }
   }
@@ -57,14 +52,11 @@ std::vector<double> cannonMatrixMultiplication_omp(const std::vector<double>& A,
         int j_end = std::min(j + blockSize, m);
         int k_end = std::min(k + blockSize, m);
 
+        // strips of rows keep every thread on its own part of C
 #pragma omp parallel for
-        for (int ii = i; ii < i_end; ++ii) {
-          for (int kk = k; kk < k_end; ++kk) {
-            double A_ik = A[ii * m + kk];
-            for (int jj = j; jj < j_end; ++jj) {
-              C[ii * m + jj] += A_ik * B[kk * m + jj];
-            }
-          }
+        for (int ii = i; ii < i_end; ii += 64) {
+          ppc::core::gemm(std::min(64, i_end - ii), j_end - j, k_end - k, &A[ii * m + k], m, &B[k * m + j], m,
+                          &C[ii * m + j], m, true);
         }
       }
     }
@@ -74,21 +66,12 @@ std::vector<double> cannonMatrixMultiplication_omp(const std::vector<double>& A,
 }
 
 std::vector<double> multiplyMatrix(const std::vector<double>& A, const std::vector<double>& B, int rows_A, int col_B) {
-  int col_A = rows_A;
-  std::vector<double> C(rows_A * col_B, 0.0);
-
   if (rows_A == 0 || col_B == 0) {
     return std::vector<double>();
   }
 
-  for (int i = 0; i < rows_A; ++i) {
-    for (int j = 0; j < col_B; ++j) {
-      for (int k = 0; k < col_A; ++k) {
-        C[i * col_B + j] += A[i * col_A + k] * B[k * col_B + j];
-      }
-    }
-  }
-  return C;
+  int col_A = rows_A;
+  return ppc::core::gemm(A, B, rows_A, col_B, col_A);
 }
 
 std::vector<double> getRandomMatrix(int rows, int cols) {
@@ -1,6 +1,7 @@
 // Copyright 2023 Kuznetsov Artem
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 
 #include "omp/kuznetsov_a_cannon_matr_mult/include/ops_omp.hpp"
@@ -247,3 +248,32 @@ TEST(Kuznetsov_a_cannon_matr_mult_omp_func_tests, mult_7x7) {
     ASSERT_TRUE(KuznetsovArtyomOmp::isEqual(resSeq[i], outputMatr[i]));
   }
 }
+
+TEST(Kuznetsov_a_cannon_matr_mult_omp_func_tests, float_and_mixed_error_bounds) {
+  // |C - fl(C)| <= gamma(n) |A| |B|, gamma(n) = n u / (1 - n u) with u = 2^-24
+  const int size = 150;
+  const int block = 64;
+  auto gamma = [](int terms) { return terms * 0x1p-24 / (1.0 - terms * 0x1p-24); };
+  auto matrOne64 = KuznetsovArtyomOmp::getRandomSquareMatrix(size, -1.0, 1.0);
+  auto matrTwo64 = KuznetsovArtyomOmp::getRandomSquareMatrix(size, -1.0, 1.0);
+  std::vector<float> matrOne(matrOne64.begin(), matrOne64.end());
+  std::vector<float> matrTwo(matrTwo64.begin(), matrTwo64.end());
+  std::vector<double> exact(size * size, 0.0);
+  std::vector<double> magnitude(size * size, 0.0);
+  for (int i = 0; i < size; ++i) {
+    for (int k = 0; k < size; ++k) {
+      for (int j = 0; j < size; ++j) {
+        const double product = static_cast<double>(matrOne[i * size + k]) * matrTwo[k * size + j];
+        exact[i * size + j] += product;
+        magnitude[i * size + j] += std::abs(product);
+      }
+    }
+  }
+
+  auto single = KuznetsovArtyomOmp::CannonMatrixMultOmp(matrOne, matrTwo, size, block);
+  auto mixed = KuznetsovArtyomOmp::CannonMatrixMultOmp<float, double>(matrOne, matrTwo, size, block);
+  for (int i = 0; i < size * size; ++i) {
+    ASSERT_LE(std::abs(single[i] - exact[i]), gamma(size + 1) * magnitude[i]) << "float at " << i;
+    ASSERT_LE(std::abs(mixed[i] - exact[i]), gamma(block + 1) * magnitude[i]) << "mixed at " << i;
+  }
+}
@@ -18,24 +18,32 @@ bool validateMatrix(size_t sizeOne, size_t sizeTwo);
 std::vector<double> CannonMatrixMultSeq(const std::vector<double> &matrOne, const std::vector<double> &matrTwo,
                                         int size, int block);
 
-std::vector<double> CannonMatrixMultOmp(const std::vector<double> &matrOne, const std::vector<double> &matrTwo,
-                                        int size, int block);
+// Instantiated for double, float and float operands with a double result (mixed precision)
+template <class T, class Acc = T>
+std::vector<Acc> CannonMatrixMultOmp(const std::vector<T> &matrOne, const std::vector<T> &matrTwo, int size,
+                                     int block);
 
 std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double maxVal);
 
-class KuznetsovCannonMatrMultOmp : public ppc::core::Task {
+template <class T, class Acc = T>
+class BasicKuznetsovCannonMatrMultOmp : public ppc::core::Task {
  public:
-  explicit KuznetsovCannonMatrMultOmp(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  explicit BasicKuznetsovCannonMatrMultOmp(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
   bool post_processing() override;
 
  private:
-  std::vector<double> mMatrOne;
-  std::vector<double> mMatrTwo;
-  std::vector<double> mMatrRes;
+  std::vector<T> mMatrOne;
+  std::vector<T> mMatrTwo;
+  std::vector<Acc> mMatrRes;
   size_t mSize;
   size_t mBlock;
 };
+
+using KuznetsovCannonMatrMultOmp = BasicKuznetsovCannonMatrMultOmp<double>;
+using KuznetsovCannonMatrMultOmpFloat = BasicKuznetsovCannonMatrMultOmp<float>;
+using KuznetsovCannonMatrMultOmpMixed = BasicKuznetsovCannonMatrMultOmp<float, double>;
 }  // namespace KuznetsovArtyomOmp
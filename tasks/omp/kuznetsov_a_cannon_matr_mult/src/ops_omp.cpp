@@ -1,6 +1,12 @@
 // Copyright 2024 Kuznetsov Artem
 #include "omp/kuznetsov_a_cannon_matr_mult/include/ops_omp.hpp"
 
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include "core/gemm/include/block_matrix.hpp"
+
 using namespace std::chrono_literals;
 
 namespace KuznetsovArtyomOmp {
@@ -34,28 +40,22 @@ std::vector<double> CannonMatrixMultSeq(const std::vector<double>& matrOne, cons
   return matrRes;
 }
 
-std::vector<double> CannonMatrixMultOmp(const std::vector<double>& matrOne, const std::vector<double>& matrTwo,
-                                        int size, int block) {
+template <class T, class Acc>
+std::vector<Acc> CannonMatrixMultOmp(const std::vector<T>& matrOne, const std::vector<T>& matrTwo, int size,
+                                     int block) {
   if (!validateMatrix(matrOne.size(), matrTwo.size())) throw std::invalid_argument{"invalid matrixs"};
 
   if (block > size) throw std::invalid_argument{"Wrong size block"};
 
-  int jbMin = 0;
-  int kbMin = 0;
-  std::vector<double> matrRes(size * size, 0.0);
-
-  for (int jb = 0; jb < size; jb += block) {
-    for (int kb = 0; kb < size; kb += block) {
-      jbMin = std::min(jb + block, size);
-      kbMin = std::min(kb + block, size);
-
-#pragma omp parallel for
-      for (int i = 0; i < size; ++i)
-        for (int k = kb; k < kbMin; ++k)
-          for (int j = jb; j < jbMin; ++j) matrRes[i * size + j] += matrOne[i * size + k] * matrTwo[k * size + j];
-    }
-  }
+  // block-major tiles, skewed Cannon schedule, C tiles placed by their owner threads
+  auto blockOne = ppc::core::BasicBlockMatrix<T>::fromRowMajor(matrOne.data(), size, block);
+  auto blockTwo = ppc::core::BasicBlockMatrix<T>::fromRowMajor(matrTwo.data(), size, block);
+  ppc::core::BasicBlockMatrix<Acc> blockRes(size, block);
+  ppc::core::multiplyBlocks(blockOne, blockTwo, blockRes, ppc::core::BlockSchedule::Cannon,
+                            ppc::core::defaultLayers(blockRes.grid()));
 
+  std::vector<Acc> matrRes(size * size);
+  blockRes.toRowMajor(matrRes.data());
   return matrRes;
 }
 
@@ -69,7 +69,8 @@ std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double max
   return matrix;
 }
 
-bool KuznetsovCannonMatrMultOmp::pre_processing() {
+template <class T, class Acc>
+bool BasicKuznetsovCannonMatrMultOmp<T, Acc>::pre_processing() {
   internal_order_test();
   // Init value for input and output
 
@@ -81,8 +82,8 @@ bool KuznetsovCannonMatrMultOmp::pre_processing() {
 
   size_t countElem = mSize * mSize;
 
-  auto* ptrOne = reinterpret_cast<double*>(taskData->inputs[MATR_ONE]);
-  auto* ptrTwo = reinterpret_cast<double*>(taskData->inputs[MATR_TWO]);
+  auto* ptrOne = reinterpret_cast<T*>(taskData->inputs[MATR_ONE]);
+  auto* ptrTwo = reinterpret_cast<T*>(taskData->inputs[MATR_TWO]);
 
   for (size_t i = 0; i < countElem; ++i) {
     mMatrOne[i] = ptrOne[i];
@@ -92,17 +93,19 @@ bool KuznetsovCannonMatrMultOmp::pre_processing() {
   return true;
 }
 
-bool KuznetsovCannonMatrMultOmp::validation() {
+template <class T, class Acc>
+bool BasicKuznetsovCannonMatrMultOmp<T, Acc>::validation() {
   internal_order_test();
   return taskData->inputs_count[MATR_ONE] == taskData->inputs_count[MATR_TWO] &&
          taskData->inputs_count[MATR_ONE] == taskData->outputs_count[MATR_RES];
 }
 
-bool KuznetsovCannonMatrMultOmp::run() {
+template <class T, class Acc>
+bool BasicKuznetsovCannonMatrMultOmp<T, Acc>::run() {
   internal_order_test();
 
   try {
-    mMatrRes = CannonMatrixMultOmp(mMatrOne, mMatrTwo, mSize, mBlock);
+    mMatrRes = CannonMatrixMultOmp<T, Acc>(mMatrOne, mMatrTwo, mSize, mBlock);
   } catch (const std::exception& ex) {
     std::cerr << ex.what() << '\n';
     return false;
@@ -111,9 +114,17 @@ bool KuznetsovCannonMatrMultOmp::run() {
   return true;
 }
 
-bool KuznetsovCannonMatrMultOmp::post_processing() {
+template <class T, class Acc>
+bool BasicKuznetsovCannonMatrMultOmp<T, Acc>::post_processing() {
   internal_order_test();
-  std::copy(mMatrRes.begin(), mMatrRes.end(), reinterpret_cast<double*>(taskData->outputs[MATR_RES]));
+  std::copy(mMatrRes.begin(), mMatrRes.end(), reinterpret_cast<Acc*>(taskData->outputs[MATR_RES]));
   return true;
 }
+template std::vector<double> CannonMatrixMultOmp(const std::vector<double>&, const std::vector<double>&, int, int);
+template std::vector<float> CannonMatrixMultOmp(const std::vector<float>&, const std::vector<float>&, int, int);
+template std::vector<double> CannonMatrixMultOmp<float, double>(const std::vector<float>&, const std::vector<float>&,
+                                                                int, int);
+template class BasicKuznetsovCannonMatrMultOmp<double>;
+template class BasicKuznetsovCannonMatrMultOmp<float>;
+template class BasicKuznetsovCannonMatrMultOmp<float, double>;
 }  // namespace KuznetsovArtyomOmp
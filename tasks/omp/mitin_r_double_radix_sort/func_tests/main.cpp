@@ -143,3 +143,69 @@ TEST(mitin_r_double_radix_sort_omp, Test_Sort_random_test) {
     ASSERT_EQ(out[0][i], expected[i]);
   }
 }
+
+TEST(mitin_r_double_radix_sort_omp, Test_Sort_pairs_stable) {
+  // Create data: few distinct keys, payload is the input position
+  const size_t input_size = 100000;
+  std::mt19937 gen(2);
+  std::uniform_int_distribution<> dis(-20, 20);
+  std::vector<double> in_keys(input_size);
+  std::vector<int64_t> in_values(input_size);
+  for (size_t i = 0; i < input_size; i++) {
+    in_keys[i] = dis(gen) * 0.5;
+    in_values[i] = static_cast<int64_t>(i);
+  }
+  std::vector<double> out_keys(input_size);
+  std::vector<int64_t> out_values(input_size);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOmp = std::make_shared<ppc::core::TaskData>();
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_keys.data()));
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_values.data()));
+  taskDataOmp->inputs_count.emplace_back(in_keys.size());
+  taskDataOmp->inputs_count.emplace_back(in_values.size());
+  taskDataOmp->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_keys.data()));
+  taskDataOmp->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_values.data()));
+  taskDataOmp->outputs_count.emplace_back(out_keys.size());
+  taskDataOmp->outputs_count.emplace_back(out_values.size());
+
+  // Create Task
+  SortRadixDoublePairsTaskOMP test(taskDataOmp);
+  ASSERT_EQ(test.validation(), true);
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  for (size_t i = 0; i < input_size; i++) {
+    ASSERT_EQ(out_keys[i], in_keys[out_values[i]]);
+    if (i > 0) {
+      ASSERT_LE(out_keys[i - 1], out_keys[i]);
+      if (out_keys[i - 1] == out_keys[i]) {
+        ASSERT_LT(out_values[i - 1], out_values[i]);
+      }
+    }
+  }
+}
+
+TEST(mitin_r_double_radix_sort_omp, Test_Argsort) {
+  // Create data
+  std::vector<double> in{3.5, -1.0, 2.0, -1.0, 0.0, 3.5};
+  std::vector<uint32_t> expected{1, 3, 4, 2, 0, 5};
+  std::vector<uint32_t> out(in.size());
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOmp = std::make_shared<ppc::core::TaskData>();
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskDataOmp->inputs_count.emplace_back(in.size());
+  taskDataOmp->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataOmp->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ArgsortRadixDoubleTaskOMP test(taskDataOmp);
+  ASSERT_EQ(test.validation(), true);
+  test.pre_processing();
+  test.run();
+  test.post_processing();
+
+  ASSERT_EQ(out, expected);
+}
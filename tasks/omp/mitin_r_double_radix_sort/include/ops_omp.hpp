@@ -1,6 +1,7 @@
 // Copyright 2024 Mitin Roman
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -18,5 +19,33 @@ class SortRadixDoubleTaskOMP : public ppc::core::Task {
  private:
   double* data_ptr;
   size_t data_size;
-  std::vector<double> bucket_arr[sizeof(double) * 256];
+};
+
+// Sorts double keys (inputs[0]) together with an int64 payload (inputs[1]); both are written to
+// outputs[0] and outputs[1]. Keys that compare equal keep the order of their payloads.
+class SortRadixDoublePairsTaskOMP : public ppc::core::Task {
+ public:
+  explicit SortRadixDoublePairsTaskOMP(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  std::vector<double> keys;
+  std::vector<int64_t> values;
+};
+
+// Writes the stable sorting permutation of the double keys in inputs[0] to outputs[0] as uint32.
+class ArgsortRadixDoubleTaskOMP : public ppc::core::Task {
+ public:
+  explicit ArgsortRadixDoubleTaskOMP(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  std::vector<double> keys;
+  std::vector<uint32_t> index;
 };
@@ -1,48 +1,13 @@
 // Copyright 2024 Mitin Roman
 #include "omp/mitin_r_double_radix_sort/include/ops_omp.hpp"
 
-#include <omp.h>
-
 #include <algorithm>
-#include <cassert>
-#include <cstdlib>
-#include <cstring>
 #include <iostream>
 #include <thread>
 
-using namespace std::chrono_literals;
-
-namespace {
-
-constexpr int64_t max_byte_val = 256;
-
-uint8_t get_byte_val(double val, size_t byte_num) {
-  assert(*(reinterpret_cast<uint8_t*>(&val) + byte_num) < max_byte_val);
-  return *(reinterpret_cast<uint8_t*>(&val) + byte_num);
-}
+#include "core/sort/include/radix_sort.hpp"
 
-void sort_arr(double* arr, size_t size, double* buckets) {
-  if (size != 0) {
-    for (size_t byte_num = 0; byte_num < 7; byte_num++) {
-      size_t buckets_size[max_byte_val]{0};
-      for (size_t i = 0; i < size; i++) {
-        const uint32_t byte_val = get_byte_val(arr[i], byte_num);
-        buckets[byte_val * size + buckets_size[byte_val]++] = arr[i];
-      }
-
-      size_t it = 0;
-      for (int64_t i = 0; i < max_byte_val; i++) {
-        if (buckets_size[i] != 0) {
-          memcpy(arr + it, &buckets[i * size], buckets_size[i] * sizeof(double));
-          it += buckets_size[i];
-          assert(it <= size);
-        }
-      }
-    }
-  }
-}
-
-}  // namespace
+using namespace std::chrono_literals;
 
 bool SortRadixDoubleTaskOMP::validation() {
   internal_order_test();
@@ -66,51 +31,8 @@ bool SortRadixDoubleTaskOMP::run() {
   internal_order_test();
 
   try {
-    constexpr int64_t first_byte_max_val = 128;
-    auto* buckets = reinterpret_cast<double*>(std::malloc(data_size * first_byte_max_val * sizeof(double)));
-    if (buckets == nullptr) {
-      std::cerr << "Cannot allocate buffer\n";
-      return false;
-    }
-    size_t buckets_size[first_byte_max_val]{0};
-
-    uint64_t max_bucket_size = 0;
-    for (size_t i = 0; i < data_size; i++) {
-      const uint32_t byte_val = get_byte_val(data_ptr[i], 7);
-      assert(byte_val < first_byte_max_val);
-      buckets[byte_val * data_size + buckets_size[byte_val]++] = data_ptr[i];
-      max_bucket_size = std::max<size_t>(max_bucket_size, buckets_size[byte_val]);
-    }
-    auto* aux_buckets =
-        reinterpret_cast<double*>(std::malloc(max_bucket_size * max_byte_val * sizeof(double) * omp_get_max_threads()));
-
-    if (aux_buckets == nullptr) {
-      free(buckets);
-      std::cerr << "Cannot allocate aux_buckets\n";
-      return false;
-    }
-
-#pragma omp parallel
-    {
-      double* local_buckets = aux_buckets + max_bucket_size * max_byte_val * omp_get_thread_num();
-#pragma omp for nowait
-      for (int64_t i = 0; i < first_byte_max_val; i++) {
-        sort_arr(&buckets[i * data_size], buckets_size[i], local_buckets);
-      }
-    }
-
-    size_t it = 0;
-    for (int64_t i = 0; i < first_byte_max_val; i++) {
-      if (buckets_size[i] != 0) {
-        std::memcpy(data_ptr + it, &buckets[i * data_size], buckets_size[i] * sizeof(double));
-        it += buckets_size[i];
-        assert(it <= data_size);
-      }
-    }
-
-    free(aux_buckets);
-    free(buckets);
-
+    // histogram then scatter into one data_size buffer per pass, split across the OpenMP team
+    ppc::core::radixSort(data_ptr, data_size);
   } catch (const std::exception& e) {
     std::cerr << "Double Radix sort Exception error: " << e.what() << std::endl;
     return false;
@@ -124,3 +46,59 @@ bool SortRadixDoubleTaskOMP::post_processing() {
   *reinterpret_cast<double**>(taskData->outputs[0]) = data_ptr;
   return true;
 }
+
+bool SortRadixDoublePairsTaskOMP::validation() {
+  internal_order_test();
+  return taskData->inputs.size() == 2 && taskData->outputs.size() == 2 && taskData->inputs_count.size() == 2 &&
+         taskData->outputs_count.size() == 2 && taskData->inputs_count[0] == taskData->inputs_count[1] &&
+         taskData->outputs_count[0] == taskData->inputs_count[0] &&
+         taskData->outputs_count[1] == taskData->inputs_count[0];
+}
+
+bool SortRadixDoublePairsTaskOMP::pre_processing() {
+  internal_order_test();
+  auto* keys_ptr = reinterpret_cast<double*>(taskData->inputs[0]);
+  auto* values_ptr = reinterpret_cast<int64_t*>(taskData->inputs[1]);
+  keys.assign(keys_ptr, keys_ptr + taskData->inputs_count[0]);
+  values.assign(values_ptr, values_ptr + taskData->inputs_count[1]);
+  return true;
+}
+
+bool SortRadixDoublePairsTaskOMP::run() {
+  internal_order_test();
+  // keys and payloads stay separate arrays, each pass streams both
+  ppc::core::radixSortPairs(keys, values);
+  return true;
+}
+
+bool SortRadixDoublePairsTaskOMP::post_processing() {
+  internal_order_test();
+  std::copy(keys.begin(), keys.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+  std::copy(values.begin(), values.end(), reinterpret_cast<int64_t*>(taskData->outputs[1]));
+  return true;
+}
+
+bool ArgsortRadixDoubleTaskOMP::validation() {
+  internal_order_test();
+  return taskData->inputs.size() == 1 && taskData->outputs.size() == 1 && taskData->inputs_count.size() == 1 &&
+         taskData->outputs_count.size() == 1 && taskData->outputs_count[0] == taskData->inputs_count[0];
+}
+
+bool ArgsortRadixDoubleTaskOMP::pre_processing() {
+  internal_order_test();
+  auto* keys_ptr = reinterpret_cast<double*>(taskData->inputs[0]);
+  keys.assign(keys_ptr, keys_ptr + taskData->inputs_count[0]);
+  return true;
+}
+
+bool ArgsortRadixDoubleTaskOMP::run() {
+  internal_order_test();
+  index = ppc::core::radixArgsort(keys);
+  return true;
+}
+
+bool ArgsortRadixDoubleTaskOMP::post_processing() {
+  internal_order_test();
+  std::copy(index.begin(), index.end(), reinterpret_cast<uint32_t*>(taskData->outputs[0]));
+  return true;
+}
@@ -47,7 +47,6 @@ void partSortSeq(std::vector<std::vector<double>>& parts, std::vector<double>& s
 std::vector<double> radixSortBatcherSeq(std::vector<double> vec);
 
 std::vector<double> batchersMergeOmp(std::vector<std::vector<double>>& subvectors);
-void partSortOmp(std::vector<std::vector<double>>& parts, std::vector<double>& side);
 std::vector<double> radixSortBatcherOmp(std::vector<double> vec);
 
 std::vector<double> randomVector(int sizeVec, double minValue, double maxValue);
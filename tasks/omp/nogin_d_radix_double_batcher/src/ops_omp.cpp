@@ -1,6 +1,11 @@
 // Copyright 2024 Nogin Denis
 #include "omp/nogin_d_radix_double_batcher/include/ops_omp.hpp"
 
+#include <span>
+
+#include "core/sort/include/multiway_merge.hpp"
+#include "core/sort/include/radix_sort.hpp"
+
 namespace NoginDenisOmp {
 
 constexpr int sizeDouble = sizeof(double);
@@ -133,81 +138,32 @@ bool RadixSortDoubleBatcherOmpParallel::post_processing() {
 }
 
 std::vector<double> batchersMergeOmp(std::vector<std::vector<double>> &subvectors) {
-  std::vector<double> merged;
-  if (subvectors.empty()) {
-    return merged;
-  }
-
-  std::vector<std::pair<double, int>> indexedValues;
-  for (size_t i = 0; i < subvectors.size(); ++i) {
-    for (const auto &val : subvectors[i]) {
-      indexedValues.emplace_back(val, i);
-    }
-  }
-
-  std::sort(indexedValues.begin(), indexedValues.end());
-  merged.resize(indexedValues.size());
-
-  for (size_t i = 0; i < indexedValues.size(); ++i) {
-    merged[i] = indexedValues[i].first;
-  }
-
+  std::vector<std::span<const double>> runs(subvectors.begin(), subvectors.end());
+  size_t size = 0;
+  for (const auto &run : runs) size += run.size();
+  std::vector<double> merged(size);
+  // one pass: every thread merges an equal share of the output from all subvectors at once
+  ppc::core::multiwayMerge(runs, merged.data());
   return merged;
 }
 
-void partSortOmp(std::vector<std::vector<double>> &parts, std::vector<double> &side) {
-#pragma omp parallel for
-  for (int i = 0; i < sizeDouble; ++i) {
-    for (unsigned long int j = 0; j < side.size(); ++j) {
-      auto temp = static_cast<uint64_t>(side[j]);
-      temp >>= i * 8;
-      temp &= 255;
-      parts[temp].push_back(side[j]);
-    }
-
-    side = batchersMergeOmp(parts);
-
-    for (auto &part : parts) {
-      part.clear();
-    }
-  }
-}
-
 std::vector<double> radixSortBatcherOmp(std::vector<double> vec) {
-  uint64_t mask = static_cast<uint64_t>(1) << (sizeDouble * 8 - 1);
-  std::vector<double> positive;
-  std::vector<double> negative;
-
-  for (auto &i : vec) {
-    auto temp = static_cast<uint64_t>(i);
-
-    if ((temp & mask) != 0) {
-      negative.push_back(i);
-    } else {
-      positive.push_back(i);
-    }
-  }
-
-#pragma omp parallel sections
+  // each thread radix sorts one chunk, then the sorted chunks are merged k ways
+  std::vector<std::span<const double>> chunks;
+#pragma omp parallel
   {
-#pragma omp section
-    {
-      std::vector<std::vector<double>> partsNegative(256);
-      partSortOmp(partsNegative, negative);
-    }
-#pragma omp section
-    {
-      std::vector<std::vector<double>> partsPositive(256);
-      partSortOmp(partsPositive, positive);
-    }
+    const size_t threads = omp_get_num_threads();
+    const size_t t = omp_get_thread_num();
+#pragma omp single
+    chunks.resize(threads);
+    const size_t first = vec.size() * t / threads;
+    const size_t last = vec.size() * (t + 1) / threads;
+    ppc::core::radixSort(vec.data() + first, last - first, 0, 1);
+    chunks[t] = std::span<const double>(vec.data() + first, last - first);
   }
-
-  vec.clear();
-  vec.reserve(negative.size() + positive.size());
-  vec.insert(vec.end(), negative.begin(), negative.end());
-  vec.insert(vec.end(), positive.begin(), positive.end());
-
-  return vec;
+  std::vector<double> sorted(vec.size());
+  ppc::core::multiwayMerge(chunks, sorted.data());
+  return sorted;
 }
 
 std::vector<double> randomVector(int sizeVec, double minValue, double maxValue) {
@@ -7,69 +7,9 @@
 #include <thread>
 #include <vector>
 
-using namespace std::chrono_literals;
-
-void PetrovRadixSortDoubleOMP::PetrovCountSort(double* in, double* out, int len, int exp) {
-  auto* buf = reinterpret_cast<unsigned char*>(in);
-  int count[256] = {0};
-  for (int i = 0; i < len; i++) {
-    count[buf[8 * i + exp]]++;
-  }
-  int sum = 0;
-  for (int i = 0; i < 256; i++) {
-    int temp = count[i];
-    count[i] = sum;
-    sum += temp;
-  }
-  for (int i = 0; i < len; i++) {
-    out[count[buf[8 * i + exp]]] = in[i];
-    count[buf[8 * i + exp]]++;
-  }
-}
+#include "core/sort/include/radix_sort.hpp"
 
-bool PetrovRadixSortDoubleOMP::PetrovCountSortSigns(const double* in, double* out, int len) {
-  bool positiveFlag = false;
-  bool negativeFlag = false;
-  int firstNegativeIndex = -1;
-  // int firstPositiveIndex = -1;
-  for (int i = 0; i < len; i++) {
-    if (positiveFlag && negativeFlag) {
-      break;
-    }
-    if (in[i] < 0 && !negativeFlag) {
-      negativeFlag = true;
-      firstNegativeIndex = i;
-    }
-    if (in[i] > 0 && !positiveFlag) {
-      positiveFlag = true;
-      // firstPositiveIndex = i;
-    }
-  }
-  if (positiveFlag && negativeFlag) {
-    bool forward = false;
-    int j = len - 1;
-    for (int i = 0; i < len; i++) {
-      out[i] = in[j];
-      if (forward) {
-        j++;
-      } else {
-        j--;
-      }
-      if (j == firstNegativeIndex - 1 && !forward) {
-        j = 0;
-        forward = true;
-      }
-    }
-    return true;
-  }
-  if (!positiveFlag) {
-    for (int i = len - 1, j = 0; i >= 0; i--, j++) {
-      out[j] = in[i];
-    }
-    return true;
-  }
-  return false;
-}
+using namespace std::chrono_literals;
 
 std::vector<std::vector<double>> PetrovRadixSortDoubleOMP::PetrovSplitVector(const std::vector<double>& data,
                                                                              int numParts) {
@@ -120,17 +60,8 @@ std::vector<double> PetrovRadixSortDoubleOMP::PetrovMerge(const std::vector<doub
 }
 
 std::vector<double> PetrovRadixSortDoubleOMP::PetrovRadixSort(const std::vector<double>& data) {
-  int len = static_cast<int>(data.size());
-  std::vector<double> in = data;
-  std::vector<double> out(data.size());
-
-  for (int i = 0; i < 4; i++) {
-    PetrovCountSort(in.data(), out.data(), len, 2 * i);
-    PetrovCountSort(out.data(), in.data(), len, 2 * i + 1);
-  }
-  if (!PetrovCountSortSigns(in.data(), out.data(), len)) {
-    in.swap(out);
-  }
+  std::vector<double> out = data;
+  ppc::core::radixSort(out);
   return out;
 }
 
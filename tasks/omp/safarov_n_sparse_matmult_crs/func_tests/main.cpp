@@ -216,4 +216,66 @@ TEST(Safarov_N_SparseMatMultCRS_OMP, TestFive) {
     double t = correctAnswer.values[i] - z.values[i];
     ASSERT_NEAR(0.0f, t, 1e-6);
   }
-}
\ No newline at end of file
+}
+TEST(Safarov_N_SparseMatMultCRS_OMP, TestTripletsMatchDense) {
+  std::vector<SparseTriplet> triplets = createRandomTriplets(37, 53, 0.2, 7);
+  std::vector<std::vector<double>> dense = fillTheMatrixWithZeros(37, 53);
+  for (const auto &e : triplets) {
+    dense[e.row][e.column] = e.value;
+  }
+
+  SparseMatrixCRS expected(dense);
+  ASSERT_EQ(buildSparseMatrixCRS(37, 53, triplets), expected);
+  ASSERT_EQ(createRandomSparseMatrix(37, 53, 0.2, 7), expected);
+}
+
+TEST(Safarov_N_SparseMatMultCRS_OMP, TestTripletsDuplicates) {
+  std::vector<SparseTriplet> triplets = {{1, 3, 2.0}, {0, 2, 1.0}, {1, 0, 4.0}, {1, 3, 0.5},
+                                         {2, 1, 3.0}, {0, 2, 2.0}, {2, 1, -3.0}};
+
+  SparseMatrixCRS sorted(4, 3, {3.0, 4.0, 2.5}, {2, 0, 3}, {0, 1, 3, 3});
+  ASSERT_EQ(buildSparseMatrixCRS(4, 3, triplets), sorted);
+  SparseMatrixCRS unsorted(4, 3, {3.0, 2.5, 4.0}, {2, 3, 0}, {0, 1, 3, 3});
+  ASSERT_EQ(buildSparseMatrixCRS(4, 3, triplets, false), unsorted);
+}
+
+TEST(Safarov_N_SparseMatMultCRS_OMP, TestTripletsCCS) {
+  std::vector<SparseTriplet> triplets = createRandomTriplets(41, 29, 0.3, 11);
+  std::vector<SparseTriplet> transposed;
+  for (const auto &e : triplets) {
+    transposed.push_back({e.column, e.row, e.value});
+  }
+
+  ASSERT_EQ(buildSparseMatrixCCS(41, 29, triplets), buildSparseMatrixCRS(29, 41, transposed));
+}
+
+TEST(Safarov_N_SparseMatMultCRS_OMP, TestTripletsWrongIndex) {
+  ASSERT_ANY_THROW(buildSparseMatrixCRS(3, 3, {{0, 0, 1.0}, {3, 1, 1.0}}));
+  ASSERT_ANY_THROW(createRandomTriplets(3, 3, 1.5, 0));
+}
+
+TEST(Safarov_N_SparseMatMultCRS_OMP, TestLargeTimesIdentity) {
+  const int n = 1500;
+  SparseMatrixCRS x = createRandomSparseMatrix(n, n, 0.005, 42);
+  std::vector<SparseTriplet> diagonal;
+  for (int i = 0; i < n; i++) {
+    diagonal.push_back({i, i, 1.0});
+  }
+  SparseMatrixCRS y = buildSparseMatrixCRS(n, n, diagonal);
+  SparseMatrixCRS z;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOmp = std::make_shared<ppc::core::TaskData>();
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(&x));
+  taskDataOmp->inputs.emplace_back(reinterpret_cast<uint8_t *>(&y));
+  taskDataOmp->outputs.emplace_back(reinterpret_cast<uint8_t *>(&z));
+
+  // Create Task
+  SparseMatrixMultiplicationCRS_OMP taskOmp(taskDataOmp);
+  ASSERT_EQ(taskOmp.validation(), true);
+  ASSERT_EQ(taskOmp.pre_processing(), true);
+  ASSERT_EQ(taskOmp.run(), true);
+  ASSERT_EQ(taskOmp.post_processing(), true);
+
+  ASSERT_EQ(z, x);
+}
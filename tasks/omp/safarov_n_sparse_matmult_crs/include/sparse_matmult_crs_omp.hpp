@@ -26,10 +26,30 @@ class SparseMatrixCRS {
   SparseMatrixCRS(int _numberOfColumns, int _numberOfRows, const std::vector<double>& _values,
                   const std::vector<int>& _columnIndexes, const std::vector<int>& _pointers);
   explicit SparseMatrixCRS(int _numberOfColumns = 0, int _numberOfRows = 0);
-  explicit SparseMatrixCRS(std::vector<std::vector<double>> matrix);
+  explicit SparseMatrixCRS(const std::vector<std::vector<double>>& matrix);
   bool operator==(const SparseMatrixCRS& matrix) const;
 };
 
+struct SparseTriplet {
+  int row;
+  int column;
+  double value;
+};
+
+// COO -> CRS. Triplets are bucketed by row with a parallel counting sort, entries with the same
+// (row, column) are summed and exact zeros are dropped, as the dense constructor does.
+// With sortColumns == false a row keeps its columns in order of first appearance.
+SparseMatrixCRS buildSparseMatrixCRS(int columns, int rows, const std::vector<SparseTriplet>& triplets,
+                                     bool sortColumns = true);
+// COO -> CCS: pointers run over columns and columnIndexes hold row numbers, so the result is
+// the CRS form of the transposed matrix (what the multiplication works on for Y).
+SparseMatrixCRS buildSparseMatrixCCS(int columns, int rows, const std::vector<SparseTriplet>& triplets,
+                                     bool sortRows = true);
+// Every element is nonzero with probability perc; triplets come out sorted by row and column.
+// The result depends only on the seed, not on the number of threads.
+std::vector<SparseTriplet> createRandomTriplets(int columns, int rows, double perc, unsigned seed);
+SparseMatrixCRS createRandomSparseMatrix(int columns, int rows, double perc, unsigned seed);
+
 std::vector<std::vector<double>> fillTheMatrixWithZeros(int columns, int rows);
 std::vector<std::vector<double>> createRandomMatrix(int columns, int rows, double perc);
 std::vector<std::vector<double>> multiplyMatrices(std::vector<std::vector<double>> A,
@@ -5,9 +5,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "core/transpose/include/transpose.hpp"
+
 SparseMatrixCRS::SparseMatrixCRS(int _numberOfColumns, int _numberOfRows, const std::vector<double>& _values,
                                  const std::vector<int>& _columnIndexes, const std::vector<int>& _pointers)
     : numberOfColumns(_numberOfColumns),
@@ -21,47 +26,40 @@ SparseMatrixCRS::SparseMatrixCRS(int _numberOfColumns, int _numberOfRows) {
   numberOfRows = _numberOfRows;
 }
 
-SparseMatrixCRS::SparseMatrixCRS(std::vector<std::vector<double>> matrix) {
-  int indexCounter = 0;
+SparseMatrixCRS::SparseMatrixCRS(const std::vector<std::vector<double>>& matrix) {
   numberOfRows = matrix.size();
   numberOfColumns = matrix[0].size();
-  pointers.push_back(indexCounter);
+  pointers.assign(numberOfRows + 1, 0);
+#pragma omp parallel for
+  for (int r = 0; r < numberOfRows; r++) {
+    pointers[r + 1] = std::count_if(matrix[r].begin(), matrix[r].end(), [](double v) { return v != 0; });
+  }
+  for (int r = 0; r < numberOfRows; r++) {
+    pointers[r + 1] += pointers[r];
+  }
+  values.resize(pointers[numberOfRows]);
+  columnIndexes.resize(pointers[numberOfRows]);
+#pragma omp parallel for
   for (int r = 0; r < numberOfRows; r++) {
+    int index = pointers[r];
     for (int c = 0; c < numberOfColumns; c++) {
       if (matrix[r][c] != 0) {
-        values.push_back(matrix[r][c]);
-        indexCounter++;
-        columnIndexes.push_back(c);
+        values[index] = matrix[r][c];
+        columnIndexes[index++] = c;
       }
     }
-    pointers.push_back(indexCounter);
   }
 }
 
 SparseMatrixCRS sparseMatrixTransposeCRS(const SparseMatrixCRS& object) {
-  SparseMatrixCRS matrix;
-  std::vector<std::vector<int>> locCVec(object.numberOfColumns);
-  std::vector<std::vector<double>> locVecVal(object.numberOfColumns);
-  matrix.numberOfColumns = object.numberOfRows;
-  int elementCounter = 0;
-  matrix.numberOfRows = object.numberOfColumns;
-
-  for (int r = 0; r < object.numberOfRows; r++) {
-    for (int index = object.pointers[r]; index < object.pointers[r + 1]; index++) {
-      int cIndex = object.columnIndexes[index];
-      locCVec[cIndex].push_back(r);
-      locVecVal[cIndex].push_back(object.values[index]);
-    }
-  }
-  matrix.pointers.push_back(elementCounter);
-  for (int c = 0; c < object.numberOfColumns; c++) {
-    for (size_t ktmp = 0; ktmp < locCVec[c].size(); ktmp++) {
-      matrix.columnIndexes.push_back(locCVec[c][ktmp]);
-      matrix.values.push_back(locVecVal[c][ktmp]);
-    }
-    elementCounter += locCVec[c].size();
-    matrix.pointers.push_back(elementCounter);
-  }
+  SparseMatrixCRS matrix(object.numberOfRows, object.numberOfColumns);
+  matrix.pointers.assign(object.numberOfColumns + 1, 0);
+  if (object.pointers.empty()) return matrix;
+  matrix.columnIndexes.resize(object.values.size());
+  matrix.values.resize(object.values.size());
+  ppc::core::transposeCRS(object.numberOfRows, object.numberOfColumns, object.pointers.data(),
+                          object.columnIndexes.data(), object.values.data(), matrix.pointers.data(),
+                          matrix.columnIndexes.data(), matrix.values.data());
   return matrix;
 }
 
@@ -72,13 +70,174 @@ bool SparseMatrixCRS::operator==(const SparseMatrixCRS& matrix) const {
 }
 
 std::vector<std::vector<double>> fillTheMatrixWithZeros(int columns, int rows) {
-  std::vector<std::vector<double>> result(rows);
-  for (int m = 0; m < rows; m++) {
-    for (int n = 0; n < columns; n++) {
-      result[m].push_back(0);
+  return std::vector<std::vector<double>>(rows, std::vector<double>(columns, 0.0));
+}
+
+namespace {
+
+// Shared by the CRS and CCS builders: "major" is the row for CRS and the column for CCS.
+template <bool ColumnMajor>
+SparseMatrixCRS buildCompressed(int columns, int rows, const std::vector<SparseTriplet>& triplets, bool sortMinor) {
+  const int majorCount = ColumnMajor ? columns : rows;
+  const int minorCount = ColumnMajor ? rows : columns;
+  auto major = [](const SparseTriplet& e) { return ColumnMajor ? e.column : e.row; };
+  auto minor = [](const SparseTriplet& e) { return ColumnMajor ? e.row : e.column; };
+  const auto count = static_cast<int64_t>(triplets.size());
+
+  // counting sort: every thread counts its chunk per major index, the (major, thread) prefix
+  // sums give the write positions, so the scatter keeps the input order inside a row
+  std::vector<int> start(majorCount + 1, 0);
+  std::vector<std::pair<int, double>> entries(count);
+  std::vector<std::vector<int>> histograms;
+  bool outOfRange = false;
+#pragma omp parallel
+  {
+#pragma omp single
+    histograms.resize(omp_get_num_threads());
+    const int t = omp_get_thread_num();
+    const auto team = static_cast<int64_t>(histograms.size());
+    const int64_t first = count * t / team;
+    const int64_t last = count * (t + 1) / team;
+    std::vector<int>& local = histograms[t];
+    local.assign(majorCount, 0);
+    for (int64_t k = first; k < last; k++) {
+      const SparseTriplet& e = triplets[k];
+      if (e.row < 0 || e.row >= rows || e.column < 0 || e.column >= columns) {
+#pragma omp atomic write
+        outOfRange = true;
+        break;
+      }
+      ++local[major(e)];
+    }
+#pragma omp barrier
+#pragma omp single
+    for (int i = 0; i < majorCount; i++) {
+      int sum = start[i];
+      for (auto& histogram : histograms) {
+        int c = histogram[i];
+        histogram[i] = sum;
+        sum += c;
+      }
+      start[i + 1] = sum;
+    }
+    if (!outOfRange) {
+      for (int64_t k = first; k < last; k++) {
+        const SparseTriplet& e = triplets[k];
+        entries[local[major(e)]++] = {minor(e), e.value};
+      }
     }
   }
-  return result;
+  if (outOfRange) {
+    throw std::runtime_error("Triplet index out of range. \n");
+  }
+
+  // duplicates are summed in place, then zeros are squeezed out
+  std::vector<int> length(majorCount + 1, 0);
+#pragma omp parallel
+  {
+    std::vector<int> seenIn(sortMinor ? 0 : minorCount, -1);
+    std::vector<int> slot(sortMinor ? 0 : minorCount);
+#pragma omp for schedule(dynamic, 256)
+    for (int i = 0; i < majorCount; i++) {
+      auto* row = entries.data() + start[i];
+      const int size = start[i + 1] - start[i];
+      int merged = 0;
+      if (sortMinor) {
+        std::sort(row, row + size, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        for (int k = 0; k < size; k++) {
+          if (merged > 0 && row[merged - 1].first == row[k].first) {
+            row[merged - 1].second += row[k].second;
+          } else {
+            row[merged++] = row[k];
+          }
+        }
+      } else {
+        for (int k = 0; k < size; k++) {
+          const int m = row[k].first;
+          if (seenIn[m] == i) {
+            row[slot[m]].second += row[k].second;
+          } else {
+            seenIn[m] = i;
+            slot[m] = merged;
+            row[merged++] = row[k];
+          }
+        }
+      }
+      length[i + 1] = std::remove_if(row, row + merged, [](const auto& e) { return e.second == 0; }) - row;
+    }
+  }
+
+  SparseMatrixCRS matrix(ColumnMajor ? rows : columns, majorCount);
+  matrix.pointers = std::move(length);
+  for (int i = 0; i < majorCount; i++) {
+    matrix.pointers[i + 1] += matrix.pointers[i];
+  }
+  matrix.values.resize(matrix.pointers[majorCount]);
+  matrix.columnIndexes.resize(matrix.pointers[majorCount]);
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int i = 0; i < majorCount; i++) {
+    int index = matrix.pointers[i];
+    for (int k = start[i]; index < matrix.pointers[i + 1]; k++, index++) {
+      matrix.columnIndexes[index] = entries[k].first;
+      matrix.values[index] = entries[k].second;
+    }
+  }
+  return matrix;
+}
+
+}  // namespace
+
+SparseMatrixCRS buildSparseMatrixCRS(int columns, int rows, const std::vector<SparseTriplet>& triplets,
+                                     bool sortColumns) {
+  return buildCompressed<false>(columns, rows, triplets, sortColumns);
+}
+
+SparseMatrixCRS buildSparseMatrixCCS(int columns, int rows, const std::vector<SparseTriplet>& triplets,
+                                     bool sortRows) {
+  return buildCompressed<true>(columns, rows, triplets, sortRows);
+}
+
+std::vector<SparseTriplet> createRandomTriplets(int columns, int rows, double perc, unsigned seed) {
+  if (perc < 0 || perc > 1) {
+    throw std::runtime_error("Wrong density. \n");
+  }
+  if (perc == 0 || columns == 0) {
+    return {};
+  }
+  // rows are generated in fixed blocks, each with its own stream, so the output does not
+  // depend on the schedule; gaps between nonzeros are geometric, the cost is O(nnz)
+  constexpr int kBlock = 256;
+  const int blocks = (rows + kBlock - 1) / kBlock;
+  std::vector<std::vector<SparseTriplet>> parts(blocks);
+#pragma omp parallel for schedule(dynamic)
+  for (int b = 0; b < blocks; b++) {
+    std::seed_seq sequence{seed, static_cast<unsigned>(b)};
+    std::mt19937 gen(sequence);
+    std::geometric_distribution<int64_t> genGap(perc);
+    std::uniform_real_distribution<double> genVal{0.0, 25.0};
+    auto& part = parts[b];
+    part.reserve(static_cast<size_t>(perc * columns * kBlock * 1.1) + 16);
+    for (int r = b * kBlock; r < std::min(rows, (b + 1) * kBlock); r++) {
+      for (int64_t c = genGap(gen); c < columns; c += genGap(gen) + 1) {
+        part.push_back({r, static_cast<int>(c), genVal(gen)});
+      }
+    }
+  }
+
+  std::vector<size_t> offsets(blocks + 1, 0);
+  for (int b = 0; b < blocks; b++) {
+    offsets[b + 1] = offsets[b] + parts[b].size();
+  }
+  std::vector<SparseTriplet> triplets(offsets[blocks]);
+#pragma omp parallel for schedule(dynamic)
+  for (int b = 0; b < blocks; b++) {
+    std::copy(parts[b].begin(), parts[b].end(), triplets.begin() + offsets[b]);
+  }
+  return triplets;
+}
+
+SparseMatrixCRS createRandomSparseMatrix(int columns, int rows, double perc, unsigned seed) {
+  return buildSparseMatrixCRS(columns, rows, createRandomTriplets(columns, rows, perc, seed));
 }
 
 std::vector<std::vector<double>> multiplyMatrices(std::vector<std::vector<double>> A,
@@ -1,12 +1,79 @@
 // Copyright 2024 Smirnova Daria
 #include <gtest/gtest.h>
 
+#include <complex>
+#include <memory>
+#include <random>
 #include <vector>
 
 #include "omp/smirnova_d_complex_matrix_crs/include/ops_omp.hpp"
 
 using namespace smirnova_omp;
 
+namespace {
+
+crs_matrix generate_random_matrix(int n, int m, double proba, int seed) {
+  std::mt19937 gen;
+  gen.seed(seed);
+  std::uniform_real_distribution<double> random(-2.0, 2.0);
+  std::bernoulli_distribution bernoulli(proba);
+
+  crs_matrix result;
+  result.n_rows = n;
+  result.n_cols = m;
+  result.pointer.assign(result.n_rows + 1, 0);
+  for (int i = 0; i < n; i++) {
+    result.pointer[i + 1] = result.pointer[i];
+    for (int j = 0; j < m; j++) {
+      if (bernoulli(gen)) {
+        result.col_indexes.push_back(j);
+        result.non_zero_values.emplace_back(random(gen), random(gen));
+        result.pointer[i + 1]++;
+      }
+    }
+  }
+  return result;
+}
+
+// A * B by the dot-product path of TestComplexMatrixCrsSeq and by TestComplexMatrixCrsSoAPar
+void expect_soa_matches_seq(crs_matrix A, crs_matrix B) {
+  crs_matrix_soa A_SoA = to_soa(A);
+  crs_matrix_soa B_SoA = to_soa(B);
+  crs_matrix_soa Result_SoA;
+  crs_matrix Result_Seq;
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&Result_Seq));
+  TestComplexMatrixCrsSeq taskSequential(taskDataSeq);
+  ASSERT_EQ(taskSequential.validation(), true);
+  ASSERT_EQ(taskSequential.pre_processing(), true);
+  ASSERT_EQ(taskSequential.run(), true);
+  ASSERT_EQ(taskSequential.post_processing(), true);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A_SoA));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B_SoA));
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(&Result_SoA));
+  TestComplexMatrixCrsSoAPar taskParallel(taskDataPar);
+  ASSERT_EQ(taskParallel.validation(), true);
+  ASSERT_EQ(taskParallel.pre_processing(), true);
+  ASSERT_EQ(taskParallel.run(), true);
+  ASSERT_EQ(taskParallel.post_processing(), true);
+
+  crs_matrix Result_Par = from_soa(Result_SoA);
+  ASSERT_EQ(Result_Par.pointer, Result_Seq.pointer);
+  ASSERT_EQ(Result_Par.col_indexes, Result_Seq.col_indexes);
+  for (size_t i = 0; i < Result_Par.non_zero_values.size(); i++) {
+    std::complex<double> t = Result_Par.non_zero_values[i] - Result_Seq.non_zero_values[i];
+    ASSERT_NEAR(0.0f, t.imag(), 1e-9);
+    ASSERT_NEAR(0.0f, t.real(), 1e-9);
+  }
+}
+
+}  // namespace
+
 TEST(smirnova_d_complex_matrix_crs_omp, test_square_matrix_by_itself) {
   crs_matrix A;
   A.n_rows = 5;
@@ -512,3 +579,150 @@ TEST(smirnova_d_complex_matrix_crs_omp, test_complex_matrix_diagonal) {
     ASSERT_NEAR(0.0f, t.real(), 1e-3);
   }
 }
+
+TEST(smirnova_d_complex_matrix_crs_omp, test_soa_roundtrip) {
+  crs_matrix A;
+  A.n_rows = 2;
+  A.n_cols = 3;
+  A.pointer = {0, 2, 3};
+  A.col_indexes = {0, 2, 1};
+  A.non_zero_values = {{1, -1}, {0, 2}, {3, 0}};
+
+  crs_matrix_soa A_soa = to_soa(A);
+  ASSERT_TRUE(is_crs(A_soa));
+  ASSERT_EQ(A_soa.re, std::vector<double>({1, 0, 3}));
+  ASSERT_EQ(A_soa.im, std::vector<double>({-1, 2, 0}));
+
+  crs_matrix A_back = from_soa(A_soa);
+  ASSERT_EQ(A_back.pointer, A.pointer);
+  ASSERT_EQ(A_back.col_indexes, A.col_indexes);
+  ASSERT_EQ(A_back.non_zero_values, A.non_zero_values);
+}
+
+TEST(smirnova_d_complex_matrix_crs_omp, test_soa_complex_matrix) {
+  crs_matrix A;
+  A.n_rows = 5;
+  A.n_cols = 4;
+  A.pointer = {0, 2, 3, 4, 5, 6};
+  A.col_indexes = {0, 2, 1, 0, 2, 3};
+  A.non_zero_values = {{0, 1}, {2, 3}, {1, 1}, {4, 1}, {1, 2}, {2, 2}};
+
+  crs_matrix B;
+  B.n_rows = 4;
+  B.n_cols = 5;
+  B.pointer = {0, 2, 3, 5, 7};
+  B.col_indexes = {0, 3, 2, 1, 3, 2, 4};
+  B.non_zero_values = {{1, 1}, {4, 1}, {1, 2}, {3, 0}, {7, 7}, {2, 1}, {3, 2}};
+
+  crs_matrix_soa A_SoA = to_soa(A);
+  crs_matrix_soa B_SoA = to_soa(B);
+  crs_matrix_soa Result_SoA;
+
+  crs_matrix Expected;
+  Expected.n_rows = 5;
+  Expected.n_cols = 5;
+  Expected.pointer = {0, 3, 4, 6, 8, 10};
+  Expected.col_indexes = {0, 1, 3, 2, 0, 3, 1, 3, 2, 4};
+  Expected.non_zero_values = {{-1, 1}, {6, 9}, {-8, 39}, {-1, 3}, {3, 5}, {15, 8}, {3, 6}, {-7, 21}, {2, 6}, {2, 10}};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A_SoA));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B_SoA));
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(&Result_SoA));
+
+  // Create Task
+  TestComplexMatrixCrsSoAPar taskParallel(taskDataPar);
+  ASSERT_EQ(taskParallel.validation(), true);
+  ASSERT_EQ(taskParallel.pre_processing(), true);
+  ASSERT_EQ(taskParallel.run(), true);
+  ASSERT_EQ(taskParallel.post_processing(), true);
+
+  crs_matrix Result_Par = from_soa(Result_SoA);
+  ASSERT_EQ(Result_Par.n_rows, Expected.n_rows);
+  ASSERT_EQ(Result_Par.n_cols, Expected.n_cols);
+  ASSERT_EQ(Result_Par.pointer, Expected.pointer);
+  ASSERT_EQ(Result_Par.col_indexes, Expected.col_indexes);
+  ASSERT_EQ(Result_Par.non_zero_values.size(), Expected.non_zero_values.size());
+
+  for (size_t i = 0; i < Result_Par.non_zero_values.size(); i++) {
+    std::complex<double> t = Result_Par.non_zero_values[i] - Expected.non_zero_values[i];
+    ASSERT_NEAR(0.0f, t.imag(), 1e-3);
+    ASSERT_NEAR(0.0f, t.real(), 1e-3);
+  }
+}
+
+TEST(smirnova_d_complex_matrix_crs_omp, test_soa_matches_complex_path) {
+  crs_matrix A;
+  A.n_rows = 5;
+  A.n_cols = 5;
+  A.pointer = {0, 3, 5, 8, 11, 13};
+  A.col_indexes = {0, 1, 3, 0, 1, 2, 3, 4, 0, 2, 3, 1, 4};
+  A.non_zero_values = {{1, 2}, {-1, 0}, {-3, 1}, {-2, -2}, {5, 1}, {4, 0}, {6, -1},
+                       {4, 4}, {-4, 0}, {2, 3}, {7, 0}, {8, -8}, {-5, 1}};
+
+  crs_matrix_soa A_SoA = to_soa(A);
+  crs_matrix_soa B_SoA = to_soa(A);
+  crs_matrix_soa Result_SoA;
+  crs_matrix B = A;
+  crs_matrix Result_Seq;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&Result_Seq));
+
+  // Create Task
+  TestComplexMatrixCrsSeq taskSequential(taskDataSeq);
+  ASSERT_EQ(taskSequential.validation(), true);
+  ASSERT_EQ(taskSequential.pre_processing(), true);
+  ASSERT_EQ(taskSequential.run(), true);
+  ASSERT_EQ(taskSequential.post_processing(), true);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A_SoA));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B_SoA));
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(&Result_SoA));
+
+  // Create Task
+  TestComplexMatrixCrsSoAPar taskParallel(taskDataPar);
+  ASSERT_EQ(taskParallel.validation(), true);
+  ASSERT_EQ(taskParallel.pre_processing(), true);
+  ASSERT_EQ(taskParallel.run(), true);
+  ASSERT_EQ(taskParallel.post_processing(), true);
+
+  crs_matrix Result_Par = from_soa(Result_SoA);
+  ASSERT_EQ(Result_Par.pointer, Result_Seq.pointer);
+  ASSERT_EQ(Result_Par.col_indexes, Result_Seq.col_indexes);
+  for (size_t i = 0; i < Result_Par.non_zero_values.size(); i++) {
+    std::complex<double> t = Result_Par.non_zero_values[i] - Result_Seq.non_zero_values[i];
+    ASSERT_NEAR(0.0f, t.imag(), 1e-3);
+    ASSERT_NEAR(0.0f, t.real(), 1e-3);
+  }
+}
+
+TEST(smirnova_d_complex_matrix_crs_omp, test_soa_matches_complex_path_on_perf_matrices) {
+  // the inputs of the perf tests, which time the complex path only
+  expect_soa_matches_seq(generate_random_matrix(100, 100, 0.6, 1993), generate_random_matrix(100, 100, 0.6, 4325));
+  expect_soa_matches_seq(generate_random_matrix(37, 80, 0.1, 7), generate_random_matrix(80, 23, 0.3, 8));
+}
+
+TEST(smirnova_d_complex_matrix_crs_omp, test_soa_repeated_columns_add_up) {
+  crs_matrix A;
+  A.n_rows = 2;
+  A.n_cols = 3;
+  A.pointer = {0, 3, 5};
+  A.col_indexes = {0, 2, 0, 1, 1};
+  A.non_zero_values = {{1, 1}, {2, 0}, {0, -1}, {3, 2}, {-1, 4}};
+
+  crs_matrix B;
+  B.n_rows = 3;
+  B.n_cols = 3;
+  B.pointer = {0, 3, 4, 6};
+  B.col_indexes = {1, 2, 1, 0, 2, 2};
+  B.non_zero_values = {{1, 0}, {2, 1}, {0, 3}, {4, -1}, {1, 1}, {-2, 2}};
+
+  expect_soa_matches_seq(A, B);
+}
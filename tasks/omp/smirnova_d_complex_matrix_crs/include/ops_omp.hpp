@@ -19,6 +19,17 @@ struct crs_matrix {
   std::vector<int> col_indexes{};
 };
 
+// Same CRS structure with real and imaginary parts kept in separate arrays,
+// so the multiply-accumulate loops run over plain doubles without std::complex temporaries
+struct crs_matrix_soa {
+  int n_rows{};
+  int n_cols{};
+  std::vector<double> re{};
+  std::vector<double> im{};
+  std::vector<int> pointer{};
+  std::vector<int> col_indexes{};
+};
+
 class TestComplexMatrixCrsSeq : public ppc::core::Task {
  public:
   explicit TestComplexMatrixCrsSeq(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -43,6 +54,21 @@ class TestComplexMatrixCrsPar : public ppc::core::Task {
   crs_matrix *A_M{}, *B_M{}, *Result{};
 };
 
+class TestComplexMatrixCrsSoAPar : public ppc::core::Task {
+ public:
+  explicit TestComplexMatrixCrsSoAPar(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  crs_matrix_soa *A_M{}, *B_M{}, *Result{};
+};
+
 crs_matrix T(const crs_matrix& M);
 bool is_crs(const crs_matrix& M);
+bool is_crs(const crs_matrix_soa& M);
+crs_matrix_soa to_soa(const crs_matrix& M);
+crs_matrix from_soa(const crs_matrix_soa& M);
 }  // namespace smirnova_omp
@@ -4,6 +4,8 @@
 
 #include <chrono>
 #include <complex>
+#include <cstdint>
+#include <memory>
 #include <random>
 #include <vector>
 
@@ -43,10 +45,12 @@ crs_matrix generate_random_matrix(int n, int m, double proba, int seed) {
   return result;
 }
 
-TEST(smirnova_d_complex_matrix_crs_omp, test_pipeline_run) {
-  crs_matrix A = generate_random_matrix(100, 100, 0.6, 1993);
-  crs_matrix B = generate_random_matrix(100, 100, 0.6, 4325);
-  crs_matrix Result;
+namespace {
+
+template <class Task, class Matrix>
+std::shared_ptr<ppc::core::PerfResults> measure(Matrix &A, Matrix &B, bool pipeline,
+                                                const std::shared_ptr<ppc::core::PerfAttr> &perfAttr) {
+  Matrix Result;
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
@@ -54,37 +58,26 @@ TEST(smirnova_d_complex_matrix_crs_omp, test_pipeline_run) {
   taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
   taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&Result));
 
-  // Create Task
-  auto taskOmp = std::make_shared<TestComplexMatrixCrsPar>(taskDataSeq);
-
-  // Create Perf attributes
-  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 50;
-  const auto t0 = omp_get_wtime();
-  perfAttr->current_timer = [&] { return omp_get_wtime() - t0; };
-
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
 
   // Create Perf analyzer
-  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(taskOmp);
-  perfAnalyzer->pipeline_run(perfAttr, perfResults);
-  ppc::core::Perf::print_perf_statistic(perfResults);
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(std::make_shared<Task>(taskDataSeq));
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  return perfResults;
 }
 
-TEST(smirnova_d_complex_matrix_crs_omp, test_task_run) {
+// The std::complex task gives the line the perf collector reads; the SoA task runs on the same
+// inputs, and both are also printed as complex multiply-adds per second to compare them.
+void runPerf(bool pipeline) {
   crs_matrix A = generate_random_matrix(100, 100, 0.6, 1993);
   crs_matrix B = generate_random_matrix(100, 100, 0.6, 4325);
-  crs_matrix Result;
-
-  // Create TaskData
-  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
-  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&Result));
-
-  // Create Task
-  auto taskOmp = std::make_shared<TestComplexMatrixCrsPar>(taskDataSeq);
+  crs_matrix_soa A_SoA = to_soa(A);
+  crs_matrix_soa B_SoA = to_soa(B);
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
@@ -92,11 +85,21 @@ TEST(smirnova_d_complex_matrix_crs_omp, test_task_run) {
   const auto t0 = omp_get_wtime();
   perfAttr->current_timer = [&] { return omp_get_wtime() - t0; };
 
-  // Create and init perf results
-  auto perfResults = std::make_shared<ppc::core::PerfResults>();
-
-  // Create Perf analyzer
-  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(taskOmp);
-  perfAnalyzer->task_run(perfAttr, perfResults);
-  ppc::core::Perf::print_perf_statistic(perfResults);
+  auto complexResults = measure<TestComplexMatrixCrsPar>(A, B, pipeline, perfAttr);
+  ppc::core::Perf::print_perf_statistic(complexResults);
+  auto soaResults = measure<TestComplexMatrixCrsSoAPar>(A_SoA, B_SoA, pipeline, perfAttr);
+
+  uint64_t multiply_adds = 0;
+  for (int k : A.col_indexes) multiply_adds += B.pointer[k + 1] - B.pointer[k];
+  const uint64_t bytes = (A.non_zero_values.size() + B.non_zero_values.size()) * sizeof(std::complex<double>);
+  ppc::core::Perf::print_throughput_statistic(perfAttr, complexResults, "smirnova_d_complex_matrix_crs_omp/complex",
+                                              multiply_adds, bytes);
+  ppc::core::Perf::print_throughput_statistic(perfAttr, soaResults, "smirnova_d_complex_matrix_crs_omp/soa",
+                                              multiply_adds, bytes);
 }
+
+}  // namespace
+
+TEST(smirnova_d_complex_matrix_crs_omp, test_pipeline_run) { runPerf(true); }
+
+TEST(smirnova_d_complex_matrix_crs_omp, test_task_run) { runPerf(false); }
@@ -4,10 +4,14 @@
 #include <omp.h>
 
 #include <algorithm>
+#include <cmath>
 #include <complex>
 #include <utility>
 #include <vector>
 
+#include "core/gemm/include/complex_axpy.hpp"
+#include "core/transpose/include/transpose.hpp"
+
 using namespace std::chrono_literals;
 
 smirnova_omp::crs_matrix smirnova_omp::T(const crs_matrix& M) {
@@ -15,21 +19,11 @@ smirnova_omp::crs_matrix smirnova_omp::T(const crs_matrix& M) {
   temp_matrix.n_rows = M.n_cols;
   temp_matrix.n_cols = M.n_rows;
   temp_matrix.pointer.assign(temp_matrix.n_rows + 1, 0);
-  std::vector<std::vector<std::pair<int, std::complex<double>>>> temp(temp_matrix.n_rows);
-  for (int i = 0; i < M.n_rows; i++) {
-    for (int k = M.pointer[i]; k < M.pointer[i + 1]; k++) {
-      int j = M.col_indexes[k];
-      temp[j].emplace_back(i, M.non_zero_values[k]);
-    }
-  }
-  for (int i = 0; i < temp_matrix.n_rows; i++) {
-    temp_matrix.pointer[i + 1] = temp_matrix.pointer[i];
-    for (auto& j : temp[i]) {
-      temp_matrix.col_indexes.push_back(j.first);
-      temp_matrix.non_zero_values.push_back(j.second);
-      temp_matrix.pointer[i + 1]++;
-    }
-  }
+  temp_matrix.col_indexes.resize(M.col_indexes.size());
+  temp_matrix.non_zero_values.resize(M.non_zero_values.size());
+  ppc::core::transposeCRS(M.n_rows, M.n_cols, M.pointer.data(), M.col_indexes.data(), M.non_zero_values.data(),
+                          temp_matrix.pointer.data(), temp_matrix.col_indexes.data(),
+                          temp_matrix.non_zero_values.data());
   return temp_matrix;
 }
 
@@ -171,3 +165,147 @@ bool smirnova_omp::TestComplexMatrixCrsPar::post_processing() {
 
   return true;
 }
+
+bool smirnova_omp::is_crs(const crs_matrix_soa& M) {
+  if (M.pointer.size() != size_t(M.n_rows + 1)) return false;
+  int non_zero_elems_count = M.re.size();
+  if (M.im.size() != size_t(non_zero_elems_count) || M.col_indexes.size() != size_t(non_zero_elems_count) ||
+      M.pointer[M.n_rows] != non_zero_elems_count)
+    return false;
+  if (M.pointer[0] != 0) return false;
+  for (int i = 1; i <= M.n_rows; i++) {
+    if (M.pointer[i] < M.pointer[i - 1]) return false;
+  }
+  for (int i = 0; i < non_zero_elems_count; i++) {
+    if (M.col_indexes[i] < 0 || M.col_indexes[i] >= M.n_cols) return false;
+  }
+  return true;
+}
+
+smirnova_omp::crs_matrix_soa smirnova_omp::to_soa(const crs_matrix& M) {
+  crs_matrix_soa res;
+  res.n_rows = M.n_rows;
+  res.n_cols = M.n_cols;
+  res.pointer = M.pointer;
+  res.col_indexes = M.col_indexes;
+  res.re.resize(M.non_zero_values.size());
+  res.im.resize(M.non_zero_values.size());
+  for (size_t k = 0; k < M.non_zero_values.size(); k++) {
+    res.re[k] = M.non_zero_values[k].real();
+    res.im[k] = M.non_zero_values[k].imag();
+  }
+  return res;
+}
+
+smirnova_omp::crs_matrix smirnova_omp::from_soa(const crs_matrix_soa& M) {
+  crs_matrix res;
+  res.n_rows = M.n_rows;
+  res.n_cols = M.n_cols;
+  res.pointer = M.pointer;
+  res.col_indexes = M.col_indexes;
+  res.non_zero_values.resize(M.re.size());
+  for (size_t k = 0; k < M.re.size(); k++) {
+    res.non_zero_values[k] = {M.re[k], M.im[k]};
+  }
+  return res;
+}
+
+bool smirnova_omp::TestComplexMatrixCrsSoAPar::pre_processing() {
+  internal_order_test();
+
+  // row-by-row (Gustavson) product reads B by rows, so no transpose is needed
+  return true;
+}
+
+bool smirnova_omp::TestComplexMatrixCrsSoAPar::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->outputs.size() != 1 || !taskData->inputs_count.empty() ||
+      !taskData->outputs_count.empty())
+    return false;
+  A_M = reinterpret_cast<crs_matrix_soa*>(taskData->inputs[0]);
+  B_M = reinterpret_cast<crs_matrix_soa*>(taskData->inputs[1]);
+  Result = reinterpret_cast<crs_matrix_soa*>(taskData->outputs[0]);
+  if (A_M == nullptr || B_M == nullptr || Result == nullptr) return false;
+  if (!is_crs(*A_M) || !is_crs(*B_M)) return false;
+  if (A_M->n_cols != B_M->n_rows) return false;
+  return true;
+}
+
+bool smirnova_omp::TestComplexMatrixCrsSoAPar::run() {
+  internal_order_test();
+
+  const int n_rows = A_M->n_rows;
+  const int n_cols = B_M->n_cols;
+  Result->n_rows = n_rows;
+  Result->n_cols = n_cols;
+  Result->pointer.assign(n_rows + 1, 0);
+
+  std::vector<std::vector<int>> row_cols(n_rows);
+  std::vector<std::vector<double>> row_re(n_rows);
+  std::vector<std::vector<double>> row_im(n_rows);
+
+#pragma omp parallel
+  {
+    std::vector<double> acc_re(n_cols, 0.0);
+    std::vector<double> acc_im(n_cols, 0.0);
+    std::vector<char> present(n_cols, 0);
+    std::vector<int> touched;
+    touched.reserve(n_cols);
+
+#pragma omp for schedule(dynamic, 16)
+    for (int i = 0; i < n_rows; i++) {
+      for (int k_A = A_M->pointer[i]; k_A < A_M->pointer[i + 1]; k_A++) {
+        const double a_re = A_M->re[k_A];
+        const double a_im = A_M->im[k_A];
+        const int k = A_M->col_indexes[k_A];
+        const int begin = B_M->pointer[k];
+        const int end = B_M->pointer[k + 1];
+        const int* cols = B_M->col_indexes.data();
+        for (int k_B = begin; k_B < end; k_B++) {
+          const int j = cols[k_B];
+          if (present[j] == 0) {
+            present[j] = 1;
+            touched.push_back(j);
+          }
+        }
+        // a column repeated within a row of B adds up, as in the dot-product path
+        ppc::core::complexAxpyScatter(a_re, a_im, B_M->re.data() + begin, B_M->im.data() + begin, cols + begin,
+                                      end - begin, acc_re.data(), acc_im.data());
+      }
+      std::sort(touched.begin(), touched.end());
+      for (int j : touched) {
+        if (std::abs(acc_im[j]) > 1e-3 || std::abs(acc_re[j]) > 1e-3) {
+          row_cols[i].push_back(j);
+          row_re[i].push_back(acc_re[j]);
+          row_im[i].push_back(acc_im[j]);
+        }
+        acc_re[j] = 0.0;
+        acc_im[j] = 0.0;
+        present[j] = 0;
+      }
+      touched.clear();
+    }
+  }
+
+  for (int i = 0; i < n_rows; i++) {
+    Result->pointer[i + 1] = Result->pointer[i] + static_cast<int>(row_cols[i].size());
+  }
+  const int nnz = Result->pointer[n_rows];
+  Result->col_indexes.resize(nnz);
+  Result->re.resize(nnz);
+  Result->im.resize(nnz);
+#pragma omp parallel for
+  for (int i = 0; i < n_rows; i++) {
+    std::copy(row_cols[i].begin(), row_cols[i].end(), Result->col_indexes.begin() + Result->pointer[i]);
+    std::copy(row_re[i].begin(), row_re[i].end(), Result->re.begin() + Result->pointer[i]);
+    std::copy(row_im[i].begin(), row_im[i].end(), Result->im.begin() + Result->pointer[i]);
+  }
+  return true;
+}
+
+bool smirnova_omp::TestComplexMatrixCrsSoAPar::post_processing() {
+  internal_order_test();
+
+  return true;
+}
@@ -4,6 +4,7 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "omp/ustinov_a_spgemm_csc_complex/include/ops_omp.hpp"
@@ -58,6 +59,48 @@ sparse_matrix dft_conj_matrix(int n) {
   return dft_conj;
 }
 
+// A * B by SpgemmCSCComplexOmpSeq and by SpgemmCSCComplexOmpSoA
+void expect_soa_matches_seq(sparse_matrix A, sparse_matrix B) {
+  sparse_matrix C_seq;
+  sparse_matrix_soa A_soa = sparse_matrix_to_soa(A);
+  sparse_matrix_soa B_soa = sparse_matrix_to_soa(B);
+  sparse_matrix_soa C_soa;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C_seq));
+
+  // Create Task
+  SpgemmCSCComplexOmpSeq testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), true);
+  testTaskSequential.pre_processing();
+  testTaskSequential.run();
+  testTaskSequential.post_processing();
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&A_soa));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&B_soa));
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(&C_soa));
+
+  // Create Task
+  SpgemmCSCComplexOmpSoA testTaskSoA(taskDataPar);
+  ASSERT_EQ(testTaskSoA.validation(), true);
+  testTaskSoA.pre_processing();
+  testTaskSoA.run();
+  testTaskSoA.post_processing();
+
+  sparse_matrix C_par = sparse_matrix_from_soa(C_soa);
+  ASSERT_EQ(C_seq.col_ptr, C_par.col_ptr);
+  ASSERT_EQ(C_seq.rows, C_par.rows);
+  for (int j = 0; j < C_seq.nonzeros; ++j) {
+    EXPECT_NEAR(C_seq.values[j].real(), C_par.values[j].real(), 1e-9);
+    EXPECT_NEAR(C_seq.values[j].imag(), C_par.values[j].imag(), 1e-9);
+  }
+}
+
 TEST(ustinov_a_spgemm_csc_complex_omp, test_scalar_matrix) {
   sparse_matrix A(1, 1, 1);
   sparse_matrix B(1, 1, 1);
@@ -304,4 +347,36 @@ TEST(ustinov_a_spgemm_csc_complex_omp, test_permutation_matrix) {
   testTaskParallel.post_processing();
 
   EXPECT_EQ(C_seq, C_par);
-}
\ No newline at end of file
+}
+TEST(ustinov_a_spgemm_csc_complex_omp, test_soa_dft64x64) {
+  expect_soa_matches_seq(dft_matrix(64), dft_conj_matrix(64));
+}
+
+TEST(ustinov_a_spgemm_csc_complex_omp, test_soa_dft384x384) {
+  // the input of the perf tests, which time SpgemmCSCComplexOmpPar only
+  expect_soa_matches_seq(dft_matrix(384), dft_conj_matrix(384));
+}
+
+TEST(ustinov_a_spgemm_csc_complex_omp, test_soa_repeated_rows_add_up) {
+  sparse_matrix A(3, 2, 5);
+  A.col_ptr = {0, 3, 5};
+  A.rows = {0, 2, 0, 1, 1};
+  A.values = {{1.0, 1.0}, {2.0, 0.0}, {0.0, -1.0}, {3.0, 2.0}, {-1.0, 4.0}};
+  sparse_matrix B(2, 3, 4);
+  B.col_ptr = {0, 2, 3, 4};
+  B.rows = {0, 1, 1, 0};
+  B.values = {{1.0, 0.0}, {2.0, 1.0}, {0.0, 3.0}, {4.0, -1.0}};
+  expect_soa_matches_seq(A, B);
+}
+
+TEST(ustinov_a_spgemm_csc_complex_omp, test_soa_roundtrip) {
+  sparse_matrix A(2, 2, 3);
+  A.col_ptr = {0, 2, 3};
+  A.rows = {0, 1, 1};
+  A.values = {std::complex<double>(1.0, -2.0), std::complex<double>(0.5, 0.0), std::complex<double>(0.0, 3.0)};
+
+  sparse_matrix_soa A_soa = sparse_matrix_to_soa(A);
+  EXPECT_EQ(A_soa.re, std::vector<double>({1.0, 0.5, 0.0}));
+  EXPECT_EQ(A_soa.im, std::vector<double>({-2.0, 0.0, 3.0}));
+  EXPECT_EQ(A, sparse_matrix_from_soa(A_soa));
+}
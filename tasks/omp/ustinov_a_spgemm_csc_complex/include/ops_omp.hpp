@@ -26,4 +26,19 @@ class SpgemmCSCComplexOmpPar : public ppc::core::Task {
 
  private:
   sparse_matrix *A, *B, *C;
-};
\ No newline at end of file
+};
+// same product as SpgemmCSCComplexOmpPar on split real/imaginary storage
+class SpgemmCSCComplexOmpSoA : public ppc::core::Task {
+ public:
+  explicit SpgemmCSCComplexOmpSoA(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  sparse_matrix_soa *A, *B, *C;
+};
+
+sparse_matrix_soa sparse_matrix_to_soa(const sparse_matrix& M);
+sparse_matrix sparse_matrix_from_soa(const sparse_matrix_soa& M);
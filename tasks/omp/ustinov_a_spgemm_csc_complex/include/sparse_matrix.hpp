@@ -20,4 +20,22 @@ struct sparse_matrix {
         col_ptr(row_num + 1),
         rows(nonzeros),
         values(nonzeros) {}
-};
\ No newline at end of file
+};
+// sparse matrix in CSC format with real and imaginary parts of values stored in separate arrays
+struct sparse_matrix_soa {
+  int row_num, col_num;            // number of rows and columns in matrix
+  int nonzeros;                    // number of non-zero elements
+  std::vector<int> col_ptr;        // index at which column data in `rows` and `re`/`im` begins
+  std::vector<int> rows;           // rows of non-zero elements of matrix
+  std::vector<double> re;          // real parts of non-zero elements in matrix
+  std::vector<double> im;          // imaginary parts of non-zero elements in matrix
+
+  sparse_matrix_soa(int row_num_ = 0, int col_num_ = 0, int nonzeros_ = 0)
+      : row_num(row_num_),
+        col_num(col_num_),
+        nonzeros(nonzeros_),
+        col_ptr(col_num + 1),
+        rows(nonzeros),
+        re(nonzeros),
+        im(nonzeros) {}
+};
@@ -2,6 +2,9 @@
 #include <gtest/gtest.h>
 #include <omp.h>
 
+#include <complex>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -41,11 +44,12 @@ sparse_matrix dft_conj_matrix(int n) {
   return dft_conj;
 }
 
-TEST(ustinov_a_spgemm_csc_complex_omp, test_pipeline_run_dft384x384) {
-  int n = 384;
-  sparse_matrix A = dft_matrix(n);
-  sparse_matrix B = dft_conj_matrix(n);
-  sparse_matrix C;
+namespace {
+
+template <class Task, class Matrix>
+std::shared_ptr<ppc::core::PerfResults> measure(Matrix& A, Matrix& B, bool pipeline,
+                                                const std::shared_ptr<ppc::core::PerfAttr>& perfAttr) {
+  Matrix C;
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
@@ -53,42 +57,27 @@ TEST(ustinov_a_spgemm_csc_complex_omp, test_pipeline_run_dft384x384) {
   taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(&B));
   taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(&C));
 
-  // Create Task
-  auto testTaskParallel = std::make_shared<SpgemmCSCComplexOmpPar>(taskDataPar);
-
-  // Create Perf attributes
-  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
-  const auto t0 = omp_get_wtime();
-  perfAttr->current_timer = [&] {
-    auto current_time_point = omp_get_wtime();
-    auto duration = current_time_point - t0;
-    return duration;
-  };
-
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
 
   // Create Perf analyzer
-  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
-  perfAnalyzer->pipeline_run(perfAttr, perfResults);
-  ppc::core::Perf::print_perf_statistic(perfResults);
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(std::make_shared<Task>(taskDataPar));
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  return perfResults;
 }
 
-TEST(ustinov_a_spgemm_csc_complex_omp, test_task_run_dft384x384) {
+// The std::complex task gives the line the perf collector reads; the SoA task runs on the same
+// inputs, and both are also printed as complex multiply-adds per second to compare them.
+void runPerf(bool pipeline) {
   int n = 384;
   sparse_matrix A = dft_matrix(n);
   sparse_matrix B = dft_conj_matrix(n);
-  sparse_matrix C;
-
-  // Create TaskData
-  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
-  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(&A));
-  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(&B));
-  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(&C));
-
-  // Create Task
-  auto testTaskParallel = std::make_shared<SpgemmCSCComplexOmpPar>(taskDataPar);
+  sparse_matrix_soa A_SoA = sparse_matrix_to_soa(A);
+  sparse_matrix_soa B_SoA = sparse_matrix_to_soa(B);
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
@@ -100,11 +89,21 @@ TEST(ustinov_a_spgemm_csc_complex_omp, test_task_run_dft384x384) {
     return duration;
   };
 
-  // Create and init perf results
-  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  auto complexResults = measure<SpgemmCSCComplexOmpPar>(A, B, pipeline, perfAttr);
+  ppc::core::Perf::print_perf_statistic(complexResults);
+  auto soaResults = measure<SpgemmCSCComplexOmpSoA>(A_SoA, B_SoA, pipeline, perfAttr);
+
+  uint64_t multiply_adds = 0;
+  for (int b_row : B.rows) multiply_adds += A.col_ptr[b_row + 1] - A.col_ptr[b_row];
+  const uint64_t bytes = (A.values.size() + B.values.size()) * sizeof(std::complex<double>);
+  ppc::core::Perf::print_throughput_statistic(perfAttr, complexResults, "ustinov_a_spgemm_csc_complex_omp/complex",
+                                              multiply_adds, bytes);
+  ppc::core::Perf::print_throughput_statistic(perfAttr, soaResults, "ustinov_a_spgemm_csc_complex_omp/soa",
+                                              multiply_adds, bytes);
+}
 
-  // Create Perf analyzer
-  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
-  perfAnalyzer->task_run(perfAttr, perfResults);
-  ppc::core::Perf::print_perf_statistic(perfResults);
-}
\ No newline at end of file
+}  // namespace
+
+TEST(ustinov_a_spgemm_csc_complex_omp, test_pipeline_run_dft384x384) { runPerf(true); }
+
+TEST(ustinov_a_spgemm_csc_complex_omp, test_task_run_dft384x384) { runPerf(false); }
@@ -3,6 +3,8 @@
 
 #include <iostream>
 
+#include "core/gemm/include/complex_axpy.hpp"
+
 bool SpgemmCSCComplexOmpSeq::pre_processing() {
   internal_order_test();
 
@@ -187,4 +189,134 @@ bool SpgemmCSCComplexOmpPar::run() {
 bool SpgemmCSCComplexOmpPar::post_processing() {
   internal_order_test();
   return true;
-}
\ No newline at end of file
+}
+sparse_matrix_soa sparse_matrix_to_soa(const sparse_matrix& M) {
+  sparse_matrix_soa res(M.row_num, M.col_num, M.nonzeros);
+  res.col_ptr = M.col_ptr;
+  res.rows = M.rows;
+  for (int i = 0; i < M.nonzeros; ++i) {
+    res.re[i] = M.values[i].real();
+    res.im[i] = M.values[i].imag();
+  }
+  return res;
+}
+
+sparse_matrix sparse_matrix_from_soa(const sparse_matrix_soa& M) {
+  sparse_matrix res(M.row_num, M.col_num, M.nonzeros);
+  res.col_ptr = M.col_ptr;
+  res.rows = M.rows;
+  for (int i = 0; i < M.nonzeros; ++i) {
+    res.values[i] = {M.re[i], M.im[i]};
+  }
+  return res;
+}
+
+bool SpgemmCSCComplexOmpSoA::pre_processing() {
+  internal_order_test();
+
+  A = reinterpret_cast<sparse_matrix_soa*>(taskData->inputs[0]);
+  B = reinterpret_cast<sparse_matrix_soa*>(taskData->inputs[1]);
+  C = reinterpret_cast<sparse_matrix_soa*>(taskData->outputs[0]);
+  return true;
+}
+
+bool SpgemmCSCComplexOmpSoA::validation() {
+  internal_order_test();
+  int A_col_num = reinterpret_cast<sparse_matrix_soa*>(taskData->inputs[0])->col_num;
+  int B_row_num = reinterpret_cast<sparse_matrix_soa*>(taskData->inputs[1])->row_num;
+  // check that matrices are compatible for multiplication
+  return (A_col_num == B_row_num);
+}
+
+bool SpgemmCSCComplexOmpSoA::run() {
+  internal_order_test();
+
+  // symbolic stage
+  C->row_num = A->row_num;
+  C->col_num = B->col_num;
+  C->col_ptr.resize(C->col_num + 1);
+  C->col_ptr[0] = 0;
+
+#pragma omp parallel
+  {
+    std::vector<int> present_elements(C->row_num);
+#pragma omp for schedule(dynamic, 64)
+    for (int b_col = 0; b_col < C->col_num; ++b_col) {
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        present_elements[c_row] = 0;
+      }
+      for (int b_idx = B->col_ptr[b_col]; b_idx < B->col_ptr[b_col + 1]; ++b_idx) {
+        int b_row = B->rows[b_idx];
+        for (int a_idx = A->col_ptr[b_row]; a_idx < A->col_ptr[b_row + 1]; ++a_idx) {
+          present_elements[A->rows[a_idx]] = 1;
+        }
+      }
+      int col_nonzero_count = 0;
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        col_nonzero_count += present_elements[c_row];
+      }
+      C->col_ptr[b_col + 1] = col_nonzero_count;
+    }
+
+#pragma omp single
+    {
+      // allocate memory for matrix C
+      for (int c_col = 0; c_col < C->col_num; ++c_col) {
+        C->col_ptr[c_col + 1] += C->col_ptr[c_col];
+      }
+      int total_nonzeros = C->col_ptr[C->col_num];
+      C->nonzeros = total_nonzeros;
+      C->rows.resize(total_nonzeros);
+      C->re.resize(total_nonzeros);
+      C->im.resize(total_nonzeros);
+    }
+
+    // numeric stage
+    std::vector<double> acc_re(C->row_num);
+    std::vector<double> acc_im(C->row_num);
+    const int* a_rows = A->rows.data();
+    const double* a_re = A->re.data();
+    const double* a_im = A->im.data();
+    double* c_re = acc_re.data();
+    double* c_im = acc_im.data();
+#pragma omp for schedule(dynamic, 64)
+    for (int b_col = 0; b_col < C->col_num; ++b_col) {
+      // set accumulator values to zero
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        c_re[c_row] = 0.0;
+        c_im[c_row] = 0.0;
+        present_elements[c_row] = 0;
+      }
+      // calculate column into accumulator
+      for (int b_idx = B->col_ptr[b_col]; b_idx < B->col_ptr[b_col + 1]; ++b_idx) {
+        int b_row = B->rows[b_idx];
+        const double b_re = B->re[b_idx];
+        const double b_im = B->im[b_idx];
+        const int a_begin = A->col_ptr[b_row];
+        const int a_end = A->col_ptr[b_row + 1];
+        for (int a_idx = a_begin; a_idx < a_end; ++a_idx) {
+          present_elements[a_rows[a_idx]] = 1;
+        }
+        // a row repeated within a column of A adds up, as in SpgemmCSCComplexOmpSeq
+        ppc::core::complexAxpyScatter(b_re, b_im, a_re + a_begin, a_im + a_begin, a_rows + a_begin, a_end - a_begin,
+                                      c_re, c_im);
+      }
+      // write column into matrix C
+      int c_pos = C->col_ptr[b_col];
+      for (int c_row = 0; c_row < C->row_num; ++c_row) {
+        if (present_elements[c_row] != 0) {
+          C->rows[c_pos] = c_row;
+          C->re[c_pos] = c_re[c_row];
+          C->im[c_pos++] = c_im[c_row];
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool SpgemmCSCComplexOmpSoA::post_processing() {
+  internal_order_test();
+  return true;
+}
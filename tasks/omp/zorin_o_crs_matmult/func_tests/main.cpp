@@ -1,9 +1,14 @@
 // Copyright 2024 Zorin Oleg
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
 #include <vector>
 
 #include "omp/zorin_o_crs_matmult/include/crs_matmult_omp.hpp"
+#include "omp/zorin_o_crs_matmult/include/crs_matrix_io.hpp"
 
 TEST(Zorin_O_CRS_MatMult_OMP, incorrect_matrix_sizes) {
   // Create data
@@ -245,4 +250,386 @@ TEST(Zorin_O_CRS_MatMult_OMP, special_matmult) {
         EXPECT_DOUBLE_EQ(out[i * r + j], 0.0);
     }
   }
-}
\ No newline at end of file
+}
+TEST(Zorin_O_CRS_MatMult_OMP, read_matrix_market_symmetric) {
+  std::string path = (std::filesystem::path() / PATH_TO_PPC_PROJECT / "tasks" / "omp" / "zorin_o_crs_matmult" /
+                      "data" / "sample_symmetric.mtx")
+                         .string();
+  std::vector<double> dense{
+      4, -1, 0, 0, -1, 4, -1, 0, 0, -1, 4, 0, 0, 0, 0, 2.5,
+  };
+  CRSMatrix expected(dense.data(), 4, 4);
+
+  CRSMatrix matrix = readMatrixMarket(path);
+  EXPECT_EQ(matrix.n_rows, 4);
+  EXPECT_EQ(matrix.n_cols, 4);
+  EXPECT_EQ(matrix.row_ptr, expected.row_ptr);
+  EXPECT_EQ(matrix.col_index, expected.col_index);
+  EXPECT_EQ(matrix.values, expected.values);
+}
+
+TEST(Zorin_O_CRS_MatMult_OMP, read_matrix_market_general_and_pattern) {
+  std::string path = (std::filesystem::temp_directory_path() / "zorin_o_omp_general.mtx").string();
+  {
+    std::ofstream out(path);
+    out << "%%MatrixMarket matrix coordinate real general\n3 4 4\n3 1 -2.5e0\n1 4 7\n1 2 +1.5\n\n2 3 3\n";
+  }
+  CRSMatrix matrix = readMatrixMarket(path);
+  EXPECT_EQ(matrix.row_ptr, std::vector<int>({0, 2, 3, 4}));
+  EXPECT_EQ(matrix.col_index, std::vector<int>({1, 3, 2, 0}));
+  EXPECT_EQ(matrix.values, std::vector<double>({1.5, 7.0, 3.0, -2.5}));
+
+  {
+    std::ofstream out(path);
+    out << "%%MatrixMarket matrix coordinate pattern skew-symmetric\n2 2 1\n2 1\n";
+  }
+  matrix = readMatrixMarket(path);
+  EXPECT_EQ(matrix.row_ptr, std::vector<int>({0, 1, 2}));
+  EXPECT_EQ(matrix.col_index, std::vector<int>({1, 0}));
+  EXPECT_EQ(matrix.values, std::vector<double>({-1.0, 1.0}));
+
+  {
+    std::ofstream out(path);
+    out << "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n";
+  }
+  EXPECT_THROW(readMatrixMarket(path), std::runtime_error);
+
+  {
+    std::ofstream out(path);
+    out << "%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1.0\n3 1 1.0\n";
+  }
+  EXPECT_THROW(readMatrixMarket(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(Zorin_O_CRS_MatMult_OMP, sparse_file_roundtrip) {
+  std::vector<double> dense = getRandomMatrix(13, 7);
+  CRSMatrix matrix(dense.data(), 13, 7);
+  std::string path = (std::filesystem::temp_directory_path() / "zorin_o_omp_roundtrip.spm").string();
+
+  saveSparseMatrix(path, getView(matrix));
+  {
+    SparseMatrixFile file(path);
+    SparseMatrixView view = file.view();
+    ASSERT_EQ(file.layout(), SparseLayout::CRS);
+    ASSERT_EQ(file.nnz(), static_cast<int64_t>(matrix.values.size()));
+    EXPECT_EQ(view.n_rows, 13);
+    EXPECT_EQ(view.n_cols, 7);
+    EXPECT_EQ(std::vector<int>(view.ptr, view.ptr + 14), matrix.row_ptr);
+    EXPECT_EQ(std::vector<int>(view.index, view.index + file.nnz()), matrix.col_index);
+    EXPECT_EQ(std::vector<double>(view.values, view.values + file.nnz()), matrix.values);
+  }
+
+  // 2x3 matrix [[1, 0, 2], [0, 3, 0]] stored by columns
+  std::vector<int> col_ptr{0, 1, 2, 3};
+  std::vector<int> row_index{0, 1, 0};
+  std::vector<double> values{1.0, 3.0, 2.0};
+  saveSparseMatrix(path, {2, 3, col_ptr.data(), row_index.data(), values.data(), SparseLayout::CCS});
+  {
+    SparseMatrixFile file(path);
+    SparseMatrixView view = file.view();
+    ASSERT_EQ(file.layout(), SparseLayout::CCS);
+    EXPECT_EQ(std::vector<int>(view.ptr, view.ptr + 4), col_ptr);
+    EXPECT_EQ(std::vector<int>(view.index, view.index + 3), row_index);
+    EXPECT_EQ(std::vector<double>(view.values, view.values + 3), values);
+
+    // a CCS view is not a CRS factor, even when its shape fits
+    CRSMatrix square(0, 0);
+    SparseMatrixView transposed = file.view();
+    transposed.n_rows = 3;
+    std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&view));
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&transposed));
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&square));
+    CRSMatMultSparse testTask(taskData);
+    EXPECT_FALSE(testTask.validation());
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(Zorin_O_CRS_MatMult_OMP, sparse_matmult_from_files) {
+  // Create data
+  int p = 17;
+  int q = 12;
+  int r = 9;
+  std::vector<double> lhs_in = getRandomMatrix(p, q);
+  std::vector<double> rhs_in = getRandomMatrix(q, r);
+  std::vector<double> out(p * r);
+  CRSMatrix lhs(lhs_in.data(), p, q);
+  CRSMatrix rhs(rhs_in.data(), q, r);
+  std::string lhs_path = (std::filesystem::temp_directory_path() / "zorin_o_omp_lhs.spm").string();
+  std::string rhs_path = (std::filesystem::temp_directory_path() / "zorin_o_omp_rhs.spm").string();
+  saveSparseMatrix(lhs_path, getView(lhs));
+  saveSparseMatrix(rhs_path, getView(rhs));
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(lhs_in.data()));
+  taskDataOMP->inputs_count.emplace_back(p);
+  taskDataOMP->inputs_count.emplace_back(q);
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(rhs_in.data()));
+  taskDataOMP->inputs_count.emplace_back(q);
+  taskDataOMP->inputs_count.emplace_back(r);
+  taskDataOMP->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataOMP->outputs_count.emplace_back(p);
+  taskDataOMP->outputs_count.emplace_back(r);
+
+  // Create Task
+  CRSMatMult testTaskOMP(taskDataOMP);
+  ASSERT_TRUE(testTaskOMP.validation());
+  ASSERT_TRUE(testTaskOMP.pre_processing());
+  ASSERT_TRUE(testTaskOMP.run());
+  ASSERT_TRUE(testTaskOMP.post_processing());
+
+  {
+    SparseMatrixFile lhs_file(lhs_path);
+    SparseMatrixFile rhs_file(rhs_path);
+    SparseMatrixView lhs_view = lhs_file.view();
+    SparseMatrixView rhs_view = rhs_file.view();
+    CRSMatrix res(0, 0);
+
+    // Create TaskData
+    std::shared_ptr<ppc::core::TaskData> taskDataSparse = std::make_shared<ppc::core::TaskData>();
+    taskDataSparse->inputs.emplace_back(reinterpret_cast<uint8_t *>(&lhs_view));
+    taskDataSparse->inputs.emplace_back(reinterpret_cast<uint8_t *>(&rhs_view));
+    taskDataSparse->outputs.emplace_back(reinterpret_cast<uint8_t *>(&res));
+
+    // Create Task
+    CRSMatMultSparse testTaskSparse(taskDataSparse);
+    ASSERT_TRUE(testTaskSparse.validation());
+    ASSERT_TRUE(testTaskSparse.pre_processing());
+    ASSERT_TRUE(testTaskSparse.run());
+    ASSERT_TRUE(testTaskSparse.post_processing());
+
+    ASSERT_EQ(res.n_rows, p);
+    ASSERT_EQ(res.n_cols, r);
+    std::vector<double> res_dense(p * r);
+    for (int i = 0; i < p; ++i) {
+      for (int j = res.row_ptr[i]; j < res.row_ptr[i + 1]; ++j) {
+        res_dense[i * r + res.col_index[j]] = res.values[j];
+      }
+    }
+    for (int i = 0; i < p * r; ++i) {
+      EXPECT_DOUBLE_EQ(res_dense[i], out[i]);
+    }
+  }
+  std::filesystem::remove(lhs_path);
+  std::filesystem::remove(rhs_path);
+}
+
+TEST(Zorin_O_CRS_MatMult_OMP, banded_matmult_from_mapped_file) {
+  // banded n x n matrix written as Matrix Market, no dense staging anywhere
+  int n = 3000;
+  int half_band = 8;
+  std::string mtx_path = (std::filesystem::temp_directory_path() / "zorin_o_omp_band.mtx").string();
+  std::string bin_path = (std::filesystem::temp_directory_path() / "zorin_o_omp_band.spm").string();
+  {
+    std::ofstream mtx(mtx_path);
+    int64_t nnz = 0;
+    for (int i = 0; i < n; ++i) nnz += std::min(n - 1, i + half_band) - std::max(0, i - half_band) + 1;
+    mtx << "%%MatrixMarket matrix coordinate real general\n" << n << " " << n << " " << nnz << "\n";
+    for (int i = 0; i < n; ++i) {
+      for (int j = std::max(0, i - half_band); j <= std::min(n - 1, i + half_band); ++j) {
+        mtx << i + 1 << " " << j + 1 << " 1.0\n";
+      }
+    }
+  }
+  saveSparseMatrix(bin_path, getView(readMatrixMarket(mtx_path)));
+  CRSMatrix res(0, 0);
+  {
+    SparseMatrixFile file(bin_path);
+    SparseMatrixView view = file.view();
+
+    // Create TaskData
+    std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
+    taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&view));
+    taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&view));
+    taskDataOMP->outputs.emplace_back(reinterpret_cast<uint8_t *>(&res));
+
+    // Create Task
+    CRSMatMultSparse testTaskOMP(taskDataOMP);
+    ASSERT_TRUE(testTaskOMP.validation());
+    ASSERT_TRUE(testTaskOMP.pre_processing());
+    ASSERT_TRUE(testTaskOMP.run());
+    ASSERT_TRUE(testTaskOMP.post_processing());
+  }
+  std::filesystem::remove(mtx_path);
+  std::filesystem::remove(bin_path);
+
+  // entry (i, j) of the square counts the k within half_band of both i and j
+  ASSERT_EQ(res.n_rows, n);
+  ASSERT_EQ(res.n_cols, n);
+  for (int i = 0; i < n; ++i) {
+    int first = std::max(0, i - 2 * half_band);
+    int last = std::min(n - 1, i + 2 * half_band);
+    ASSERT_EQ(res.row_ptr[i + 1] - res.row_ptr[i], last - first + 1) << i;
+    for (int k = res.row_ptr[i]; k < res.row_ptr[i + 1]; ++k) {
+      int j = res.col_index[k];
+      int count =
+          std::min({n - 1, i + half_band, j + half_band}) - std::max({0, i - half_band, j - half_band}) + 1;
+      ASSERT_EQ(j, first + k - res.row_ptr[i]);
+      ASSERT_DOUBLE_EQ(res.values[k], count) << i << " " << j;
+    }
+  }
+}
+
+namespace {
+
+std::vector<double> toDense(const CRSMatrix &matrix) {
+  std::vector<double> dense(matrix.n_rows * matrix.n_cols);
+  for (int i = 0; i < matrix.n_rows; ++i) {
+    for (int j = matrix.row_ptr[i]; j < matrix.row_ptr[i + 1]; ++j) {
+      dense[i * matrix.n_cols + matrix.col_index[j]] = matrix.values[j];
+    }
+  }
+  return dense;
+}
+
+}  // namespace
+
+TEST(Zorin_O_CRS_MatMult_OMP, planned_matmult_reuses_pattern) {
+  // Create data
+  int p = 23;
+  int q = 31;
+  int r = 19;
+  CRSMatrix lhs(getRandomMatrix(p, q, 0.2).data(), p, q);
+  CRSMatrix rhs(getRandomMatrix(q, r, 0.2).data(), q, r);
+  SparseMatrixView lhs_view = getView(lhs);
+  SparseMatrixView rhs_view = getView(rhs);
+  CRSMultPlan plan(lhs_view, rhs_view);
+
+  for (int iteration = 0; iteration < 3; ++iteration) {
+    CRSMatrix expected(0, 0);
+    multiplyCRS(lhs_view, rhs_view, expected);
+    CRSMatrix res(0, 0);
+
+    // Create TaskData
+    std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
+    taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&plan));
+    taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&lhs_view));
+    taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&rhs_view));
+    taskDataOMP->outputs.emplace_back(reinterpret_cast<uint8_t *>(&res));
+
+    // Create Task
+    CRSMatMultPlanned testTaskOMP(taskDataOMP);
+    ASSERT_TRUE(testTaskOMP.validation());
+    ASSERT_TRUE(testTaskOMP.pre_processing());
+    ASSERT_TRUE(testTaskOMP.run());
+    ASSERT_TRUE(testTaskOMP.post_processing());
+
+    ASSERT_EQ(res.row_ptr.back(), plan.nnz());
+    std::vector<double> res_dense = toDense(res);
+    std::vector<double> expected_dense = toDense(expected);
+    for (int i = 0; i < p * r; ++i) {
+      EXPECT_NEAR(res_dense[i], expected_dense[i], 1e-9 * std::max(1.0, std::abs(expected_dense[i])));
+    }
+
+    // same patterns, new values
+    for (auto &value : lhs.values) value = value * 0.5 - iteration;
+    for (auto &value : rhs.values) value += 1.0;
+  }
+}
+
+TEST(Zorin_O_CRS_MatMult_OMP, planned_banded_square) {
+  // banded n x n matrix squared with the symbolic work done once
+  int n = 5000;
+  int half_band = 8;
+  CRSMatrix band(n, n);
+  band.row_ptr.push_back(0);
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - half_band); j <= std::min(n - 1, i + half_band); ++j) {
+      band.col_index.push_back(j);
+      band.values.push_back(1.0);
+    }
+    band.row_ptr.push_back(static_cast<int>(band.values.size()));
+  }
+  SparseMatrixView view = getView(band);
+  CRSMultPlan plan(view, view);
+  CRSMatrix expected(0, 0);
+  multiplyCRS(view, view, expected);
+  CRSMatrix res(0, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&plan));
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&view));
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&view));
+  taskDataOMP->outputs.emplace_back(reinterpret_cast<uint8_t *>(&res));
+
+  // Create Task
+  CRSMatMultPlanned testTaskOMP(taskDataOMP);
+  ASSERT_TRUE(testTaskOMP.validation());
+  ASSERT_TRUE(testTaskOMP.pre_processing());
+  ASSERT_TRUE(testTaskOMP.run());
+  ASSERT_TRUE(testTaskOMP.post_processing());
+
+  ASSERT_EQ(res.n_rows, n);
+  EXPECT_DOUBLE_EQ(res.values[res.row_ptr[n / 2] + 2 * half_band], 2 * half_band + 1.0);
+  EXPECT_EQ(res.row_ptr[n / 2 + 1] - res.row_ptr[n / 2], 4 * half_band + 1);
+  EXPECT_EQ(res.row_ptr, expected.row_ptr);
+  EXPECT_EQ(res.col_index, expected.col_index);
+  EXPECT_EQ(res.values, expected.values);
+}
+
+TEST(Zorin_O_CRS_MatMult_OMP, masked_matmult) {
+  // Create data
+  int p = 20;
+  int q = 15;
+  int r = 25;
+  CRSMatrix lhs(getRandomMatrix(p, q, 0.3).data(), p, q);
+  CRSMatrix rhs(getRandomMatrix(q, r, 0.3).data(), q, r);
+  CRSMatrix mask(getRandomMatrix(p, r, 0.2).data(), p, r);
+  CRSMultPlan plan(getView(lhs), getView(rhs), getView(mask));
+  CRSMatrix res(0, 0);
+  plan.multiply(lhs.values.data(), rhs.values.data(), res);
+
+  CRSMatrix full(0, 0);
+  multiplyCRS(getView(lhs), getView(rhs), full);
+  std::vector<double> full_dense = toDense(full);
+  std::vector<double> mask_dense = toDense(mask);
+  std::vector<double> res_dense = toDense(res);
+  for (int i = 0; i < p * r; ++i) {
+    EXPECT_NEAR(res_dense[i], mask_dense[i] != 0.0 ? full_dense[i] : 0.0,
+                1e-9 * std::max(1.0, std::abs(full_dense[i])));
+  }
+  for (int i = 0; i < p; ++i) {
+    for (int j = res.row_ptr[i]; j < res.row_ptr[i + 1]; ++j) {
+      EXPECT_NE(mask_dense[i * r + res.col_index[j]], 0.0);
+    }
+  }
+}
+
+TEST(Zorin_O_CRS_MatMult_OMP, planned_matmult_other_pattern) {
+  // Create data
+  CRSMatrix lhs(getIdentityMatrix(6).data(), 6, 6);
+  CRSMatrix rhs(getRandomMatrix(6, 4).data(), 6, 4);
+  CRSMatrix other(getRandomMatrix(6, 4, 0.9).data(), 6, 4);
+  other.col_index[0] = (other.col_index[0] + 1) % 4;
+  SparseMatrixView lhs_view = getView(lhs);
+  SparseMatrixView other_view = getView(other);
+  CRSMultPlan plan(lhs_view, getView(rhs));
+  CRSMatrix res(0, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&plan));
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&lhs_view));
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&other_view));
+  taskDataOMP->outputs.emplace_back(reinterpret_cast<uint8_t *>(&res));
+
+  // Create Task
+  CRSMatMultPlanned testTaskOMP(taskDataOMP);
+  ASSERT_FALSE(testTaskOMP.validation());
+  ASSERT_ANY_THROW(CRSMultPlan(lhs_view, getView(rhs), lhs_view));
+
+  // same shape and nonzero count: a copy of the planned pattern is accepted, a moved column is not
+  std::vector<int> ptr{0, 1, 2};
+  std::vector<int> planned_cols{0, 1};
+  std::vector<int> copied_cols = planned_cols;
+  std::vector<int> moved_cols{2, 1};
+  std::vector<double> values{1.0, 2.0};
+  const SparseMatrixView eye = {2, 2, ptr.data(), planned_cols.data(), values.data()};
+  CRSMultPlan small_plan(eye, {2, 3, ptr.data(), planned_cols.data(), values.data()});
+  EXPECT_TRUE(small_plan.matches(eye, {2, 3, ptr.data(), copied_cols.data(), values.data()}));
+  EXPECT_FALSE(small_plan.matches(eye, {2, 3, ptr.data(), moved_cols.data(), values.data()}));
+}
@@ -5,6 +5,7 @@
 
 #include "core/task/include/task.hpp"
 #include "crs_matrix.hpp"
+#include "omp/zorin_o_crs_matmult/include/crs_mult_plan.hpp"
 
 class CRSMatMult : public ppc::core::Task {
   std::unique_ptr<CRSMatrix> A;
@@ -18,3 +19,34 @@ class CRSMatMult : public ppc::core::Task {
   bool run() override;
   bool post_processing() override;
 };
+
+// Takes both factors as CRS views (e.g. mapped from SparseMatrixFile) and keeps the product sparse
+class CRSMatMultSparse : public ppc::core::Task {
+  const SparseMatrixView* A{};
+  const SparseMatrixView* B{};
+  CRSMatrix* C{};
+
+ public:
+  explicit CRSMatMultSparse(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+};
+
+// Numeric-only product: inputs are a CRSMultPlan and views of A and B with the planned patterns
+class CRSMatMultPlanned : public ppc::core::Task {
+  const CRSMultPlan* plan{};
+  const SparseMatrixView* A{};
+  const SparseMatrixView* B{};
+  CRSMatrix* C{};
+
+ public:
+  explicit CRSMatMultPlanned(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+};
+
+void multiplyCRS(const SparseMatrixView& A, const SparseMatrixView& B, CRSMatrix& C);
@@ -6,6 +6,8 @@
 #include <random>
 #include <vector>
 
+#include "core/io/include/sparse_file.hpp"
+
 #define EPS 1e-8
 
 struct CRSMatrix {
@@ -19,6 +21,22 @@ struct CRSMatrix {
   CRSMatrix(const double* matrix, int n_rows, int n_cols);
 };
 
+using ppc::core::SparseLayout;
+
+// Read-only compressed matrix that does not own its arrays.
+// For CRS `ptr` has n_rows + 1 entries and `index` holds columns,
+// for CCS `ptr` has n_cols + 1 entries and `index` holds rows.
+struct SparseMatrixView {
+  int n_rows;
+  int n_cols;
+  const int* ptr;
+  const int* index;
+  const double* values;
+  SparseLayout layout = SparseLayout::CRS;
+};
+
+SparseMatrixView getView(const CRSMatrix& matrix);
+
 std::vector<double> getRandomMatrix(const int& n_rows, const int& n_cols, const double& density = 0.3,
                                     const double& a = 1.0, const double& b = 100.0);
 
@@ -0,0 +1,35 @@
+// Copyright 2024 Zorin Oleg
+
+#ifndef TASKS_OMP_ZORIN_O_CRS_MATMULT_INCLUDE_CRS_MATRIX_IO_HPP_
+#define TASKS_OMP_ZORIN_O_CRS_MATMULT_INCLUDE_CRS_MATRIX_IO_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/io/include/sparse_file.hpp"
+#include "omp/zorin_o_crs_matmult/include/crs_matrix.hpp"
+
+// Matrices are stored in the ppc::core sparse file format (core/io/include/sparse_file.hpp).
+void saveSparseMatrix(const std::string& path, const SparseMatrixView& matrix);
+
+// Maps a sparse file, which is checked on open. Index and values are used from the mapping;
+// the 64-bit pointers are narrowed into an owned copy, so the file must have fewer than 2^31 nonzeros.
+class SparseMatrixFile {
+ public:
+  explicit SparseMatrixFile(const std::string& path);
+
+  [[nodiscard]] SparseLayout layout() const { return file.layout(); }
+  [[nodiscard]] int64_t nnz() const { return file.header().nnz; }
+  [[nodiscard]] SparseMatrixView view() const;
+
+ private:
+  ppc::core::SparseFile file;
+  std::vector<int> ptr;
+};
+
+// Reads a coordinate Matrix Market file (real, integer or pattern; general, symmetric or
+// skew-symmetric) straight into CRS with sorted columns. The body is parsed in parallel.
+CRSMatrix readMatrixMarket(const std::string& path);
+
+#endif  // TASKS_OMP_ZORIN_O_CRS_MATMULT_INCLUDE_CRS_MATRIX_IO_HPP_
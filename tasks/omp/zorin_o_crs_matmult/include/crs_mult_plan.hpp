@@ -0,0 +1,59 @@
+// Copyright 2024 Zorin Oleg
+
+#ifndef TASKS_OMP_ZORIN_O_CRS_MATMULT_INCLUDE_CRS_MULT_PLAN_HPP_
+#define TASKS_OMP_ZORIN_O_CRS_MATMULT_INCLUDE_CRS_MULT_PLAN_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "omp/zorin_o_crs_matmult/include/crs_matrix.hpp"
+
+// Symbolic part of C = A * B, computed once for fixed patterns of A and B.
+// For every product A[i][k] * B[k][j] the plan stores the slot of C(i, j) in C.values,
+// so a numeric multiply is a single pass of fused multiply-adds with no column work.
+// With a mask only the positions of the mask pattern are produced (masked SpGEMM),
+// products that fall outside the mask get slot -1 and are skipped.
+// Unlike multiplyCRS, C keeps its full structural pattern: cancelled values stay as zeros.
+// The plan serves the products of this task only; the other CRS tasks keep their one-shot products.
+class CRSMultPlan {
+ public:
+  // Shape, nonzero count and a 64-bit hash of ptr and index: equal patterns always give equal
+  // fingerprints, and a changed pattern is caught without keeping or rereading a copy of it.
+  struct Fingerprint {
+    int n_rows;
+    int n_cols;
+    int64_t nnz;
+    uint64_t hash;
+
+    bool operator==(const Fingerprint&) const = default;
+  };
+  static Fingerprint fingerprint(const SparseMatrixView& matrix);
+
+  CRSMultPlan(const SparseMatrixView& A, const SparseMatrixView& B);
+  CRSMultPlan(const SparseMatrixView& A, const SparseMatrixView& B, const SparseMatrixView& mask);
+
+  // A and B must have the patterns the plan was built from, only the values may change. Shapes and
+  // nonzero counts are compared first; only views that agree on them are hashed.
+  [[nodiscard]] bool matches(const SparseMatrixView& A, const SparseMatrixView& B) const;
+  void multiply(const double* a_values, const double* b_values, CRSMatrix& C) const;
+
+  [[nodiscard]] int64_t nnz() const { return row_ptr.back(); }
+  [[nodiscard]] int64_t products() const { return product_ptr.back(); }
+
+ private:
+  void build(const SparseMatrixView& A, const SparseMatrixView& B, const SparseMatrixView* mask);
+
+  int n_rows;
+  int n_cols;
+  Fingerprint a_key;
+  Fingerprint b_key;
+  std::vector<int> a_ptr;
+  std::vector<int> a_index;
+  std::vector<int> b_ptr;
+  std::vector<int> row_ptr;
+  std::vector<int> col_index;
+  std::vector<int64_t> product_ptr;  // first product of every row of A in slot
+  std::vector<int> slot;
+};
+
+#endif  // TASKS_OMP_ZORIN_O_CRS_MATMULT_INCLUDE_CRS_MULT_PLAN_HPP_
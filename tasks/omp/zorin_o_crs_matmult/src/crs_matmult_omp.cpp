@@ -1,6 +1,10 @@
 // Copyright 2024 Zorin Oleg
 #include "omp/zorin_o_crs_matmult/include/crs_matmult_omp.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
 bool CRSMatMult::validation() {
   internal_order_test();
 
@@ -23,38 +27,7 @@ bool CRSMatMult::pre_processing() {
 
 bool CRSMatMult::run() {
   internal_order_test();
-  std::vector<std::vector<double>> all_value(A->n_rows);
-  std::vector<std::vector<int>> all_col_index(A->n_rows);
-
-#pragma omp parallel for default(none) shared(all_value, all_col_index) schedule(static)
-  for (int row_i = 0; row_i < A->n_rows; ++row_i) {
-    std::vector<double> local_row(C->n_cols);
-    for (int i = A->row_ptr[row_i]; i < A->row_ptr[row_i + 1]; ++i) {
-      const int& col_i = A->col_index[i];
-      const double& val = A->values[i];
-
-      for (int j = B->row_ptr[col_i]; j < B->row_ptr[col_i + 1]; ++j) {
-        local_row[B->col_index[j]] += val * B->values[j];
-      }
-    }
-
-    for (int i = 0; i < C->n_cols; ++i) {
-      double& val = local_row[i];
-      if (std::abs(val) > EPS) {
-        all_col_index[row_i].emplace_back(i);
-        all_value[row_i].emplace_back(val);
-        val = 0.0;
-      }
-    }
-  }
-
-  for (int i = 0; i < C->n_rows; ++i) {
-    C->row_ptr.emplace_back(static_cast<int>(C->values.size()));
-    C->col_index.insert(C->col_index.cend(), all_col_index[i].begin(), all_col_index[i].end());
-    C->values.insert(C->values.cend(), all_value[i].begin(), all_value[i].end());
-  }
-  C->row_ptr.emplace_back(static_cast<int>(C->values.size()));
-
+  multiplyCRS(getView(*A), getView(*B), *C);
   return true;
 }
 
@@ -70,3 +43,144 @@ bool CRSMatMult::post_processing() {
 
   return true;
 }
+
+bool CRSMatMultSparse::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->outputs.size() != 1) return false;
+  const auto* lhs = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[0]);
+  const auto* rhs = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[1]);
+  return lhs != nullptr && rhs != nullptr && taskData->outputs[0] != nullptr && lhs->layout == SparseLayout::CRS &&
+         rhs->layout == SparseLayout::CRS && lhs->n_cols == rhs->n_rows;
+}
+
+bool CRSMatMultSparse::pre_processing() {
+  internal_order_test();
+
+  A = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[0]);
+  B = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[1]);
+  C = reinterpret_cast<CRSMatrix*>(taskData->outputs[0]);
+  return true;
+}
+
+bool CRSMatMultSparse::run() {
+  internal_order_test();
+  multiplyCRS(*A, *B, *C);
+  return true;
+}
+
+bool CRSMatMultSparse::post_processing() {
+  internal_order_test();
+  return true;
+}
+
+bool CRSMatMultPlanned::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 3 || taskData->outputs.size() != 1) return false;
+  const auto* planned = reinterpret_cast<const CRSMultPlan*>(taskData->inputs[0]);
+  const auto* lhs = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[1]);
+  const auto* rhs = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[2]);
+  return planned != nullptr && lhs != nullptr && rhs != nullptr && taskData->outputs[0] != nullptr &&
+         lhs->layout == SparseLayout::CRS && rhs->layout == SparseLayout::CRS && planned->matches(*lhs, *rhs);
+}
+
+bool CRSMatMultPlanned::pre_processing() {
+  internal_order_test();
+
+  plan = reinterpret_cast<const CRSMultPlan*>(taskData->inputs[0]);
+  A = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[1]);
+  B = reinterpret_cast<const SparseMatrixView*>(taskData->inputs[2]);
+  C = reinterpret_cast<CRSMatrix*>(taskData->outputs[0]);
+  return true;
+}
+
+bool CRSMatMultPlanned::run() {
+  internal_order_test();
+  plan->multiply(A->values, B->values, *C);
+  return true;
+}
+
+bool CRSMatMultPlanned::post_processing() {
+  internal_order_test();
+  return true;
+}
+
+void multiplyCRS(const SparseMatrixView& A, const SparseMatrixView& B, CRSMatrix& C) {
+  C.n_rows = A.n_rows;
+  C.n_cols = B.n_cols;
+  C.row_ptr.clear();
+  C.col_index.clear();
+  C.values.clear();
+  std::vector<std::vector<double>> all_value(A.n_rows);
+  std::vector<std::vector<int>> all_col_index(A.n_rows);
+
+#pragma omp parallel default(none) shared(A, B, C, all_value, all_col_index)
+  {
+    // dense accumulator per thread; short rows track their columns instead of scanning all of them
+    std::vector<double> local_row(C.n_cols);
+    std::vector<char> touched(C.n_cols);
+    std::vector<int> touched_cols;
+#pragma omp for schedule(static)
+    for (int row_i = 0; row_i < A.n_rows; ++row_i) {
+      int64_t row_flops = 0;
+      for (int i = A.ptr[row_i]; i < A.ptr[row_i + 1]; ++i) {
+        row_flops += B.ptr[A.index[i] + 1] - B.ptr[A.index[i]];
+      }
+
+      if (row_flops * 4 >= C.n_cols) {
+        for (int i = A.ptr[row_i]; i < A.ptr[row_i + 1]; ++i) {
+          const int& col_i = A.index[i];
+          const double& val = A.values[i];
+
+          for (int j = B.ptr[col_i]; j < B.ptr[col_i + 1]; ++j) {
+            local_row[B.index[j]] += val * B.values[j];
+          }
+        }
+
+        for (int i = 0; i < C.n_cols; ++i) {
+          double& val = local_row[i];
+          if (std::abs(val) > EPS) {
+            all_col_index[row_i].emplace_back(i);
+            all_value[row_i].emplace_back(val);
+          }
+          val = 0.0;
+        }
+        continue;
+      }
+
+      for (int i = A.ptr[row_i]; i < A.ptr[row_i + 1]; ++i) {
+        const int& col_i = A.index[i];
+        const double& val = A.values[i];
+
+        for (int j = B.ptr[col_i]; j < B.ptr[col_i + 1]; ++j) {
+          const int& col_j = B.index[j];
+          local_row[col_j] += val * B.values[j];
+          if (touched[col_j] == 0) {
+            touched[col_j] = 1;
+            touched_cols.emplace_back(col_j);
+          }
+        }
+      }
+
+      std::sort(touched_cols.begin(), touched_cols.end());
+      for (const int& i : touched_cols) {
+        double& val = local_row[i];
+        if (std::abs(val) > EPS) {
+          all_col_index[row_i].emplace_back(i);
+          all_value[row_i].emplace_back(val);
+        }
+        val = 0.0;
+        touched[i] = 0;
+      }
+      touched_cols.clear();
+    }
+  }
+
+  for (int i = 0; i < C.n_rows; ++i) {
+    C.row_ptr.emplace_back(static_cast<int>(C.values.size()));
+    C.col_index.insert(C.col_index.cend(), all_col_index[i].begin(), all_col_index[i].end());
+    C.values.insert(C.values.cend(), all_value[i].begin(), all_value[i].end());
+  }
+  C.row_ptr.emplace_back(static_cast<int>(C.values.size()));
+}
@@ -21,6 +21,10 @@ CRSMatrix::CRSMatrix(const double* matrix, int n_rows, int n_cols) : CRSMatrix(n
   row_ptr.emplace_back(static_cast<int>(values.size()));
 }
 
+SparseMatrixView getView(const CRSMatrix& matrix) {
+  return {matrix.n_rows, matrix.n_cols, matrix.row_ptr.data(), matrix.col_index.data(), matrix.values.data()};
+}
+
 std::vector<double> getRandomMatrix(const int& n_rows, const int& n_cols, const double& density, const double& a,
                                     const double& b) {
   std::random_device rd;
@@ -0,0 +1,171 @@
+// Copyright 2024 Zorin Oleg
+
+#include "omp/zorin_o_crs_matmult/include/crs_matrix_io.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct MMEntry {
+  int row;
+  int col;
+  double value;
+};
+
+const char* skipBlanks(const char* pos, const char* end) {
+  while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) ++pos;
+  return pos;
+}
+
+const char* nextLine(const char* pos, const char* end) {
+  pos = std::find(pos, end, '\n');
+  return pos < end ? pos + 1 : end;
+}
+
+template <class T>
+const char* parseNumber(const char* pos, const char* end, T& value) {
+  pos = skipBlanks(pos, end);
+  if (pos < end && *pos == '+') ++pos;
+  auto [ptr, ec] = std::from_chars(pos, end, value);
+  return ec == std::errc() ? ptr : nullptr;
+}
+
+std::string toLower(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+  return str;
+}
+
+}  // namespace
+
+void saveSparseMatrix(const std::string& path, const SparseMatrixView& matrix) {
+  ppc::core::writeSparseFile(path, matrix.layout, matrix.n_rows, matrix.n_cols, matrix.ptr, matrix.index,
+                             matrix.values);
+}
+
+SparseMatrixFile::SparseMatrixFile(const std::string& path) : file(path) {
+  if (file.header().nnz > std::numeric_limits<int>::max()) {
+    throw std::runtime_error("Too many nonzeros for 32-bit pointers in " + path);
+  }
+  const int64_t* file_ptr = file.ptr();
+  ptr.assign(file_ptr, file_ptr + file.header().nMajor() + 1);
+}
+
+SparseMatrixView SparseMatrixFile::view() const {
+  return {static_cast<int>(file.header().n_rows), static_cast<int>(file.header().n_cols), ptr.data(), file.index(),
+          file.values(), layout()};
+}
+
+CRSMatrix readMatrixMarket(const std::string& path) {
+  const uint64_t file_size = std::filesystem::file_size(path);
+  ppc::core::MappedFile file(path, 0, file_size, false);
+  const char* pos = reinterpret_cast<const char*>(file.data());
+  const char* end = pos + file_size;
+
+  const char* line_end = nextLine(pos, end);
+  std::istringstream banner(std::string(pos, line_end));
+  std::string tag, object, format, field, symmetry;
+  banner >> tag >> object >> format >> field >> symmetry;
+  field = toLower(field);
+  symmetry = toLower(symmetry);
+  if (tag != "%%MatrixMarket" || toLower(object) != "matrix" || toLower(format) != "coordinate" ||
+      (field != "real" && field != "double" && field != "integer" && field != "pattern") ||
+      (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric")) {
+    throw std::runtime_error("Unsupported Matrix Market header in " + path);
+  }
+  const bool pattern = field == "pattern";
+  const bool mirrored = symmetry != "general";
+  const double mirror_sign = symmetry == "skew-symmetric" ? -1.0 : 1.0;
+
+  // comments and blank lines before the size line
+  pos = line_end;
+  while (pos < end) {
+    const char* first = skipBlanks(pos, end);
+    if (first < end && *first != '%' && *first != '\n') break;
+    pos = nextLine(pos, end);
+  }
+  int n_rows = 0;
+  int n_cols = 0;
+  int64_t declared = 0;
+  const char* body = nullptr;
+  if ((body = parseNumber(pos, end, n_rows)) == nullptr || (body = parseNumber(body, end, n_cols)) == nullptr ||
+      (body = parseNumber(body, end, declared)) == nullptr) {
+    throw std::runtime_error("Bad Matrix Market size line in " + path);
+  }
+  body = nextLine(body, end);
+
+  // every thread parses the lines that start inside its share of the body
+  const int num_threads = omp_get_max_threads();
+  std::vector<const char*> starts(num_threads + 1, end);
+  starts[0] = body;
+  for (int t = 1; t < num_threads; ++t) {
+    const char* guess = body + (end - body) * t / num_threads;
+    starts[t] = std::max(starts[t - 1], guess == body || guess[-1] == '\n' ? guess : nextLine(guess, end));
+  }
+  std::vector<std::vector<MMEntry>> entries(num_threads);
+  std::vector<int64_t> parsed(num_threads, 0);
+  bool failed = false;
+
+#pragma omp parallel num_threads(num_threads)
+  {
+    const int t = omp_get_thread_num();
+    std::vector<MMEntry>& local = entries[t];
+    for (const char* line = starts[t]; line < starts[t + 1]; line = nextLine(line, end)) {
+      const char* p = skipBlanks(line, end);
+      if (p == end || *p == '\n' || *p == '%') continue;
+      MMEntry e{0, 0, 1.0};
+      if ((p = parseNumber(p, end, e.row)) == nullptr || (p = parseNumber(p, end, e.col)) == nullptr ||
+          (!pattern && parseNumber(p, end, e.value) == nullptr) || e.row < 1 || e.row > n_rows || e.col < 1 ||
+          e.col > n_cols) {
+#pragma omp atomic write
+        failed = true;
+        break;
+      }
+      --e.row;
+      --e.col;
+      local.push_back(e);
+      ++parsed[t];
+      if (mirrored && e.row != e.col) local.push_back({e.col, e.row, mirror_sign * e.value});
+    }
+  }
+  int64_t total_parsed = 0;
+  for (int64_t count : parsed) total_parsed += count;
+  if (failed || total_parsed != declared) {
+    throw std::runtime_error("Bad Matrix Market entries in " + path);
+  }
+
+  // counting sort of the entries by row, then columns are sorted inside every row
+  CRSMatrix matrix(n_rows, n_cols);
+  matrix.row_ptr.assign(n_rows + 1, 0);
+  for (const auto& local : entries) {
+    for (const auto& e : local) ++matrix.row_ptr[e.row + 1];
+  }
+  for (int i = 0; i < n_rows; ++i) matrix.row_ptr[i + 1] += matrix.row_ptr[i];
+  const int nnz = matrix.row_ptr[n_rows];
+  std::vector<std::pair<int, double>> sorted(nnz);
+  std::vector<int> next(matrix.row_ptr.begin(), matrix.row_ptr.end() - 1);
+  for (const auto& local : entries) {
+    for (const auto& e : local) sorted[next[e.row]++] = {e.col, e.value};
+  }
+  matrix.col_index.resize(nnz);
+  matrix.values.resize(nnz);
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int i = 0; i < n_rows; ++i) {
+    std::sort(sorted.begin() + matrix.row_ptr[i], sorted.begin() + matrix.row_ptr[i + 1],
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (int k = matrix.row_ptr[i]; k < matrix.row_ptr[i + 1]; ++k) {
+      matrix.col_index[k] = sorted[k].first;
+      matrix.values[k] = sorted[k].second;
+    }
+  }
+  return matrix;
+}
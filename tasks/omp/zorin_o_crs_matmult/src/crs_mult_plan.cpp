@@ -0,0 +1,142 @@
+// Copyright 2024 Zorin Oleg
+
+#include "omp/zorin_o_crs_matmult/include/crs_mult_plan.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+CRSMultPlan::CRSMultPlan(const SparseMatrixView& A, const SparseMatrixView& B) { build(A, B, nullptr); }
+
+CRSMultPlan::CRSMultPlan(const SparseMatrixView& A, const SparseMatrixView& B, const SparseMatrixView& mask) {
+  if (mask.n_rows != A.n_rows || mask.n_cols != B.n_cols) {
+    throw std::invalid_argument("Mask does not match the product shape");
+  }
+  build(A, B, &mask);
+}
+
+void CRSMultPlan::build(const SparseMatrixView& A, const SparseMatrixView& B, const SparseMatrixView* mask) {
+  if (A.n_cols != B.n_rows) {
+    throw std::invalid_argument("Inner dimensions of A and B differ");
+  }
+  n_rows = A.n_rows;
+  n_cols = B.n_cols;
+  a_key = fingerprint(A);
+  b_key = fingerprint(B);
+  a_ptr.assign(A.ptr, A.ptr + n_rows + 1);
+  a_index.assign(A.index, A.index + a_ptr[n_rows]);
+  b_ptr.assign(B.ptr, B.ptr + B.n_rows + 1);
+  const int* b_index = B.index;
+  row_ptr.assign(n_rows + 1, 0);
+  product_ptr.assign(n_rows + 1, 0);
+
+  // pass 1: products and distinct (allowed) columns per row
+#pragma omp parallel
+  {
+    std::vector<int> seen(n_cols, -1);
+    std::vector<int> allowed(mask != nullptr ? n_cols : 0, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < n_rows; ++i) {
+      if (mask != nullptr) {
+        for (int k = mask->ptr[i]; k < mask->ptr[i + 1]; ++k) allowed[mask->index[k]] = i;
+      }
+      int64_t products_in_row = 0;
+      int count = 0;
+      for (int k = a_ptr[i]; k < a_ptr[i + 1]; ++k) {
+        const int col_a = a_index[k];
+        products_in_row += b_ptr[col_a + 1] - b_ptr[col_a];
+        for (int l = b_ptr[col_a]; l < b_ptr[col_a + 1]; ++l) {
+          const int col = b_index[l];
+          if (seen[col] != i && (mask == nullptr || allowed[col] == i)) {
+            seen[col] = i;
+            ++count;
+          }
+        }
+      }
+      row_ptr[i + 1] = count;
+      product_ptr[i + 1] = products_in_row;
+    }
+  }
+  for (int i = 0; i < n_rows; ++i) {
+    row_ptr[i + 1] += row_ptr[i];
+    product_ptr[i + 1] += product_ptr[i];
+  }
+  col_index.resize(row_ptr[n_rows]);
+  slot.resize(product_ptr[n_rows]);
+
+  // pass 2: sorted columns of C and the slot of every product
+#pragma omp parallel
+  {
+    std::vector<int> position(n_cols, -1);
+    std::vector<int> allowed(mask != nullptr ? n_cols : 0, -1);
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < n_rows; ++i) {
+      if (mask != nullptr) {
+        for (int k = mask->ptr[i]; k < mask->ptr[i + 1]; ++k) allowed[mask->index[k]] = i;
+      }
+      int* cols = col_index.data() + row_ptr[i];
+      int count = 0;
+      for (int k = a_ptr[i]; k < a_ptr[i + 1]; ++k) {
+        for (int l = b_ptr[a_index[k]]; l < b_ptr[a_index[k] + 1]; ++l) {
+          const int col = b_index[l];
+          if (position[col] == -1 && (mask == nullptr || allowed[col] == i)) {
+            position[col] = 0;
+            cols[count++] = col;
+          }
+        }
+      }
+      std::sort(cols, cols + count);
+      for (int c = 0; c < count; ++c) position[cols[c]] = row_ptr[i] + c;
+
+      int64_t p = product_ptr[i];
+      for (int k = a_ptr[i]; k < a_ptr[i + 1]; ++k) {
+        for (int l = b_ptr[a_index[k]]; l < b_ptr[a_index[k] + 1]; ++l) {
+          slot[p++] = position[b_index[l]];
+        }
+      }
+      for (int c = 0; c < count; ++c) position[cols[c]] = -1;
+    }
+  }
+}
+
+CRSMultPlan::Fingerprint CRSMultPlan::fingerprint(const SparseMatrixView& matrix) {
+  const int n_major = matrix.layout == SparseLayout::CCS ? matrix.n_cols : matrix.n_rows;
+  const int64_t nnz = matrix.ptr[n_major];
+  // FNV-1a over the 32-bit words of ptr, then index
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](const int* first, const int* last) {
+    for (; first != last; ++first) hash = (hash ^ static_cast<uint32_t>(*first)) * 1099511628211ULL;
+  };
+  mix(matrix.ptr, matrix.ptr + n_major + 1);
+  mix(matrix.index, matrix.index + nnz);
+  return {matrix.n_rows, matrix.n_cols, nnz, hash};
+}
+
+bool CRSMultPlan::matches(const SparseMatrixView& A, const SparseMatrixView& B) const {
+  auto cheap_match = [](const SparseMatrixView& view, const Fingerprint& key) {
+    const int n_major = view.layout == SparseLayout::CCS ? view.n_cols : view.n_rows;
+    return view.n_rows == key.n_rows && view.n_cols == key.n_cols && view.ptr[n_major] == key.nnz;
+  };
+  return cheap_match(A, a_key) && cheap_match(B, b_key) && fingerprint(A) == a_key && fingerprint(B) == b_key;
+}
+
+void CRSMultPlan::multiply(const double* a_values, const double* b_values, CRSMatrix& C) const {
+  C.n_rows = n_rows;
+  C.n_cols = n_cols;
+  C.row_ptr = row_ptr;
+  C.col_index = col_index;
+  C.values.assign(col_index.size(), 0.0);
+  double* c_values = C.values.data();
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < n_rows; ++i) {
+    const int* s = slot.data() + product_ptr[i];
+    for (int k = a_ptr[i]; k < a_ptr[i + 1]; ++k) {
+      const double a = a_values[k];
+      const int first = b_ptr[a_index[k]];
+      const int last = b_ptr[a_index[k] + 1];
+      for (int l = first; l < last; ++l, ++s) {
+        if (*s >= 0) c_values[*s] += a * b_values[l];
+      }
+    }
+  }
+}
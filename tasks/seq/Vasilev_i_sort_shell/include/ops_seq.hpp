@@ -23,6 +23,6 @@ class VasilevTaskSequential : public ppc::core::Task {
   std::vector<int> input_;
   std::vector<int> res;
   void merge(int l, int m, int r);
-  void shellSort();
+  void shellSort(int l, int r);
   void batcherMerge(int l, int r);
 };
@@ -81,10 +81,10 @@
 // }
 
 TEST(vasilev_i_sort_shell_seq, pipeline_run) {
-  const int count = 1024;
+  const int count = 1 << 20;
 
   // Create data
-  std::vector<int> in = VasilevTaskSequential::generate_random_vector(count, 1, 1024);
+  std::vector<int> in = VasilevTaskSequential::generate_random_vector(count, 1, count);
   std::vector<int> out(count, 0);
 
   // Create TaskData
@@ -118,10 +118,10 @@ TEST(vasilev_i_sort_shell_seq, pipeline_run) {
 }
 
 TEST(vasilev_i_sort_shell_seq, task_run) {
-  const int count = 2048;
+  const int count = 1 << 20;
 
   // Create data
-  std::vector<int> in = VasilevTaskSequential::generate_random_vector(count, 1, 1024);
+  std::vector<int> in = VasilevTaskSequential::generate_random_vector(count, 1, count);
   std::vector<int> out(count, 0);
 
   // Create TaskData
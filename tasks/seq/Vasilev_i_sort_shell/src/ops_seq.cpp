@@ -4,6 +4,8 @@
 #include "seq/Vasilev_i_sort_shell/include/ops_seq.hpp"
 
 #include <algorithm>
+
+#include "core/sort/include/shell_sort.hpp"
 // using namespace std::chrono_literals;
 
 bool VasilevTaskSequential::pre_processing() {
@@ -81,37 +83,21 @@ void VasilevTaskSequential::merge(int l, int m, int r) {
 }
 
 // Сортировка Шелла
-void VasilevTaskSequential::shellSort() {
-  int n = input_.size();
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      int temp = input_[i];
-      int j;
-      for (j = i; j >= gap && input_[j - gap] > temp; j -= gap) {
-        input_[j] = input_[j - gap];
-      }
-      input_[j] = temp;
-    }
-  }
+void VasilevTaskSequential::shellSort(int l, int r) {
+  ppc::core::shellSort(input_.data() + l, r - l + 1, ppc::core::ShellGaps::kCiura, 1);
 }
 
 // Четно-нечетное слияние Бэтчера
 void VasilevTaskSequential::batcherMerge(int l, int r) {
-  shellSort();
   if (r > l) {
     int m = l + (r - l) / 2;
-    for (int i = l; i <= m; i += 2) {
-      if (i + 1 <= m) {
-        if (input_[i] > input_[i + 1]) {
-          std::swap(input_[i], input_[i + 1]);
-        }
-      }
-    }
-    batcherMerge(l, m);
-    batcherMerge(m + 1, r);
+    // each half is Shell sorted once, not the whole array again on every level of the recursion
+    shellSort(l, m);
+    shellSort(m + 1, r);
     merge(l, m, r);
   }
 }
+
 bool VasilevTaskSequential::R_sorted(std::vector<int> input) { return std::is_sorted(input.begin(), input.end()); }
 
 std::vector<int> VasilevTaskSequential::generate_random_vector(int size, int min, int max) {
@@ -16,7 +16,6 @@ class HoareSortWBatcherMergeSequential : public ppc::core::Task {
   bool run() override;
   bool post_processing() override;
   static void HoareSortWBatcherMergeSeq(std::vector<int> &arr, size_t l, size_t r);
-  static void CompExch(int &a, int &b);
 
  private:
   std::vector<int> array{};
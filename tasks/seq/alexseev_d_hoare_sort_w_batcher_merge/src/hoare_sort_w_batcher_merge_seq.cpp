@@ -5,6 +5,8 @@
 #include <random>
 #include <thread>
 
+#include "core/sort/include/sorting_network.hpp"
+
 using namespace std::chrono_literals;
 
 bool alexseev_seq::HoareSortWBatcherMergeSequential::pre_processing() {
@@ -56,14 +58,6 @@ bool alexseev_seq::HoareSortWBatcherMergeSequential::post_processing() {
 void alexseev_seq::HoareSortWBatcherMergeSequential::HoareSortWBatcherMergeSeq(std::vector<int> &arr, size_t l,
                                                                                size_t r) {
   if (arr.size() <= 1) return;
-  int n = r - l + 1;
-  for (int p = 1; p < n; p += p)
-    for (int k = p; k > 0; k /= 2)
-      for (int j = k % p; j + k < n; j += (k + k))
-        for (int i = 0; i < n - j - k; ++i)
-          if ((j + i) / (p + p) == (j + i + k) / (p + p)) CompExch(arr[l + j + i], arr[l + j + i + k]);
-}
-
-void alexseev_seq::HoareSortWBatcherMergeSequential::CompExch(int &a, int &b) {
-  if (a > b) std::swap(a, b);
+  // vectorized odd-even networks: 8 x 8 blocks sorted in registers, then bitonic merges of runs
+  ppc::core::networkSort(arr.data() + l, r - l + 1, 1);
 }
@@ -1,10 +1,14 @@
 // Copyright 2024 Nesterov Alexander
 #include "seq/benduyzhko_t_shell_batcher/include/ops_seq.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <vector>
 
+#include "core/sort/include/shell_sort.hpp"
+#include "core/sort/include/sorting_network.hpp"
+
 bool BenduyzhkoSequential::pre_processing() {
   internal_order_test();
   n = taskData->inputs_count[0];
@@ -24,17 +28,10 @@ bool BenduyzhkoSequential::run() {
   int p = n >> 1;  // n = 2 * p;
   shell(in_out, p);
   shell(in_out + p, n - p);
-  for (int k = p; k >= 1; k >>= 1) {
-    for (int j = k % p; j < n - k + 1; j += 2 * k) {
-      for (int i = 0; i < std::min(k - 1, n - j - k - 1) + 1; ++i) {
-        if ((i + j) % n + k < n) {  // if ((i + j) / n == (i + j + k) / n) {
-          if (in_out[i + j] > in_out[i + j + k]) {
-            std::swap(in_out[i + j], in_out[i + j + k]);
-          }
-        }
-      }
-    }
-  }
+  // bitonic merge network on the two halves; correct for any n, not only powers of two
+  std::vector<int> merged(n);
+  ppc::core::networkMerge(in_out, p, in_out + p, n - p, merged.data());
+  std::copy(merged.begin(), merged.end(), in_out);
   return true;
 }
 
@@ -43,19 +40,7 @@ bool BenduyzhkoSequential::post_processing() {
   return true;
 }
 
-void shell(int* arr, int n) {
-  int tmp;
-  int j;
-  for (int gap = n >> 1; gap > 0; gap >>= 1) {
-    for (int i = gap; i < n; ++i) {
-      tmp = arr[i];
-      for (j = i; j >= gap && arr[j - gap] > tmp; j -= gap) {
-        arr[j] = arr[j - gap];
-      }
-      arr[j] = tmp;
-    }
-  }
-}
+void shell(int* arr, int n) { ppc::core::shellSort(arr, n, ppc::core::ShellGaps::kCiura, 1); }
 
 void BenduyzhkoSequential::get_random_numbers(int* arr, int n, int a, int b, int seed) {
   std::uniform_int_distribution<int> dist(a, b);
@@ -1,108 +1,9 @@
 // Copyright 2024 Chuvashov Andrey
 
 #include "seq/chuvashov_a_batcher_ints_sort/include/batcher_ints_sort.hpp"
-using namespace std::chrono_literals;
-
-std::vector<int> Chuvashov_BatcherEven(std::vector<int> arr1, std::vector<int> arr2) {
-  std::vector<int> result(arr1.size() / 2 + arr2.size() / 2 + arr1.size() % 2 + arr2.size() % 2);
-  size_t i = 0;
-  size_t j = 0;
-  size_t k = 0;
-
-  while ((j < arr1.size()) && (k < arr2.size())) {
-    if (arr1[j] <= arr2[k]) {
-      result[i] = arr1[j];
-      j += 2;
-    } else {
-      result[i] = arr2[k];
-      k += 2;
-    }
-    i++;
-  }
-
-  if (j >= arr1.size()) {
-    for (size_t l = k; l < arr2.size(); l += 2) {
-      result[i] = arr2[l];
-      i++;
-    }
-  } else {
-    for (size_t l = j; l < arr1.size(); l += 2) {
-      result[i] = arr1[l];
-      i++;
-    }
-  }
-
-  return result;
-}
-
-std::vector<int> Chuvashov_BatcherOdd(std::vector<int> arr1, std::vector<int> arr2) {
-  std::vector<int> result(arr1.size() / 2 + arr2.size() / 2);
-  size_t i = 0;
-  size_t j = 1;
-  size_t k = 1;
-
-  while ((j < arr1.size()) && (k < arr2.size())) {
-    if (arr1[j] <= arr2[k]) {
-      result[i] = arr1[j];
-      j += 2;
-    } else {
-      result[i] = arr2[k];
-      k += 2;
-    }
-    i++;
-  }
-
-  if (j >= arr1.size()) {
-    for (size_t l = k; l < arr2.size(); l += 2) {
-      result[i] = arr2[l];
-      i++;
-    }
-  } else {
-    for (size_t l = j; l < arr1.size(); l += 2) {
-      result[i] = arr1[l];
-      i++;
-    }
-  }
 
-  return result;
-}
-
-std::vector<int> Chuvashov_merge(std::vector<int> arr1, std::vector<int> arr2) {
-  std::vector<int> result(arr1.size() + arr2.size());
-  size_t i = 0;
-  size_t j = 0;
-  size_t k = 0;
-
-  while ((j < arr1.size()) && (k < arr2.size())) {
-    result[i] = arr1[j];
-    result[i + 1] = arr2[k];
-    i += 2;
-    j++;
-    k++;
-  }
-
-  if ((k >= arr2.size()) && (j < arr1.size())) {
-    for (size_t l = i; l < result.size(); l++) {
-      result[l] = arr1[j];
-      j++;
-    }
-  }
-
-  for (size_t l = 0; l < result.size() - 1; l++) {
-    if (result[l] > result[l + 1]) {
-      std::swap(result[l], result[l + 1]);
-    }
-  }
-
-  return result;
-}
-
-std::vector<int> Chuvashov_BatcherSort(const std::vector<int> &arr1, const std::vector<int> &arr2) {
-  std::vector<int> even = Chuvashov_BatcherEven(arr1, arr2);
-  std::vector<int> odd = Chuvashov_BatcherOdd(arr1, arr2);
-  std::vector<int> result = Chuvashov_merge(even, odd);
-  return result;
-}
+#include "core/sort/include/sorting_network.hpp"
+using namespace std::chrono_literals;
 
 bool Chuvashov_SequentialBatcherSort::pre_processing() {
   internal_order_test();
@@ -119,8 +20,8 @@ bool Chuvashov_SequentialBatcherSort::pre_processing() {
     arr2[i] = input[(input.size() / 2) + i];
   }
 
-  std::sort(arr1.begin(), arr1.end());
-  std::sort(arr2.begin(), arr2.end());
+  ppc::core::networkSort(arr1, 1);
+  ppc::core::networkSort(arr2, 1);
   return true;
 }
 
@@ -131,7 +32,8 @@ bool Chuvashov_SequentialBatcherSort::validation() {
 
 bool Chuvashov_SequentialBatcherSort::run() {
   internal_order_test();
-  output = Chuvashov_BatcherSort(arr1, arr2);
+  // bitonic merge network on whole vectors instead of the odd-even split into copies
+  output = ppc::core::networkMerge(arr1, arr2);
   return true;
 }
 
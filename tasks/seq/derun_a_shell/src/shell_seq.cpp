@@ -3,6 +3,8 @@
 
 #include <thread>  // NOLINT
 
+#include "core/sort/include/shell_sort.hpp"
+
 using namespace std::chrono_literals;  // NOLINT
 
 bool ShellSequential::pre_processing() {
@@ -42,18 +44,7 @@ bool ShellSequential::post_processing() {
 
 std::vector<int> ShellSequential::shell_sort(const std::vector<int>& input) {
   std::vector<int> vec(input);
-
-  for (int interval = static_cast<int>(vec.size()) / 2; interval > 0; interval /= 2) {
-    for (int i = interval; i < static_cast<int>(vec.size()); i++) {
-      int tmp = vec[i];
-      int j = i;
-      for (; j >= interval && vec[j - interval] > tmp; j -= interval) {
-        vec[j] = vec[j - interval];
-      }
-      vec[j] = tmp;
-    }
-  }
-
+  ppc::core::shellSort(vec, ppc::core::ShellGaps::kCiura, 1);
   return vec;
 }
 
@@ -1,9 +1,10 @@
 // Copyright 2024 Eremin Alexander
 #include "seq/eremin_a_int_radixsort/include/ops_seq.hpp"
 
-#include <cmath>
 #include <thread>
 
+#include "core/sort/include/radix_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool RadixSortTaskSequential::pre_processing() {
@@ -31,59 +32,7 @@ bool RadixSortTaskSequential::validation() {
 bool RadixSortTaskSequential::run() {
   internal_order_test();
   try {
-    std::vector<int> VectorForSort_;
-    VectorForSort_ = VectorForSort;
-    int numDevider = 0;
-    int maxNum = 0;
-    int MinKey;
-    int MaxKey;
-
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      if (maxNum <= VectorForSort_[i]) {
-        maxNum = VectorForSort_[i];
-      }
-    }
-
-    if (maxNum == 0) {
-      numDevider = 1;
-    } else
-      numDevider = log10(abs(maxNum)) + 1;
-
-    for (int dev = 0; dev < numDevider; dev++) {
-      int devider = pow(10, dev);
-
-      MinKey = VectorForSort_[0] % (devider * 10) / devider;
-      MaxKey = MinKey;
-      for (size_t i = 0; i < VectorForSort_.size(); i++) {
-        int digit = VectorForSort_[i] % (devider * 10) / devider;
-        if (digit < MinKey) {
-          MinKey = digit;
-        }
-        if (digit > MaxKey) {
-          MaxKey = digit;
-        }
-      }
-
-      std::vector<int> count(MaxKey - MinKey + 1);
-      for (size_t i = 0; i < VectorForSort_.size(); i++) {
-        count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]++;
-      }
-
-      int size = VectorForSort_.size();
-      for (int i = count.size() - 1; i >= 0; i--) {
-        size -= count[i];
-        count[i] = size;
-      }
-      std::vector<int> temp(VectorForSort_.size());
-      for (size_t i = 0; i < VectorForSort_.size(); i++) {
-        temp[count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]] = VectorForSort_[i];
-        count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]++;
-      }
-      for (size_t i = 0; i < VectorForSort_.size(); i++) {
-        VectorForSort_[i] = temp[i];
-      }
-    }
-    VectorForSort = VectorForSort_;
+    ppc::core::radixSort(VectorForSort, 0, 1);
   } catch (...) {
     return false;
   }
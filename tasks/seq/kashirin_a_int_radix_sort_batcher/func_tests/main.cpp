@@ -119,3 +119,41 @@ TEST(kashirin_a_int_radix_sort_batcher_seq, Test_sort_100) {
   testTaskSequential.post_processing();
   ASSERT_TRUE(std::is_sorted(out.begin(), out.end()));
 }
+
+TEST(kashirin_a_int_radix_sort_batcher_seq, Test_sort_pairs_stable) {
+  const int count = 20000;
+
+  // Create data: keys repeat, values record the input position
+  std::vector<int> in_keys = RandomVector(count);
+  std::vector<int> in_values(count);
+  for (int i = 0; i < count; i++) in_values[i] = i;
+  std::vector<int> out_keys(count, 0);
+  std::vector<int> out_values(count, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_keys.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_values.data()));
+  taskDataSeq->inputs_count.emplace_back(in_keys.size());
+  taskDataSeq->inputs_count.emplace_back(in_values.size());
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_keys.data()));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_values.data()));
+  taskDataSeq->outputs_count.emplace_back(out_keys.size());
+  taskDataSeq->outputs_count.emplace_back(out_values.size());
+
+  // Create Task
+  SeqIntRadixSortPairsWithMerge testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), true);
+  testTaskSequential.pre_processing();
+  testTaskSequential.run();
+  testTaskSequential.post_processing();
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(out_keys[i], in_keys[out_values[i]]);
+    if (i > 0) {
+      ASSERT_LE(out_keys[i - 1], out_keys[i]);
+      if (out_keys[i - 1] == out_keys[i]) {
+        ASSERT_LT(out_values[i - 1], out_values[i]);
+      }
+    }
+  }
+}
@@ -23,6 +23,21 @@ class SeqIntRadixSortWithBatcherMerge : public ppc::core::Task {
   std::vector<int> input, result;
 };
 
+// Sorts int keys (inputs[0]) with an int payload (inputs[1]) into outputs[0] and outputs[1].
+// Unlike the Batcher-style merge above, the merge keeps equal keys in input order.
+class SeqIntRadixSortPairsWithMerge : public ppc::core::Task {
+ public:
+  explicit SeqIntRadixSortPairsWithMerge(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  std::vector<int> keys, values;
+};
+
 inline std::vector<int> RandomVector(int size) {
   std::vector<int> vector(size);
   for (int i = 0; i < size; i++) {
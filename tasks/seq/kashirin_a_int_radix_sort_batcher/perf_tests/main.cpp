@@ -9,7 +9,7 @@
 
 TEST(kashirin_a_int_radix_sort_batcher_seq, test_pipeline_run) {
   // Create data
-  std::vector<int> in = RandomVector(100000);
+  std::vector<int> in = RandomVector(1000000);
   std::vector<int> res(in.size(), 0);
 
   // Create TaskData
@@ -46,7 +46,7 @@ TEST(kashirin_a_int_radix_sort_batcher_seq, test_pipeline_run) {
 
 TEST(kashirin_a_int_radix_sort_batcher_seq, test_task_run) {
   // Create data
-  std::vector<int> in = RandomVector(100000);
+  std::vector<int> in = RandomVector(1000000);
   std::vector<int> res(in.size(), 0);
 
   // Create TaskData
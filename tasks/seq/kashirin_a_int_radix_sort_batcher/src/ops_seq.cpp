@@ -1,22 +1,21 @@
 // Copyright 2024 Kashirin Alexander
 
 #include "seq/kashirin_a_int_radix_sort_batcher/include/ops_seq.hpp"
+
+#include "core/sort/include/merge_sort.hpp"
+#include "core/sort/include/radix_sort.hpp"
+
 using namespace std::chrono_literals;
 
-int remainder(int num, int k) {
-  while (k > 1) {
-    num = num / 10;
-    k--;
-  }
-  return num % 10;
-}
+// runs up to this long are radix sorted in one go, longer ones are split and merged
+const size_t radix_run = 1 << 12;
 
 void merge(std::vector<int>& a, size_t left, size_t mid, size_t right) {
-  std::vector<int> b(a.size(), 0);
+  std::vector<int> b(right - left + 1, 0);
   size_t i = left;
   size_t j = mid + 1;
-  size_t k = left;
-  while (k <= right) {
+  size_t k = 0;
+  while (k <= right - left) {
     if (((j > right) || (a[i] < a[j])) && (i <= mid)) {
       b[k++] = a[i++];
     } else if (((i > mid) || (a[i] > a[j])) && (j <= right)) {
@@ -27,37 +26,16 @@ void merge(std::vector<int>& a, size_t left, size_t mid, size_t right) {
       j++;
     }
   }
-  for (size_t q = left; q <= right; q++) {
-    a[q] = b[q];
-  }
+  std::copy(b.begin(), b.end(), a.begin() + left);
 }
 
 void sort(const std::vector<int>& src, std::vector<int>& result, size_t left, size_t right) {
-  std::vector<int> b(src);
-  std::vector<std::vector<int>> tmp(10, std::vector<int>(100, 0));
-  std::vector<int> amount(10, 0);
-  int k = 1;
-  while (k <= 3) {
-    for (size_t i = left; i <= right; i++) {
-      int rem = remainder(b[i], k);
-      tmp[rem][amount[rem]++] = b[i];
-    }
-    for (int i = 0, ind = left; i < 10; i++) {
-      for (int j = 0; j < amount[i]; j++) {
-        b[ind] = tmp[i][j];
-        ind++;
-      }
-      amount[i] = 0;
-    }
-    k++;
-  }
-  for (size_t i = left; i <= right; i++) {
-    result[i] = b[i];
-  }
+  std::copy(src.begin() + left, src.begin() + right + 1, result.begin() + left);
+  ppc::core::radixSort(result.data() + left, right - left + 1, 0, 1);
 }
 
 void recursiveSort(std::vector<int>& src, std::vector<int>& result, size_t left, size_t right) {
-  if (right - left <= 8) {
+  if (right - left < radix_run) {
     sort(src, result, left, right);
   } else {
     auto mid = (size_t)((right + left) / 2);
@@ -106,3 +84,51 @@ bool SeqIntRadixSortWithBatcherMerge::post_processing() {
   return true;
   // return std::is_sorted(result.begin(), result.end());
 }
+
+// sorts [left, right) of keys and values, using buffers of the same size as scratch
+void recursiveSortPairs(std::vector<int>& keys, std::vector<int>& values, std::vector<int>& key_buffer,
+                        std::vector<int>& value_buffer, size_t left, size_t right) {
+  if (right - left <= radix_run) {
+    ppc::core::radixSortPairs(keys.data() + left, values.data() + left, right - left, 0, 1);
+    return;
+  }
+  const size_t mid = left + (right - left) / 2;
+  recursiveSortPairs(keys, values, key_buffer, value_buffer, left, mid);
+  recursiveSortPairs(keys, values, key_buffer, value_buffer, mid, right);
+  ppc::core::mergePairs(keys.data() + left, values.data() + left, mid - left, keys.data() + mid, values.data() + mid,
+                        right - mid, key_buffer.data() + left, value_buffer.data() + left);
+  std::copy(key_buffer.begin() + left, key_buffer.begin() + right, keys.begin() + left);
+  std::copy(value_buffer.begin() + left, value_buffer.begin() + right, values.begin() + left);
+}
+
+bool SeqIntRadixSortPairsWithMerge::pre_processing() {
+  internal_order_test();
+  auto* keys_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
+  auto* values_ptr = reinterpret_cast<int*>(taskData->inputs[1]);
+  keys.assign(keys_ptr, keys_ptr + taskData->inputs_count[0]);
+  values.assign(values_ptr, values_ptr + taskData->inputs_count[1]);
+  return true;
+}
+
+bool SeqIntRadixSortPairsWithMerge::validation() {
+  internal_order_test();
+  return taskData->inputs_count.size() == 2 && taskData->outputs_count.size() == 2 &&
+         taskData->inputs_count[0] == taskData->inputs_count[1] &&
+         taskData->outputs_count[0] == taskData->inputs_count[0] &&
+         taskData->outputs_count[1] == taskData->inputs_count[0];
+}
+
+bool SeqIntRadixSortPairsWithMerge::run() {
+  internal_order_test();
+  std::vector<int> key_buffer(keys.size());
+  std::vector<int> value_buffer(values.size());
+  recursiveSortPairs(keys, values, key_buffer, value_buffer, 0, keys.size());
+  return true;
+}
+
+bool SeqIntRadixSortPairsWithMerge::post_processing() {
+  internal_order_test();
+  std::copy(keys.begin(), keys.end(), reinterpret_cast<int*>(taskData->outputs[0]));
+  std::copy(values.begin(), values.end(), reinterpret_cast<int*>(taskData->outputs[1]));
+  return true;
+}
@@ -7,7 +7,7 @@
 #include "seq/kirillov_m_strassen_alg/include/ops_seq.hpp"
 
 TEST(kirillov_m_strassen_seq_perf_tests, test_pipeline_run) {
-  const int n = 64;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = generateRandomMatrixKirillov(n);
@@ -54,7 +54,7 @@ TEST(kirillov_m_strassen_seq_perf_tests, test_pipeline_run) {
 }
 
 TEST(kirillov_m_strassen_seq_perf_tests, test_task_run) {
-  const int n = 64;
+  const int n = 512;
 
   // Create data
   std::vector<double> A = generateRandomMatrixKirillov(n);
@@ -1,6 +1,8 @@
 // Copyright 2024 Kiselev Igor
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -9,16 +11,17 @@
 using namespace Kiselev_seq;
 
 TEST(kiselev_i_shell_simple_seq, test_pipeline_run) {
-  const int count = 100;
+  const int count = 1 << 20;
 
   // Create data
   std::vector<int> in(count, 0);
   std::vector<int> out(count, 0);
   std::vector<int> res(count, 0);
   for (int i = 0; i < count; i++) {
-    in[i] = count - 1 - i;
+    in[i] = i;
     res[i] = i;
   }
+  std::shuffle(in.begin(), in.end(), std::mt19937(42));
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
@@ -53,16 +56,17 @@ TEST(kiselev_i_shell_simple_seq, test_pipeline_run) {
 // task_run
 
 TEST(kiselev_i_shell_simple_seq, test_task_run) {
-  const int count = 100;
+  const int count = 1 << 20;
 
   // Create data
   std::vector<int> in(count, 0);
   std::vector<int> out(count, 0);
   std::vector<int> res(count, 0);
   for (int i = 0; i < count; i++) {
-    in[i] = count - 1 - i;
+    in[i] = i;
     res[i] = i;
   }
+  std::shuffle(in.begin(), in.end(), std::mt19937(42));
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
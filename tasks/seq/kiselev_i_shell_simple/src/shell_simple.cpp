@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/sort/include/shell_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool Kiselev_seq::KiselevTaskSequential::pre_processing() {
@@ -32,15 +34,7 @@ bool Kiselev_seq::KiselevTaskSequential::validation() {
 bool Kiselev_seq::KiselevTaskSequential::run() {
   try {
     internal_order_test();
-    int n = arr.size();
-    for (int gap = n / 2; gap > 0; gap /= 2) {
-      for (int i = gap; i < n; i += 1) {
-        int temp = arr[i];
-        int j;
-        for (j = i; j >= gap && arr[j - gap] > temp; j -= gap) arr[j] = arr[j - gap];
-        arr[j] = temp;
-      }
-    }
+    ppc::core::shellSort(arr, ppc::core::ShellGaps::kCiura, 1);
     return true;
   } catch (...) {
     return false;
@@ -17,5 +17,4 @@ class RadixSortSequentialTask : public ppc::core::Task {
  private:
   size_t input_size;
   double* input_;
-  std::vector<double> ordered[sizeof(double) * 256];
 };
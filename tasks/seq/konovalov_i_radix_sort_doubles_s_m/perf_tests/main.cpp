@@ -8,7 +8,7 @@
 #include "seq/konovalov_i_radix_sort_doubles_s_m/include/ops_seq.hpp"
 
 TEST(konovalov_i_double_radix_sort_seq, test_pipeline_run) {
-  const size_t size = 1e+5;
+  const size_t size = 1e+6;
   std::mt19937 gen(1.0);
   std::uniform_real_distribution<> dis(0.0, 1e+5);
 
@@ -60,7 +60,7 @@ TEST(konovalov_i_double_radix_sort_seq, test_pipeline_run) {
 }
 
 TEST(konovalov_i_double_radix_sort_seq, test_task_run) {
-  const size_t size = 1e+5;
+  const size_t size = 1e+6;
   std::mt19937 gen(1.0);
   std::uniform_real_distribution<> dis(0.0, 1e+5);
 
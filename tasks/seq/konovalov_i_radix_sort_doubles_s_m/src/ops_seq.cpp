@@ -1,8 +1,11 @@
 // Copyright 2024 Konovalov Igor
 #include "seq/konovalov_i_radix_sort_doubles_s_m/include/ops_seq.hpp"
 
+#include <iostream>
 #include <thread>
 
+#include "core/sort/include/radix_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool RadixSortSequentialTask::pre_processing() {
@@ -22,23 +25,7 @@ bool RadixSortSequentialTask::validation() {
 bool RadixSortSequentialTask::run() {
   internal_order_test();
   try {
-    char* buf;
-    for (size_t i = 0; i < sizeof(double); i++) {
-      for (size_t j = 0; j < input_size; j++) {
-        buf = reinterpret_cast<char*>(&input_[j]);
-        ordered[(uint8_t)buf[i]].push_back(input_[j]);
-      }
-
-      size_t cur = 0;
-
-      for (size_t j = 0; j < sizeof(double) * 256; j++) {
-        for (size_t k = 0; k < ordered[j].size(); k++) {
-          input_[cur] = ordered[j][k];
-          cur++;
-        }
-        ordered[j].clear();
-      }
-    }
+    ppc::core::radixSort(input_, input_size, 0, 1);
   } catch (std::exception& e) {
     std::cerr << "error: " << e.what() << std::endl;
     return false;
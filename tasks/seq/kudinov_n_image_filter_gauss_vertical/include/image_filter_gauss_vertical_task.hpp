@@ -43,8 +43,6 @@ class Image {
   std::size_t _height;
   std::size_t _width;
   std::vector<Pixel> _pixels;
-
-  Pixel _get_gauss_filtered_pixel(std::size_t y, std::size_t x, const GaussKernel& gauss_kernel) const;
 };
 
 class ImageFilterGaussVerticalTask : public ppc::core::Task {
@@ -6,6 +6,8 @@
 #include <random>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
+
 std::vector<double> cannonMatrixMultiplication1(const std::vector<double>& A, const std::vector<double>& B, int n,
                                                 int m) {
   int blockSize = std::min(n, m);
@@ -23,14 +25,7 @@ std::vector<double> cannonMatrixMultiplication1(const std::vector<double>& A, co
         int j_end = std::min(j + blockSize, m);
         int k_end = std::min(k + blockSize, m);
 
-        for (int ii = i; ii < i_end; ++ii) {
-          for (int kk = k; kk < k_end; ++kk) {
-            double A_ik = A[ii * m + kk];
-            for (int jj = j; jj < j_end; ++jj) {
-              C[ii * m + jj] += A_ik * B[kk * m + jj];
-            }
-          }
-        }
+        ppc::core::gemm(i_end - i, j_end - j, k_end - k, &A[i * m + k], m, &B[k * m + j], m, &C[i * m + j], m, true);
       }
     }
   }
@@ -39,21 +34,12 @@ std::vector<double> cannonMatrixMultiplication1(const std::vector<double>& A, co
 }
 
 std::vector<double> multiplyMatrix1(const std::vector<double>& A, const std::vector<double>& B, int rows_A, int col_B) {
-  int col_A = rows_A;
-  std::vector<double> C(rows_A * col_B, 0.0);
-
   if (rows_A == 0 || col_B == 0) {
     return std::vector<double>();
   }
 
-  for (int i = 0; i < rows_A; ++i) {
-    for (int j = 0; j < col_B; ++j) {
-      for (int k = 0; k < col_A; ++k) {
-        C[i * col_B + j] += A[i * col_A + k] * B[k * col_B + j];
-      }
-    }
-  }
-  return C;
+  int col_A = rows_A;
+  return ppc::core::gemm(A, B, rows_A, col_B, col_A);
 }
 
 bool TestTaskSequentialKulaevCannon::pre_processing() {
@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/gemm/include/gemm.hpp"
+
 using namespace std::chrono_literals;
 
 namespace KuznetsovArtyomSeq {
@@ -40,14 +42,8 @@ std::vector<double> multMatrSquare(const std::vector<double>& matrOne, const std
                                    size_t size) {
   if (!validateMatrix(matrOne.size(), matrTwo.size())) throw std::invalid_argument{"invalid matrixs"};
 
-  std::vector<double> matrRes;
-  matrRes.resize(size * size, 0.0);
-
-  for (size_t i = 0; i < size; ++i)
-    for (size_t j = 0; j < size; ++j)
-      for (size_t k = 0; k < size; ++k) matrRes[i * size + j] += matrOne[i * size + k] * matrTwo[k * size + j];
-
-  return matrRes;
+  const int n = static_cast<int>(size);
+  return ppc::core::gemm(matrOne, matrTwo, n, n, n);
 }
 
 std::vector<double> getRandomSquareMatrix(size_t size, double minVal, double maxVal) {
@@ -18,6 +18,7 @@ class LysanovaTaskSequential : public ppc::core::Task {
 
  private:
   double *A{}, *B{}, *C{};
+  std::vector<double> BT;
   size_t n{};
 };
 
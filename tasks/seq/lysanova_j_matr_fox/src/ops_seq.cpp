@@ -6,6 +6,8 @@
 #include <iostream>
 #include <random>
 
+#include "core/transpose/include/transpose.hpp"
+
 bool LysanovaTaskSequential::validation() {
   internal_order_test();
   return (taskData->inputs[0] != nullptr) && (taskData->inputs[1] != nullptr) && (taskData->outputs[0] != nullptr) &&
@@ -26,12 +28,15 @@ bool LysanovaTaskSequential::pre_processing() {
 bool LysanovaTaskSequential::run() {
   internal_order_test();
   try {
+    BT.resize(n * n);
+    const int size = static_cast<int>(n);
+    ppc::core::transpose(size, size, B, size, BT.data(), size);
     double c = 0;
     for (size_t i = 0; i < n; i++) {
       for (size_t j = 0; j < n; j++) {
         c = 0;
         for (size_t k = 0; k < n; k++) {
-          c += A[i * n + k] * B[k * n + j];
+          c += A[i * n + k] * BT[j * n + k];
         }
         C[i * n + j] = c;
       }
@@ -2,6 +2,8 @@
 
 #include "seq/makhinya_d_hoare_sort_batcher_merge/include/hoare_sort.hpp"
 
+#include "core/sort/include/sample_sort.hpp"
+
 bool HoareSort::pre_processing() {
   internal_order_test();
   // Init value for input and output
@@ -22,9 +24,8 @@ bool HoareSort::validation() {
 
 bool HoareSort::run() {
   internal_order_test();
-  sortable_type* begin = _data->data();
-  sortable_type* end = begin + _data->size() - 1UL;
-  seq_hoare_sort(begin, end);
+  // branch-free classification into up to 256 buckets instead of two-way Hoare partitions
+  ppc::core::sampleSort(_data->data(), _data->size(), _comp, 1);
   return true;
 }
 
@@ -42,30 +43,3 @@ bool HoareSort::check_order() {
 
   return true;
 }
-
-void HoareSort::seq_hoare_sort(sortable_type* first_ptr, sortable_type* last_ptr) {
-  if (last_ptr <= first_ptr) {
-    return;
-  }
-
-  sortable_type m = *(first_ptr + (last_ptr + 1UL - first_ptr) / 2UL);
-  sortable_type* ll = first_ptr;
-  sortable_type* rr = last_ptr;
-  while (ll <= rr) {
-    while (HoareSort::_comp(*ll, m)) ll++;
-    while (HoareSort::_comp(m, *rr)) rr--;
-
-    if (ll <= rr) {
-      std::swap(*ll, *rr);
-      ll++;
-      rr--;
-    }
-  }
-
-  if (first_ptr < rr) {
-    HoareSort::seq_hoare_sort(first_ptr, rr);
-  }
-  if (ll < last_ptr) {
-    HoareSort::seq_hoare_sort(ll, last_ptr);
-  }
-}
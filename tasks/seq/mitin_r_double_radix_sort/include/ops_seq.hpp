@@ -18,5 +18,4 @@ class SortRadixDoubleTaskSequential : public ppc::core::Task {
  private:
   double* data_ptr;
   size_t data_size;
-  std::vector<double> bucket_arr[sizeof(double) * 256];
 };
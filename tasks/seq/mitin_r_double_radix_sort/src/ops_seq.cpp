@@ -1,21 +1,12 @@
 // Copyright 2024 Mitin Roman
 #include "seq/mitin_r_double_radix_sort/include/ops_seq.hpp"
 
-#include <cstring>
 #include <iostream>
 #include <thread>
 
-using namespace std::chrono_literals;
-
-namespace {
-
-uint8_t get_byte_val(double val, size_t byte_num) {
-  char bytes[sizeof(double)];
-  std::memcpy(bytes, &val, sizeof(double));
-  return bytes[byte_num];
-}
+#include "core/sort/include/radix_sort.hpp"
 
-}  // namespace
+using namespace std::chrono_literals;
 
 bool SortRadixDoubleTaskSequential::validation() {
   internal_order_test();
@@ -39,19 +30,7 @@ bool SortRadixDoubleTaskSequential::run() {
   internal_order_test();
 
   try {
-    for (size_t byte_num = 0; byte_num < sizeof(double); byte_num++) {
-      for (size_t i = 0; i < data_size; i++) {
-        bucket_arr[get_byte_val(data_ptr[i], byte_num)].emplace_back(data_ptr[i]);
-      }
-
-      size_t i = 0;
-      for (auto& vec : bucket_arr) {
-        for (double val : vec) {
-          data_ptr[i++] = val;
-        }
-        vec.clear();
-      }
-    }
+    ppc::core::radixSort(data_ptr, data_size, 0, 1);
   } catch (const std::exception& e) {
     std::cerr << "Double Radix sort Exception error: " << e.what() << std::endl;
     return false;
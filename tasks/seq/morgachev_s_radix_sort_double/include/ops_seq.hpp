@@ -16,5 +16,4 @@ class RadixSortDoubleSequential : public ppc::core::Task {
  private:
   std::vector<double> data;
   size_t dataSize;
-  static void countSort(double* in, double* out, int length, int exp);
 };
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <thread>
 
+#include "core/sort/include/radix_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool RadixSortDoubleSequential::pre_processing() {
@@ -28,15 +30,7 @@ bool RadixSortDoubleSequential::validation() {
 bool RadixSortDoubleSequential::run() {
   internal_order_test();
   try {
-    std::vector<double> tempLeft = data;
-    std::vector<double> tempRight(dataSize);
-
-    for (int i = 0; i < 4; i++) {
-      countSort(tempLeft.data(), tempRight.data(), dataSize, 2 * i);
-      countSort(tempRight.data(), tempLeft.data(), dataSize, 2 * i + 1);
-    }
-
-    data = tempLeft;
+    ppc::core::radixSort(data, 0, 1);
   } catch (...) {
     return false;
   }
@@ -54,34 +48,3 @@ bool RadixSortDoubleSequential::post_processing() {
   }
   return true;
 }
-
-void RadixSortDoubleSequential::countSort(double* in, double* out, int length, int exp) {
-  auto* buffer = reinterpret_cast<unsigned char*>(in);
-  int counter[256] = {0};
-  int minValue = 0;
-  int minPos = 0;
-
-  for (int i = 0; i < length; i++) {
-    counter[buffer[8 * i + exp]]++;
-  }
-
-  for (int j = 0; j < 256; j++) {
-    if (counter[j] != 0) {
-      minValue = counter[j];
-      counter[j] = 0;
-      minPos = ++j;
-      break;
-    }
-  }
-
-  for (; minPos < 256; minPos++) {
-    int temp = counter[minPos];
-    counter[minPos] = minValue;
-    minValue += temp;
-  }
-
-  for (int i = 0; i < length; i++) {
-    out[counter[buffer[8 * i + exp]]] = in[i];
-    counter[buffer[8 * i + exp]]++;
-  }
-}
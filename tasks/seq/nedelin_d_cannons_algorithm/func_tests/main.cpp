@@ -169,4 +169,55 @@ TEST(nedelin_d_block_cannons_seq, Multiplication_100x100) {
   for (size_t i = 0; i < res.size(); ++i) {
     ASSERT_EQ(res[i], out[i]);
   }
-}
\ No newline at end of file
+}
+TEST(nedelin_d_block_cannons_seq, Batched_Small_Matrices) {
+  for (int n : {8, 12}) {
+    const int batch = 100;
+    std::vector<double> in_mtrx_A = getRandomMatrix(batch * n, n);
+    std::vector<double> in_mtrx_B = getRandomMatrix(batch * n, n);
+    std::vector<double> out(batch * n * n);
+
+    std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_mtrx_A.data()));
+    taskDataSeq->inputs_count.emplace_back(in_mtrx_A.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_mtrx_B.data()));
+    taskDataSeq->inputs_count.emplace_back(in_mtrx_B.size());
+    taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&n));
+    taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskDataSeq->outputs_count.emplace_back(out.size());
+
+    TestTaskSequentialNedelinCannonBatched testTaskSequential(taskDataSeq);
+    ASSERT_EQ(testTaskSequential.validation(), true);
+    testTaskSequential.pre_processing();
+    testTaskSequential.run();
+    testTaskSequential.post_processing();
+
+    for (int b = 0; b < batch; ++b) {
+      std::vector<double> A(in_mtrx_A.begin() + b * n * n, in_mtrx_A.begin() + (b + 1) * n * n);
+      std::vector<double> B(in_mtrx_B.begin() + b * n * n, in_mtrx_B.begin() + (b + 1) * n * n);
+      std::vector<double> res = multiplyMatrix(A, B, n, n);
+      for (int i = 0; i < n * n; ++i) {
+        ASSERT_NEAR(res[i], out[b * n * n + i], 1e-9);
+      }
+    }
+  }
+}
+
+TEST(nedelin_d_block_cannons_seq, Batched_Rejects_Partial_Matrix) {
+  int n = 4;
+  std::vector<double> in_mtrx_A(3 * n * n + 1);
+  std::vector<double> in_mtrx_B(3 * n * n + 1);
+  std::vector<double> out(3 * n * n + 1);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_mtrx_A.data()));
+  taskDataSeq->inputs_count.emplace_back(in_mtrx_A.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_mtrx_B.data()));
+  taskDataSeq->inputs_count.emplace_back(in_mtrx_B.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&n));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+
+  TestTaskSequentialNedelinCannonBatched testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), false);
+}
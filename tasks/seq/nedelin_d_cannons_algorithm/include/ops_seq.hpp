@@ -1,6 +1,7 @@
 // Copyright 2024 Nedelin Dmitry
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <string>
@@ -25,6 +26,26 @@ class TestTaskSequentialNedelinCannon : public ppc::core::Task {
   int n = 0, m = 0;
 };
 
+// C_i = A_i * B_i for a batch of n x n matrices stored one after another: inputs are the A and B
+// batches and n, the output is the C batch. Works on the buffers of taskData in place, so one task
+// replaces a task and three copies per pair.
+class TestTaskSequentialNedelinCannonBatched : public ppc::core::Task {
+ public:
+  explicit TestTaskSequentialNedelinCannonBatched(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  const double* A = nullptr;
+  const double* B = nullptr;
+  double* C = nullptr;
+  int n = 0;
+  int64_t batch = 0;
+};
+
 inline std::vector<double> getRandomMatrix(int rows, int cols) {
   std::random_device dev;
   std::mt19937 gen(dev());
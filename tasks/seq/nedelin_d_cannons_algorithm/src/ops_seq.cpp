@@ -6,6 +6,8 @@
 #include <random>
 #include <vector>
 
+#include "core/gemm/include/gemm.hpp"
+
 std::vector<double> cannonMatrixMultiplication(const std::vector<double>& A, const std::vector<double>& B, int n,
                                                int m) {
   int SizeBlock = std::min(n, m);
@@ -23,14 +25,8 @@ std::vector<double> cannonMatrixMultiplication(const std::vector<double>& A, con
         int j_end = std::min(j + SizeBlock, m);
         int k_end = std::min(k + SizeBlock, m);
 
-        for (int ii = i; ii < i_end; ++ii) {
-          for (int kk = k; kk < k_end; ++kk) {
-            double A_ik = A[ii * m + kk];
-            for (int jj = j; jj < j_end; ++jj) {
-              mtrx_C[ii * m + jj] += A_ik * B[kk * m + jj];
-            }
-          }
-        }
+        ppc::core::gemm(i_end - i, j_end - j, k_end - k, &A[i * m + k], m, &B[k * m + j], m, &mtrx_C[i * m + j], m,
+                        true);
       }
     }
   }
@@ -39,21 +35,12 @@ std::vector<double> cannonMatrixMultiplication(const std::vector<double>& A, con
 }
 
 std::vector<double> multiplyMatrix(const std::vector<double>& A, const std::vector<double>& B, int rows_A, int col_B) {
-  int col_A = rows_A;
-  std::vector<double> mtrx_C(rows_A * col_B, 0.0);
-
   if (rows_A == 0 || col_B == 0) {
     return std::vector<double>();
   }
 
-  for (int i = 0; i < rows_A; ++i) {
-    for (int j = 0; j < col_B; ++j) {
-      for (int k = 0; k < col_A; ++k) {
-        mtrx_C[i * col_B + j] += A[i * col_A + k] * B[k * col_B + j];
-      }
-    }
-  }
-  return mtrx_C;
+  int col_A = rows_A;
+  return ppc::core::gemm(A, B, rows_A, col_B, col_A);
 }
 
 bool TestTaskSequentialNedelinCannon::pre_processing() {
@@ -94,4 +81,34 @@ bool TestTaskSequentialNedelinCannon::post_processing() {
   internal_order_test();
   std::copy(res.begin(), res.end(), reinterpret_cast<double*>(taskData->outputs[0]));
   return true;
-}
\ No newline at end of file
+}
+
+bool TestTaskSequentialNedelinCannonBatched::pre_processing() {
+  internal_order_test();
+  A = reinterpret_cast<const double*>(taskData->inputs[0]);
+  B = reinterpret_cast<const double*>(taskData->inputs[1]);
+  C = reinterpret_cast<double*>(taskData->outputs[0]);
+  batch = taskData->inputs_count[0] / (static_cast<int64_t>(n) * n);
+  return true;
+}
+
+bool TestTaskSequentialNedelinCannonBatched::validation() {
+  internal_order_test();
+  if (taskData->inputs.size() != 3 || taskData->outputs.size() != 1) return false;
+  n = *reinterpret_cast<int*>(taskData->inputs[2]);
+  return n > 0 && taskData->inputs_count[0] == taskData->inputs_count[1] &&
+         taskData->inputs_count[0] == taskData->outputs_count[0] &&
+         taskData->inputs_count[0] % (static_cast<int64_t>(n) * n) == 0;
+}
+
+bool TestTaskSequentialNedelinCannonBatched::run() {
+  internal_order_test();
+  const int64_t stride = static_cast<int64_t>(n) * n;
+  ppc::core::gemmBatched(n, n, n, A, n, stride, B, n, stride, C, n, stride, batch, false, 1);
+  return true;
+}
+
+bool TestTaskSequentialNedelinCannonBatched::post_processing() {
+  internal_order_test();
+  return true;
+}
@@ -7,7 +7,7 @@
 #include "seq/pivovarov_a_strassen_alg/include/ops_seq.hpp"
 
 TEST(sequential_pivovarov_a_strassen_alg_perf_test, test_pipeline_run) {
-  int n = 64;
+  int n = 512;
 
   // Create data
   std::vector<double> in_A = createRndMatrix(n);
@@ -51,13 +51,12 @@ TEST(sequential_pivovarov_a_strassen_alg_perf_test, test_pipeline_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(std::round(res[i] * std::pow(10, 3)) / std::pow(10, 3),
-              std::round(out[i] * std::pow(10, 3)) / std::pow(10, 3));
+    ASSERT_NEAR(res[i], out[i], 1e-6);
   }
 }
 
 TEST(sequential_pivovarov_a_strassen_alg_perf_test, test_task_run) {
-  int n = 64;
+  int n = 512;
 
   // Create data
   std::vector<double> in_A = createRndMatrix(n);
@@ -101,7 +100,6 @@ TEST(sequential_pivovarov_a_strassen_alg_perf_test, test_task_run) {
   ppc::core::Perf::print_perf_statistic(perfResults);
 
   for (size_t i = 0; i < res.size(); ++i) {
-    ASSERT_EQ(std::round(res[i] * std::pow(10, 3)) / std::pow(10, 3),
-              std::round(out[i] * std::pow(10, 3)) / std::pow(10, 3));
+    ASSERT_NEAR(res[i], out[i], 1e-6);
   }
 }
@@ -20,8 +20,6 @@ class SortHoarWithMergeBatcher : public ppc::core::Task {
   std::vector<int> res;
 };
 
-int partition(std::vector<int>& a, int l, int r);
 void Hoar_sort(std::vector<int>& a, int l, int r);
 std::vector<int> generate_data(int n, int mn, int mx);
-void CompAndSwap(int& x, int& y);
 std::vector<int> odd_even_merge_with_hoar(std::vector<int>& my_data);
\ No newline at end of file
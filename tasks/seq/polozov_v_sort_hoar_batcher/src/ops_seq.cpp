@@ -1,6 +1,11 @@
 // Copyright 2024 Polozov Vladislav
 #include "seq/polozov_v_sort_hoar_batcher/include/ops_seq.hpp"
 
+#include <functional>
+
+#include "core/sort/include/sample_sort.hpp"
+#include "core/sort/include/sorting_network.hpp"
+
 bool SortHoarWithMergeBatcher::pre_processing() {
   internal_order_test();
   // Init value for input and output
@@ -31,23 +36,9 @@ bool SortHoarWithMergeBatcher::post_processing() {
   return true;
 }
 
-int partition(std::vector<int>& a, int l, int r) {
-  int pivot = a[r];
-  int m = l;
-  for (int i = l; i <= r; i++) {
-    if (a[i] <= pivot) {
-      std::swap(a[i], a[m]);
-      m++;
-    }
-  }
-  return m - 1;
-}
-
 void Hoar_sort(std::vector<int>& a, int l, int r) {
   if (r <= l) return;
-  int m = partition(a, l, r);
-  Hoar_sort(a, l, m - 1);
-  Hoar_sort(a, m + 1, r);
+  ppc::core::sampleSort(a.data() + l, r - l + 1, std::less<int>(), 1);
 }
 
 std::vector<int> generate_data(int n, int mn, int mx) {
@@ -61,10 +52,6 @@ std::vector<int> generate_data(int n, int mn, int mx) {
   return ans;
 }
 
-void CompAndSwap(int& x, int& y) {
-  if (x > y) std::swap(x, y);
-}
-
 std::vector<int> odd_even_merge_with_hoar(std::vector<int>& my_data) {
   if (my_data.size() < 4) {
     Hoar_sort(my_data, 0, my_data.size() - 1);
@@ -73,28 +60,10 @@ std::vector<int> odd_even_merge_with_hoar(std::vector<int>& my_data) {
     return ans;
   }
   int n = my_data.size();
-  std::vector<int> a(n / 2);
-  std::vector<int> b(n / 2);
-  for (int i = 0; i < n / 2; i++) {
-    a[i] = my_data[i];
-    b[i] = my_data[i + n / 2];
-  }
-  Hoar_sort(a, 0, n / 2 - 1);
-  Hoar_sort(b, 0, n / 2 - 1);
-  std::vector<int> ans(n);
-  for (int i = 0; i < n / 2; i++) {
-    ans[i] = a[i];
-    ans[i + n / 2] = b[i];
-  }
-  for (int i = 0; i < n / 2; i++) {
-    CompAndSwap(ans[i], ans[n - i - 1]);
-  }
-  for (int k = n / 2; k >= 2; k /= 2) {
-    for (int i = 0; i < n / k; i++) {
-      for (int j = 0; j < k / 2; j++) {
-        CompAndSwap(ans[k * i + j], ans[k * i + j + k / 2]);
-      }
-    }
-  }
-  return ans;
+  std::vector<int> a(my_data.begin(), my_data.begin() + n / 2);
+  std::vector<int> b(my_data.begin() + n / 2, my_data.end());
+  Hoar_sort(a, 0, a.size() - 1);
+  Hoar_sort(b, 0, b.size() - 1);
+  // bitonic merge network on whole vectors; any n, not only powers of two
+  return ppc::core::networkMerge(a, b);
 }
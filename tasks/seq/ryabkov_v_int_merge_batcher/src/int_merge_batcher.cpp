@@ -1,60 +1,14 @@
 // Copyright 2024 Ryabkov Vladislav
 #include "seq/ryabkov_v_int_merge_batcher/include/int_merge_batcher.hpp"
 
-namespace ryabkov_batcher {
-void radix_sort(std::vector<int>& arr, int exp) {
-  const std::size_t n = arr.size();
-  std::vector<int> output(n);
-  std::vector<int> count(10, 0);
-
-  for (std::size_t i = 0; i < n; i++) count[(arr[i] / exp) % 10]++;
-
-  for (int i = 1; i < 10; i++) count[i] += count[i - 1];
-
-  for (int i = static_cast<int>(n) - 1; i >= 0; i--) {
-    output[count[(arr[i] / exp) % 10] - 1] = arr[i];
-    count[(arr[i] / exp) % 10]--;
-  }
-
-  for (std::size_t i = 0; i < n; i++) arr[i] = output[i];
-}
-
-void radix_sort(std::vector<int>& arr) {
-  const int max_element = *std::max_element(arr.begin(), arr.end());
-
-  for (int exp = 1; max_element / exp > 0; exp *= 10) {
-    radix_sort(arr, exp);
-  }
-}
-
-std::vector<int> batch_merge(const std::vector<int>& a1, const std::vector<int>& a2) {
-  std::vector<int> merged(a1.size() + a2.size());
-  std::size_t i = 0;
-  std::size_t j = 0;
-
-  for (std::size_t k = 0; k < merged.size(); ++k) {
-    if (i < a1.size() && (j >= a2.size() || a1[i] < a2[j])) {
-      merged[k] = a1[i++];
-    } else {
-      merged[k] = a2[j++];
-    }
-  }
-  return merged;
-}
+#include "core/sort/include/sorting_network.hpp"
 
+namespace ryabkov_batcher {
 std::vector<int> BatchSort(std::vector<int>& a1, std::vector<int>& a2) {
-  std::vector<int> merged = batch_merge(a1, a2);
-
-  for (size_t bit = 0; bit < sizeof(int) * 8; bit++) {
-    for (std::size_t i = 0; i < merged.size() / 2; i++) {
-      if (((i % 2 == 0) && ((merged[2 * i] >> bit) & 1) != 0) ||
-          ((i % 2 != 0) && ((merged[2 * i + 1] >> bit) & 1) != 0)) {
-        std::swap(merged[2 * i], merged[2 * i + 1]);
-      }
-    }
-  }
-
-  radix_sort(merged);
+  // each half is sorted by the vectorized network, then the halves are merged by bitonic networks
+  ppc::core::networkSort(a1, 1);
+  ppc::core::networkSort(a2, 1);
+  std::vector<int> merged = ppc::core::networkMerge(a1, a2);
 
   std::size_t n = merged.size() / 2;
   a1.assign(merged.begin(), merged.begin() + n);
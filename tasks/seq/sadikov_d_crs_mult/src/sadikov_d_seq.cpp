@@ -6,6 +6,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/transpose/include/transpose.hpp"
+
 bool check_CRS_properties(const matrix_CRS& A) {
   if (A.row_id.size() != size_t(A.n + 1)) return false;
   int nz = A.value.size();
@@ -25,21 +27,10 @@ matrix_CRS transpose_CRS(const matrix_CRS& B) {
   B_T.n = B.m;
   B_T.m = B.n;
   B_T.row_id.assign(B_T.n + 1, 0);
-  std::vector<std::vector<std::pair<int, std::complex<double>>>> temp(B_T.n);
-  for (int i = 0; i < B.n; i++) {
-    for (int k = B.row_id[i]; k < B.row_id[i + 1]; k++) {
-      int j = B.col[k];
-      temp[j].emplace_back(i, B.value[k]);
-    }
-  }
-  for (int i = 0; i < B_T.n; i++) {
-    B_T.row_id[i + 1] = B_T.row_id[i];
-    for (auto& j : temp[i]) {
-      B_T.col.push_back(j.first);
-      B_T.value.push_back(j.second);
-      B_T.row_id[i + 1]++;
-    }
-  }
+  B_T.col.resize(B.col.size());
+  B_T.value.resize(B.value.size());
+  ppc::core::transposeCRS(B.n, B.m, B.row_id.data(), B.col.data(), B.value.data(), B_T.row_id.data(), B_T.col.data(),
+                          B_T.value.data(), 1);
   return B_T;
 }
 
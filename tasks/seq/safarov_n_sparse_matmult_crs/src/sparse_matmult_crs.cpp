@@ -6,6 +6,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/transpose/include/transpose.hpp"
+
 SparseMatrixCRS::SparseMatrixCRS(int _numberOfColumns, int _numberOfRows, const std::vector<double>& _values,
                                  const std::vector<int>& _columnIndexes, const std::vector<int>& _pointers)
     : numberOfColumns(_numberOfColumns),
@@ -37,29 +39,14 @@ SparseMatrixCRS::SparseMatrixCRS(std::vector<std::vector<double>> matrix) {
 }
 
 SparseMatrixCRS sparseMatrixTransposeCRS(const SparseMatrixCRS& object) {
-  SparseMatrixCRS matrix;
-  std::vector<std::vector<int>> locCVec(object.numberOfColumns);
-  std::vector<std::vector<double>> locVecVal(object.numberOfColumns);
-  matrix.numberOfColumns = object.numberOfRows;
-  int elementCounter = 0;
-  matrix.numberOfRows = object.numberOfColumns;
-
-  for (int r = 0; r < object.numberOfRows; r++) {
-    for (int index = object.pointers[r]; index < object.pointers[r + 1]; index++) {
-      int cIndex = object.columnIndexes[index];
-      locCVec[cIndex].push_back(r);
-      locVecVal[cIndex].push_back(object.values[index]);
-    }
-  }
-  matrix.pointers.push_back(elementCounter);
-  for (int c = 0; c < object.numberOfColumns; c++) {
-    for (size_t ktmp = 0; ktmp < locCVec[c].size(); ktmp++) {
-      matrix.columnIndexes.push_back(locCVec[c][ktmp]);
-      matrix.values.push_back(locVecVal[c][ktmp]);
-    }
-    elementCounter += locCVec[c].size();
-    matrix.pointers.push_back(elementCounter);
-  }
+  SparseMatrixCRS matrix(object.numberOfRows, object.numberOfColumns);
+  matrix.pointers.assign(object.numberOfColumns + 1, 0);
+  if (object.pointers.empty()) return matrix;
+  matrix.columnIndexes.resize(object.values.size());
+  matrix.values.resize(object.values.size());
+  ppc::core::transposeCRS(object.numberOfRows, object.numberOfColumns, object.pointers.data(),
+                          object.columnIndexes.data(), object.values.data(), matrix.pointers.data(),
+                          matrix.columnIndexes.data(), matrix.values.data(), 1);
   return matrix;
 }
 
@@ -70,13 +57,7 @@ bool SparseMatrixCRS::operator==(const SparseMatrixCRS& matrix) const {
 }
 
 std::vector<std::vector<double>> fillTheMatrixWithZeros(int columns, int rows) {
-  std::vector<std::vector<double>> result(rows);
-  for (int m = 0; m < rows; m++) {
-    for (int n = 0; n < columns; n++) {
-      result[m].push_back(0);
-    }
-  }
-  return result;
+  return std::vector<std::vector<double>>(rows, std::vector<double>(columns, 0.0));
 }
 
 std::vector<std::vector<double>> multiplyMatrices(std::vector<std::vector<double>> A,
@@ -6,6 +6,8 @@
 #include <iostream>
 #include <random>
 
+#include "core/gemm/include/gemm.hpp"
+
 using namespace std::chrono_literals;
 
 bool SafronovSeqFoxAlgTask::validation() {
@@ -85,13 +87,5 @@ std::vector<double> mulSafronov(const std::vector<double> &A, const std::vector<
   if (n == 0) {
     return std::vector<double>();
   }
-  std::vector<double> C(n * n, 0.0);
-  for (int i = 0; i < n; i++) {
-    for (int j = 0; j < n; j++) {
-      for (int k = 0; k < n; k++) {
-        C[i * n + j] += A[i * n + k] * B[k * n + j];
-      }
-    }
-  }
-  return C;
+  return ppc::core::gemm(A, B, n, n, n);
 }
\ No newline at end of file
@@ -22,5 +22,6 @@ class SaratovaTaskSequential : public ppc::core::Task {
 
  private:
   double *A{}, *B{}, *C{};
+  std::vector<double> BT;
   size_t n{};
 };
@@ -3,14 +3,15 @@
 
 #include <thread>
 
+#include "core/sort/include/shell_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool ShellTaskSequential::pre_processing() {
   internal_order_test();
   // Init value for input and output
-  for (int i = 0; i < static_cast<int>(taskData->inputs_count[0]); i++) {
-    input_.push_back(reinterpret_cast<int*>(taskData->inputs[0])[i]);
-  }
+  auto* input = reinterpret_cast<int*>(taskData->inputs[0]);
+  input_.assign(input, input + taskData->inputs_count[0]);
   return true;
 }
 
@@ -37,18 +38,7 @@ bool ShellTaskSequential::post_processing() {
 
 std::vector<int> ShellTaskSequential::ShellSort(const std::vector<int>& input) {
   std::vector<int> vec(input);
-
-  for (int interval = static_cast<int>(vec.size()) / 2; interval > 0; interval /= 2) {
-    for (int i = interval; i < static_cast<int>(vec.size()); i++) {
-      int tmp = vec[i];
-      int j = i;
-      for (; j >= interval && vec[j - interval] > tmp; j = j - interval) {
-        vec[j] = vec[j - interval];
-      }
-      vec[j] = tmp;
-    }
-  }
-
+  ppc::core::shellSort(vec, ppc::core::ShellGaps::kCiura, 1);
   return vec;
 }
 
@@ -23,6 +23,4 @@ class ShmelevTaskSequential : public ppc::core::Task {
   std::vector<int> input_;
   std::vector<int> res;
   void batcherMerge(int l, int r);
-  void sortingShell();
-  void merge(int l, int m, int r);
 };
\ No newline at end of file
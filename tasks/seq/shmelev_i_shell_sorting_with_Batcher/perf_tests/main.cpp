@@ -7,7 +7,7 @@
 #include "seq/shmelev_i_shell_sorting_with_Batcher/include/ops_seq.hpp"
 
 TEST(shmelev_i_shell_sorting_with_Batcher, pipeline_run) {
-  const int count = 2048;
+  const int count = 1 << 22;
 
   // Create data
   std::vector<int> in = ShmelevTaskSequential::generate_random_vector(count, 1, 1024);
@@ -44,7 +44,7 @@ TEST(shmelev_i_shell_sorting_with_Batcher, pipeline_run) {
 }
 
 TEST(shmelev_i_shell_sorting_with_Batcher, task_run) {
-  const int count = 2048;
+  const int count = 1 << 22;
 
   // Create data
   std::vector<int> in = ShmelevTaskSequential::generate_random_vector(count, 1, 1024);
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 
+#include "core/sort/include/sorting_network.hpp"
+
 bool ShmelevTaskSequential::pre_processing() {
   internal_order_test();
   input_ = *reinterpret_cast<std::vector<int>*>(taskData->inputs[0]);
@@ -42,74 +44,15 @@ std::vector<int> ShmelevTaskSequential::generate_random_vector(int size, int min
   return vector;
 }
 
-void ShmelevTaskSequential::sortingShell() {
-  int n = input_.size();
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      int temp = input_[i];
-      int j;
-      for (j = i; j >= gap && input_[j - gap] > temp; j -= gap) {
-        input_[j] = input_[j - gap];
-      }
-      input_[j] = temp;
-    }
-  }
-}
-
+// the halves are sorted by the vectorized sorting network and joined by the bitonic merge network
 void ShmelevTaskSequential::batcherMerge(int l, int r) {
-  sortingShell();
-  if (r > l) {
-    int m = l + (r - l) / 2;
-    for (int i = l; i <= m; i += 2) {
-      if (i + 1 <= m) {
-        if (input_[i] > input_[i + 1]) {
-          std::swap(input_[i], input_[i + 1]);
-        }
-      }
-    }
-    batcherMerge(l, m);
-    batcherMerge(m + 1, r);
-    merge(l, m, r);
-  }
+  if (r <= l) return;
+  const int m = l + (r - l) / 2;
+  ppc::core::networkSort(input_.data() + l, m - l + 1, 1);
+  ppc::core::networkSort(input_.data() + m + 1, r - m, 1);
+  std::vector<int> merged(r - l + 1);
+  ppc::core::networkMerge(input_.data() + l, m - l + 1, input_.data() + m + 1, r - m, merged.data());
+  std::copy(merged.begin(), merged.end(), input_.begin() + l);
 }
-bool ShmelevTaskSequential::sorted(std::vector<int> input) { return std::is_sorted(input.begin(), input.end()); }
-
-void ShmelevTaskSequential::merge(int l, int m, int r) {
-  int n1 = m - l + 1;
-  int n2 = r - m;
 
-  std::vector<int> L(n1);
-  std::vector<int> R(n2);
-
-  for (int i = 0; i < n1; i++) {
-    L[i] = input_[l + i];
-  }
-  for (int j = 0; j < n2; j++) {
-    R[j] = input_[m + 1 + j];
-  }
-
-  int i = 0;
-  int j = 0;
-  int k = l;
-  while (i < n1 && j < n2) {
-    if (L[i] <= R[j]) {
-      input_[k] = L[i];
-      i++;
-    } else {
-      input_[k] = R[j];
-      j++;
-    }
-    k++;
-  }
-
-  while (i < n1) {
-    input_[k] = L[i];
-    i++;
-    k++;
-  }
-  while (j < n2) {
-    input_[k] = R[j];
-    j++;
-    k++;
-  }
-}
\ No newline at end of file
+bool ShmelevTaskSequential::sorted(std::vector<int> input) { return std::is_sorted(input.begin(), input.end()); }
@@ -205,3 +205,33 @@ TEST(shubin_m_double_crs_mult_seq, random_small_dim_mat_mult) {
     EXPECT_DOUBLE_EQ(res[i], C[i]);
   }
 }
+
+TEST(shubin_m_double_crs_mult_seq, triplets_to_crs) {
+  size_t mat_row = 40;
+  size_t mat_col = 30;
+
+  std::vector<CRS_triplet> triplets = random_triplets(mat_row, mat_col, 0.2);
+  std::vector<double> dense(mat_row * mat_col, 0.0);
+  for (const auto &t : triplets) {
+    dense[t.row * mat_col + t.col] = t.val;
+  }
+  // a repeated entry is summed, a cancelled one disappears
+  triplets.push_back({0, 0, 1.5});
+  triplets.push_back({0, 0, 2.0});
+  triplets.push_back({1, 2, 4.0});
+  triplets.push_back({1, 2, -4.0});
+  dense[0] += 3.5;
+
+  SparseMat_CRS expected(dense, mat_row, mat_col);
+  for (bool sort_cols : {true, false}) {
+    SparseMat_CRS mat = triplets_to_CRS(mat_row, mat_col, triplets, sort_cols);
+    ASSERT_EQ(mat.nz_c, expected.nz_c);
+    ASSERT_EQ(mat.row_ind, expected.row_ind);
+    std::vector<double> res = CRS_to_vector(mat);
+    for (size_t i = 0; i < res.size(); i++) {
+      EXPECT_DOUBLE_EQ(res[i], dense[i]);
+    }
+  }
+
+  EXPECT_ANY_THROW(triplets_to_CRS(mat_row, mat_col, {{mat_row, 0, 1.0}}));
+}
@@ -23,6 +23,21 @@ class SparseMat_CRS {
   ~SparseMat_CRS() = default;
 };
 
+struct CRS_triplet {
+  size_t row;
+  size_t col;
+  double val;
+};
+
+// COO -> CRS by a counting sort on rows; repeated (row, col) entries are summed and sums
+// within PRECISION of zero are dropped. Without sort_cols the columns keep their input order.
+SparseMat_CRS triplets_to_CRS(size_t _row_c, size_t _col_c, const std::vector<CRS_triplet>& triplets,
+                              bool sort_cols = true);
+
+// Each element is nonzero with probability dens; the triplets come out in row-major order.
+std::vector<CRS_triplet> random_triplets(size_t _row_c, size_t _col_c, double dens = 0.1, double _min = -100.0,
+                                         double _max = 100.0);
+
 SparseMat_CRS random_CRS_mat(size_t _row_c, size_t _col_c, double dens = 0.1, double _min = -100.0,
                              double _max = 100.0);
 
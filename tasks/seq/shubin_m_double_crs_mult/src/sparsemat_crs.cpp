@@ -2,7 +2,10 @@
 
 #include "seq/shubin_m_double_crs_mult/include/sparsemat_crs.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <utility>
 
 SparseMat_CRS::SparseMat_CRS(size_t _row_c, size_t _col_c) {
   row_c = _row_c;
@@ -18,7 +21,11 @@ SparseMat_CRS::SparseMat_CRS(size_t _row_c, size_t _col_c, size_t _nz_c) {
 SparseMat_CRS::SparseMat_CRS(const std::vector<double>& matrix, size_t _row_c, size_t _col_c) {
   row_c = _row_c;
   col_c = _col_c;
-  nz_c = 0;
+  nz_c = std::count_if(matrix.begin(), matrix.begin() + row_c * col_c,
+                       [](double temp) { return std::abs(temp) > PRECISION; });
+  val.reserve(nz_c);
+  col_ind.reserve(nz_c);
+  row_ind.reserve(row_c + 1);
   for (size_t i = 0; i < row_c; i++) {
     row_ind.push_back(val.size());
     for (size_t j = 0; j < col_c; j++) {
@@ -26,31 +33,96 @@ SparseMat_CRS::SparseMat_CRS(const std::vector<double>& matrix, size_t _row_c, s
       if (std::abs(temp) > PRECISION) {
         val.push_back(temp);
         col_ind.push_back(j);
-        nz_c++;
       }
     }
   }
   row_ind.push_back(val.size());
 }
 
-SparseMat_CRS random_CRS_mat(size_t _row_c, size_t _col_c, double dens, double _min, double _max) {
-  auto nz_max = static_cast<size_t>(static_cast<double>(_row_c * _col_c) * dens);
-  std::vector<double> matrix(_row_c * _col_c, 0.0);
+SparseMat_CRS triplets_to_CRS(size_t _row_c, size_t _col_c, const std::vector<CRS_triplet>& triplets, bool sort_cols) {
+  for (const auto& t : triplets) {
+    if (t.row >= _row_c || t.col >= _col_c) {
+      throw std::out_of_range("triplet index out of range");
+    }
+  }
+
+  // counting sort by row, stable inside a row
+  std::vector<size_t> start(_row_c + 1, 0);
+  for (const auto& t : triplets) start[t.row + 1]++;
+  for (size_t i = 0; i < _row_c; i++) start[i + 1] += start[i];
+  std::vector<std::pair<size_t, double>> entries(triplets.size());
+  std::vector<size_t> next(start.begin(), start.end() - 1);
+  for (const auto& t : triplets) entries[next[t.row]++] = {t.col, t.val};
+
+  SparseMat_CRS res(_row_c, _col_c, 0);
+  res.val.reserve(entries.size());
+  res.col_ind.reserve(entries.size());
+  res.row_ind.reserve(_row_c + 1);
+  // slot[j] is the position of column j in the output while seen[j] marks the current row
+  std::vector<size_t> seen(sort_cols ? 0 : _col_c, _row_c);
+  std::vector<size_t> slot(sort_cols ? 0 : _col_c);
+  for (size_t i = 0; i < _row_c; i++) {
+    size_t row_begin = res.val.size();
+    res.row_ind.push_back(row_begin);
+    auto first = entries.begin() + start[i];
+    auto last = entries.begin() + start[i + 1];
+    if (sort_cols) {
+      std::sort(first, last, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    }
+    for (auto it = first; it != last; ++it) {
+      if (sort_cols && res.val.size() > row_begin && res.col_ind.back() == it->first) {
+        res.val.back() += it->second;
+      } else if (!sort_cols && seen[it->first] == i) {
+        res.val[slot[it->first]] += it->second;
+      } else {
+        if (!sort_cols) {
+          seen[it->first] = i;
+          slot[it->first] = res.val.size();
+        }
+        res.val.push_back(it->second);
+        res.col_ind.push_back(it->first);
+      }
+    }
+    size_t kept = row_begin;
+    for (size_t k = row_begin; k < res.val.size(); k++) {
+      if (std::abs(res.val[k]) > PRECISION) {
+        res.val[kept] = res.val[k];
+        res.col_ind[kept++] = res.col_ind[k];
+      }
+    }
+    res.val.resize(kept);
+    res.col_ind.resize(kept);
+  }
+  res.row_ind.push_back(res.val.size());
+  res.nz_c = res.val.size();
+
+  return res;
+}
+
+std::vector<CRS_triplet> random_triplets(size_t _row_c, size_t _col_c, double dens, double _min, double _max) {
+  std::vector<CRS_triplet> res;
+  if (dens <= 0.0 || _col_c == 0) return res;
+  res.reserve(static_cast<size_t>(static_cast<double>(_row_c) * static_cast<double>(_col_c) * std::min(dens, 1.0)));
 
   std::random_device rd;
   std::mt19937 gen(rd());
   std::uniform_real_distribution<double> value_dist(_min, _max);
-  std::uniform_int_distribution<size_t> index_dist(0, _row_c * _col_c - 1);
+  // distance to the next nonzero is geometric, so the cost is proportional to the nonzeros
+  std::geometric_distribution<size_t> gap_dist(std::min(dens, 1.0));
 
-  for (size_t i = 0; i < nz_max; i++) {
-    matrix[index_dist(gen)] = value_dist(gen);
+  for (size_t i = 0; i < _row_c; i++) {
+    for (size_t j = gap_dist(gen); j < _col_c; j += gap_dist(gen) + 1) {
+      res.push_back({i, j, value_dist(gen)});
+    }
   }
 
-  SparseMat_CRS res(matrix, _row_c, _col_c);
-
   return res;
 }
 
+SparseMat_CRS random_CRS_mat(size_t _row_c, size_t _col_c, double dens, double _min, double _max) {
+  return triplets_to_CRS(_row_c, _col_c, random_triplets(_row_c, _col_c, dens, _min, _max));
+}
+
 SparseMat_CRS ident_CRS_mat(size_t _size) {
   SparseMat_CRS res(_size, _size, _size);
 
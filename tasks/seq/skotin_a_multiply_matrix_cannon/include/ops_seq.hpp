@@ -17,7 +17,7 @@ class MatrixMultiplicationTask : public ppc::core::Task {
 
  private:
   std::vector<std::vector<double>> matrixA;
-  std::vector<std::vector<double>> matrixB;
+  std::vector<std::vector<double>> matrixB;  // transposed
   std::vector<std::vector<double>> resultMatrix;
 
   static bool loadMatrix(const std::vector<double>& inputData, std::vector<std::vector<double>>& matrix, size_t size);
@@ -5,6 +5,8 @@
 #include <cmath>
 #include <cstring>
 
+#include "core/transpose/include/transpose.hpp"
+
 bool MatrixMultiplicationTask::pre_processing() {
   size_t totalElementsPerMatrix = taskData->inputs_count[0] / sizeof(double);
   size_t matrixSize = std::sqrt(totalElementsPerMatrix);
@@ -25,7 +27,9 @@ bool MatrixMultiplicationTask::pre_processing() {
   std::vector<double> matrixBData(matrixSize * matrixSize);
   memcpy(matrixBData.data(), taskData->inputs[1], taskData->inputs_count[1]);
 
-  if (!loadMatrix(matrixBData, matrixB, matrixSize)) {
+  // B is kept transposed so run() reads its columns as contiguous rows
+  const int size = static_cast<int>(matrixSize);
+  if (!loadMatrix(ppc::core::transpose(matrixBData, size, size), matrixB, matrixSize)) {
     std::cerr << "Failed to load matrix B." << std::endl;
     return false;
   }
@@ -50,7 +54,7 @@ bool MatrixMultiplicationTask::run() {
         for (size_t j = blockCol; j < std::min(blockCol + blockSize, n); ++j) {
           double sum = 0.0;
           for (size_t k = blockRow; k < std::min(blockRow + blockSize, n); ++k) {
-            sum += matrixA[i][k] * matrixB[k][j];
+            sum += matrixA[i][k] * matrixB[j][k];
           }
           resultMatrix[i][j] += sum;
         }
@@ -20,10 +20,10 @@ std::vector<int> getRandomVector(int length) {
 }
 
 TEST(Smirnov_L_Radix_Sort_Test, test_pipeline_run) {
-  const int count = 300000;
+  const int count = 5000000;
 
   // Create data
-  std::vector<int> in = getRandomVector(300000);
+  std::vector<int> in = getRandomVector(count);
   std::vector<int> expected = in;
   std::vector<int> out(count);
 
@@ -63,7 +63,7 @@ TEST(Smirnov_L_Radix_Sort_Test, test_pipeline_run) {
 }
 
 TEST(Smirnov_L_Radix_Sort_Test, test_task_run) {
-  const int count = 300000;
+  const int count = 5000000;
 
   // Create data
   std::vector<int> in = getRandomVector(count);
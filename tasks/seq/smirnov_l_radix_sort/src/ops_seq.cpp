@@ -1,8 +1,7 @@
 // Copyright 2024 Smirnov Leonid
 #include "seq/smirnov_l_radix_sort/include/ops_seq.hpp"
 
-#include <algorithm>
-#include <cmath>
+#include "core/sort/include/radix_sort.hpp"
 
 bool RadixSortSequential::validation() {
   internal_order_test();
@@ -36,42 +35,7 @@ bool RadixSortSequential::pre_processing() {
 bool RadixSortSequential::run() {
   internal_order_test();
   try {
-    std::vector<int> temporaryArray = work_vector;
-
-    int maxElem = *std::max_element(temporaryArray.begin(), temporaryArray.end());
-    int numDigitsMaxElement = maxElem == 0 ? 1 : static_cast<int>(log10(abs(maxElem))) + 1;
-
-    for (int digitIndex = 0; digitIndex < numDigitsMaxElement; digitIndex++) {
-      int devider = static_cast<int>(pow(10, digitIndex));
-      int minDigit = temporaryArray[0] % (devider * 10) / devider;
-      int maxDigit = minDigit;
-
-      for (size_t i = 0; i < temporaryArray.size(); i++) {
-        int currentDigit = temporaryArray[i] % (devider * 10) / devider;
-        minDigit = std::min(minDigit, currentDigit);
-        maxDigit = std::max(maxDigit, currentDigit);
-      }
-
-      std::vector<int> frequency(maxDigit - minDigit + 1);
-      for (size_t i = 0; i < temporaryArray.size(); i++) {
-        int keyCurrentDigit = temporaryArray[i] % (devider * 10) / devider;
-        frequency[keyCurrentDigit - minDigit]++;
-      }
-
-      int cumulativeSum = 0;
-      for (int& c : frequency) {
-        cumulativeSum += c;
-        c = cumulativeSum;
-      }
-
-      std::vector<int> tempSorted(temporaryArray.size());
-      for (int i = static_cast<int>(temporaryArray.size()) - 1; i >= 0; i--) {
-        int key = temporaryArray[i] % (devider * 10) / devider;
-        tempSorted[--frequency[key - minDigit]] = temporaryArray[i];
-      }
-      temporaryArray = tempSorted;
-    }
-    work_vector = temporaryArray;
+    ppc::core::radixSort(work_vector, 0, 1);
     return true;
   } catch (...) {
     return false;
@@ -1,6 +1,9 @@
 // Copyright 2024 Soloninko Andrey
 
 #include "seq/soloninko_a_radix_int_batcher/include/ops_seq.hpp"
+
+#include "core/sort/include/radix_sort.hpp"
+
 using namespace std::chrono_literals;
 
 void sol_fill_missing(std::vector<int> &res, std::vector<int> p1, std::vector<int> p2, size_t i, size_t j, size_t k) {
@@ -103,8 +106,8 @@ bool TaskSequentialBatcherSoloninko::pre_processing() {
     p2[i] = in_vec[(in_vec.size() / 2) + i];
   }
 
-  std::sort(p1.begin(), p1.end());
-  std::sort(p2.begin(), p2.end());
+  ppc::core::radixSort(p1, 0, 1);
+  ppc::core::radixSort(p2, 0, 1);
 
   return true;
 }
@@ -2,10 +2,13 @@
 #include "stl/eremin_a_int_radixsort/include/ops_seq.hpp"
 
 #include <algorithm>
-#include <cmath>
 #include <iostream>
+#include <span>
 #include <thread>
 
+#include "core/sort/include/multiway_merge.hpp"
+#include "core/sort/include/radix_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool RadixSortTaskSTL::pre_processing() {
@@ -30,107 +33,43 @@ bool RadixSortTaskSTL::validation() {
          taskData->inputs[0] != nullptr && taskData->inputs_count[0] != 0;
 }
 
-std::vector<int> radixSort(std::vector<int> vec) {
-  std::vector<int> VectorForSort_;
-  VectorForSort_ = vec;
-  int numDevider = 0;
-  int maxNum = 0;
-  int MinKey;
-  int MaxKey;
-
-  for (size_t i = 0; i < VectorForSort_.size(); i++) {
-    if (maxNum <= VectorForSort_[i]) {
-      maxNum = VectorForSort_[i];
-    }
-  }
-
-  if (maxNum == 0) {
-    numDevider = 1;
-  } else
-    numDevider = log10(abs(maxNum)) + 1;
-
-  for (int dev = 0; dev < numDevider; dev++) {
-    int devider = pow(10, dev);
-
-    MinKey = VectorForSort_[0] % (devider * 10) / devider;
-
-    MaxKey = MinKey;
-
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      int digit = VectorForSort_[i] % (devider * 10) / devider;
-      if (digit < MinKey) {
-        MinKey = digit;
-      }
-      if (digit > MaxKey) {
-        MaxKey = digit;
-      }
-    }
-
-    std::vector<int> count(MaxKey - MinKey + 1);
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]++;
-    }
-
-    int size = VectorForSort_.size();
-    for (int i = count.size() - 1; i >= 0; i--) {
-      size -= count[i];
-      count[i] = size;
-    }
-    std::vector<int> temp(VectorForSort_.size());
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      temp[count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]] = VectorForSort_[i];
-      count[(VectorForSort_[i] % (devider * 10) / devider) - MinKey]++;
-    }
-    for (size_t i = 0; i < VectorForSort_.size(); i++) {
-      VectorForSort_[i] = temp[i];
-    }
-  }
-  vec = VectorForSort_;
-  return vec;
-}
-
-std::vector<int> myMerge(std::vector<int>* OneVector, std::vector<int>* TwoVector) {
-  std::vector<int> result(OneVector->size() + TwoVector->size());
-  std::merge((*OneVector).begin(), (*OneVector).end(), (*TwoVector).begin(), (*TwoVector).end(), result.begin());
-  return result;
-}
-
 bool RadixSortTaskSTL::run() {
   internal_order_test();
   try {
-    std::vector<int> result;
-    int VectorSize = VectorForSort.size();
-
-    int threadNum = std::thread::hardware_concurrency();
+    size_t VectorSize = VectorForSort.size();
+    size_t threadNum = std::max(1U, std::thread::hardware_concurrency());
+    threadNum = std::min(threadNum, VectorSize);
 
-    if (threadNum >= VectorSize) {
-      threadNum = VectorSize;
-    }
+    // every thread radix sorts one chunk in place
+    std::vector<std::span<const int>> runs(threadNum);
     std::vector<std::thread> threads(threadNum);
-    std::vector<std::vector<int>> VectorForSortLocal(threadNum);
-    for (int i = 0; i < threadNum; i++) {
-      int currentThread = i;
-      if (currentThread < VectorSize) {
-        int step = VectorSize / threadNum;
-        int left = step * currentThread;
-        int righ = step * (currentThread + 1);
-        if (currentThread == threadNum - 1) {
-          righ += VectorSize - step * threadNum;
-        }
-        VectorForSortLocal[i] = std::vector<int>(VectorForSort.begin() + left, VectorForSort.begin() + righ);
-      }
-      threads[i] =
-          std::thread([i, &VectorForSortLocal]() { VectorForSortLocal[i] = radixSort(VectorForSortLocal[i]); });
+    for (size_t i = 0; i < threadNum; i++) {
+      size_t left = VectorSize * i / threadNum;
+      size_t right = VectorSize * (i + 1) / threadNum;
+      runs[i] = std::span<const int>(VectorForSort.data() + left, right - left);
+      threads[i] = std::thread([this, left, right]() {
+        ppc::core::radixSort(&VectorForSort[left], right - left, 0, 1);
+      });
     }
     for (auto& t : threads) {
       t.join();
     }
 
-    for (int i = 0; i < threadNum; i++) {
-      result = myMerge(&result, &VectorForSortLocal[i]);
+    // then every thread merges an equal share of the output from all chunks at once
+    std::vector<int> result(VectorSize);
+    for (size_t i = 0; i < threadNum; i++) {
+      threads[i] = std::thread([&runs, &result, i, VectorSize, threadNum]() {
+        size_t left = VectorSize * i / threadNum;
+        size_t right = VectorSize * (i + 1) / threadNum;
+        ppc::core::multiwayMergePart(runs, ppc::core::multiwaySplit(runs, left),
+                                     ppc::core::multiwaySplit(runs, right), result.data() + left);
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
     }
 
-    VectorForSort = result;
+    VectorForSort = std::move(result);
   } catch (...) {
     return false;
   }
@@ -2,9 +2,14 @@
 #include "tbb/derun_a_shell/include/shell_tbb.hpp"
 
 #include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
 
+#include <span>
 #include <thread>
 
+#include "core/sort/include/multiway_merge.hpp"
+#include "core/sort/include/shell_sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool ShellTBB::pre_processing() {
@@ -42,81 +47,29 @@ bool ShellTBB::post_processing() {
   return true;
 }
 
-std::vector<int> ShellTBB::merge(const std::vector<std::vector<int>>& chunks) {
-  std::vector<int> result;
-
-  // Merge the sorted chunks
-  for (const auto& chunk : chunks) {
-    // Merge the current chunk with the result vector
-    std::vector<int> merged;
-    merged.reserve(result.size() + chunk.size());
-    auto resultIter = result.begin();
-    auto chunkIter = chunk.begin();
-
-    while (resultIter != result.end() && chunkIter != chunk.end()) {
-      if (*resultIter < *chunkIter) {
-        merged.push_back(*resultIter);
-        ++resultIter;
-      } else {
-        merged.push_back(*chunkIter);
-        ++chunkIter;
-      }
-    }
-
-    // Copy remaining elements from result vector
-    while (resultIter != result.end()) {
-      merged.push_back(*resultIter);
-      ++resultIter;
-    }
-
-    // Copy remaining elements from current chunk
-    while (chunkIter != chunk.end()) {
-      merged.push_back(*chunkIter);
-      ++chunkIter;
-    }
-
-    // Update result vector with merged vector
-    result = std::move(merged);
-  }
-
-  return result;
-}
-
 void ShellTBB::shell_sort_parallel(std::vector<int>& input) {
-  int numProcs = 4;
-  // int numProcs = tbb::task_scheduler_init::default_num_threads();
-  int size = static_cast<int>(input.size());
-  int chunkSize = size / numProcs;
-  int remainder = size % numProcs;
-
-  std::vector<std::vector<int>> chunks(numProcs);
-
-  tbb::parallel_for(0, numProcs, [&](int i) {
-    int startIdx = i * chunkSize;
-    int endIdx = startIdx + chunkSize;
-    if (i == numProcs - 1) {
-      endIdx += remainder;  // Add remaining elements to the last chunk
-    }
-    chunks[i].assign(input.begin() + startIdx, input.begin() + endIdx);
-    shell_sort(chunks[i]);
+  const size_t size = input.size();
+  const auto numProcs = static_cast<size_t>(std::max(1, tbb::this_task_arena::max_concurrency()));
+  const size_t chunksCount = std::min(numProcs, size);
+
+  // every worker sorts one chunk in place with serial Ciura gaps
+  std::vector<std::span<const int>> chunks(chunksCount);
+  tbb::parallel_for(size_t{0}, chunksCount, [&](size_t i) {
+    size_t startIdx = size * i / chunksCount;
+    size_t endIdx = size * (i + 1) / chunksCount;
+    ppc::core::shellSort(input.data() + startIdx, endIdx - startIdx, ppc::core::ShellGaps::kCiura, 1);
+    chunks[i] = std::span<const int>(input.data() + startIdx, endIdx - startIdx);
   });
 
-  // Barrier is not needed in TBB
-
-  input = merge(chunks);
-}
-
-void ShellTBB::shell_sort(std::vector<int>& vec) {
-  for (int interval = static_cast<int>(vec.size()) / 2; interval > 0; interval /= 2) {
-    for (int i = interval; i < static_cast<int>(vec.size()); i++) {
-      int tmp = vec[i];
-      int j = i;
-      for (; j >= interval && vec[j - interval] > tmp; j -= interval) {
-        vec[j] = vec[j - interval];
-      }
-      vec[j] = tmp;
-    }
-  }
+  // then every worker merges an equal share of the output from all chunks at once
+  std::vector<int> result(size);
+  tbb::parallel_for(size_t{0}, chunksCount, [&](size_t i) {
+    size_t first = size * i / chunksCount;
+    size_t last = size * (i + 1) / chunksCount;
+    ppc::core::multiwayMergePart(chunks, ppc::core::multiwaySplit(chunks, first),
+                                 ppc::core::multiwaySplit(chunks, last), result.data() + first);
+  });
+  input = std::move(result);
 }
 
 bool ShellTBB::checkSorted(std::vector<int> input) { return std::is_sorted(input.begin(), input.end()); }
@@ -7,22 +7,10 @@
 #include <iostream>
 #include <thread>
 
+#include "core/gemm/include/gemm.hpp"
+
 using namespace std::chrono_literals;
 namespace {
-std::vector<std::vector<double>> multiply_block(const std::vector<std::vector<double>>& block_A,
-                                                const std::vector<std::vector<double>>& block_B) {
-  size_t blockSize = block_A.size();
-  std::vector<std::vector<double>> block_C(blockSize, std::vector<double>(blockSize, 0.0));
-  for (size_t i = 0; i < blockSize; ++i) {
-    for (size_t j = 0; j < blockSize; ++j) {
-      for (size_t k = 0; k < blockSize; ++k) {
-        block_C[i][j] += block_A[i][k] * block_B[k][j];
-      }
-    }
-  }
-  return block_C;
-}
-
 int calculateBlockSize(int n, int cacheSize = 1024, int elementSize = 8) {
   int b = std::sqrt((cacheSize) / (elementSize * 2));
 
@@ -73,25 +61,14 @@ bool FoxAlgorithm::run() {
     std::vector<std::vector<double>> result(data_size, std::vector<double>(data_size, 0.0));
 
     tbb::parallel_for(0, numBlocks, [&](int stage) {
-      std::vector<std::vector<double>> local_matrix_C(data_size, std::vector<double>(data_size, 0.0));
+      std::vector<double> local_matrix_C(data_size * data_size, 0.0);
 
       for (int i = 0; i < numBlocks; ++i) {
         for (int j = 0; j < numBlocks; ++j) {
           int k = (i + stage) % numBlocks;
-          std::vector<std::vector<double>> block_A(blockSize, std::vector<double>(blockSize));
-          std::vector<std::vector<double>> block_B(blockSize, std::vector<double>(blockSize));
-          for (int row = 0; row < blockSize; ++row) {
-            for (int col = 0; col < blockSize; ++col) {
-              block_A[row][col] = matrix_A[((i * blockSize) + row) * n + (k * blockSize) + col];
-              block_B[row][col] = matrix_B[((k * blockSize) + row) * n + (j * blockSize) + col];
-            }
-          }
-          std::vector<std::vector<double>> block_C = multiply_block(block_A, block_B);
-          for (int row = 0; row < blockSize; ++row) {
-            for (int col = 0; col < blockSize; ++col) {
-              local_matrix_C[i * blockSize + row][j * blockSize + col] += block_C[row][col];
-            }
-          }
+          ppc::core::gemm(blockSize, blockSize, blockSize, matrix_A + (i * blockSize) * n + (k * blockSize), n,
+                          matrix_B + (k * blockSize) * n + (j * blockSize), n,
+                          local_matrix_C.data() + (i * blockSize) * n + (j * blockSize), n, true);
         }
       }
 
@@ -99,7 +76,7 @@ bool FoxAlgorithm::run() {
       tbb::mutex::scoped_lock lock(mutex);
       for (size_t i = 0; i < data_size; ++i) {
         for (size_t j = 0; j < data_size; ++j) {
-          matrix_C[i * data_size + j] += local_matrix_C[i][j];
+          matrix_C[i * data_size + j] += local_matrix_C[i * data_size + j];
         }
       }
     });
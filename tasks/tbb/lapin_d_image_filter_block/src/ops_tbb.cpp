@@ -4,10 +4,13 @@
 #include <tbb/parallel_for.h>
 #include <tbb/tbb.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <vector>
 
+#include "core/image/include/separable_filter.hpp"
+
 int Clamp(int value, int min, int max) {
   if (value < min) {
     return min;
@@ -18,18 +21,16 @@ int Clamp(int value, int min, int max) {
   return value;
 }
 
-std::vector<std::vector<double>> create2DFilter(int n, double sigma) {
+// The 3 x 3 filter coeff * exp(-(x^2 + y^2) / (2 sigma^2)) is the outer product of this 1D filter
+// with itself, so it is applied as one pass along rows and one along columns.
+std::vector<double> create1DFilter(int n, double sigma) {
   double PI = 3.141592653;
-  std::vector<double> temp(3);
-  std::vector<std::vector<double>> filter(3, temp);
-  double coeff = 1.0 / (2.0 * PI * sigma * sigma);
+  std::vector<double> filter(n);
+  double coeff = 1.0 / std::sqrt(2.0 * PI * sigma * sigma);
   int middle = n / 2;
   for (int i = 0; i < n; i++) {
-    for (int j = 0; j < n; j++) {
-      auto x = double(j - middle);
-      auto y = double(i - middle);
-      filter[i][j] = coeff * exp(-(x * x + y * y) / (2.0 * sigma * sigma));
-    }
+    auto x = double(i - middle);
+    filter[i] = coeff * exp(-(x * x) / (2.0 * sigma * sigma));
   }
   return filter;
 }
@@ -50,18 +51,16 @@ bool BlockFilterTBBTaskSequential::validation() {
 
 bool BlockFilterTBBTaskSequential::run() {
   internal_order_test();
-  std::vector<std::vector<double>> kernel = create2DFilter(3, 1);
+  std::vector<double> kernel = create1DFilter(3, 1);
+  std::vector<double> image(height * width);
+  std::vector<double> result(height * width);
+  for (int i = 0; i < height; i++) {
+    std::copy((*mas_in)[i].begin(), (*mas_in)[i].end(), image.begin() + i * width);
+  }
+  ppc::core::separableFilter(image.data(), result.data(), width, height, 1, kernel, kernel, 1);
   for (int i = 0; i < height; i++) {
     for (int j = 0; j < width; j++) {
-      double result = 0;
-      for (int l = -1; l <= 1; l++) {
-        for (int k = -1; k <= 1; k++) {
-          int idX = Clamp(i + k, 0, height - 1);
-          int idY = Clamp(j + l, 0, width - 1);
-          result += (*mas_in)[idX][idY] * kernel[k + 1][l + 1];
-        }
-      }
-      (*mas_out)[i][j] = Clamp((int)result, 0, 255);
+      (*mas_out)[i][j] = Clamp((int)result[i * width + j], 0, 255);
     }
   }
   return true;
@@ -88,23 +87,24 @@ bool BlockFilterTBBTaskParallel::validation() {
 
 bool BlockFilterTBBTaskParallel::run() {
   internal_order_test();
-  std::vector<std::vector<double>> kernel = create2DFilter(3, 1);
-  oneapi::tbb::parallel_for(oneapi::tbb::blocked_range2d<int, int>(0, height, 0, width),
-                            [&](oneapi::tbb::blocked_range2d<int, int> &r) {
-                              for (int i = r.rows().begin(), i_end = r.rows().end(); i < i_end; i++) {
-                                for (int j = r.cols().begin(), j_end = r.cols().end(); j < j_end; j++) {
-                                  double result = 0;
-                                  for (int l = -1; l <= 1; l++) {
-                                    for (int k = -1; k <= 1; k++) {
-                                      int idX = Clamp(i + k, 0, height - 1);
-                                      int idY = Clamp(j + l, 0, width - 1);
-                                      result += (*mas_in)[idX][idY] * kernel[k + 1][l + 1];
-                                    }
-                                  }
-                                  (*mas_out)[i][j] = Clamp((int)result, 0, 255);
-                                }
-                              }
-                            });
+  std::vector<double> kernel = create1DFilter(3, 1);
+  std::vector<double> image(height * width);
+  std::vector<double> result(height * width);
+  oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<int>(0, height), [&](oneapi::tbb::blocked_range<int> &r) {
+    for (int i = r.begin(); i < r.end(); i++) {
+      std::copy((*mas_in)[i].begin(), (*mas_in)[i].end(), image.begin() + i * width);
+    }
+  });
+  // every band filters the row above and below it once more, so bands are kept at 64 rows or more
+  oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<int>(0, height, 64), [&](oneapi::tbb::blocked_range<int> &r) {
+    ppc::core::separableFilterRows(image.data(), result.data(), width, height, 1, kernel, kernel, r.begin(),
+                                   r.end());
+    for (int i = r.begin(); i < r.end(); i++) {
+      for (int j = 0; j < width; j++) {
+        (*mas_out)[i][j] = Clamp((int)result[i * width + j], 0, 255);
+      }
+    }
+  });
   return true;
 }
 
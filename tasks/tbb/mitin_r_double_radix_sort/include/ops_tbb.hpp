@@ -20,7 +20,6 @@ class SortRadixDoubleTaskTBB : public ppc::core::Task {
  private:
   double* data_ptr;
   size_t data_size;
-  std::vector<double> bucket_arr[sizeof(double) * 256];
 };
 
 }  // namespace mitinr_radix_sort
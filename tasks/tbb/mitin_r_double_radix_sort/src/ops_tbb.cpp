@@ -2,46 +2,35 @@
 #include "tbb/mitin_r_double_radix_sort/include/ops_tbb.hpp"
 
 #include <algorithm>
-#include <cassert>
-#include <cstdlib>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <thread>
+#include <vector>
 
+#include "core/sort/include/radix_sort.hpp"
 #include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 
 using namespace std::chrono_literals;
 using namespace mitinr_radix_sort;
 
 namespace {
 
-constexpr int64_t max_byte_val = 256;
+constexpr int max_byte_val = 256;
+// below this many keys per worker the top-byte pass is not split
+constexpr size_t min_chunk_size = 1 << 16;
 
-uint8_t get_byte_val(double val, size_t byte_num) {
-  assert(*(reinterpret_cast<uint8_t*>(&val) + byte_num) < max_byte_val);
-  return *(reinterpret_cast<uint8_t*>(&val) + byte_num);
+uint8_t get_top_byte(double val) {
+  uint64_t bits;
+  std::memcpy(&bits, &val, sizeof(val));
+  return static_cast<uint8_t>(bits >> 56);
 }
 
-void sort_arr(double* arr, size_t size, double* buckets) {
-  if (size != 0) {
-    for (size_t byte_num = 0; byte_num < 7; byte_num++) {
-      size_t buckets_size[max_byte_val]{0};
-      for (size_t i = 0; i < size; i++) {
-        const uint32_t byte_val = get_byte_val(arr[i], byte_num);
-        buckets[byte_val * size + buckets_size[byte_val]++] = arr[i];
-      }
-
-      size_t it = 0;
-      for (int64_t i = 0; i < max_byte_val; i++) {
-        if (buckets_size[i] != 0) {
-          memcpy(arr + it, &buckets[i * size], buckets_size[i] * sizeof(double));
-          it += buckets_size[i];
-          assert(it <= size);
-        }
-      }
-    }
-  }
-}
+// Buckets in the order their keys come out: negative doubles have the top bit set and sort the
+// other way round, so the buckets from 255 down to 128 go first.
+int bucket_at(int rank) { return rank < max_byte_val / 2 ? max_byte_val - 1 - rank : rank - max_byte_val / 2; }
 
 }  // namespace
 
@@ -66,45 +55,50 @@ bool SortRadixDoubleTaskTBB::pre_processing() {
 bool SortRadixDoubleTaskTBB::run() {
   internal_order_test();
 
-  // tbb::task_scheduler_init init;
-
   try {
-    constexpr int64_t first_byte_max_val = 128;
-    auto* buckets = reinterpret_cast<double*>(std::malloc(data_size * first_byte_max_val * sizeof(double)));
-    if (buckets == nullptr) {
-      std::cerr << "Cannot allocate buffer\n";
-      return false;
-    }
-    size_t buckets_size[first_byte_max_val]{0};
-
-    uint64_t max_bucket_size = 0;
-    for (size_t i = 0; i < data_size; i++) {
-      const uint32_t byte_val = get_byte_val(data_ptr[i], 7);
-      assert(byte_val < first_byte_max_val);
-      buckets[byte_val * data_size + buckets_size[byte_val]++] = data_ptr[i];
-      max_bucket_size = std::max<size_t>(max_bucket_size, buckets_size[byte_val]);
-    }
-
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, first_byte_max_val), [=, this](const tbb::blocked_range<size_t>& r) {
-          auto* local_buckets = reinterpret_cast<double*>(malloc(max_bucket_size * max_byte_val * sizeof(double)));
-          for (size_t i = r.begin(); i < r.end(); i++) {
-            sort_arr(&buckets[i * data_size], buckets_size[i], local_buckets);
-          };
-          free(local_buckets);
-        });
-
+    // histogram then scatter on the top byte into one data_size buffer; every worker counts and
+    // scatters its own chunk, and the chunk offsets inside a bucket follow chunk order, so the
+    // scatter is stable and needs no synchronization
+    const size_t chunks = std::clamp<size_t>(data_size / min_chunk_size, 1,
+                                             static_cast<size_t>(std::max(1, tbb::this_task_arena::max_concurrency())));
+    std::vector<std::array<size_t, max_byte_val>> chunk_counts(chunks);
+    auto chunk_begin = [&](size_t c) { return data_size * c / chunks; };
+    tbb::parallel_for(size_t{0}, chunks, [&](size_t c) {
+      std::array<size_t, max_byte_val>& count = chunk_counts[c];
+      count.fill(0);
+      for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++) count[get_top_byte(data_ptr[i])]++;
+    });
+    std::array<size_t, max_byte_val> bucket_size{};
+    std::array<size_t, max_byte_val> bucket_start{};
     size_t it = 0;
-    for (int64_t i = 0; i < first_byte_max_val; i++) {
-      if (buckets_size[i] != 0) {
-        std::memcpy(data_ptr + it, &buckets[i * data_size], buckets_size[i] * sizeof(double));
-        it += buckets_size[i];
-        assert(it <= data_size);
+    for (int rank = 0; rank < max_byte_val; rank++) {
+      const int b = bucket_at(rank);
+      bucket_start[b] = it;
+      for (size_t c = 0; c < chunks; c++) {
+        const size_t count = chunk_counts[c][b];
+        chunk_counts[c][b] = it;
+        it += count;
       }
+      bucket_size[b] = it - bucket_start[b];
     }
-
-    free(buckets);
-
+    std::vector<double> buffer(data_size);
+    tbb::parallel_for(size_t{0}, chunks, [&](size_t c) {
+      std::array<size_t, max_byte_val>& next = chunk_counts[c];
+      for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++) {
+        buffer[next[get_top_byte(data_ptr[i])]++] = data_ptr[i];
+      }
+    });
+
+    // every bucket goes back into place and is sorted there on the remaining bytes by one worker,
+    // with its own slice of buffer as the radix sort scratch
+    tbb::parallel_for(tbb::blocked_range<int>(0, max_byte_val), [&](const tbb::blocked_range<int>& r) {
+      for (int b = r.begin(); b < r.end(); b++) {
+        double* bucket = data_ptr + bucket_start[b];
+        double* scratch = buffer.data() + bucket_start[b];
+        std::copy(scratch, scratch + bucket_size[b], bucket);
+        ppc::core::radixSort(bucket, bucket_size[b], scratch, 0, 1);
+      }
+    });
   } catch (const std::exception& e) {
     std::cerr << "Double Radix sort Exception error: " << e.what() << std::endl;
     return false;